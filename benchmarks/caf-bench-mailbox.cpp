@@ -0,0 +1,110 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+// Measures the per-message cost on the consumer side of an actor mailbox with
+// a varying number of producers. Each producer pre-allocates its messages and
+// then pushes them as fast as possible while a single consumer drains the
+// mailbox into the cached DRR queues and dispatches all messages.
+
+#include "caf/init_global_meta_objects.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/scheduled_actor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using mailbox_type = scheduled_actor::mailbox_type;
+
+using clock_type = std::chrono::steady_clock;
+
+// Every n-th message is an urgent message.
+constexpr size_t urgent_interval = 16;
+
+struct result {
+  size_t producers;
+  size_t messages;
+  size_t batches;
+  std::chrono::nanoseconds consumer_time;
+};
+
+result run(size_t num_producers, size_t messages_per_producer) {
+  mailbox_type mbox{unit, unit, unit};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < num_producers; ++i) {
+    producers.emplace_back([&, i] {
+      std::vector<mailbox_element_ptr> msgs;
+      msgs.reserve(messages_per_producer);
+      for (size_t n = 0; n < messages_per_producer; ++n) {
+        auto mid = n % urgent_interval == 0
+                     ? make_message_id(message_priority::high)
+                     : make_message_id();
+        msgs.emplace_back(make_mailbox_element(nullptr, mid, {},
+                                               static_cast<int32_t>(i)));
+      }
+      while (!go.load())
+        std::this_thread::yield();
+      for (auto& msg : msgs)
+        mbox.push_back(std::move(msg));
+    });
+  }
+  auto total = num_producers * messages_per_producer;
+  size_t consumed = 0;
+  size_t batches = 0;
+  auto f = [&consumed](mailbox_element&) {
+    ++consumed;
+    return intrusive::task_result::resume;
+  };
+  auto& urgent = std::get<scheduled_actor::urgent_queue_index>(
+    mbox.queue().queues());
+  auto& normal = std::get<scheduled_actor::normal_queue_index>(
+    mbox.queue().queues());
+  std::chrono::nanoseconds consumer_time{0};
+  go = true;
+  while (consumed < total) {
+    auto t0 = clock_type::now();
+    if (!mbox.fetch_more()) {
+      std::this_thread::yield();
+      continue;
+    }
+    ++batches;
+    // Mimic scheduled_actor::resume: urgent messages first, then normal ones.
+    urgent.new_round(total, f);
+    normal.new_round(total, f);
+    consumer_time += clock_type::now() - t0;
+  }
+  for (auto& producer : producers)
+    producer.join();
+  return {num_producers, total, batches, consumer_time};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  core::init_global_meta_objects();
+  size_t messages_per_producer = 1'000'000;
+  if (argc > 1)
+    messages_per_producer = strtoul(argv[1], nullptr, 10);
+  printf("%10s %10s %10s %12s %12s\n", "producers", "messages", "batches",
+         "avg-batch", "ns/msg");
+  for (size_t num_producers : {1u, 4u, 16u}) {
+    auto res = run(num_producers, messages_per_producer / num_producers);
+    auto ns = static_cast<double>(res.consumer_time.count());
+    printf("%10zu %10zu %10zu %12.1f %12.2f\n", res.producers, res.messages,
+           res.batches,
+           static_cast<double>(res.messages)
+             / static_cast<double>(std::max(res.batches, size_t{1})),
+           ns / static_cast<double>(res.messages));
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+// Compares the dispatcher cost per wakeup for the timing wheel of the actor
+// clock against a sorted table (the previous implementation) with a large
+// number of pending timers. Each wakeup receives a batch of new timers from
+// the queue, advances the simulated time by one millisecond and then collects
+// all expired timers.
+
+#include "caf/action.hpp"
+#include "caf/detail/timing_wheel.hpp"
+#include "caf/init_global_meta_objects.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using time_point = detail::timing_wheel::time_point;
+
+using entry = detail::timing_wheel::entry;
+
+using entry_ptr = detail::timing_wheel::entry_ptr;
+
+// Number of entries the dispatcher receives per wakeup.
+constexpr size_t batch_size = 64;
+
+// Maximum timeout for new timers.
+constexpr auto max_timeout = 60s;
+
+/// The previous implementation: a vector that the dispatcher sorts after
+/// receiving new entries.
+class sorted_table {
+public:
+  bool empty() const noexcept {
+    return tbl_.empty();
+  }
+
+  template <class Iterator>
+  void insert(Iterator first, Iterator last) {
+    std::move(first, last, std::back_inserter(tbl_));
+    std::sort(tbl_.begin(), tbl_.end(),
+              [](auto& x, auto& y) { return x->t < y->t; });
+  }
+
+  void advance(time_point now, std::vector<entry_ptr>& result) {
+    auto i = tbl_.begin();
+    for (; i != tbl_.end() && (*i)->t <= now; ++i)
+      result.emplace_back(std::move(*i));
+    i = std::stable_partition(i, tbl_.end(),
+                              [](auto& x) { return !x || x->f.disposed(); });
+    tbl_.erase(tbl_.begin(), i);
+  }
+
+private:
+  std::vector<entry_ptr> tbl_;
+};
+
+class wheel_table {
+public:
+  explicit wheel_table(time_point epoch) : wheel_(epoch) {
+    // nop
+  }
+
+  bool empty() const noexcept {
+    return wheel_.empty();
+  }
+
+  template <class Iterator>
+  void insert(Iterator first, Iterator last) {
+    for (; first != last; ++first)
+      wheel_.insert(std::move(*first));
+  }
+
+  void advance(time_point now, std::vector<entry_ptr>& result) {
+    wheel_.advance(now, result);
+  }
+
+private:
+  detail::timing_wheel wheel_;
+};
+
+struct result {
+  std::chrono::nanoseconds fill_time;
+  std::chrono::nanoseconds dispatch_time;
+  size_t expired;
+};
+
+std::vector<entry_ptr> make_entries(std::minstd_rand& rng, time_point now,
+                                    size_t n) {
+  std::uniform_int_distribution<int64_t> delay{0, timespan{max_timeout}.count()};
+  std::vector<entry_ptr> result;
+  result.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    result.emplace_back(
+      new entry{now + timespan{delay(rng)}, make_action([] {})});
+  return result;
+}
+
+template <class Table>
+result run(Table& tbl, time_point epoch, size_t num_timers, size_t rounds) {
+  std::minstd_rand rng{42};
+  // Fill the table with the initial set of pending timers.
+  auto initial = make_entries(rng, epoch, num_timers);
+  auto t0 = clock_type::now();
+  tbl.insert(initial.begin(), initial.end());
+  auto fill_time = clock_type::now() - t0;
+  // Simulate the dispatcher loop.
+  std::vector<entry_ptr> expired;
+  auto total_expired = size_t{0};
+  auto dispatch_time = std::chrono::nanoseconds{0};
+  for (size_t round = 1; round <= rounds; ++round) {
+    auto now = epoch + std::chrono::milliseconds{round};
+    auto batch = make_entries(rng, now, batch_size);
+    auto t1 = clock_type::now();
+    tbl.insert(batch.begin(), batch.end());
+    tbl.advance(now, expired);
+    for (auto& x : expired)
+      x->f.run();
+    dispatch_time += clock_type::now() - t1;
+    total_expired += expired.size();
+    expired.clear();
+  }
+  return {fill_time, dispatch_time, total_expired};
+}
+
+void print(const char* name, size_t rounds, const result& res) {
+  using fractional_ms = std::chrono::duration<double, std::milli>;
+  using fractional_us = std::chrono::duration<double, std::micro>;
+  auto fill = fractional_ms{res.fill_time}.count();
+  auto per_wakeup = fractional_us{res.dispatch_time}.count()
+                    / static_cast<double>(rounds);
+  printf("%12s %14.2f %14.2f %10zu\n", name, fill, per_wakeup, res.expired);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  core::init_global_meta_objects();
+  size_t num_timers = 1'000'000;
+  size_t rounds = 100;
+  if (argc > 1)
+    num_timers = strtoul(argv[1], nullptr, 10);
+  if (argc > 2)
+    rounds = strtoul(argv[2], nullptr, 10);
+  printf("pending timers: %zu, wakeups: %zu\n", num_timers, rounds);
+  printf("%12s %14s %14s %10s\n", "table", "fill [ms]", "wakeup [us]",
+         "expired");
+  auto epoch = time_point{};
+  {
+    sorted_table tbl;
+    print("sorted", rounds, run(tbl, epoch, num_timers, rounds));
+  }
+  {
+    wheel_table tbl{epoch};
+    print("wheel", rounds, run(tbl, epoch, num_timers, rounds));
+  }
+  return EXIT_SUCCESS;
+}
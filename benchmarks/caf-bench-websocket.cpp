@@ -0,0 +1,94 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+// Measures the throughput of unmasking WebSocket payloads with each masking
+// algorithm that the CPU supports, as well as unmasking text payloads with a
+// separate UTF-8 validation pass compared to the fused implementation.
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/rfc3629.hpp"
+#include "caf/detail/rfc6455.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using impl = detail::rfc6455;
+
+using algorithm = impl::mask_algorithm;
+
+constexpr uint32_t mask_key = 0xDEADC0DE;
+
+// Prevents the compiler from optimizing away the benchmarked code.
+volatile size_t sink;
+
+const char* to_cstr(algorithm x) {
+  switch (x) {
+    case algorithm::scalar:
+      return "scalar";
+    case algorithm::word:
+      return "word";
+    case algorithm::sse2:
+      return "sse2";
+    default:
+      return "avx2";
+  }
+}
+
+// Returns the average throughput in GB/s for running `f` on `buf`.
+template <class F>
+double measure(byte_buffer& buf, size_t total_bytes, F f) {
+  auto rounds = std::max(total_bytes / buf.size(), size_t{1});
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < rounds; ++i)
+    f(buf);
+  std::chrono::duration<double> elapsed = clock_type::now() - t0;
+  sink = sink + static_cast<size_t>(buf[0]);
+  return static_cast<double>(rounds * buf.size()) / elapsed.count() / 1e9;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t total_bytes = 1'000'000'000;
+  if (argc > 1)
+    total_bytes = strtoul(argv[1], nullptr, 10);
+  printf("default algorithm: %s\n\n",
+         to_cstr(impl::default_mask_algorithm()));
+  printf("%-24s %10s %10s\n", "benchmark", "size", "GB/s");
+  for (size_t size : {4'096u, 16'384u, 65'536u}) {
+    byte_buffer buf(size, std::byte{'x'});
+    for (auto alg : {algorithm::scalar, algorithm::word, algorithm::sse2,
+                     algorithm::avx2}) {
+      if (!impl::supports(alg))
+        continue;
+      auto res = measure(buf, total_bytes, [alg](byte_buffer& xs) {
+        impl::mask_data(alg, mask_key, xs);
+      });
+      printf("mask/%-19s %10zu %10.2f\n", to_cstr(alg), size, res);
+    }
+    // Both text benchmarks mask the text first to have a valid input for each
+    // round. Hence, the difference between both results is the gain of the
+    // fused implementation over a scalar unmasking plus a separate validation.
+    auto separate = measure(buf, total_bytes, [](byte_buffer& xs) {
+      impl::mask_data(mask_key, xs);
+      impl::mask_data(algorithm::scalar, mask_key, xs);
+      sink = sink + detail::rfc3629::valid(xs);
+    });
+    printf("%-24s %10zu %10.2f\n", "text/scalar+validate", size, separate);
+    auto fused = measure(buf, total_bytes, [](byte_buffer& xs) {
+      impl::mask_data(mask_key, xs);
+      sink = sink + impl::mask_and_validate(mask_key, xs);
+    });
+    printf("%-24s %10zu %10.2f\n", "text/fused", size, fused);
+  }
+  return EXIT_SUCCESS;
+}
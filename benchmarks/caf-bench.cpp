@@ -0,0 +1,359 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+// Runs a suite of micro-benchmarks for the actor runtime once per scheduler
+// policy and prints the results either as a table or as JSON. Each run uses a
+// fresh actor system and measures the wall-clock time until all actors of the
+// benchmark have terminated.
+//
+// Usage: caf-bench [--format=console|json] [--filter=<substring>]
+//                  [--scale=<factor>] [--repetitions=<n>] [--max-threads=<n>]
+//
+// With more than one repetition, the output contains the median run. The JSON
+// output follows the layout of Google Benchmark to make it usable with
+// existing tooling for tracking results across commits. Since the runtime
+// spreads each benchmark across all workers, the CPU time covers the whole
+// process rather than only the main thread.
+
+#include "caf/actor_pool.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/exit_reason.hpp"
+#include "caf/init_global_meta_objects.hpp"
+#include "caf/settings.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// -- benchmark implementations ------------------------------------------------
+
+/// Number of workers for the fan-out/fan-in benchmark.
+constexpr size_t fan_out_workers = 64;
+
+/// Number of workers in the actor pool.
+constexpr size_t pool_workers = 8;
+
+/// Maximum number of in-flight messages to the actor pool.
+constexpr size_t pool_window = 128;
+
+behavior echo() {
+  return {
+    [](int32_t x) { return x; },
+  };
+}
+
+/// Spawns `n` actors that terminate immediately.
+void spawn_destroy(actor_system& sys, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    sys.spawn([](event_based_actor*) {});
+}
+
+/// Sends a message back and forth between two actors `n` times.
+void ping_pong(actor_system& sys, size_t n) {
+  auto pong = sys.spawn(echo);
+  sys.spawn([pong, n](event_based_actor* self) -> behavior {
+    self->send(pong, int32_t{1});
+    return {
+      [self, pong, n](int32_t x) {
+        if (static_cast<size_t>(x) == n) {
+          self->send_exit(pong, exit_reason::user_shutdown);
+          self->quit();
+          return;
+        }
+        self->send(pong, x + 1);
+      },
+    };
+  });
+}
+
+/// Sends a message to each of `fan_out_workers` workers and waits for all
+/// replies before starting the next of `n` rounds.
+void fan_out_in(actor_system& sys, size_t n) {
+  std::vector<actor> workers;
+  for (size_t i = 0; i < fan_out_workers; ++i)
+    workers.emplace_back(sys.spawn(echo));
+  sys.spawn([workers, n](event_based_actor* self) -> behavior {
+    auto broadcast = [self, workers](int32_t round) {
+      for (auto& worker : workers)
+        self->send(worker, round);
+    };
+    broadcast(1);
+    return {
+      [self, workers, n, broadcast,
+       pending = workers.size()](int32_t round) mutable {
+        if (--pending > 0)
+          return;
+        if (static_cast<size_t>(round) == n) {
+          for (auto& worker : workers)
+            self->send_exit(worker, exit_reason::user_shutdown);
+          self->quit();
+          return;
+        }
+        pending = workers.size();
+        broadcast(round + 1);
+      },
+    };
+  });
+}
+
+/// Dispatches `n` messages through a round-robin actor pool while keeping at
+/// most `pool_window` messages in flight.
+void pool_dispatch(actor_system& sys, size_t n) {
+  auto pool = actor_pool::make(sys.dummy_execution_unit(), pool_workers,
+                               [&sys] { return sys.spawn(echo); },
+                               actor_pool::round_robin());
+  sys.spawn([pool, n](event_based_actor* self) -> behavior {
+    auto sent = std::min(n, pool_window);
+    for (size_t i = 0; i < sent; ++i)
+      self->send(pool, int32_t{1});
+    return {
+      [self, pool, n, sent, received = size_t{0}](int32_t) mutable {
+        if (++received == n) {
+          self->send_exit(pool, exit_reason::user_shutdown);
+          self->quit();
+        } else if (sent < n) {
+          ++sent;
+          self->send(pool, int32_t{1});
+        }
+      },
+    };
+  });
+}
+
+void request_loop(event_based_actor* self, actor server, size_t remaining) {
+  if (remaining == 0) {
+    self->send_exit(server, exit_reason::user_shutdown);
+    self->quit();
+    return;
+  }
+  self->request(server, infinite, int32_t{1})
+    .then([self, server, remaining](int32_t) {
+      request_loop(self, server, remaining - 1);
+    });
+}
+
+/// Performs `n` sequential request/response round trips.
+void request_then(actor_system& sys, size_t n) {
+  auto server = sys.spawn(echo);
+  sys.spawn([server, n](event_based_actor* self) {
+    request_loop(self, server, n);
+  });
+}
+
+// -- harness ------------------------------------------------------------------
+
+struct benchmark {
+  /// Identifies the benchmark in the output.
+  const char* name;
+
+  /// Number of iterations at scale 1.
+  size_t iterations;
+
+  /// Spawns all actors for the benchmark.
+  void (*setup)(actor_system&, size_t);
+};
+
+constexpr benchmark benchmarks[] = {
+  {"spawn_destroy", 100'000, spawn_destroy},
+  {"ping_pong", 100'000, ping_pong},
+  {"fan_out_in/workers:64", 2'000, fan_out_in},
+  {"actor_pool/workers:8", 100'000, pool_dispatch},
+  {"request_then", 100'000, request_then},
+};
+
+constexpr const char* policies[] = {"sharing", "stealing",
+                                    "lock-free-stealing"};
+
+struct options {
+  bool json = false;
+  std::string filter;
+  double scale = 1.0;
+  size_t repetitions = 1;
+  size_t max_threads = 0;
+};
+
+/// Stores the wall-clock time and the CPU time of a single run.
+struct timing {
+  std::chrono::nanoseconds real_time;
+  std::chrono::nanoseconds cpu_time;
+};
+
+struct measurement {
+  std::string name;
+  size_t iterations;
+  timing time;
+};
+
+/// Returns the CPU time of the process, i.e., of all threads.
+std::chrono::nanoseconds process_cpu_time() {
+  auto ticks = static_cast<double>(std::clock());
+  return std::chrono::nanoseconds{
+    static_cast<std::chrono::nanoseconds::rep>(ticks * 1e9 / CLOCKS_PER_SEC)};
+}
+
+timing run_once(const benchmark& bm, const char* policy, size_t iterations,
+                const options& opts) {
+  actor_system_config cfg;
+  put(cfg.content, "caf.scheduler.policy", std::string{policy});
+  if (opts.max_threads > 0)
+    put(cfg.content, "caf.scheduler.max-threads", opts.max_threads);
+  actor_system sys{cfg};
+  auto t0 = clock_type::now();
+  auto c0 = process_cpu_time();
+  bm.setup(sys, iterations);
+  sys.await_all_actors_done();
+  return {clock_type::now() - t0, process_cpu_time() - c0};
+}
+
+measurement run(const benchmark& bm, const char* policy, std::string name,
+                const options& opts) {
+  auto scaled = static_cast<double>(bm.iterations) * opts.scale;
+  auto iterations = std::max(size_t{1}, static_cast<size_t>(scaled));
+  std::vector<timing> times;
+  for (size_t i = 0; i < opts.repetitions; ++i)
+    times.emplace_back(run_once(bm, policy, iterations, opts));
+  auto median = times.begin() + static_cast<ptrdiff_t>(times.size() / 2);
+  std::nth_element(times.begin(), median, times.end(),
+                   [](const timing& x, const timing& y) {
+                     return x.real_time < y.real_time;
+                   });
+  return {std::move(name), iterations, *median};
+}
+
+double per_iteration(std::chrono::nanoseconds time, const measurement& res) {
+  return static_cast<double>(time.count())
+         / static_cast<double>(res.iterations);
+}
+
+double ns_per_iteration(const measurement& res) {
+  return per_iteration(res.time.real_time, res);
+}
+
+double cpu_ns_per_iteration(const measurement& res) {
+  return per_iteration(res.time.cpu_time, res);
+}
+
+double items_per_second(const measurement& res) {
+  return 1e9 / ns_per_iteration(res);
+}
+
+void print_console(const std::vector<measurement>& results) {
+  printf("%-48s %12s %14s %14s %16s\n", "benchmark", "iterations",
+         "time [ns]", "cpu [ns]", "items/s");
+  for (auto& res : results)
+    printf("%-48s %12zu %14.1f %14.1f %16.0f\n", res.name.c_str(),
+           res.iterations, ns_per_iteration(res), cpu_ns_per_iteration(res),
+           items_per_second(res));
+}
+
+void print_json(const std::vector<measurement>& results, const options& opts) {
+  char date[32];
+  auto now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z",
+                std::localtime(&now));
+  printf("{\n");
+  printf("  \"context\": {\n");
+  printf("    \"date\": \"%s\",\n", date);
+  printf("    \"caf_version\": \"%d.%d.%d\",\n", CAF_MAJOR_VERSION,
+         CAF_MINOR_VERSION, CAF_PATCH_VERSION);
+  printf("    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+  printf("    \"scale\": %g,\n", opts.scale);
+  printf("    \"repetitions\": %zu\n", opts.repetitions);
+  printf("  },\n");
+  printf("  \"benchmarks\": [");
+  // With multiple repetitions, each entry is the median of all runs. Google
+  // Benchmark reports such entries as aggregates with a suffix in the name.
+  auto is_aggregate = opts.repetitions > 1;
+  for (size_t i = 0; i < results.size(); ++i) {
+    auto& res = results[i];
+    printf(i == 0 ? "\n" : ",\n");
+    printf("    {\n");
+    printf("      \"name\": \"%s%s\",\n", res.name.c_str(),
+           is_aggregate ? "_median" : "");
+    printf("      \"run_name\": \"%s\",\n", res.name.c_str());
+    if (is_aggregate) {
+      printf("      \"run_type\": \"aggregate\",\n");
+      printf("      \"aggregate_name\": \"median\",\n");
+    } else {
+      printf("      \"run_type\": \"iteration\",\n");
+    }
+    printf("      \"repetitions\": %zu,\n", opts.repetitions);
+    printf("      \"iterations\": %zu,\n", res.iterations);
+    printf("      \"real_time\": %.1f,\n", ns_per_iteration(res));
+    printf("      \"cpu_time\": %.1f,\n", cpu_ns_per_iteration(res));
+    printf("      \"time_unit\": \"ns\",\n");
+    printf("      \"items_per_second\": %.0f\n", items_per_second(res));
+    printf("    }");
+  }
+  printf("\n  ]\n}\n");
+}
+
+bool parse_args(int argc, char** argv, options& opts) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    auto value_of = [arg](std::string_view prefix) {
+      return arg.substr(prefix.size()).data();
+    };
+    if (arg == "--format=json") {
+      opts.json = true;
+    } else if (arg == "--format=console") {
+      opts.json = false;
+    } else if (arg.rfind("--filter=", 0) == 0) {
+      opts.filter = value_of("--filter=");
+    } else if (arg.rfind("--scale=", 0) == 0) {
+      opts.scale = strtod(value_of("--scale="), nullptr);
+    } else if (arg.rfind("--repetitions=", 0) == 0) {
+      opts.repetitions = strtoul(value_of("--repetitions="), nullptr, 10);
+    } else if (arg.rfind("--max-threads=", 0) == 0) {
+      opts.max_threads = strtoul(value_of("--max-threads="), nullptr, 10);
+    } else {
+      fprintf(stderr,
+              "usage: %s [--format=console|json] [--filter=<substring>]\n"
+              "       [--scale=<factor>] [--repetitions=<n>]"
+              " [--max-threads=<n>]\n",
+              argv[0]);
+      return false;
+    }
+  }
+  return opts.scale > 0 && opts.repetitions > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  options opts;
+  if (!parse_args(argc, argv, opts))
+    return EXIT_FAILURE;
+  core::init_global_meta_objects();
+  std::vector<measurement> results;
+  for (auto& bm : benchmarks) {
+    for (auto policy : policies) {
+      auto name = std::string{bm.name} + "/policy:" + policy;
+      if (name.find(opts.filter) == std::string::npos)
+        continue;
+      results.emplace_back(run(bm, policy, std::move(name), opts));
+    }
+  }
+  if (opts.json)
+    print_json(results, opts);
+  else
+    print_console(results);
+  return EXIT_SUCCESS;
+}
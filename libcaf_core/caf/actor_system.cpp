@@ -9,6 +9,7 @@
 #include "caf/defaults.hpp"
 #include "caf/detail/meta_object.hpp"
 #include "caf/event_based_actor.hpp"
+#include "caf/policy/lock_free_work_stealing.hpp"
 #include "caf/policy/work_sharing.hpp"
 #include "caf/policy/work_stealing.hpp"
 #include "caf/raise_error.hpp"
@@ -244,6 +245,11 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
       "Time a message waits in the mailbox before processing.", "seconds"),
     reg.gauge_family("caf.actor", "mailbox-size", {"name"},
                      "Number of messages in the mailbox."),
+    reg.gauge_family("caf.actor", "throughput-quota", {"name"},
+                     "Number of messages an actor may consume per resume."),
+    reg.histogram_family<double>("caf.actor", "resume-time", {"name"},
+                                 default_buckets,
+                                 "Time an actor runs per resume.", "seconds"),
     {
       reg.counter_family("caf.actor.stream", "processed-elements",
                          {"name", "type"},
@@ -315,15 +321,18 @@ actor_system::actor_system(actor_system_config& cfg)
   // Make sure we have a scheduler up and running.
   auto& sched = modules_[module::scheduler];
   using namespace scheduler;
+  using policy::lock_free_work_stealing;
   using policy::work_sharing;
   using policy::work_stealing;
   using share = coordinator<work_sharing>;
   using steal = coordinator<work_stealing>;
+  using lf_steal = coordinator<lock_free_work_stealing>;
   if (!sched) {
     enum sched_conf {
       stealing = 0x0001,
       sharing = 0x0002,
       testing = 0x0003,
+      lock_free_stealing = 0x0004,
     };
     sched_conf sc = stealing;
     namespace sr = defaults::scheduler;
@@ -332,6 +341,8 @@ actor_system::actor_system(actor_system_config& cfg)
       sc = sharing;
     else if (sr_policy == "testing")
       sc = testing;
+    else if (sr_policy == "lock-free-stealing")
+      sc = lock_free_stealing;
     else if (sr_policy != "stealing")
       std::cerr << "[WARNING] " << deep_to_string(sr_policy)
                 << " is an unrecognized scheduler pollicy, "
@@ -344,6 +355,9 @@ actor_system::actor_system(actor_system_config& cfg)
       case sharing:
         sched.reset(new share(*this));
         break;
+      case lock_free_stealing:
+        sched.reset(new lf_steal(*this));
+        break;
       case testing:
         sched.reset(new test_coordinator(*this));
     }
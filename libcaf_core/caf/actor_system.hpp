@@ -228,6 +228,12 @@ public:
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge_family* mailbox_size = nullptr;
 
+    /// Tracks how many messages the actor may consume per resume.
+    telemetry::int_gauge_family* throughput_quota = nullptr;
+
+    /// Samples how long the actor runs per resume.
+    telemetry::dbl_histogram_family* resume_time = nullptr;
+
     struct {
       // -- inbound ------------------------------------------------------------
 
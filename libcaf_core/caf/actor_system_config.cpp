@@ -52,9 +52,16 @@ actor_system_config::actor_system_config()
     .add<bool>("dump-config", "print configuration and exit")
     .add<string>("config-file", "sets a path to a configuration file");
   opt_group{custom_options_, "caf.scheduler"}
-    .add<string>("policy", "'stealing' (default) or 'sharing'")
+    .add<string>("policy", "'stealing' (default), 'lock-free-stealing' or "
+                           "'sharing'")
     .add<size_t>("max-threads", "maximum number of worker threads")
     .add<size_t>("max-throughput", "nr. of messages actors can consume per run")
+    .add<timespan>("max-resume-time",
+                   "time budget for adapting the throughput of actors")
+    .add<timespan>("watchdog-threshold",
+                   "moves queued jobs away from workers that are busy longer")
+    .add<bool>("use-slab-allocator",
+               "allocate messages from per-worker slab caches")
     .add<bool>("enable-profiling", "enables profiler output")
     .add<timespan>("profiling-resolution", "data collection rate")
     .add<string>("profiling-output-file", "output file for the profiler");
@@ -70,7 +77,13 @@ actor_system_config::actor_system_config()
     .add<size_t>("relaxed-steal-interval",
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
-                   "sleep duration between relaxed steal attempts");
+                   "sleep duration between relaxed steal attempts")
+    .add<bool>("park-idle-workers",
+               "parks idle workers instead of polling for new jobs")
+    .add<bool>("topology-aware",
+               "steal from workers on the same core complex or NUMA node first "
+               "and bind each worker thread to a dedicated CPU")
+    .add<bool>("pin-workers", "binds each worker thread to a dedicated CPU");
   opt_group{custom_options_, "caf.logger.file"}
     .add<string>("path", "filesystem path for the log file")
     .add<string>("format", "format for individual log file entries")
@@ -97,6 +110,12 @@ settings actor_system_config::dump_content() const {
   put_missing(scheduler_group, "policy", defaults::scheduler::policy);
   put_missing(scheduler_group, "max-throughput",
               defaults::scheduler::max_throughput);
+  put_missing(scheduler_group, "max-resume-time",
+              defaults::scheduler::max_resume_time);
+  put_missing(scheduler_group, "watchdog-threshold",
+              defaults::scheduler::watchdog_threshold);
+  put_missing(scheduler_group, "use-slab-allocator",
+              defaults::scheduler::use_slab_allocator);
   put_missing(scheduler_group, "enable-profiling", false);
   put_missing(scheduler_group, "profiling-resolution",
               defaults::scheduler::profiling_resolution);
@@ -117,6 +136,12 @@ settings actor_system_config::dump_content() const {
               defaults::work_stealing::relaxed_steal_interval);
   put_missing(work_stealing_group, "relaxed-sleep-duration",
               defaults::work_stealing::relaxed_sleep_duration);
+  put_missing(work_stealing_group, "park-idle-workers",
+              defaults::work_stealing::park_idle_workers);
+  put_missing(work_stealing_group, "topology-aware",
+              defaults::work_stealing::topology_aware);
+  put_missing(work_stealing_group, "pin-workers",
+              defaults::work_stealing::pin_workers);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
   auto& file_group = logger_group["file"].as_dictionary();
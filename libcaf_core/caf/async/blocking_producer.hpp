@@ -16,7 +16,8 @@
 
 namespace caf::async {
 
-/// Blocking interface for emitting items to an asynchronous consumer.
+/// Blocking interface for emitting items to an asynchronous consumer. Multiple
+/// threads may call `push` concurrently.
 template <class T>
 class blocking_producer {
 public:
@@ -38,11 +39,16 @@ public:
         if (demand_ < 0) {
           return false;
         } else {
+          // We cannot hold `mtx_` while pushing to the buffer, because the
+          // buffer calls `on_consumer_demand` while holding its own lock.
+          // Hence, we claim the demand before releasing `mtx_` to make sure
+          // that concurrent producers never exceed the demand. The buffer
+          // itself serializes concurrent calls to `push`.
           auto n = std::min(static_cast<size_t>(demand_), items.size());
+          demand_ -= static_cast<ptrdiff_t>(n);
           guard.unlock();
           buf_->push(items.subspan(0, n));
           guard.lock();
-          demand_ -= static_cast<ptrdiff_t>(n);
           items = items.subspan(n);
         }
       }
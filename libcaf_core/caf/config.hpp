@@ -50,6 +50,7 @@
 #  define CAF_CLANG
 #  define CAF_LIKELY(x) __builtin_expect((x), 1)
 #  define CAF_UNLIKELY(x) __builtin_expect((x), 0)
+#  define CAF_PREFETCH(addr) __builtin_prefetch(addr)
 #  define CAF_DEPRECATED __attribute__((deprecated))
 #  define CAF_DEPRECATED_MSG(msg) __attribute__((deprecated(msg)))
 #  define CAF_PUSH_WARNINGS                                                    \
@@ -98,6 +99,7 @@
 #  define CAF_GCC
 #  define CAF_LIKELY(x) __builtin_expect((x), 1)
 #  define CAF_UNLIKELY(x) __builtin_expect((x), 0)
+#  define CAF_PREFETCH(addr) __builtin_prefetch(addr)
 #  define CAF_DEPRECATED __attribute__((deprecated))
 #  define CAF_DEPRECATED_MSG(msg) __attribute__((deprecated(msg)))
 #  define CAF_PUSH_WARNINGS                                                    \
@@ -133,6 +135,7 @@
 #  define CAF_MSVC
 #  define CAF_LIKELY(x) x
 #  define CAF_UNLIKELY(x) x
+#  define CAF_PREFETCH(addr) static_cast<void>(0)
 #  define CAF_DEPRECATED
 #  define CAF_DEPRECATED_MSG(msg)
 #  define CAF_PUSH_WARNINGS                                                    \
@@ -156,6 +159,7 @@
 #else
 #  define CAF_LIKELY(x) x
 #  define CAF_UNLIKELY(x) x
+#  define CAF_PREFETCH(addr) static_cast<void>(0)
 #  define CAF_DEPRECATED
 #  define CAF_PUSH_WARNINGS
 #  define CAF_PUSH_NON_VIRTUAL_DTOR_WARNING
@@ -513,8 +513,8 @@ config_value::parse_msg_impl(std::string_view str,
       reader.begin_sequence(unused);
       CAF_ASSERT(unused == ls_size);
       intrusive_ptr<detail::message_data> ptr;
-      if (auto vptr = malloc(sizeof(detail::message_data) + ls.data_size()))
-        ptr.reset(new (vptr) detail::message_data(ls), false);
+      if (auto raw_ptr = detail::message_data::try_make(ls, ls.data_size()))
+        ptr.reset(raw_ptr, false);
       else
         return false;
       auto pos = ptr->storage();
@@ -6,6 +6,7 @@
 
 #include "caf/detail/build_config.hpp"
 #include "caf/detail/log_level.hpp"
+#include "caf/timespan.hpp"
 #include "caf/timestamp.hpp"
 
 #include <chrono>
@@ -98,6 +99,19 @@ constexpr auto profiling_output_file = std::string_view{""};
 constexpr auto max_throughput = std::numeric_limits<size_t>::max();
 constexpr auto profiling_resolution = timespan(100'000'000);
 
+/// Configures whether worker threads allocate mailbox elements and message
+/// payloads from a thread-local slab cache instead of using `malloc`.
+constexpr auto use_slab_allocator = false;
+
+/// Configures how long an actor may run before yielding its worker thread.
+/// Actors derive an adaptive message quota from this time budget. The default
+/// value disables the time budget.
+constexpr auto max_resume_time = infinite;
+
+/// Configures after how long a single job on a worker counts as stalled. The
+/// default value disables the watchdog.
+constexpr auto watchdog_threshold = infinite;
+
 } // namespace caf::defaults::scheduler
 
 namespace caf::defaults::work_stealing {
@@ -110,6 +124,19 @@ constexpr auto moderate_sleep_duration = timespan{50'000};
 constexpr auto relaxed_steal_interval = size_t{1};
 constexpr auto relaxed_sleep_duration = timespan{10'000'000};
 
+/// Configures whether idle workers park until new jobs arrive instead of
+/// polling their queue with increasing sleep durations.
+constexpr auto park_idle_workers = true;
+
+/// Configures whether workers steal from workers that share a last-level cache
+/// or NUMA node first before stealing from remote workers. Implies
+/// `pin_workers`, since the distance between workers depends on their CPUs.
+constexpr auto topology_aware = false;
+
+/// Configures whether workers bind their thread to a dedicated CPU even if
+/// `topology_aware` is `false`.
+constexpr auto pin_workers = false;
+
 } // namespace caf::defaults::work_stealing
 
 namespace caf::defaults::logger::file {
@@ -131,11 +158,18 @@ namespace caf::defaults::middleman {
 
 constexpr auto app_identifier = std::string_view{"generic-caf-app"};
 constexpr auto cached_udp_buffers = size_t{10};
+constexpr auto compression = std::string_view{"none"};
+constexpr auto compression_threshold = size_t{1024};
 constexpr auto connection_timeout = timespan{30'000'000'000};
+constexpr auto enable_dictionaries = false;
+constexpr auto flush_delay = timespan{0};
+constexpr auto flush_policy = std::string_view{"coalesce"};
+constexpr auto flush_threshold = size_t{65'536};
 constexpr auto heartbeat_interval = timespan{10'000'000'000};
 constexpr auto max_consecutive_reads = size_t{50};
 constexpr auto max_pending_msgs = size_t{10};
 constexpr auto network_backend = std::string_view{"default"};
+constexpr auto shm_buffer_size = size_t{262'144};
 
 } // namespace caf::defaults::middleman
 
@@ -39,7 +39,7 @@ public:
   std::optional<message> value;
 
   void operator()(error& x) override {
-    value = make_message(std::move(x));
+    value = make_message_impl<true>(std::move(x));
   }
 
   void operator()(message& x) override {
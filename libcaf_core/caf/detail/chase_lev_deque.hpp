@@ -0,0 +1,195 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace caf::detail {
+
+/// A lock-free, growable work-stealing deque as described by Chase and Lev in
+/// "Dynamic Circular Work-Stealing Deque" (SPAA 2005) with the memory orderings
+/// from Lê et al. "Correct and Efficient Work-Stealing for Weak Memory Models"
+/// (PPoPP 2013).
+///
+/// Only the owner may call `push` and `pop`, which operate on the bottom of
+/// the deque in LIFO order. Any other thread may call `steal` to take the
+/// oldest element from the top of the deque.
+/// @note The deque stores raw pointers and never takes ownership of them.
+template <class T>
+class chase_lev_deque {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using pointer = value_type*;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Default number of slots in the initial ring buffer.
+  static constexpr size_t default_capacity = 256;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit chase_lev_deque(size_t capacity = default_capacity)
+    : top_(0), bottom_(0) {
+    // Round up to the next power of two.
+    size_t n = 2;
+    while (n < capacity)
+      n <<= 1;
+    auto buf = std::make_unique<ring>(n);
+    buf_.store(buf.get(), std::memory_order_relaxed);
+    rings_.emplace_back(std::move(buf));
+  }
+
+  chase_lev_deque(const chase_lev_deque&) = delete;
+
+  chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns an approximation of the current number of elements.
+  size_t size() const noexcept {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0u;
+  }
+
+  /// Returns whether the deque appears to be empty.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /// Returns the capacity of the current ring buffer.
+  size_t capacity() const noexcept {
+    return buf_.load(std::memory_order_relaxed)->capacity();
+  }
+
+  // -- owner interface --------------------------------------------------------
+
+  /// Pushes `value` to the bottom of the deque, growing the buffer if needed.
+  /// @warning Must only be called by the owner of the deque.
+  void push(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto* buf = buf_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(buf->capacity()) - 1)
+      buf = grow(buf, t, b);
+    buf->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Takes the most recently pushed element from the bottom of the deque.
+  /// @returns the element or `nullptr` if the deque is empty.
+  /// @warning Must only be called by the owner of the deque.
+  pointer pop() noexcept {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto* buf = buf_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // Empty deque.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto* result = buf->get(b);
+    if (t == b) {
+      // Last element: race against thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        result = nullptr;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  // -- thief interface --------------------------------------------------------
+
+  /// Takes the oldest element from the top of the deque.
+  /// @returns the element or `nullptr` if the deque is empty or if another
+  ///          thread won the race for the top element.
+  pointer steal() noexcept {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+      return nullptr;
+    auto* buf = buf_.load(std::memory_order_acquire);
+    auto* result = buf->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return nullptr;
+    return result;
+  }
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  class ring {
+  public:
+    explicit ring(size_t capacity)
+      : mask_(capacity - 1), slots_(new std::atomic<pointer>[capacity]) {
+      // nop
+    }
+
+    size_t capacity() const noexcept {
+      return mask_ + 1;
+    }
+
+    pointer get(int64_t index) const noexcept {
+      return slots_[static_cast<size_t>(index) & mask_].load(
+        std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, pointer value) noexcept {
+      slots_[static_cast<size_t>(index) & mask_].store(
+        value, std::memory_order_relaxed);
+    }
+
+  private:
+    size_t mask_;
+    std::unique_ptr<std::atomic<pointer>[]> slots_;
+  };
+
+  // -- utility functions ------------------------------------------------------
+
+  ring* grow(ring* old_buf, int64_t t, int64_t b) {
+    auto buf = std::make_unique<ring>(old_buf->capacity() * 2);
+    for (auto i = t; i < b; ++i)
+      buf->put(i, old_buf->get(i));
+    auto* result = buf.get();
+    // Thieves may still read from the old ring, so we keep it alive until the
+    // deque gets destroyed. Since each ring doubles the capacity, the total
+    // memory overhead is bounded by the size of the current ring.
+    rings_.emplace_back(std::move(buf));
+    buf_.store(result, std::memory_order_release);
+    return result;
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Index of the oldest element. Modified by thieves and by the owner.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> top_;
+
+  /// Index past the newest element. Modified only by the owner.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> bottom_;
+
+  /// Points to the currently active ring buffer.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<ring*> buf_;
+
+  /// Owns all ring buffers, including retired ones. Accessed only by the owner.
+  std::vector<std::unique_ptr<ring>> rings_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,98 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/chase_lev_deque.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using int_deque = detail::chase_lev_deque<int>;
+
+TEST("the owner pops elements in LIFO order") {
+  std::vector<int> xs{1, 2, 3};
+  int_deque uut;
+  check(uut.empty());
+  check_eq(uut.pop(), nullptr);
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.size(), 3u);
+  check_eq(uut.pop(), &xs[2]);
+  check_eq(uut.pop(), &xs[1]);
+  check_eq(uut.pop(), &xs[0]);
+  check_eq(uut.pop(), nullptr);
+  check(uut.empty());
+}
+
+TEST("thieves steal elements in FIFO order") {
+  std::vector<int> xs{1, 2, 3};
+  int_deque uut;
+  check_eq(uut.steal(), nullptr);
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.steal(), &xs[0]);
+  check_eq(uut.pop(), &xs[2]);
+  check_eq(uut.steal(), &xs[1]);
+  check_eq(uut.steal(), nullptr);
+  check_eq(uut.pop(), nullptr);
+}
+
+TEST("the deque grows on demand") {
+  std::vector<int> xs(100);
+  std::iota(xs.begin(), xs.end(), 0);
+  int_deque uut{4};
+  check_eq(uut.capacity(), 4u);
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.size(), 100u);
+  check(uut.capacity() >= 100u);
+  for (auto i = 0; i < 50; ++i)
+    check_eq(uut.steal(), &xs[i]);
+  for (auto i = 99; i >= 50; --i)
+    check_eq(uut.pop(), &xs[i]);
+  check(uut.empty());
+}
+
+TEST("each element is taken exactly once under contention") {
+  constexpr size_t num_items = 100'000;
+  constexpr size_t num_thieves = 3;
+  std::vector<int> xs(num_items);
+  std::vector<std::atomic<int>> taken(num_items);
+  int_deque uut{8};
+  std::atomic<bool> done{false};
+  auto mark = [&](int* x) { taken[static_cast<size_t>(x - xs.data())]++; };
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i)
+    thieves.emplace_back([&] {
+      while (!done.load()) {
+        if (auto* x = uut.steal())
+          mark(x);
+      }
+      while (auto* x = uut.steal())
+        mark(x);
+    });
+  // The owner interleaves pushes with occasional pops.
+  for (size_t i = 0; i < num_items; ++i) {
+    uut.push(&xs[i]);
+    if (i % 3 == 0)
+      if (auto* x = uut.pop())
+        mark(x);
+  }
+  while (auto* x = uut.pop())
+    mark(x);
+  done = true;
+  for (auto& thief : thieves)
+    thief.join();
+  auto once = [](const std::atomic<int>& x) { return x.load() == 1; };
+  check(std::all_of(taken.begin(), taken.end(), once));
+}
+
+CAF_TEST_MAIN()
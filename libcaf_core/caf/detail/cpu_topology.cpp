@@ -0,0 +1,229 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <thread>
+
+#ifdef CAF_LINUX
+#  include <dirent.h>
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace caf::detail {
+
+namespace {
+
+[[maybe_unused]] std::string read_first_line(const std::string& path) {
+  std::string result;
+  std::ifstream in{path};
+  if (in)
+    std::getline(in, result);
+  return result;
+}
+
+[[maybe_unused]] bool parse_size(std::string_view str, size_t& result) {
+  if (str.empty())
+    return false;
+  size_t value = 0;
+  for (auto ch : str) {
+    if (!isdigit(static_cast<unsigned char>(ch)))
+      return false;
+    value = value * 10 + static_cast<size_t>(ch - '0');
+  }
+  result = value;
+  return true;
+}
+
+std::string_view trim(std::string_view str) {
+  auto is_space = [](char ch) {
+    return isspace(static_cast<unsigned char>(ch)) != 0;
+  };
+  while (!str.empty() && is_space(str.front()))
+    str.remove_prefix(1);
+  while (!str.empty() && is_space(str.back()))
+    str.remove_suffix(1);
+  return str;
+}
+
+#ifdef CAF_LINUX
+
+// Returns the smallest CPU ID that shares the last-level cache with `base`.
+// Without cache information, we treat all CPUs of a package as one complex and
+// return the smallest CPU ID of the package. Returns `fallback` if `sysfs`
+// provides neither.
+size_t read_core_complex(const std::string& base, size_t fallback) {
+  size_t max_level = 0;
+  std::string shared_cpus;
+  for (size_t index = 0; index < 10; ++index) {
+    auto dir = base + "/cache/index" + std::to_string(index);
+    size_t level = 0;
+    if (!parse_size(trim(read_first_line(dir + "/level")), level))
+      continue;
+    if (level > max_level) {
+      if (auto str = read_first_line(dir + "/shared_cpu_list"); !str.empty()) {
+        max_level = level;
+        shared_cpus = std::move(str);
+      }
+    }
+  }
+  if (auto ids = parse_cpu_list(shared_cpus); !ids.empty())
+    return *std::min_element(ids.begin(), ids.end());
+  // Note: `core_siblings_list` is the deprecated name of `package_cpus_list`.
+  for (auto name : {"/topology/package_cpus_list",
+                    "/topology/core_siblings_list"}) {
+    auto ids = parse_cpu_list(read_first_line(base + name));
+    if (!ids.empty())
+      return *std::min_element(ids.begin(), ids.end());
+  }
+  return fallback;
+}
+
+// Returns the NUMA node for the CPU at `base` by looking for a `node<N>` link.
+size_t read_numa_node(const std::string& base) {
+  size_t result = 0;
+  if (auto* dir = opendir(base.c_str())) {
+    while (auto* entry = readdir(dir)) {
+      std::string_view name{entry->d_name};
+      if (name.size() > 4 && name.compare(0, 4, "node") == 0
+          && parse_size(name.substr(4), result))
+        break;
+    }
+    closedir(dir);
+  }
+  return result;
+}
+
+#endif // CAF_LINUX
+
+} // namespace
+
+cpu_topology::cpu_topology(std::vector<cpu_info> cpus) : cpus_(std::move(cpus)) {
+  if (cpus_.empty())
+    cpus_.emplace_back();
+}
+
+cpu_topology cpu_topology::flat(size_t num_cpus) {
+  std::vector<cpu_info> cpus;
+  num_cpus = std::max(num_cpus, size_t{1});
+  cpus.reserve(num_cpus);
+  for (size_t id = 0; id < num_cpus; ++id)
+    cpus.emplace_back(cpu_info{id, 0, 0});
+  return cpu_topology{std::move(cpus)};
+}
+
+cpu_topology cpu_topology::read(std::string_view root) {
+#ifdef CAF_LINUX
+  std::string dir{root};
+  auto ids = parse_cpu_list(read_first_line(dir + "/online"));
+  if (!ids.empty()) {
+    std::vector<cpu_info> cpus;
+    cpus.reserve(ids.size());
+    for (auto id : ids) {
+      auto base = dir + "/cpu" + std::to_string(id);
+      cpus.emplace_back(
+        cpu_info{id, read_core_complex(base, 0), read_numa_node(base)});
+    }
+    return cpu_topology{std::move(cpus)};
+  }
+#else
+  CAF_IGNORE_UNUSED(root);
+#endif
+  return flat(std::thread::hardware_concurrency());
+}
+
+cpu_topology::distance
+cpu_topology::distance_between(const cpu_info& x, const cpu_info& y) noexcept {
+  if (x.numa_node != y.numa_node)
+    return distance::remote;
+  if (x.core_complex != y.core_complex)
+    return distance::same_node;
+  return distance::same_complex;
+}
+
+cpu_topology::victim_list cpu_topology::victims(size_t worker_id,
+                                                size_t num_workers) const {
+  victim_list result;
+  if (cpus_.empty())
+    return result;
+  auto& self = cpu_of(worker_id);
+  for (size_t other = 0; other < num_workers; ++other) {
+    if (other != worker_id) {
+      auto dist = distance_between(self, cpu_of(other));
+      result[static_cast<size_t>(dist)].push_back(other);
+    }
+  }
+  return result;
+}
+
+void cpu_topology::retain(const std::vector<size_t>& ids) {
+  if (ids.empty())
+    return;
+  auto not_allowed = [&ids](const cpu_info& cpu) {
+    return std::find(ids.begin(), ids.end(), cpu.id) == ids.end();
+  };
+  auto first = std::remove_if(cpus_.begin(), cpus_.end(), not_allowed);
+  if (first != cpus_.begin())
+    cpus_.erase(first, cpus_.end());
+}
+
+std::vector<size_t> cpu_topology::affinity() {
+  std::vector<size_t> result;
+#ifdef CAF_LINUX
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &cpus) == 0) {
+    for (size_t id = 0; id < CPU_SETSIZE; ++id)
+      if (CPU_ISSET(id, &cpus))
+        result.push_back(id);
+  }
+#endif
+  return result;
+}
+
+bool cpu_topology::pin_this_thread(size_t cpu_id) {
+#ifdef CAF_LINUX
+  if (cpu_id >= CPU_SETSIZE)
+    return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu_id, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) == 0;
+#else
+  CAF_IGNORE_UNUSED(cpu_id);
+  return false;
+#endif
+}
+
+std::vector<size_t> parse_cpu_list(std::string_view str) {
+  std::vector<size_t> result;
+  while (!str.empty()) {
+    auto sep = str.find(',');
+    auto item = trim(str.substr(0, sep));
+    str = sep == std::string_view::npos ? std::string_view{}
+                                        : str.substr(sep + 1);
+    size_t first = 0;
+    size_t last = 0;
+    if (auto dash = item.find('-'); dash != std::string_view::npos) {
+      if (!parse_size(trim(item.substr(0, dash)), first)
+          || !parse_size(trim(item.substr(dash + 1)), last) || last < first)
+        continue;
+    } else if (parse_size(item, first)) {
+      last = first;
+    } else {
+      continue;
+    }
+    for (auto id = first; id <= last; ++id)
+      result.push_back(id);
+  }
+  return result;
+}
+
+} // namespace caf::detail
@@ -0,0 +1,121 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace caf::detail {
+
+/// Describes the location of a logical CPU in the memory hierarchy.
+struct cpu_info {
+  /// The logical CPU number as used by the operating system.
+  size_t id = 0;
+
+  /// Identifies the group of CPUs that share a last-level cache (core complex).
+  size_t core_complex = 0;
+
+  /// Identifies the NUMA node of the CPU.
+  size_t numa_node = 0;
+};
+
+/// Describes the logical CPUs of the host and how they relate to each other.
+class CAF_CORE_EXPORT cpu_topology {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Classifies how far apart two CPUs are in the memory hierarchy.
+  enum class distance {
+    /// Both CPUs share the last-level cache.
+    same_complex,
+    /// Both CPUs are attached to the same NUMA node.
+    same_node,
+    /// Accessing memory of the other CPU crosses the interconnect.
+    remote,
+  };
+
+  /// Number of distinct values for `distance`.
+  static constexpr size_t num_distances = 3;
+
+  /// Stores worker IDs grouped by their distance to a worker.
+  using victim_list = std::array<std::vector<size_t>, num_distances>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Default root for reading the CPU topology on Linux.
+  static constexpr std::string_view default_sysfs_root
+    = "/sys/devices/system/cpu";
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  cpu_topology() = default;
+
+  explicit cpu_topology(std::vector<cpu_info> cpus);
+
+  // -- factory functions ------------------------------------------------------
+
+  /// Returns a topology with `num_cpus` CPUs that all share a core complex.
+  static cpu_topology flat(size_t num_cpus);
+
+  /// Reads the CPU topology of the host from the `sysfs` directory at `root`.
+  /// Falls back to a flat topology if the information is not available, e.g.,
+  /// on platforms other than Linux.
+  static cpu_topology read(std::string_view root = default_sysfs_root);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns all logical CPUs.
+  const std::vector<cpu_info>& cpus() const noexcept {
+    return cpus_;
+  }
+
+  /// Returns the number of logical CPUs.
+  size_t size() const noexcept {
+    return cpus_.size();
+  }
+
+  /// Returns the CPU assigned to the worker with ID `worker_id`. Workers map to
+  /// CPUs in round-robin order.
+  const cpu_info& cpu_of(size_t worker_id) const noexcept {
+    return cpus_[worker_id % cpus_.size()];
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Removes all CPUs that are not listed in `ids`. Keeps all CPUs if `ids` is
+  /// empty or if none of the CPUs is listed in `ids`.
+  void retain(const std::vector<size_t>& ids);
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Returns the distance between the CPUs `x` and `y`.
+  static distance distance_between(const cpu_info& x,
+                                   const cpu_info& y) noexcept;
+
+  /// Computes the steal order for the worker `worker_id`, i.e., lists all other
+  /// workers grouped by their distance to `worker_id`.
+  victim_list victims(size_t worker_id, size_t num_workers) const;
+
+  /// Returns the IDs of all logical CPUs the process may run on or an empty
+  /// list if the affinity mask is not available.
+  static std::vector<size_t> affinity();
+
+  /// Binds the calling thread to the logical CPU `cpu_id`.
+  /// @returns `true` on success, `false` otherwise (or if not supported).
+  static bool pin_this_thread(size_t cpu_id);
+
+private:
+  std::vector<cpu_info> cpus_;
+};
+
+/// Parses a CPU list such as "0-3,8,10-11" from `sysfs`.
+CAF_CORE_EXPORT std::vector<size_t> parse_cpu_list(std::string_view str);
+
+} // namespace caf::detail
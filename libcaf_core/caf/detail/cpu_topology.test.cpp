@@ -0,0 +1,159 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/config.hpp"
+
+#include <cstdlib>
+#include <fstream>
+
+#ifdef CAF_LINUX
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+using namespace caf;
+
+using detail::cpu_info;
+using detail::cpu_topology;
+using distance = cpu_topology::distance;
+
+using id_list = std::vector<size_t>;
+
+namespace {
+
+// Two NUMA nodes with two core complexes each, two CPUs per complex.
+cpu_topology dual_socket() {
+  std::vector<cpu_info> cpus;
+  for (size_t id = 0; id < 8; ++id)
+    cpus.emplace_back(cpu_info{id, id / 2, id / 4});
+  return cpu_topology{std::move(cpus)};
+}
+
+} // namespace
+
+TEST("parse_cpu_list parses CPU lists from sysfs") {
+  using detail::parse_cpu_list;
+  check_eq(parse_cpu_list(""), id_list{});
+  check_eq(parse_cpu_list("0"), id_list{0});
+  check_eq(parse_cpu_list("0-3\n"), id_list({0, 1, 2, 3}));
+  check_eq(parse_cpu_list("0-1,4,6-7"), id_list({0, 1, 4, 6, 7}));
+  check_eq(parse_cpu_list("3-1,x,5"), id_list{5});
+}
+
+TEST("cpu_topology computes the distance between CPUs") {
+  auto uut = dual_socket();
+  auto& cpus = uut.cpus();
+  check(cpu_topology::distance_between(cpus[0], cpus[1])
+        == distance::same_complex);
+  check(cpu_topology::distance_between(cpus[0], cpus[2])
+        == distance::same_node);
+  check(cpu_topology::distance_between(cpus[0], cpus[4]) == distance::remote);
+}
+
+TEST("cpu_topology groups victims by their distance") {
+  auto uut = dual_socket();
+  SECTION("one worker per CPU") {
+    auto victims = uut.victims(0, 8);
+    check_eq(victims[0], id_list{1});
+    check_eq(victims[1], id_list({2, 3}));
+    check_eq(victims[2], id_list({4, 5, 6, 7}));
+  }
+  SECTION("more workers than CPUs") {
+    auto victims = uut.victims(5, 10);
+    check_eq(victims[0], id_list({4}));
+    check_eq(victims[1], id_list({6, 7}));
+    check_eq(victims[2], id_list({0, 1, 2, 3, 8, 9}));
+  }
+  SECTION("flat topologies put all workers into the first group") {
+    auto victims = cpu_topology::flat(4).victims(1, 4);
+    check_eq(victims[0], id_list({0, 2, 3}));
+    check(victims[1].empty());
+    check(victims[2].empty());
+  }
+}
+
+TEST("cpu_topology retains only the CPUs in the affinity mask") {
+  auto ids_of = [](const cpu_topology& topo) {
+    id_list result;
+    for (auto& cpu : topo.cpus())
+      result.push_back(cpu.id);
+    return result;
+  };
+  auto uut = dual_socket();
+  SECTION("retain removes all CPUs that are not listed") {
+    uut.retain(id_list({1, 4, 5, 9}));
+    check_eq(ids_of(uut), id_list({1, 4, 5}));
+    check_eq(uut.cpu_of(1).numa_node, 1u);
+  }
+  SECTION("retain keeps all CPUs if the mask is empty or disjoint") {
+    uut.retain(id_list{});
+    check_eq(uut.size(), 8u);
+    uut.retain(id_list({10, 11}));
+    check_eq(uut.size(), 8u);
+  }
+}
+
+#ifdef CAF_LINUX
+
+namespace {
+
+void write_file(const std::string& path, const std::string& content) {
+  std::ofstream out{path};
+  out << content << '\n';
+}
+
+} // namespace
+
+TEST("cpu_topology reads the topology from sysfs") {
+  char tmpl[] = "/tmp/caf-cpu-topology-XXXXXX";
+  auto* root_ptr = mkdtemp(tmpl);
+  if (root_ptr == nullptr) {
+    info("unable to create a temporary directory, skip test");
+    return;
+  }
+  std::string root{root_ptr};
+  for (size_t id = 0; id < 4; ++id) {
+    auto base = root + "/cpu" + std::to_string(id);
+    mkdir(base.c_str(), 0700);
+    mkdir((base + "/node" + std::to_string(id / 2)).c_str(), 0700);
+    mkdir((base + "/cache").c_str(), 0700);
+    mkdir((base + "/cache/index0").c_str(), 0700);
+    write_file(base + "/cache/index0/level", "1");
+    write_file(base + "/cache/index0/shared_cpu_list", std::to_string(id));
+    mkdir((base + "/cache/index3").c_str(), 0700);
+    write_file(base + "/cache/index3/level", "3");
+    write_file(base + "/cache/index3/shared_cpu_list",
+               id < 2 ? "0-1" : "2-3");
+  }
+  // Without cache information, CAF groups CPUs by their package.
+  for (size_t id = 4; id < 6; ++id) {
+    auto base = root + "/cpu" + std::to_string(id);
+    mkdir(base.c_str(), 0700);
+    mkdir((base + "/topology").c_str(), 0700);
+    write_file(base + "/topology/physical_package_id", "1");
+    write_file(base + "/topology/package_cpus_list", "4-5");
+  }
+  write_file(root + "/online", "0-5");
+  auto uut = cpu_topology::read(root);
+  check_eq(uut.size(), 6u);
+  if (uut.size() == 6) {
+    auto& cpus = uut.cpus();
+    check_eq(cpus[1].core_complex, 0u);
+    check_eq(cpus[1].numa_node, 0u);
+    check_eq(cpus[3].core_complex, 2u);
+    check_eq(cpus[3].numa_node, 1u);
+    check_eq(cpus[5].core_complex, 4u);
+  }
+  auto rc = system(("rm -rf " + root).c_str());
+  CAF_IGNORE_UNUSED(rc);
+}
+
+#endif // CAF_LINUX
+
+CAF_TEST_MAIN()
@@ -0,0 +1,113 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/eventcount.hpp"
+
+#include <chrono>
+#include <climits>
+
+#ifdef CAF_LINUX
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <time.h>
+#  include <unistd.h>
+#endif
+
+namespace caf::detail {
+
+#ifdef CAF_LINUX
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+uint32_t* futex_addr(std::atomic<uint32_t>& x) {
+  return reinterpret_cast<uint32_t*>(&x);
+}
+
+void futex_wait(std::atomic<uint32_t>& x, uint32_t expected,
+                const timespec* rel_timeout) {
+  syscall(SYS_futex, futex_addr(x), FUTEX_WAIT_PRIVATE, expected, rel_timeout,
+          nullptr, 0);
+}
+
+void futex_wake(std::atomic<uint32_t>& x, int num) {
+  syscall(SYS_futex, futex_addr(x), FUTEX_WAKE_PRIVATE, num, nullptr, nullptr,
+          0);
+}
+
+} // namespace
+
+void eventcount::wait(key_type key) {
+  while (epoch_.load(std::memory_order_acquire) == key)
+    futex_wait(epoch_, key, nullptr);
+  waiters_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+bool eventcount::wait_for(key_type key, timespan rel_timeout) {
+  using clock_type = std::chrono::steady_clock;
+  auto deadline = clock_type::now() + rel_timeout;
+  auto result = true;
+  while (epoch_.load(std::memory_order_acquire) == key) {
+    auto remaining = std::chrono::duration_cast<timespan>(deadline
+                                                          - clock_type::now());
+    if (remaining.count() <= 0) {
+      result = false;
+      break;
+    }
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(remaining.count() / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(remaining.count() % 1'000'000'000);
+    futex_wait(epoch_, key, &ts);
+  }
+  waiters_.fetch_sub(1, std::memory_order_seq_cst);
+  return result;
+}
+
+void eventcount::do_notify(bool all) noexcept {
+  epoch_.fetch_add(1, std::memory_order_seq_cst);
+  futex_wake(epoch_, all ? INT_MAX : 1);
+}
+
+#else // CAF_LINUX
+
+void eventcount::wait(key_type key) {
+  {
+    std::unique_lock guard{mtx_};
+    while (epoch_.load(std::memory_order_acquire) == key)
+      cv_.wait(guard);
+  }
+  waiters_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+bool eventcount::wait_for(key_type key, timespan rel_timeout) {
+  auto deadline = std::chrono::steady_clock::now() + rel_timeout;
+  auto result = true;
+  {
+    std::unique_lock guard{mtx_};
+    while (epoch_.load(std::memory_order_acquire) == key) {
+      if (cv_.wait_until(guard, deadline) == std::cv_status::timeout) {
+        result = epoch_.load(std::memory_order_acquire) != key;
+        break;
+      }
+    }
+  }
+  waiters_.fetch_sub(1, std::memory_order_seq_cst);
+  return result;
+}
+
+void eventcount::do_notify(bool all) noexcept {
+  {
+    std::unique_lock guard{mtx_};
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+  }
+  if (all)
+    cv_.notify_all();
+  else
+    cv_.notify_one();
+}
+
+#endif // CAF_LINUX
+
+} // namespace caf::detail
@@ -0,0 +1,119 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/timespan.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef CAF_LINUX
+#  include <condition_variable>
+#  include <mutex>
+#endif
+
+namespace caf::detail {
+
+/// A synchronization primitive for parking threads until some condition
+/// becomes true without adding any overhead to the notifying side while no
+/// thread waits. Uses a futex on Linux and a condition variable otherwise.
+///
+/// Waiting follows a two-phase protocol:
+///
+/// ~~~
+/// auto key = ec.prepare_wait();
+/// if (condition_satisfied()) {
+///   ec.cancel_wait();
+/// } else {
+///   ec.wait(key);
+/// }
+/// ~~~
+///
+/// Notifiers must first make the condition true (e.g., push to a queue) and
+/// then call `notify_one` or `notify_all`. Announcing the intent to wait
+/// before checking the condition one last time guarantees that no
+/// notification gets lost.
+class CAF_CORE_EXPORT eventcount {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using key_type = uint32_t;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  eventcount() = default;
+
+  eventcount(const eventcount&) = delete;
+
+  eventcount& operator=(const eventcount&) = delete;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of threads that have announced their intent to wait.
+  size_t num_waiters() const noexcept {
+    return waiters_.load(std::memory_order_relaxed);
+  }
+
+  // -- waiting ----------------------------------------------------------------
+
+  /// Announces the intent to wait. Callers must either call `cancel_wait` or
+  /// `wait` afterwards.
+  key_type prepare_wait() noexcept {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_seq_cst);
+  }
+
+  /// Revokes a previous call to `prepare_wait`.
+  void cancel_wait() noexcept {
+    waiters_.fetch_sub(1, std::memory_order_seq_cst);
+  }
+
+  /// Blocks until a notification arrives after the call to `prepare_wait`
+  /// that returned `key`.
+  void wait(key_type key);
+
+  /// Blocks until a notification arrives after the call to `prepare_wait`
+  /// that returned `key` or until `rel_timeout` expires.
+  /// @returns `false` if the timeout expired, `true` otherwise.
+  bool wait_for(key_type key, timespan rel_timeout);
+
+  // -- notification -----------------------------------------------------------
+
+  /// Wakes up one waiting thread, if any.
+  void notify_one() noexcept {
+    if (has_waiters())
+      do_notify(false);
+  }
+
+  /// Wakes up all waiting threads.
+  void notify_all() noexcept {
+    if (has_waiters())
+      do_notify(true);
+  }
+
+private:
+  bool has_waiters() noexcept {
+    // Pairs with the read-modify-write in `prepare_wait`: either the waiter
+    // sees the new state or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return waiters_.load(std::memory_order_relaxed) != 0;
+  }
+
+  void do_notify(bool all) noexcept;
+
+  std::atomic<uint32_t> epoch_{0};
+
+  std::atomic<uint32_t> waiters_{0};
+
+#ifndef CAF_LINUX
+  std::mutex mtx_;
+
+  std::condition_variable cv_;
+#endif
+};
+
+} // namespace caf::detail
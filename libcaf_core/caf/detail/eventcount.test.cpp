@@ -0,0 +1,78 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/eventcount.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+TEST("eventcount::notify_one is a no-op without waiters") {
+  detail::eventcount uut;
+  check_eq(uut.num_waiters(), 0u);
+  uut.notify_one();
+  uut.notify_all();
+  SECTION("cancel_wait revokes the intent to wait") {
+    uut.prepare_wait();
+    check_eq(uut.num_waiters(), 1u);
+    uut.cancel_wait();
+    check_eq(uut.num_waiters(), 0u);
+  }
+  SECTION("waiting returns immediately after a notification") {
+    auto key = uut.prepare_wait();
+    uut.notify_one();
+    check(uut.wait_for(key, 1h));
+    check_eq(uut.num_waiters(), 0u);
+  }
+}
+
+TEST("eventcount::wait_for returns false after a timeout") {
+  detail::eventcount uut;
+  auto key = uut.prepare_wait();
+  check(!uut.wait_for(key, 1ms));
+  check_eq(uut.num_waiters(), 0u);
+}
+
+TEST("eventcount wakes up parked threads") {
+  // Each consumer waits for the shared counter to reach its target value and
+  // the producer increments the counter step by step.
+  constexpr int num_consumers = 4;
+  constexpr int num_rounds = 1000;
+  detail::eventcount uut;
+  std::atomic<int> counter{0};
+  std::atomic<int> done{0};
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < num_consumers; ++i)
+    consumers.emplace_back([&] {
+      for (int target = 1; target <= num_rounds; ++target) {
+        for (;;) {
+          if (counter.load() >= target)
+            break;
+          auto key = uut.prepare_wait();
+          if (counter.load() >= target) {
+            uut.cancel_wait();
+            break;
+          }
+          uut.wait(key);
+        }
+      }
+      ++done;
+    });
+  for (int i = 0; i < num_rounds; ++i) {
+    ++counter;
+    uut.notify_all();
+  }
+  for (auto& consumer : consumers)
+    consumer.join();
+  check_eq(done.load(), num_consumers);
+  check_eq(uut.num_waiters(), 0u);
+}
+
+CAF_TEST_MAIN()
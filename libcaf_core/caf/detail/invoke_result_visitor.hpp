@@ -40,9 +40,10 @@ public:
   // -- extraction and conversions ---------------------------------------------
 
   /// Wraps arbitrary values into a `message` and calls the visitor recursively.
+  /// The message reserves memory for the mailbox element of the response.
   template <class... Ts>
   void operator()(Ts&... xs) {
-    auto tmp = make_message(std::move(xs)...);
+    auto tmp = make_message_impl<true>(std::move(xs)...);
     (*this)(tmp);
   }
 
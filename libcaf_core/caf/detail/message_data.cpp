@@ -18,7 +18,10 @@
 namespace caf::detail {
 
 message_data::message_data(type_id_list types) noexcept
-  : rc_(1), types_(std::move(types)), constructed_elements_(0) {
+  : rc_(1),
+    types_(std::move(types)),
+    constructed_elements_(0),
+    host_slot_(no_host_slot) {
   // nop
 }
 
@@ -45,11 +48,10 @@ message_data* message_data::copy() const {
   size_t storage_size = 0;
   for (auto id : types_)
     storage_size += gmos[id].padded_size;
-  auto total_size = sizeof(message_data) + storage_size;
-  auto vptr = malloc(total_size);
-  if (vptr == nullptr)
+  auto raw_ptr = try_make(types_, storage_size);
+  if (raw_ptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
-  intrusive_ptr<message_data> ptr{new (vptr) message_data(types_), false};
+  intrusive_ptr<message_data> ptr{raw_ptr, false};
   auto src = storage();
   auto dst = ptr->storage();
   for (auto id : types_) {
@@ -68,11 +70,43 @@ message_data::make_uninitialized(type_id_list types) {
   size_t storage_size = 0;
   for (auto id : types)
     storage_size += gmos[id].padded_size;
-  auto total_size = sizeof(message_data) + storage_size;
-  auto vptr = malloc(total_size);
-  if (vptr == nullptr)
+  auto raw_ptr = try_make(types, storage_size);
+  if (raw_ptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
-  return {new (vptr) message_data(types), false};
+  return {raw_ptr, false};
+}
+
+message_data* message_data::try_make(type_id_list types, size_t storage_size,
+                                     bool with_host_slot) noexcept {
+  auto data_size = sizeof(message_data) + storage_size;
+  if constexpr (max_inline_storage_size > 0) {
+    if (with_host_slot && storage_size <= max_inline_storage_size) {
+      auto vptr = slab_allocator::allocate_shareable(host_slot_size
+                                                     + data_size);
+      if (vptr == nullptr)
+        return nullptr;
+      auto pos = static_cast<std::byte*>(vptr) + host_slot_size;
+      auto result = new (pos) message_data(types);
+      result->host_slot_.store(vacant_host_slot, std::memory_order_relaxed);
+      return result;
+    }
+  }
+  auto vptr = slab_allocator::allocate(data_size);
+  if (vptr == nullptr)
+    return nullptr;
+  return new (vptr) message_data(types);
+}
+
+void* message_data::claim_host_slot() const noexcept {
+  auto expected = vacant_host_slot;
+  if (host_slot_.load(std::memory_order_relaxed) != vacant_host_slot
+      || !host_slot_.compare_exchange_strong(expected, claimed_host_slot,
+                                             std::memory_order_relaxed))
+    return nullptr;
+  auto block = reinterpret_cast<std::byte*>(const_cast<message_data*>(this))
+               - host_slot_size;
+  slab_allocator::add_owner(block);
+  return block;
 }
 
 std::byte* message_data::at(size_t index) noexcept {
@@ -8,6 +8,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/implicit_conversions.hpp"
 #include "caf/detail/padded_size.hpp"
+#include "caf/detail/slab_allocator.hpp"
 #include "caf/fwd.hpp"
 #include "caf/type_id_list.hpp"
 
@@ -30,8 +31,23 @@
 namespace caf::detail {
 
 /// Container for storing an arbitrary number of message elements.
+///
+/// When creating a small message for enqueueing it right away, the container
+/// reserves memory for a single @ref mailbox_element in front of itself. This
+/// allows CAF to put a message into a mailbox with a single allocation.
 class CAF_CORE_EXPORT message_data {
 public:
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum size of the storage for which message data objects reserve
+  /// memory for a mailbox element.
+  static constexpr size_t max_inline_storage_size
+    = CAF_MESSAGE_INLINE_STORAGE_SIZE;
+
+  /// Size of the memory region for a mailbox element in front of small
+  /// message data objects.
+  static constexpr size_t host_slot_size = 80;
+
   // -- constructors, destructors, and assignment operators --------------------
 
   message_data() = delete;
@@ -49,6 +65,16 @@ public:
 
   static intrusive_ptr<message_data> make_uninitialized(type_id_list types);
 
+  /// Allocates memory for a message data object with `storage_size` bytes for
+  /// storing the elements and constructs the object *without* constructing
+  /// any element. If `with_host_slot` is `true` and `storage_size` does not
+  /// exceed `max_inline_storage_size`, also reserves memory for a mailbox
+  /// element in front of the object.
+  /// @returns a pointer to the new object or `nullptr` if memory allocation
+  ///          failed.
+  static message_data* try_make(type_id_list types, size_t storage_size,
+                                bool with_host_slot = false) noexcept;
+
   // -- reference counting -----------------------------------------------------
 
   /// Increases reference count by one.
@@ -60,8 +86,11 @@ public:
   /// reference count drops to zero.
   void deref() noexcept {
     if (unique() || rc_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      auto block = reinterpret_cast<std::byte*>(this);
+      if (host_slot_.load(std::memory_order_relaxed) != no_host_slot)
+        block -= host_slot_size;
       this->~message_data();
-      free(const_cast<message_data*>(this));
+      slab_allocator::deallocate(block);
     }
   }
 
@@ -108,6 +137,14 @@ public:
     ++constructed_elements_;
   }
 
+  /// Tries to claim the memory in front of this object for storing a mailbox
+  /// element. Succeeds at most once per object. On success, the mailbox
+  /// element shares the memory block of this object and must release it by
+  /// calling `slab_allocator::deallocate` on the returned pointer.
+  /// @returns a pointer to `host_slot_size` bytes of memory on success,
+  ///          `nullptr` otherwise.
+  void* claim_host_slot() const noexcept;
+
   template <class... Ts>
   void init(Ts&&... xs) {
     init_impl(storage(), std::forward<Ts>(xs)...);
@@ -181,9 +218,16 @@ private:
                    std::forward<Ts>(xs)...);
   }
 
+  static constexpr uint32_t no_host_slot = 0;
+
+  static constexpr uint32_t vacant_host_slot = 1;
+
+  static constexpr uint32_t claimed_host_slot = 2;
+
   mutable std::atomic<size_t> rc_;
   type_id_list types_;
-  size_t constructed_elements_;
+  uint32_t constructed_elements_;
+  mutable std::atomic<uint32_t> host_slot_;
   std::byte storage_[];
 };
 
@@ -4,6 +4,9 @@
 
 #include "caf/detail/rfc3629.hpp"
 
+#include <cstdint>
+#include <cstring>
+
 namespace {
 
 // Convenient literal for std::byte.
@@ -32,6 +35,20 @@ constexpr std::byte head(std::byte value) noexcept {
   }
 }
 
+// Skips over all ASCII characters in [first, last), processing eight bytes at
+// a time.
+const std::byte* skip_ascii(const std::byte* first, const std::byte* last) {
+  constexpr uint64_t high_bits = 0x8080'8080'8080'8080;
+  while (last - first >= 8) {
+    uint64_t block;
+    memcpy(&block, first, 8);
+    if ((block & high_bits) != 0)
+      break;
+    first += 8;
+  }
+  return first;
+}
+
 // Checks whether `value` is an UTF-8 continuation byte.
 constexpr bool is_continuation_byte(std::byte value) noexcept {
   return head<2>(value) == 0b1000'0000_b;
@@ -45,6 +62,9 @@ constexpr bool is_continuation_byte(std::byte value) noexcept {
 std::pair<const std::byte*, bool> validate_rfc3629(const std::byte* first,
                                                    const std::byte* last) {
   while (first != last) {
+    first = skip_ascii(first, last);
+    if (first == last)
+      break;
     auto checkpoint = first;
     auto x = *first++;
     // First bit is zero: ASCII character.
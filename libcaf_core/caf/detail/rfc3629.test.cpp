@@ -220,4 +220,18 @@ TEST("rfc3629::validate stops at the first invalid byte") {
   }
 }
 
+TEST("rfc3629::validate checks every byte of long ASCII inputs") {
+  // Exercises the fast path that skips over eight ASCII characters at once.
+  auto str = std::string(37, 'a');
+  check_eq(rfc3629::validate(str), res_t{37, false});
+  for (size_t pos = 0; pos < str.size(); ++pos) {
+    auto copy = str;
+    copy[pos] = '\xff';
+    check_eq(rfc3629::validate(copy), res_t{pos, false});
+    copy[pos] = '\xc8';
+    auto incomplete = pos + 1 == str.size();
+    check_eq(rfc3629::validate(copy), res_t{pos, incomplete});
+  }
+}
+
 CAF_TEST_MAIN()
@@ -0,0 +1,280 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/slab_allocator.hpp"
+
+#include "caf/config.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+namespace caf::detail {
+
+namespace {
+
+class slab_cache;
+
+/// Bookkeeping data in front of each allocated block.
+struct block_header {
+  /// Points to the owning cache or is `nullptr` for blocks from `operator new`.
+  slab_cache* owner;
+
+  /// Stores the index of the size class.
+  uint32_t size_class;
+
+  /// Stores the number of objects that share this block.
+  std::atomic<uint32_t> owners;
+};
+
+static_assert(sizeof(block_header) <= slab_allocator::header_size);
+
+static_assert(alignof(block_header) <= slab_allocator::min_alignment);
+
+static_assert(slab_allocator::header_size % (2 * slab_allocator::min_alignment)
+              == 0);
+
+static_assert(slab_allocator::size_class_step
+                % (2 * slab_allocator::min_alignment)
+              == 0);
+
+/// Overlays a block while it sits in a free list.
+struct free_block {
+  free_block* next;
+};
+
+/// Size of the memory regions that a cache carves into blocks.
+constexpr size_t chunk_size = 16 * 1024;
+
+/// Blocks with a header start at an odd multiple of `min_alignment`. Hence,
+/// memory from `operator new` that has no header must start at an even
+/// multiple, i.e., the default alignment must be larger than `min_alignment`.
+/// Otherwise, we store the header for all blocks.
+constexpr bool plain_blocks_have_header
+  = __STDCPP_DEFAULT_NEW_ALIGNMENT__ < 2 * slab_allocator::min_alignment;
+
+/// Number of padding bytes in front of the header of blocks that we allocate
+/// via `operator new`.
+constexpr size_t header_padding = slab_allocator::min_alignment;
+
+/// The thread-local slab cache. Only the owning thread allocates from a cache,
+/// but any thread may deallocate blocks.
+class slab_cache {
+public:
+  slab_cache() noexcept {
+    for (auto& ptr : local_)
+      ptr = nullptr;
+    for (auto& ptr : remote_)
+      ptr = nullptr;
+  }
+
+  ~slab_cache() {
+    while (chunks_ != nullptr) {
+      auto next = chunks_->next;
+      ::operator delete(chunks_);
+      chunks_ = next;
+    }
+  }
+
+  void* allocate(uint32_t size_class) noexcept {
+    auto& head = local_[size_class];
+    if (head == nullptr) {
+      // Reclaim all blocks that other threads have released in the meantime
+      // before allocating a new chunk.
+      head = remote_[size_class].exchange(nullptr, std::memory_order_acquire);
+      if (head == nullptr && !refill(size_class))
+        return nullptr;
+    }
+    auto blk = head;
+    head = blk->next;
+    ++outstanding_;
+    auto hdr = new (blk) block_header;
+    hdr->owner = this;
+    hdr->size_class = size_class;
+    hdr->owners.store(1, std::memory_order_relaxed);
+    return reinterpret_cast<std::byte*>(blk) + slab_allocator::header_size;
+  }
+
+  void deallocate_local(free_block* blk, uint32_t size_class) noexcept {
+    blk->next = local_[size_class];
+    local_[size_class] = blk;
+    --outstanding_;
+  }
+
+  /// Pushes `blk` to the remote free list.
+  /// @returns `true` if the caller must destroy the cache.
+  [[nodiscard]] bool deallocate_remote(free_block* blk,
+                                       uint32_t size_class) noexcept {
+    auto& head = remote_[size_class];
+    auto top = head.load(std::memory_order_relaxed);
+    do {
+      blk->next = top;
+    } while (!head.compare_exchange_weak(top, blk, std::memory_order_release,
+                                         std::memory_order_relaxed));
+    // While the owner is alive, the counter is non-negative. After
+    // `abandon`, the counter holds the negated number of pending blocks.
+    return remote_frees_.fetch_add(1, std::memory_order_acq_rel) == -1;
+  }
+
+  /// Releases ownership of the cache.
+  /// @returns `true` if the caller must destroy the cache.
+  [[nodiscard]] bool abandon() noexcept {
+    auto prev = remote_frees_.fetch_sub(outstanding_,
+                                        std::memory_order_acq_rel);
+    return prev == outstanding_;
+  }
+
+private:
+  bool refill(uint32_t size_class) noexcept {
+    auto vptr = ::operator new(chunk_size, std::nothrow);
+    if (vptr == nullptr)
+      return false;
+    // The padding in front of the first block links all chunks of the cache.
+    auto chunk = static_cast<free_block*>(vptr);
+    chunk->next = chunks_;
+    chunks_ = chunk;
+    auto block_size = (size_class + 1) * slab_allocator::size_class_step;
+    auto pos = static_cast<std::byte*>(vptr) + header_padding;
+    auto end = static_cast<std::byte*>(vptr) + chunk_size;
+    free_block* head = nullptr;
+    // Push in reverse order to hand out blocks at ascending addresses.
+    auto num_blocks = static_cast<size_t>(end - pos) / block_size;
+    for (auto i = num_blocks; i > 0; --i) {
+      auto blk = reinterpret_cast<free_block*>(pos + (i - 1) * block_size);
+      blk->next = head;
+      head = blk;
+    }
+    local_[size_class] = head;
+    return true;
+  }
+
+  // -- member variables for the owning thread ---------------------------------
+
+  /// Free lists for the owning thread.
+  std::array<free_block*, slab_allocator::num_size_classes> local_;
+
+  /// Number of blocks allocated by the owner minus the number of blocks
+  /// deallocated by the owner.
+  ptrdiff_t outstanding_ = 0;
+
+  /// Intrusive list of all chunks of this cache.
+  free_block* chunks_ = nullptr;
+
+  // -- member variables for other threads -------------------------------------
+
+  /// Free lists for blocks that other threads have deallocated.
+  alignas(CAF_CACHE_LINE_SIZE)
+    std::array<std::atomic<free_block*>, slab_allocator::num_size_classes>
+      remote_;
+
+  /// Number of blocks that other threads have deallocated.
+  std::atomic<ptrdiff_t> remote_frees_{0};
+};
+
+thread_local slab_cache* this_thread_cache;
+
+block_header* header_of(void* ptr) noexcept {
+  return reinterpret_cast<block_header*>(static_cast<std::byte*>(ptr)
+                                         - slab_allocator::header_size);
+}
+
+bool has_header(void* ptr) noexcept {
+  if constexpr (plain_blocks_have_header) {
+    return true;
+  } else {
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    return (addr & slab_allocator::min_alignment) != 0;
+  }
+}
+
+/// Allocates a block with a header via `operator new`.
+void* allocate_with_header(size_t size) noexcept {
+  auto total_size = header_padding + slab_allocator::header_size + size;
+  auto vptr = ::operator new(total_size, std::nothrow);
+  if (vptr == nullptr)
+    return nullptr;
+  auto hdr = new (static_cast<std::byte*>(vptr) + header_padding) block_header;
+  hdr->owner = nullptr;
+  hdr->size_class = 0;
+  hdr->owners.store(1, std::memory_order_relaxed);
+  return reinterpret_cast<std::byte*>(hdr) + slab_allocator::header_size;
+}
+
+/// Returns a block from the slab cache of the calling thread or `nullptr` if
+/// the thread has no cache or if the block would exceed `max_block_size`.
+void* allocate_from_cache(size_t size) noexcept {
+  auto total_size = size + slab_allocator::header_size;
+  if (auto cache = this_thread_cache;
+      cache != nullptr && total_size <= slab_allocator::max_block_size)
+    return cache->allocate(static_cast<uint32_t>(
+      (total_size - 1) / slab_allocator::size_class_step));
+  return nullptr;
+}
+
+} // namespace
+
+void* slab_allocator::allocate(size_t size) noexcept {
+  if (auto ptr = allocate_from_cache(size))
+    return ptr;
+  if constexpr (plain_blocks_have_header)
+    return allocate_with_header(size);
+  else
+    return ::operator new(size, std::nothrow);
+}
+
+void* slab_allocator::allocate_shareable(size_t size) noexcept {
+  if (auto ptr = allocate_from_cache(size))
+    return ptr;
+  return allocate_with_header(size);
+}
+
+void slab_allocator::deallocate(void* ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  if (!has_header(ptr)) {
+    ::operator delete(ptr);
+    return;
+  }
+  auto hdr = header_of(ptr);
+  // Blocks with a single owner are by far the most common case. Hence, we
+  // avoid the read-modify-write operation unless the block is shared.
+  if (hdr->owners.load(std::memory_order_acquire) != 1
+      && hdr->owners.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    return;
+  auto owner = hdr->owner;
+  if (owner == nullptr) {
+    ::operator delete(reinterpret_cast<std::byte*>(hdr) - header_padding);
+    return;
+  }
+  auto size_class = hdr->size_class;
+  auto blk = reinterpret_cast<free_block*>(hdr);
+  if (owner == this_thread_cache)
+    owner->deallocate_local(blk, size_class);
+  else if (owner->deallocate_remote(blk, size_class))
+    delete owner;
+}
+
+void slab_allocator::add_owner(void* ptr) noexcept {
+  header_of(ptr)->owners.fetch_add(1, std::memory_order_relaxed);
+}
+
+void slab_allocator::attach_thread() {
+  if (this_thread_cache == nullptr)
+    this_thread_cache = new slab_cache;
+}
+
+void slab_allocator::detach_thread() noexcept {
+  if (auto cache = this_thread_cache) {
+    this_thread_cache = nullptr;
+    if (cache->abandon())
+      delete cache;
+  }
+}
+
+bool slab_allocator::attached() noexcept {
+  return this_thread_cache != nullptr;
+}
+
+} // namespace caf::detail
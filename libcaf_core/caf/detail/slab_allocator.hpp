@@ -0,0 +1,89 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <cstddef>
+
+namespace caf::detail {
+
+/// Allocator for small, short-lived objects such as mailbox elements and
+/// message payloads. Threads that call `attach_thread` receive a private slab
+/// cache with one free list per size class. Allocating and deallocating on the
+/// owning thread requires no synchronization. Blocks deallocated by any other
+/// thread go to a lock-free remote free list of the owning cache, which the
+/// owner reclaims once its local free list runs dry.
+///
+/// Allocations on threads without a slab cache as well as allocations that
+/// exceed `max_block_size` fall back to the global `operator new` without
+/// storing any bookkeeping data. Hence, memory returned by `allocate` must
+/// always be released via `deallocate`.
+///
+/// A slab cache keeps the memory for all of its size classes until its owner
+/// calls `detach_thread` *and* all blocks of the cache have been deallocated.
+///
+/// Multiple objects may share a single block by calling `add_owner`, if the
+/// block came from `allocate_shareable`. In this case, the allocator releases
+/// the block after each owner called `deallocate`.
+///
+/// Blocks with bookkeeping data start at an odd multiple of `min_alignment`,
+/// whereas the global `operator new` returns addresses at even multiples. This
+/// allows `deallocate` to tell them apart without a header for all blocks.
+class CAF_CORE_EXPORT slab_allocator {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Number of bytes in front of each block for storing bookkeeping data.
+  static constexpr size_t header_size = 16;
+
+  /// Minimum alignment of all blocks.
+  static constexpr size_t min_alignment = 8;
+
+  /// Difference in bytes between two adjacent size classes.
+  static constexpr size_t size_class_step = 32;
+
+  /// Number of size classes per slab cache.
+  static constexpr size_t num_size_classes = 8;
+
+  /// Maximum size of a block in the slab cache, including the header.
+  static constexpr size_t max_block_size = size_class_step * num_size_classes;
+
+  // -- memory management ------------------------------------------------------
+
+  /// Allocates `size` bytes, aligned to `min_alignment`.
+  /// @returns a pointer to the allocated memory or `nullptr` on error.
+  static void* allocate(size_t size) noexcept;
+
+  /// Allocates `size` bytes like `allocate`, but always stores bookkeeping
+  /// data for the block in order to enable `add_owner`.
+  /// @returns a pointer to the allocated memory or `nullptr` on error.
+  static void* allocate_shareable(size_t size) noexcept;
+
+  /// Releases memory previously returned by `allocate`. Safe to call from any
+  /// thread.
+  static void deallocate(void* ptr) noexcept;
+
+  /// Adds an owner to the block at `ptr`.
+  /// @pre The block came from `allocate_shareable` and the caller holds a
+  ///      reference to an object that owns the block.
+  static void add_owner(void* ptr) noexcept;
+
+  // -- thread management ------------------------------------------------------
+
+  /// Creates a slab cache for the calling thread. No-op if the thread already
+  /// has a slab cache.
+  static void attach_thread();
+
+  /// Releases the slab cache of the calling thread. The cache releases its
+  /// memory as soon as all of its blocks have been deallocated. No-op if the
+  /// thread has no slab cache.
+  static void detach_thread() noexcept;
+
+  /// Queries whether the calling thread has a slab cache.
+  static bool attached() noexcept;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,128 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/slab_allocator.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::slab_allocator;
+
+TEST("threads without slab cache fall back to operator new") {
+  check(!slab_allocator::attached());
+  auto ptr = slab_allocator::allocate(32);
+  check(ptr != nullptr);
+  memset(ptr, 0xFF, 32);
+  slab_allocator::deallocate(ptr);
+  slab_allocator::deallocate(nullptr);
+}
+
+TEST("shareable blocks stay alive until their last owner releases them") {
+  auto run = [this] {
+    auto ptr = slab_allocator::allocate_shareable(40);
+    check(ptr != nullptr);
+    check_eq(reinterpret_cast<uintptr_t>(ptr) % slab_allocator::min_alignment,
+             0u);
+    slab_allocator::add_owner(ptr);
+    slab_allocator::deallocate(ptr);
+    memset(ptr, 0xFF, 40);
+    slab_allocator::deallocate(ptr);
+  };
+  SECTION("without slab cache") {
+    run();
+  }
+  SECTION("with slab cache") {
+    slab_allocator::attach_thread();
+    run();
+    slab_allocator::detach_thread();
+  }
+}
+
+TEST("the owning thread recycles blocks without synchronization") {
+  slab_allocator::attach_thread();
+  check(slab_allocator::attached());
+  SECTION("the slab cache hands out distinct blocks") {
+    std::set<void*> blocks;
+    for (size_t i = 0; i < 1000; ++i) {
+      auto ptr = slab_allocator::allocate(40);
+      memset(ptr, 0xFF, 40);
+      blocks.insert(ptr);
+    }
+    check_eq(blocks.size(), 1000u);
+    for (auto ptr : blocks)
+      slab_allocator::deallocate(ptr);
+  }
+  SECTION("deallocated blocks are reused in LIFO order") {
+    auto ptr1 = slab_allocator::allocate(40);
+    slab_allocator::deallocate(ptr1);
+    auto ptr2 = slab_allocator::allocate(40);
+    check(ptr1 == ptr2);
+    slab_allocator::deallocate(ptr2);
+  }
+  SECTION("blocks are aligned to min_alignment") {
+    for (size_t size = 0; size < 2 * slab_allocator::max_block_size; ++size) {
+      auto ptr = slab_allocator::allocate(size);
+      auto addr = reinterpret_cast<uintptr_t>(ptr);
+      check_eq(addr % slab_allocator::min_alignment, 0u);
+      slab_allocator::deallocate(ptr);
+    }
+  }
+  slab_allocator::detach_thread();
+  check(!slab_allocator::attached());
+}
+
+TEST("other threads return blocks to the remote free list of the owner") {
+  // Allocate blocks on one thread, release them on another thread and then
+  // allocate again until the owner reclaims the remote blocks.
+  constexpr size_t num_blocks = 1000;
+  slab_allocator::attach_thread();
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < num_blocks; ++i)
+    blocks.push_back(slab_allocator::allocate(40));
+  std::thread releaser{[&blocks] {
+    for (auto ptr : blocks)
+      slab_allocator::deallocate(ptr);
+  }};
+  releaser.join();
+  std::set<void*> released{blocks.begin(), blocks.end()};
+  blocks.clear();
+  auto reused = size_t{0};
+  for (size_t i = 0; i < 4 * num_blocks; ++i) {
+    auto ptr = slab_allocator::allocate(40);
+    if (released.count(ptr) != 0)
+      ++reused;
+    blocks.push_back(ptr);
+  }
+  check_eq(reused, num_blocks);
+  for (auto ptr : blocks)
+    slab_allocator::deallocate(ptr);
+  slab_allocator::detach_thread();
+}
+
+TEST("blocks may outlive the thread that allocated them") {
+  std::vector<void*> blocks;
+  std::thread owner{[&blocks] {
+    slab_allocator::attach_thread();
+    for (size_t i = 0; i < 100; ++i) {
+      auto ptr = slab_allocator::allocate(i);
+      memset(ptr, 0xFF, i);
+      blocks.push_back(ptr);
+    }
+    slab_allocator::detach_thread();
+  }};
+  owner.join();
+  for (auto ptr : blocks)
+    slab_allocator::deallocate(ptr);
+  check_eq(blocks.size(), 100u);
+}
+
+CAF_TEST_MAIN()
@@ -13,8 +13,8 @@
 
 namespace caf::detail {
 
-thread_safe_actor_clock::thread_safe_actor_clock() {
-  tbl_.reserve(buffer_size * 2);
+thread_safe_actor_clock::thread_safe_actor_clock() : tbl_(clock_type::now()) {
+  // nop
 }
 
 disposable thread_safe_actor_clock::schedule(time_point abs_time, action f) {
@@ -24,31 +24,27 @@ disposable thread_safe_actor_clock::schedule(time_point abs_time, action f) {
 
 void thread_safe_actor_clock::run() {
   CAF_LOG_TRACE("");
-  auto is_disposed = [](auto& x) { return !x || x->f.disposed(); };
-  auto by_timeout = [](auto& x, auto& y) { return x->t < y->t; };
+  std::vector<schedule_entry_ptr> buf;
+  buf.reserve(buffer_size);
+  std::vector<schedule_entry_ptr> expired;
   while (running_) {
     // Fetch additional scheduling requests from the queue.
-    if (tbl_.empty()) {
+    auto has_input = true;
+    if (tbl_.empty())
       queue_.wait_nonempty();
-      queue_.get_all(std::back_inserter(tbl_));
-      std::sort(tbl_.begin(), tbl_.end(), by_timeout);
-    } else {
-      auto next_timeout = (*tbl_.begin())->t;
-      if (queue_.wait_nonempty(next_timeout)) {
-        queue_.get_all(std::back_inserter(tbl_));
-        std::sort(tbl_.begin(), tbl_.end(), by_timeout);
-      }
+    else
+      has_input = queue_.wait_nonempty(tbl_.next_timeout());
+    if (has_input) {
+      queue_.get_all(std::back_inserter(buf));
+      for (auto& entry : buf)
+        tbl_.insert(std::move(entry));
+      buf.clear();
     }
     // Run all actions that timed out.
-    auto n = now();
-    auto i = tbl_.begin();
-    for (; i != tbl_.end() && (*i)->t <= n; ++i)
-      (*i)->f.run();
-    // Here, we have [begin, i) be the actions that were executed. Move any
-    // already disposed action also to the beginning so that we can erase them
-    // at once.
-    i = std::stable_partition(i, tbl_.end(), is_disposed);
-    tbl_.erase(tbl_.begin(), i);
+    tbl_.advance(now(), expired);
+    for (auto& entry : expired)
+      entry->f.run();
+    expired.clear();
   }
 }
 
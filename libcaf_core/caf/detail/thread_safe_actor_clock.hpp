@@ -9,6 +9,7 @@
 #include "caf/actor_control_block.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/ringbuffer.hpp"
+#include "caf/detail/timing_wheel.hpp"
 #include "caf/fwd.hpp"
 
 #include <memory>
@@ -28,10 +29,7 @@ public:
   using super = actor_clock;
 
   /// Stores actions along with their scheduling period.
-  struct schedule_entry {
-    time_point t;
-    action f;
-  };
+  using schedule_entry = timing_wheel::entry;
 
   /// @relates schedule_entry
   using schedule_entry_ptr = std::unique_ptr<schedule_entry>;
@@ -67,7 +65,7 @@ private:
   bool running_ = true;
 
   /// Internal data of the dispatcher.
-  std::vector<schedule_entry_ptr> tbl_;
+  timing_wheel tbl_;
 };
 
 } // namespace caf::detail
@@ -0,0 +1,35 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/throughput_quota.hpp"
+
+#include <algorithm>
+
+namespace caf::detail {
+
+throughput_quota::throughput_quota(timespan budget) noexcept {
+  if (budget.count() > 0 && !is_infinite(budget))
+    budget_ = budget;
+}
+
+void throughput_quota::update(size_t consumed, timespan elapsed,
+                              bool backlog) noexcept {
+  if (!enabled() || consumed == 0)
+    return;
+  // Estimate how many messages would fit into the budget, based on the
+  // average cost per message of the last resume.
+  auto elapsed_ns = std::max(elapsed.count(), int64_t{1});
+  auto estimate = static_cast<double>(consumed)
+                  * static_cast<double>(budget_.count())
+                  / static_cast<double>(elapsed_ns);
+  auto fitting = estimate < static_cast<double>(max_quota)
+                   ? static_cast<size_t>(estimate)
+                   : max_quota;
+  if (elapsed > budget_)
+    quota_ = std::max(fitting, min_quota);
+  else if (backlog && fitting > quota_)
+    quota_ = std::min({fitting, quota_ * 2, max_quota});
+}
+
+} // namespace caf::detail
@@ -0,0 +1,79 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/timespan.hpp"
+
+#include <cstddef>
+
+namespace caf::detail {
+
+/// Limits how many messages an actor may consume per resume in order to keep
+/// each resume within a time budget. The quota adapts to the observed cost per
+/// message of previous resumes:
+///
+/// - After exceeding the budget, the quota shrinks to the number of messages
+///   that would have fit into the budget.
+/// - After stopping at the quota with messages left in the mailbox without
+///   using up the budget, the quota grows towards the number of messages that
+///   would fit into the budget, at most doubling per resume.
+/// - After draining the mailbox within the budget, the quota remains
+///   unchanged since there was no pressure to consume more messages.
+class CAF_CORE_EXPORT throughput_quota {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// The quota before the first update.
+  static constexpr size_t initial_quota = 32;
+
+  /// The lower bound for the quota.
+  static constexpr size_t min_quota = 1;
+
+  /// The upper bound for the quota.
+  static constexpr size_t max_quota = size_t{1} << 30;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a disabled quota.
+  throughput_quota() noexcept = default;
+
+  /// Creates a quota for given time budget. Passing `infinite` or a
+  /// non-positive value disables the quota.
+  explicit throughput_quota(timespan budget) noexcept;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether the quota limits the throughput at all.
+  bool enabled() const noexcept {
+    return budget_.count() > 0;
+  }
+
+  /// Returns the time budget per resume.
+  timespan budget() const noexcept {
+    return budget_;
+  }
+
+  /// Returns the maximum number of messages for the next resume or `max` if
+  /// the quota is disabled or larger than `max`.
+  size_t get(size_t max) const noexcept {
+    return enabled() && quota_ < max ? quota_ : max;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adjusts the quota after a resume.
+  /// @param consumed The number of messages consumed during the resume.
+  /// @param elapsed The time spent in the resume.
+  /// @param backlog Whether the actor stopped with messages left in its
+  ///                mailbox.
+  void update(size_t consumed, timespan elapsed, bool backlog) noexcept;
+
+private:
+  timespan budget_{0};
+  size_t quota_ = initial_quota;
+};
+
+} // namespace caf::detail
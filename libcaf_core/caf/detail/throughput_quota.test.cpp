@@ -0,0 +1,81 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/throughput_quota.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include <limits>
+
+using namespace caf;
+using namespace std::literals;
+
+using detail::throughput_quota;
+
+namespace {
+
+constexpr auto unlimited = std::numeric_limits<size_t>::max();
+
+} // namespace
+
+TEST("a quota without a time budget never limits the throughput") {
+  SECTION("default-constructed quotas are disabled") {
+    throughput_quota uut;
+    check(!uut.enabled());
+    check_eq(uut.get(unlimited), unlimited);
+  }
+  SECTION("an infinite budget disables the quota") {
+    throughput_quota uut{infinite};
+    check(!uut.enabled());
+    uut.update(1000, 1s, true);
+    check_eq(uut.get(unlimited), unlimited);
+  }
+  SECTION("a budget of zero disables the quota") {
+    throughput_quota uut{timespan{0}};
+    check(!uut.enabled());
+    check_eq(uut.get(10), 10u);
+  }
+}
+
+TEST("the quota never exceeds the maximum throughput") {
+  throughput_quota uut{200us};
+  check(uut.enabled());
+  check_eq(uut.get(unlimited), throughput_quota::initial_quota);
+  check_eq(uut.get(5), 5u);
+}
+
+TEST("the quota shrinks after exceeding the budget") {
+  throughput_quota uut{200us};
+  SECTION("the quota drops to the number of messages fitting the budget") {
+    // 32 messages at 10us each take 320us, i.e., only 20 fit into 200us.
+    uut.update(32, 320us, true);
+    check_eq(uut.get(unlimited), 20u);
+  }
+  SECTION("the quota never drops below one") {
+    uut.update(1, 5ms, true);
+    check_eq(uut.get(unlimited), throughput_quota::min_quota);
+  }
+}
+
+TEST("the quota grows under mailbox pressure") {
+  throughput_quota uut{200us};
+  SECTION("the quota at most doubles per resume") {
+    // 32 messages at 1us each take 32us, i.e., 200 messages fit into 200us.
+    uut.update(32, 32us, true);
+    check_eq(uut.get(unlimited), 64u);
+    uut.update(64, 64us, true);
+    check_eq(uut.get(unlimited), 128u);
+    uut.update(128, 128us, true);
+    check_eq(uut.get(unlimited), 200u);
+    uut.update(200, 200us, true);
+    check_eq(uut.get(unlimited), 200u);
+  }
+  SECTION("the quota remains unchanged without backlog") {
+    uut.update(10, 10us, false);
+    check_eq(uut.get(unlimited), throughput_quota::initial_quota);
+  }
+}
+
+CAF_TEST_MAIN()
@@ -0,0 +1,266 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/timing_wheel.hpp"
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef CAF_MSVC
+#  include <intrin.h>
+#endif
+
+namespace caf::detail {
+
+namespace {
+
+using tick_type = timing_wheel::tick_type;
+
+constexpr auto slot_mask = tick_type{timing_wheel::num_slots - 1};
+
+/// Returns the index of the lowest set bit in `x`.
+/// @pre `x != 0`
+size_t lowest_set_bit(uint64_t x) noexcept {
+#ifdef CAF_MSVC
+  unsigned long result;
+  _BitScanForward64(&result, x);
+  return static_cast<size_t>(result);
+#else
+  return static_cast<size_t>(__builtin_ctzll(x));
+#endif
+}
+
+/// Returns the slot index for `tick` at level `lvl`.
+size_t index_at(tick_type tick, size_t lvl) noexcept {
+  return static_cast<size_t>((tick >> (lvl * timing_wheel::bits_per_level))
+                             & slot_mask);
+}
+
+/// Returns a mask that selects all bits of a tick below level `lvl`.
+constexpr tick_type lower_bits(size_t lvl) noexcept {
+  return (tick_type{1} << (lvl * timing_wheel::bits_per_level)) - 1;
+}
+
+void delete_all(timing_wheel::entry* head) noexcept {
+  while (head != nullptr)
+    delete std::exchange(head, head->next);
+}
+
+} // namespace
+
+// -- nested types -------------------------------------------------------------
+
+void timing_wheel::entry_list::push_back(entry* x) noexcept {
+  x->next = nullptr;
+  if (tail == nullptr) {
+    head = tail = x;
+  } else {
+    tail->next = x;
+    tail = x;
+  }
+}
+
+timing_wheel::entry* timing_wheel::entry_list::take_all() noexcept {
+  tail = nullptr;
+  return std::exchange(head, nullptr);
+}
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+timing_wheel::timing_wheel(time_point epoch, timespan resolution) noexcept
+  : epoch_(epoch), resolution_(resolution) {
+  // nop
+}
+
+timing_wheel::~timing_wheel() {
+  delete_all(due_.take_all());
+  delete_all(overflow_.take_all());
+  for (auto& lvl : levels_)
+    for (auto& slot : lvl.slots)
+      delete_all(slot.take_all());
+}
+
+// -- properties ---------------------------------------------------------------
+
+timing_wheel::time_point timing_wheel::next_timeout() const noexcept {
+  return time_of(next_tick());
+}
+
+// -- modifiers ----------------------------------------------------------------
+
+void timing_wheel::insert(entry_ptr x) noexcept {
+  if (size_ >= purge_threshold_) {
+    purge();
+    purge_threshold_ = std::max(min_purge_threshold, size_ * 2);
+  }
+  x->tick = tick_of(x->t);
+  ++size_;
+  place(x.release());
+}
+
+void timing_wheel::purge() noexcept {
+  purge(due_);
+  purge(overflow_);
+  for (auto& bucket : levels_) {
+    for (size_t index = 0; index < num_slots; ++index) {
+      if (auto& slot = bucket.slots[index]; !slot.empty()) {
+        purge(slot);
+        if (slot.empty())
+          bucket.bitmap[index / 64] &= ~(uint64_t{1} << (index % 64));
+      }
+    }
+  }
+}
+
+void timing_wheel::advance(time_point now, std::vector<entry_ptr>& result) {
+  auto first = result.size();
+  auto target = tick_type{0};
+  if (now > epoch_) {
+    auto elapsed = std::chrono::duration_cast<timespan>(now - epoch_);
+    target = static_cast<tick_type>(elapsed.count() / resolution_.count());
+  }
+  expire(due_.take_all(), result);
+  while (current_ < target && !empty()) {
+    // Expire the next non-empty slot on the lowest level, if any.
+    auto index = index_at(current_, 0);
+    if (auto next = next_slot(0, index); next < num_slots) {
+      auto tick = current_ - index + next;
+      if (tick > target)
+        break;
+      current_ = tick;
+      expire(take(0, next), result);
+      continue;
+    }
+    // Skip all empty slots up to the next tick that moves entries from a
+    // higher level down and cascade, starting at the top.
+    auto tick = next_tick();
+    if (tick > target)
+      break;
+    current_ = tick;
+    if ((current_ & lower_bits(num_levels)) == 0)
+      place_all(overflow_.take_all());
+    for (auto lvl = num_levels - 1; lvl > 0; --lvl)
+      if ((current_ & lower_bits(lvl)) == 0)
+        place_all(take(lvl, index_at(current_, lvl)));
+    expire(due_.take_all(), result);
+  }
+  current_ = std::max(current_, target);
+  // Entries in one slot are in insertion order and ticks may span multiple
+  // timeouts. Hence, we need to sort the batch to run actions in order.
+  std::stable_sort(result.begin() + static_cast<ptrdiff_t>(first),
+                   result.end(),
+                   [](const entry_ptr& x, const entry_ptr& y) {
+                     return x->t < y->t;
+                   });
+}
+
+// -- utility functions --------------------------------------------------------
+
+timing_wheel::tick_type timing_wheel::tick_of(time_point t) const noexcept {
+  if (t <= epoch_)
+    return 0;
+  auto elapsed = std::chrono::duration_cast<timespan>(t - epoch_).count();
+  auto res = resolution_.count();
+  return static_cast<tick_type>((elapsed + res - 1) / res);
+}
+
+timing_wheel::time_point
+timing_wheel::time_of(tick_type tick) const noexcept {
+  auto offset = resolution_ * static_cast<timespan::rep>(tick);
+  return epoch_ + std::chrono::duration_cast<clock_type::duration>(offset);
+}
+
+timing_wheel::tick_type timing_wheel::next_tick() const noexcept {
+  if (!due_.empty())
+    return current_;
+  // Slots on lower levels always come before slots on higher levels.
+  for (size_t lvl = 0; lvl < num_levels; ++lvl) {
+    if (auto next = next_slot(lvl, index_at(current_, lvl)); next < num_slots) {
+      auto shift = lvl * bits_per_level;
+      auto base = current_ & ~lower_bits(lvl + 1);
+      return base + (tick_type{next} << shift);
+    }
+  }
+  // Only the overflow list remains. Wake up when the top level wraps around.
+  return (current_ | lower_bits(num_levels)) + 1;
+}
+
+void timing_wheel::purge(entry_list& list) noexcept {
+  auto head = list.take_all();
+  while (head != nullptr) {
+    auto x = std::exchange(head, head->next);
+    if (x->f.disposed()) {
+      delete x;
+      --size_;
+    } else {
+      list.push_back(x);
+    }
+  }
+}
+
+void timing_wheel::place(entry* x) noexcept {
+  auto tick = x->tick;
+  if (tick <= current_) {
+    due_.push_back(x);
+    return;
+  }
+  // Pick the lowest level where the deadline falls into the current rotation.
+  for (size_t lvl = 0; lvl < num_levels; ++lvl) {
+    if (((tick ^ current_) & ~lower_bits(lvl + 1)) == 0) {
+      auto index = index_at(tick, lvl);
+      auto& bucket = levels_[lvl];
+      bucket.slots[index].push_back(x);
+      bucket.bitmap[index / 64] |= uint64_t{1} << (index % 64);
+      return;
+    }
+  }
+  overflow_.push_back(x);
+}
+
+void timing_wheel::place_all(entry* head) noexcept {
+  while (head != nullptr) {
+    auto x = std::exchange(head, head->next);
+    if (x->f.disposed()) {
+      delete x;
+      --size_;
+    } else {
+      place(x);
+    }
+  }
+}
+
+timing_wheel::entry* timing_wheel::take(size_t lvl, size_t index) noexcept {
+  auto& bucket = levels_[lvl];
+  bucket.bitmap[index / 64] &= ~(uint64_t{1} << (index % 64));
+  return bucket.slots[index].take_all();
+}
+
+void timing_wheel::expire(entry* head, std::vector<entry_ptr>& result) {
+  while (head != nullptr) {
+    entry_ptr x{std::exchange(head, head->next)};
+    --size_;
+    if (!x->f.disposed())
+      result.emplace_back(std::move(x));
+  }
+}
+
+size_t timing_wheel::next_slot(size_t lvl, size_t index) const noexcept {
+  auto first = index + 1;
+  if (first >= num_slots)
+    return num_slots;
+  auto& bitmap = levels_[lvl].bitmap;
+  auto word = first / 64;
+  auto bits = bitmap[word] & (~uint64_t{0} << (first % 64));
+  for (;;) {
+    if (bits != 0)
+      return word * 64 + lowest_set_bit(bits);
+    if (++word == bitmap.size())
+      return num_slots;
+    bits = bitmap[word];
+  }
+}
+
+} // namespace caf::detail
@@ -0,0 +1,202 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/action.hpp"
+#include "caf/actor_clock.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/timespan.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace caf::detail {
+
+/// A hierarchical timing wheel for storing timeouts with O(1) insertion. The
+/// wheel divides time into ticks of fixed length and stores each entry in a
+/// slot on the lowest level that covers its deadline. Advancing the wheel
+/// moves entries from higher levels to lower levels whenever the current tick
+/// reaches their slot, until they finally expire on the lowest level.
+///
+/// Cancelling an entry requires no interaction with the wheel: the wheel drops
+/// entries with disposed actions when it encounters them. To bound the memory
+/// held by cancelled entries with long timeouts, the wheel also purges all
+/// disposed entries whenever its size doubles.
+///
+/// @note Entries never expire early, but may expire up to one tick late.
+class CAF_CORE_EXPORT timing_wheel {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Number of bits of the tick counter that each level covers.
+  static constexpr size_t bits_per_level = 8;
+
+  /// Number of slots per level.
+  static constexpr size_t num_slots = size_t{1} << bits_per_level;
+
+  /// Number of levels in the wheel.
+  static constexpr size_t num_levels = 4;
+
+  /// Length of a single tick if not configured otherwise.
+  static constexpr timespan default_resolution = timespan{1'000'000};
+
+  /// Minimum number of entries before `insert` purges disposed entries.
+  static constexpr size_t min_purge_threshold = 1024;
+
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = actor_clock::clock_type;
+
+  using time_point = actor_clock::time_point;
+
+  using tick_type = uint64_t;
+
+  /// Stores an action along with its timeout.
+  struct entry {
+    time_point t;
+    action f;
+    entry* next = nullptr;
+    tick_type tick = 0;
+  };
+
+  using entry_ptr = std::unique_ptr<entry>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit timing_wheel(time_point epoch,
+                        timespan resolution = default_resolution) noexcept;
+
+  timing_wheel(const timing_wheel&) = delete;
+
+  timing_wheel& operator=(const timing_wheel&) = delete;
+
+  ~timing_wheel();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of stored entries, including disposed entries that
+  /// the wheel did not encounter yet.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Queries whether the wheel contains no entries.
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the length of a single tick.
+  timespan resolution() const noexcept {
+    return resolution_;
+  }
+
+  /// Returns the earliest point in time at which `advance` can produce any
+  /// expired entries.
+  /// @pre `!empty()`
+  time_point next_timeout() const noexcept;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Inserts a new entry into the wheel. Purges all disposed entries first if
+  /// the size of the wheel reached the purge threshold.
+  void insert(entry_ptr x) noexcept;
+
+  /// Drops all entries with disposed actions.
+  void purge() noexcept;
+
+  /// Advances the wheel to `now` and appends all expired entries to `result`,
+  /// ordered by their timeout. Drops all entries with disposed actions on the
+  /// way.
+  void advance(time_point now, std::vector<entry_ptr>& result);
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  /// Intrusive, singly-linked FIFO list of entries.
+  struct entry_list {
+    entry* head = nullptr;
+    entry* tail = nullptr;
+
+    bool empty() const noexcept {
+      return head == nullptr;
+    }
+
+    void push_back(entry* x) noexcept;
+
+    /// Removes all entries from the list and returns the former head.
+    entry* take_all() noexcept;
+  };
+
+  /// Stores all slots of a level plus a bitmap of non-empty slots.
+  struct level {
+    std::array<entry_list, num_slots> slots;
+    std::array<uint64_t, num_slots / 64> bitmap = {};
+  };
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Converts a point in time to a tick, rounding up.
+  tick_type tick_of(time_point t) const noexcept;
+
+  /// Converts a tick to a point in time.
+  time_point time_of(tick_type tick) const noexcept;
+
+  /// Returns the earliest tick at which the wheel has due entries, expires a
+  /// slot on the lowest level or moves entries down from a higher level.
+  tick_type next_tick() const noexcept;
+
+  /// Drops all entries with disposed actions from `list`.
+  void purge(entry_list& list) noexcept;
+
+  /// Places `x` into a slot relative to the current tick without updating
+  /// `size_`.
+  void place(entry* x) noexcept;
+
+  /// Places all entries of the list at `head` relative to the current tick,
+  /// dropping disposed actions.
+  void place_all(entry* head) noexcept;
+
+  /// Removes all entries from a slot and returns them as a list.
+  entry* take(size_t lvl, size_t index) noexcept;
+
+  /// Moves all entries from the list at `head` to `result`, dropping disposed
+  /// actions.
+  void expire(entry* head, std::vector<entry_ptr>& result);
+
+  /// Returns the index of the first non-empty slot at `lvl` that comes after
+  /// `index` or `num_slots` if no such slot exists.
+  size_t next_slot(size_t lvl, size_t index) const noexcept;
+
+  // -- member variables -------------------------------------------------------
+
+  /// Point in time that corresponds to tick 0.
+  time_point epoch_;
+
+  /// Length of a single tick.
+  timespan resolution_;
+
+  /// The current tick.
+  tick_type current_ = 0;
+
+  /// Number of stored entries.
+  size_t size_ = 0;
+
+  /// Size at which `insert` purges disposed entries.
+  size_t purge_threshold_ = min_purge_threshold;
+
+  /// Stores entries that were already due at insertion time.
+  entry_list due_;
+
+  /// Stores entries with deadlines beyond the range of the top level.
+  entry_list overflow_;
+
+  /// Stores the levels of the wheel.
+  std::array<level, num_levels> levels_;
+};
+
+} // namespace caf::detail
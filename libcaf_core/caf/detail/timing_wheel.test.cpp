@@ -0,0 +1,162 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/timing_wheel.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using time_point = detail::timing_wheel::time_point;
+
+using entry = detail::timing_wheel::entry;
+
+using entry_ptr = detail::timing_wheel::entry_ptr;
+
+struct fixture {
+  time_point epoch;
+
+  detail::timing_wheel uut{epoch};
+
+  std::vector<entry_ptr> expired;
+
+  void add(timespan t) {
+    uut.insert(entry_ptr{new entry{epoch + t, make_action([] {})}});
+  }
+
+  /// Advances the wheel and returns the offsets of all expired entries.
+  std::vector<timespan> advance(timespan t) {
+    expired.clear();
+    uut.advance(epoch + t, expired);
+    std::vector<timespan> result;
+    for (auto& x : expired)
+      result.emplace_back(x->t - epoch);
+    return result;
+  }
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("entries expire in order and never before their timeout") {
+  using v = std::vector<timespan>;
+  add(5ms);
+  add(3ms);
+  add(300ms);
+  add(70s);
+  add(2h);
+  add(1500us);
+  check_eq(uut.size(), 6u);
+  // The wheel rounds deadlines up to the next tick.
+  check(uut.next_timeout() == epoch + 2ms);
+  check_eq(advance(1ms), v{});
+  check_eq(advance(4ms), v({1500us, 3ms}));
+  check_eq(advance(5ms), v{5ms});
+  check_eq(advance(299ms), v{});
+  check(uut.next_timeout() <= epoch + 300ms);
+  check_eq(advance(300ms), v{300ms});
+  check_eq(advance(69999ms), v{});
+  check_eq(advance(70s), v{70s});
+  check_eq(advance(1h), v{});
+  check_eq(advance(3h), v{2h});
+  check(uut.empty());
+}
+
+TEST("entries that are due at insertion expire on the next advance") {
+  using v = std::vector<timespan>;
+  check_eq(advance(10ms), v{});
+  add(2ms);
+  add(10ms);
+  add(11ms);
+  check(uut.next_timeout() <= epoch + 10ms);
+  check_eq(advance(10ms), v({2ms, 10ms}));
+  check_eq(advance(11ms), v{11ms});
+}
+
+TEST("the wheel drops disposed entries") {
+  auto f1 = make_action([] {});
+  auto f2 = make_action([] {});
+  uut.insert(entry_ptr{new entry{epoch + 2s, f1}});
+  uut.insert(entry_ptr{new entry{epoch + 2s, f2}});
+  f1.dispose();
+  advance(3s);
+  check_eq(expired.size(), 1u);
+  if (expired.size() == 1)
+    check(expired[0]->f.ptr() == f2.ptr());
+  check(uut.empty());
+}
+
+TEST("the wheel purges disposed entries once its size doubles") {
+  constexpr auto n = detail::timing_wheel::min_purge_threshold;
+  std::vector<action> actions;
+  for (size_t i = 0; i < n; ++i) {
+    auto f = make_action([] {});
+    uut.insert(entry_ptr{new entry{epoch + 24h * (i % 3 + 1), f}});
+    actions.push_back(std::move(f));
+  }
+  check_eq(uut.size(), n);
+  for (size_t i = 1; i < n; ++i)
+    actions[i].dispose();
+  add(1s);
+  check_eq(uut.size(), 2u);
+  check_eq(advance(24h * 4).size(), 2u);
+  check(uut.empty());
+}
+
+TEST("entries with large timeouts go to the overflow list") {
+  using v = std::vector<timespan>;
+  add(24h * 60);
+  add(24h * 120);
+  check_eq(advance(24h * 59), v{});
+  check_eq(advance(24h * 61), v{24h * 60});
+  check_eq(advance(24h * 121), v{24h * 120});
+  check(uut.empty());
+}
+
+TEST("randomized timeouts expire in order and on time") {
+  std::minstd_rand rng{42};
+  std::uniform_int_distribution<int64_t> delay{0, 5'000'000'000};
+  std::uniform_int_distribution<int64_t> step{0, 50'000'000};
+  std::vector<timespan> pending;
+  auto now = timespan{0};
+  auto ok = true;
+  for (int round = 0; round < 1000 && ok; ++round) {
+    for (int i = 0; i < 10; ++i) {
+      auto t = now + timespan{delay(rng)};
+      add(t);
+      pending.push_back(t);
+    }
+    now += timespan{step(rng)};
+    auto got = advance(now);
+    std::sort(pending.begin(), pending.end());
+    auto first_pending = std::upper_bound(pending.begin(), pending.end(), now);
+    // The wheel may expire entries up to one tick late.
+    std::vector<timespan> due{pending.begin(), first_pending};
+    if (got.size() > due.size()) {
+      ok = false;
+      break;
+    }
+    ok = std::equal(got.begin(), got.end(), due.begin())
+         && std::all_of(due.begin() + static_cast<ptrdiff_t>(got.size()),
+                        due.end(),
+                        [&](timespan t) { return t > now - uut.resolution(); });
+    pending.erase(pending.begin(),
+                  pending.begin() + static_cast<ptrdiff_t>(got.size()));
+  }
+  check(ok);
+  check_eq(uut.size(), pending.size());
+}
+
+} // WITH_FIXTURE(fixture)
+
+CAF_TEST_MAIN()
@@ -15,4 +15,8 @@ execution_unit::~execution_unit() {
   // nop
 }
 
+bool execution_unit::yield_requested() const noexcept {
+  return false;
+}
+
 } // namespace caf
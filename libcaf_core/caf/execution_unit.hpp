@@ -29,6 +29,10 @@ public:
   ///          executed by this execution unit.
   virtual void exec_later(resumable* ptr) = 0;
 
+  /// Queries whether the scheduler asked this execution unit to run other
+  /// jobs, because its current job is running for too long.
+  virtual bool yield_requested() const noexcept;
+
   /// Returns the enclosing actor system.
   /// @warning Must be set before the execution unit calls `resume` on an actor.
   actor_system& system() const {
@@ -176,6 +176,8 @@ public:
       return {0, false};
     size_t consumed = 0;
     do {
+      // Overlap fetching the next element with running the consumer.
+      CAF_PREFETCH(list_.peek());
       auto consumer_res = consumer(*ptr);
       switch (consumer_res) {
         case task_result::skip:
@@ -112,13 +112,18 @@ public:
     queue_.flush_cache();
   }
 
-  /// Tries to get more items from the inbox.
+  /// Tries to get more items from the inbox. Moves all new elements from the
+  /// inbox to the queue in a single pass, thereby restoring FIFO order and
+  /// dispatching the elements to their nested queues (if any).
   bool fetch_more() {
     node_pointer head = inbox_.take_head();
     if (head == nullptr)
       return false;
     do {
       auto next = head->next;
+      // Load the next node while categorizing the current one. Walking a
+      // linked list written by other threads otherwise stalls on each node.
+      CAF_PREFETCH(next);
       queue_.lifo_append(lifo_inbox_type::promote(head));
       head = next;
     } while (head != nullptr);
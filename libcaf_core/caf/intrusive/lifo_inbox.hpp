@@ -53,7 +53,7 @@ public:
     while (e != eof) {
       // A tag is never part of a non-empty list.
       new_element->next = e != blk ? e : nullptr;
-      if (stack_.compare_exchange_strong(e, new_element))
+      if (stack_.compare_exchange_weak(e, new_element))
         return e == reader_blocked_tag() ? inbox_result::unblocked_reader
                                          : inbox_result::success;
       // Continue with new value of `e`.
@@ -141,7 +141,15 @@ public:
   /// Sets the head to `stack_empty_tag()` and returns the previous head if
   /// the queue was not empty.
   pointer take_head() noexcept {
-    return take_head(stack_empty_tag());
+    pointer e = stack_.load();
+    if (e == stack_empty_tag())
+      return nullptr;
+    if (e == reader_blocked_tag() || e == stack_closed_tag())
+      return take_head(stack_empty_tag());
+    // Only the reader may turn a non-empty stack back into a tag. Hence, we can
+    // grab all elements with a single exchange instead of competing with the
+    // writers in a CAS loop.
+    return stack_.exchange(stack_empty_tag());
   }
 
   /// Closes this queue and deletes all remaining elements.
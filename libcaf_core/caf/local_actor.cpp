@@ -40,6 +40,8 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
       nullptr,
       nullptr,
       nullptr,
+      nullptr,
+      nullptr,
     };
   self->setf(abstract_actor::collects_metrics_flag);
   const auto& families = sys.actor_metric_families();
@@ -48,6 +50,8 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
     families.processing_time->get_or_add({{"name", sv}}),
     families.mailbox_time->get_or_add({{"name", sv}}),
     families.mailbox_size->get_or_add({{"name", sv}}),
+    families.throughput_quota->get_or_add({{"name", sv}}),
+    families.resume_time->get_or_add({{"name", sv}}),
   };
 }
 
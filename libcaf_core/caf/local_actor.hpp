@@ -61,6 +61,12 @@ public:
 
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge* mailbox_size = nullptr;
+
+    /// Tracks how many messages the actor may consume per resume.
+    telemetry::int_gauge* throughput_quota = nullptr;
+
+    /// Samples how long the actor runs per resume.
+    telemetry::dbl_histogram* resume_time = nullptr;
   };
 
   /// Optional metrics for inbound stream traffic collected by individual actors
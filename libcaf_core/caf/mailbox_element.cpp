@@ -4,7 +4,11 @@
 
 #include "caf/mailbox_element.hpp"
 
+#include "caf/detail/slab_allocator.hpp"
+#include "caf/raise_error.hpp"
+
 #include <memory>
+#include <new>
 
 namespace caf {
 
@@ -17,10 +21,36 @@ mailbox_element::mailbox_element(strong_actor_ptr sender, message_id mid,
   // nop
 }
 
+void* mailbox_element::operator new(size_t size) {
+  auto vptr = detail::slab_allocator::allocate(size);
+  if (vptr == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  return vptr;
+}
+
+void mailbox_element::operator delete(void* ptr) noexcept {
+  detail::slab_allocator::deallocate(ptr);
+}
+
+static_assert(sizeof(mailbox_element) <= detail::message_data::host_slot_size,
+              "mailbox elements must fit into the host slot of message data");
+
+static_assert(alignof(mailbox_element)
+              <= detail::slab_allocator::min_alignment);
+
 mailbox_element_ptr
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages,
                      message payload) {
+  // Place the element into the memory block of the payload if possible.
+  if (auto data = payload.cptr()) {
+    if (auto vptr = data->claim_host_slot()) {
+      auto ptr = ::new (vptr) mailbox_element(std::move(sender), id,
+                                              std::move(stages),
+                                              std::move(payload));
+      return mailbox_element_ptr{ptr};
+    }
+  }
   return std::make_unique<mailbox_element>(std::move(sender), id,
                                            std::move(stages),
                                            std::move(payload));
@@ -77,6 +77,14 @@ public:
   mailbox_element& operator=(mailbox_element&&) = delete;
   mailbox_element& operator=(const mailbox_element&) = delete;
 
+  // -- memory management ------------------------------------------------------
+
+  /// Allocates memory for a mailbox element via the slab allocator of the
+  /// calling thread, if available.
+  static void* operator new(size_t size);
+
+  static void operator delete(void* ptr) noexcept;
+
   // -- backward compatibility -------------------------------------------------
 
   message& content() noexcept {
@@ -116,8 +124,8 @@ make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages, T&& x,
                      Ts&&... xs) {
   return make_mailbox_element(std::move(sender), id, std::move(stages),
-                              make_message(std::forward<T>(x),
-                                           std::forward<Ts>(xs)...));
+                              detail::make_message_impl<true>(
+                                std::forward<T>(x), std::forward<Ts>(xs)...));
 }
 
 } // namespace caf
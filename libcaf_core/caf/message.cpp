@@ -77,10 +77,11 @@ bool load_data(Deserializer& source, message::data_ptr& data) {
         STOP(sec::unknown_type);
     }
     intrusive_ptr<detail::message_data> ptr;
-    if (auto vptr = malloc(sizeof(detail::message_data) + data_size)) {
-      // We don't need to worry about exceptions here: the message_data
-      // constructor as well as `move_to_list` are `noexcept`.
-      ptr.reset(new (vptr) detail::message_data(ids.move_to_list()), false);
+    // We don't need to worry about exceptions here: `try_make` as well as
+    // `move_to_list` are `noexcept`.
+    if (auto raw_ptr = detail::message_data::try_make(ids.move_to_list(),
+                                                      data_size)) {
+      ptr.reset(raw_ptr, false);
     } else {
       STOP(sec::runtime_error, "unable to allocate memory");
     }
@@ -173,10 +174,11 @@ bool load_data(Deserializer& source, message::data_ptr& data) {
     GUARDED(source.end_sequence());
     // Merge elements into a single message data object.
     intrusive_ptr<detail::message_data> ptr;
-    if (auto vptr = malloc(sizeof(detail::message_data) + data_size)) {
-      // We don't need to worry about exceptions here: the message_data
-      // constructor as well as `move_to_list` are `noexcept`.
-      ptr.reset(new (vptr) detail::message_data(ids.move_to_list()), false);
+    // We don't need to worry about exceptions here: `try_make` as well as
+    // `move_to_list` are `noexcept`.
+    if (auto raw_ptr = detail::message_data::try_make(ids.move_to_list(),
+                                                      data_size)) {
+      ptr.reset(raw_ptr, false);
     } else {
       STOP(sec::runtime_error, "unable to allocate memory");
     }
@@ -202,24 +202,33 @@ inline message make_message() {
   return {};
 }
 
-/// @relates message
-template <class... Ts>
-message make_message(Ts&&... xs) {
-  using namespace detail;
+namespace detail {
+
+/// Creates a message from `xs`. Reserves memory for a mailbox element in front
+/// of the message if `WithHostSlot` is `true`.
+template <bool WithHostSlot, class... Ts>
+message make_message_impl(Ts&&... xs) {
   static_assert((!std::is_pointer<strip_and_convert_t<Ts>>::value && ...));
   static_assert((is_complete<type_id<strip_and_convert_t<Ts>>> && ...));
-  static constexpr size_t data_size
-    = sizeof(message_data) + (padded_size_v<strip_and_convert_t<Ts>> + ...);
+  static constexpr size_t storage_size
+    = (padded_size_v<strip_and_convert_t<Ts>> + ...);
   auto types = make_type_id_list<strip_and_convert_t<Ts>...>();
-  auto vptr = malloc(data_size);
-  if (vptr == nullptr)
+  auto raw_ptr = message_data::try_make(types, storage_size, WithHostSlot);
+  if (raw_ptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
-  auto raw_ptr = new (vptr) message_data(types);
   intrusive_cow_ptr<message_data> ptr{raw_ptr, false};
   raw_ptr->init(std::forward<Ts>(xs)...);
   return message{std::move(ptr)};
 }
 
+} // namespace detail
+
+/// @relates message
+template <class... Ts>
+message make_message(Ts&&... xs) {
+  return detail::make_message_impl<false>(std::forward<Ts>(xs)...);
+}
+
 /// @relates message
 template <class Tuple, size_t... Is>
 message make_message_from_tuple(Tuple&& xs, std::index_sequence<Is...>) {
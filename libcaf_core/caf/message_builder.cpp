@@ -23,14 +23,13 @@ message to_message_impl(size_t storage_size, TypeListBuilder& types,
                         ElementVector& elements) {
   if (storage_size == 0)
     return message{};
-  auto vptr = malloc(sizeof(message_data) + storage_size);
-  if (vptr == nullptr)
-    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   message_data* raw_ptr;
   if constexpr (Policy == move_msg)
-    raw_ptr = new (vptr) message_data(types.move_to_list());
+    raw_ptr = message_data::try_make(types.move_to_list(), storage_size);
   else
-    raw_ptr = new (vptr) message_data(types.copy_to_list());
+    raw_ptr = message_data::try_make(types.copy_to_list(), storage_size);
+  if (raw_ptr == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   intrusive_cow_ptr<message_data> ptr{raw_ptr, false};
   auto storage = raw_ptr->storage();
   for (auto& element : elements) {
@@ -0,0 +1,178 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/chase_lev_deque.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/double_ended_queue.hpp"
+#include "caf/policy/unprofiled.hpp"
+#include "caf/policy/work_stealing.hpp"
+#include "caf/resumable.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <random>
+
+namespace caf::policy {
+
+/// Implements scheduling of actors via work stealing with a lock-free deque
+/// per worker. The owner pushes and pops jobs at the bottom of its deque
+/// without any synchronization with other workers, while idle workers steal
+/// from the top. Jobs from outside of the worker (central enqueue) as well as
+/// jobs that yield the CPU go to a separate inbox that also serves as parking
+/// spot for idle workers.
+/// @extends scheduler_policy
+class CAF_CORE_EXPORT lock_free_work_stealing : public unprofiled {
+public:
+  ~lock_free_work_stealing() override;
+
+  /// Lock-free deque for jobs that the worker schedules itself.
+  using queue_type = detail::chase_lev_deque<resumable>;
+
+  /// Thread-safe queue for jobs from other threads. Idle workers wait on this
+  /// queue for new jobs.
+  using inbox_type = detail::double_ended_queue<resumable>;
+
+  /// Re-uses the poll strategy configuration of the regular work stealing.
+  using poll_strategy = work_stealing::poll_strategy;
+
+  /// Configures after how many jobs from the local deque a worker checks its
+  /// inbox, to make sure that external jobs cannot starve.
+  static constexpr size_t inbox_check_interval = 61;
+
+  // The coordinator has only a counter for round-robin enqueue to its workers.
+  struct coordinator_data {
+    explicit coordinator_data(scheduler::abstract_coordinator*)
+      : next_worker(0) {
+      // nop
+    }
+
+    std::atomic<size_t> next_worker;
+  };
+
+  // Holds the job queues of a worker and a random number generator.
+  struct worker_data {
+    explicit worker_data(scheduler::abstract_coordinator* p);
+    worker_data(const worker_data& other);
+
+    // Owner-only push/pop, other workers may steal from it.
+    queue_type queue;
+    // Receives jobs from other threads.
+    inbox_type inbox;
+    // Counts dequeue operations for checking the inbox periodically.
+    size_t ticks = 0;
+    // needed to generate pseudo random numbers
+    std::default_random_engine rengine;
+    std::uniform_int_distribution<size_t> uniform;
+    std::array<poll_strategy, 3> strategies;
+    // Shared topology information or `nullptr` if disabled.
+    work_stealing::topology_data_ptr topology;
+  };
+
+  template <class Worker>
+  void init_worker_thread(Worker* self) {
+    work_stealing::pin_worker_thread(self);
+  }
+
+  // Goes on a raid in quest for a shiny new job.
+  template <class Worker>
+  resumable* try_steal(Worker* self) {
+    // steal oldest element from the victim's queues
+    return work_stealing::steal_from_victims(self, [](Worker* victim) {
+      auto& vd = d(victim);
+      if (auto* job = vd.queue.steal())
+        return job;
+      return vd.inbox.try_take_tail();
+    });
+  }
+
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable* job) {
+    auto w = self->worker_by_id(d(self).next_worker++ % self->num_workers());
+    w->external_enqueue(job);
+  }
+
+  template <class Worker>
+  void external_enqueue(Worker* self, resumable* job) {
+    d(self).inbox.append(job);
+  }
+
+  template <class Worker>
+  void internal_enqueue(Worker* self, resumable* job) {
+    d(self).queue.push(job);
+  }
+
+  template <class Worker>
+  void resume_job_later(Worker* self, resumable* job) {
+    // job has voluntarily released the CPU to let others run instead
+    // this means we are going to put this job to the very end of our inbox
+    d(self).inbox.unsafe_append(job);
+  }
+
+  // Moves all queued jobs of a stalled worker to the other workers.
+  template <class Coordinator, class Worker>
+  void redistribute(Coordinator* self, Worker* stalled) {
+    work_stealing::move_jobs(self, stalled, [stalled]() -> resumable* {
+      auto& data = d(stalled);
+      if (auto* job = data.queue.steal())
+        return job;
+      return data.inbox.try_take_head();
+    });
+  }
+
+  template <class Worker>
+  resumable* dequeue(Worker* self) {
+    auto& data = d(self);
+    // Check the inbox periodically to make sure that jobs from other threads
+    // make progress even if our own deque never runs empty.
+    if (++data.ticks % inbox_check_interval == 0)
+      if (auto* job = data.inbox.try_take_head())
+        return job;
+    if (auto* job = data.queue.pop())
+      return job;
+    if (auto* job = data.inbox.try_take_head())
+      return job;
+    // Same three-stage polling as the regular work stealing, but blocking on
+    // the inbox rather than on a shared queue.
+    auto& strategies = data.strategies;
+    for (size_t k = 0; k < 2; ++k) { // iterate over the first two strategies
+      for (size_t i = 0; i < strategies[k].attempts;
+           i += strategies[k].step_size) {
+        // try to steal every X poll attempts
+        if ((i % strategies[k].steal_interval) == 0)
+          if (auto* job = try_steal(self))
+            return job;
+        if (auto* job = data.inbox.try_take_head(strategies[k].sleep_duration))
+          return job;
+      }
+    }
+    // we assume pretty much nothing is going on so we can relax polling
+    auto& relaxed = strategies[2];
+    for (;;) {
+      if (auto* job = try_steal(self))
+        return job;
+      if (auto* job = data.inbox.try_take_head(relaxed.sleep_duration))
+        return job;
+    }
+  }
+
+  template <class Worker, class UnaryFunction>
+  void foreach_resumable(Worker* self, UnaryFunction f) {
+    for (auto job = d(self).queue.pop(); job != nullptr;
+         job = d(self).queue.pop())
+      f(job);
+    for (auto job = d(self).inbox.try_take_head(); job != nullptr;
+         job = d(self).inbox.try_take_head())
+      f(job);
+  }
+
+  template <class Coordinator, class UnaryFunction>
+  void foreach_central_resumable(Coordinator*, UnaryFunction) {
+    // nop
+  }
+};
+
+} // namespace caf::policy
@@ -65,6 +65,11 @@ public:
   template <class Worker>
   void after_completion(Worker* self, resumable* job);
 
+  /// Called by the watchdog of the coordinator from its own thread if
+  /// `stalled` runs a single job for too long.
+  template <class Coordinator, class Worker>
+  void redistribute(Coordinator* self, Worker* stalled);
+
   /// Applies given functor to all resumables attached to a worker.
   template <class Worker, typename UnaryFunction>
   void foreach_resumable(Worker* self, UnaryFunction f);
@@ -18,6 +18,13 @@ class CAF_CORE_EXPORT unprofiled {
 public:
   virtual ~unprofiled();
 
+  /// Called by each worker from its own thread before entering the scheduling
+  /// loop.
+  template <class Worker>
+  void init_worker_thread(Worker*) {
+    // nop
+  }
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker*) {
@@ -44,6 +51,14 @@ public:
     // nop
   }
 
+  /// Called by the watchdog of the coordinator if `stalled` runs a single job
+  /// for too long. Policies with a job queue per worker move queued jobs to
+  /// other workers.
+  template <class Coordinator, class Worker>
+  void redistribute(Coordinator*, Worker*) {
+    // nop
+  }
+
 protected:
   // Convenience function to access the data field.
   template <class WorkerOrCoordinator>
@@ -19,6 +19,35 @@ work_stealing::~work_stealing() {
   // nop
 }
 
+work_stealing::coordinator_data::coordinator_data(
+  scheduler::abstract_coordinator* p)
+  : next_worker(0),
+    park_idle_workers(CONFIG("park-idle-workers", park_idle_workers)),
+    spinning_workers(0) {
+  // nop
+}
+
+work_stealing::topology_data_ptr
+work_stealing::make_topology_data(scheduler::abstract_coordinator* p) {
+  auto steal_by_distance = CONFIG("topology-aware", topology_aware);
+  // The distance between two workers only means something if both stay on
+  // their CPU. Hence, stealing by distance always pins the workers.
+  auto pin_workers = steal_by_distance || CONFIG("pin-workers", pin_workers);
+  if (!steal_by_distance && !pin_workers)
+    return nullptr;
+  auto result = std::make_shared<topology_data>();
+  result->topology = detail::cpu_topology::read();
+  // Pinning a thread to a CPU outside of the affinity mask fails.
+  result->topology.retain(detail::cpu_topology::affinity());
+  result->steal_by_distance = steal_by_distance;
+  result->pin_workers = pin_workers;
+  auto num_workers = p->num_workers();
+  result->victims.reserve(num_workers);
+  for (size_t id = 0; id < num_workers; ++id)
+    result->victims.emplace_back(result->topology.victims(id, num_workers));
+  return result;
+}
+
 work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
   : rengine(std::random_device{}()),
     // no need to worry about wrap-around; if `p->num_workers() < 2`,
@@ -32,14 +61,16 @@ work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
         CONFIG("moderate-steal-interval", moderate_steal_interval),
         CONFIG("moderate-sleep-duration", moderate_sleep_duration)},
        {1, 0, CONFIG("relaxed-steal-interval", relaxed_steal_interval),
-        CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}} {
+        CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}},
+    topology(make_topology_data(p)) {
   // nop
 }
 
 work_stealing::worker_data::worker_data(const worker_data& other)
   : rengine(std::random_device{}()),
     uniform(other.uniform),
-    strategies(other.strategies) {
+    strategies(other.strategies),
+    topology(other.topology) {
   // nop
 }
 
@@ -6,7 +6,9 @@
 
 #include "caf/actor_system_config.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/eventcount.hpp"
 #include "caf/policy/unprofiled.hpp"
 #include "caf/resumable.hpp"
 #include "caf/timespan.hpp"
@@ -16,6 +18,7 @@
 #include <condition_variable>
 #include <cstddef>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <random>
 #include <thread>
@@ -39,14 +42,36 @@ public:
     timespan sleep_duration;
   };
 
-  // The coordinator has only a counter for round-robin enqueue to its workers.
+  // Topology information that all workers share.
+  struct topology_data {
+    detail::cpu_topology topology;
+    // Stores for each worker the other workers grouped by their distance.
+    std::vector<detail::cpu_topology::victim_list> victims;
+    // Configures whether workers steal from nearby workers first.
+    bool steal_by_distance = false;
+    // Configures whether workers bind their thread to a dedicated CPU.
+    bool pin_workers = false;
+  };
+
+  using topology_data_ptr = std::shared_ptr<const topology_data>;
+
+  // Reads the CPU topology if enabled via `caf.work-stealing`. Returns `nullptr`
+  // if neither topology-aware stealing nor pinning is enabled.
+  static topology_data_ptr make_topology_data(
+    scheduler::abstract_coordinator* p);
+
+  // The coordinator has a counter for round-robin enqueue to its workers and
+  // a parking lot for idle workers.
   struct coordinator_data {
-    explicit coordinator_data(scheduler::abstract_coordinator*)
-      : next_worker(0) {
-      // nop
-    }
+    explicit coordinator_data(scheduler::abstract_coordinator* p);
 
     std::atomic<size_t> next_worker;
+    // Configures whether idle workers park instead of polling their queue.
+    bool park_idle_workers;
+    // Number of workers that are currently looking for jobs to steal.
+    std::atomic<size_t> spinning_workers;
+    // Shared by all workers for parking and waking up idle workers.
+    detail::eventcount idle_workers;
   };
 
   // Holds job job queue of a worker and a random number generator.
@@ -61,22 +86,59 @@ public:
     std::default_random_engine rengine;
     std::uniform_int_distribution<size_t> uniform;
     std::array<poll_strategy, 3> strategies;
+    // Shared topology information or `nullptr` if disabled.
+    topology_data_ptr topology;
   };
 
-  // Goes on a raid in quest for a shiny new job.
-  template <class Worker>
-  resumable* try_steal(Worker* self) {
+  // Picks victims for `self` and calls `steal_from` on each until it returns a
+  // job. When stealing by distance, tries one random victim from each distance
+  // class in order. Otherwise, picks a single victim at random.
+  template <class Worker, class StealFrom>
+  static resumable* steal_from_victims(Worker* self, StealFrom steal_from) {
     auto p = self->parent();
     if (p->num_workers() < 2) {
       // you can't steal from yourself, can you?
       return nullptr;
     }
+    auto& data = d(self);
+    if (auto& topo = data.topology; topo && topo->steal_by_distance) {
+      for (auto& candidates : topo->victims[self->id()]) {
+        if (candidates.empty())
+          continue;
+        auto pick = std::uniform_int_distribution<size_t>{
+          0, candidates.size() - 1}(data.rengine);
+        if (auto job = steal_from(p->worker_by_id(candidates[pick])))
+          return job;
+      }
+      return nullptr;
+    }
     // roll the dice to pick a victim other than ourselves
-    auto victim = d(self).uniform(d(self).rengine);
+    auto victim = data.uniform(data.rengine);
     if (victim == self->id())
       victim = p->num_workers() - 1;
+    return steal_from(p->worker_by_id(victim));
+  }
+
+  // Binds the thread of `self` to a CPU if configured.
+  template <class Worker>
+  static void pin_worker_thread(Worker* self) {
+    if (auto& topo = d(self).topology; topo && topo->pin_workers)
+      detail::cpu_topology::pin_this_thread(
+        topo->topology.cpu_of(self->id()).id);
+  }
+
+  template <class Worker>
+  void init_worker_thread(Worker* self) {
+    pin_worker_thread(self);
+  }
+
+  // Goes on a raid in quest for a shiny new job.
+  template <class Worker>
+  resumable* try_steal(Worker* self) {
     // steal oldest element from the victim's queue
-    return d(p->worker_by_id(victim)).queue.try_take_tail();
+    return steal_from_victims(self, [](Worker* victim) {
+      return d(victim).queue.try_take_tail();
+    });
   }
 
   template <class Coordinator>
@@ -88,11 +150,13 @@ public:
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     d(self).queue.append(job);
+    wake_idle_worker(self->parent());
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
     d(self).queue.prepend(job);
+    wake_idle_worker(self->parent());
   }
 
   template <class Worker>
@@ -102,8 +166,112 @@ public:
     d(self).queue.unsafe_append(job);
   }
 
+  // Moves all queued jobs of a stalled worker to the other workers.
+  template <class Coordinator, class Worker>
+  void redistribute(Coordinator* self, Worker* stalled) {
+    move_jobs(self, stalled,
+              [stalled] { return d(stalled).queue.try_take_head(); });
+  }
+
+  // Distributes all jobs from `take` to the workers other than `stalled` in
+  // round-robin order.
+  template <class Coordinator, class Worker, class Take>
+  static void move_jobs(Coordinator* self, Worker* stalled, Take take) {
+    auto num_workers = self->num_workers();
+    if (num_workers < 2)
+      return;
+    auto& next_worker = d(self).next_worker;
+    for (auto* job = take(); job != nullptr; job = take()) {
+      auto target = self->worker_by_id(next_worker++ % num_workers);
+      if (target == stalled)
+        target = self->worker_by_id(next_worker++ % num_workers);
+      target->external_enqueue(job);
+    }
+  }
+
   template <class Worker>
   resumable* dequeue(Worker* self) {
+    if (d(self->parent()).park_idle_workers)
+      return dequeue_or_park(self);
+    return dequeue_or_poll(self);
+  }
+
+  // Wakes up a parked worker unless another worker is already looking for
+  // jobs, because that worker is going to find the new job anyway.
+  template <class Coordinator>
+  static void wake_idle_worker(Coordinator* self) {
+    auto& data = d(self);
+    if (!data.park_idle_workers)
+      return;
+    // Pairs with the read-modify-write operations on `spinning_workers` by the
+    // workers: either we see the spinning worker or it sees the new job.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (data.spinning_workers.load(std::memory_order_relaxed) == 0)
+      data.idle_workers.notify_one();
+  }
+
+  // Tries to steal a job from all other workers in turn.
+  template <class Worker>
+  resumable* steal_from_any(Worker* self) {
+    auto p = self->parent();
+    auto num_workers = p->num_workers();
+    for (size_t offset = 1; offset < num_workers; ++offset) {
+      auto victim = p->worker_by_id((self->id() + offset) % num_workers);
+      if (auto* job = d(victim).queue.try_take_tail())
+        return job;
+    }
+    return nullptr;
+  }
+
+  // Spins for a short while and then parks the worker until another thread
+  // enqueues a new job.
+  template <class Worker>
+  resumable* dequeue_or_park(Worker* self) {
+    auto& data = d(self);
+    auto& parent_data = d(self->parent());
+    auto& aggressive = data.strategies[0];
+    auto& relaxed = data.strategies[2];
+    for (;;) {
+      if (auto* job = data.queue.try_take_head())
+        return job;
+      // Look for jobs from other workers for a short while before parking.
+      parent_data.spinning_workers.fetch_add(1, std::memory_order_seq_cst);
+      for (size_t i = 0; i < aggressive.attempts; ++i) {
+        auto* job = (i % aggressive.steal_interval) == 0 ? try_steal(self)
+                                                         : nullptr;
+        if (job == nullptr)
+          job = data.queue.try_take_head();
+        if (job != nullptr) {
+          // If we were the last spinning worker, another worker needs to take
+          // over since there may be more jobs waiting.
+          if (parent_data.spinning_workers.fetch_sub(1,
+                                                     std::memory_order_seq_cst)
+              == 1)
+            wake_idle_worker(self->parent());
+          return job;
+        }
+      }
+      parent_data.spinning_workers.fetch_sub(1, std::memory_order_seq_cst);
+      // Announce that we are going to park and then check all queues one last
+      // time. Any job enqueued after this point causes a notification.
+      auto key = parent_data.idle_workers.prepare_wait();
+      auto* job = data.queue.try_take_head();
+      if (job == nullptr)
+        job = steal_from_any(self);
+      if (job != nullptr) {
+        parent_data.idle_workers.cancel_wait();
+        return job;
+      }
+      // The timeout only serves as a safety net that bounds how long a worker
+      // sleeps without checking the queues again.
+      parent_data.idle_workers.wait_for(key, relaxed.sleep_duration);
+    }
+  }
+
+  // Polls the worker's queue with increasing sleep durations between steal
+  // attempts.
+  template <class Worker>
+  resumable* dequeue_or_poll(Worker* self) {
     // we wait for new jobs by polling our external queue: first, we
     // assume an active work load on the machine and perform aggressive
     // polling, then we relax our polling a bit and wait 50 us between
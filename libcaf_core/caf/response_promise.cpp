@@ -104,7 +104,7 @@ void response_promise::deliver(message msg) {
 void response_promise::deliver(error x) {
   CAF_LOG_TRACE(CAF_ARG(x));
   if (pending()) {
-    state_->deliver_impl(make_message(std::move(x)));
+    state_->deliver_impl(detail::make_message_impl<true>(std::move(x)));
     state_.reset();
   }
 }
@@ -140,7 +140,7 @@ void response_promise::respond_to(local_actor* self, mailbox_element* request,
     tmp.source.swap(request->sender);
     tmp.stages.swap(request->stages);
     tmp.id = request->mid;
-    tmp.deliver_impl(make_message(std::move(response)));
+    tmp.deliver_impl(detail::make_message_impl<true>(std::move(response)));
     request->mid.mark_as_answered();
   }
 }
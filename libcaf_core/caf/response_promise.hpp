@@ -105,7 +105,11 @@ public:
     static_assert(!detail::tl_exists<arg_types, detail::is_expected>::value,
                   "mixing expected<T> with regular values is not supported");
     if (pending()) {
-      state_->deliver_impl(make_message(std::move(xs)...));
+      if constexpr (sizeof...(Ts) == 0)
+        state_->deliver_impl(make_message());
+      else
+        state_->deliver_impl(
+          detail::make_message_impl<true>(std::move(xs)...));
       state_.reset();
     }
   }
@@ -120,9 +124,10 @@ public:
         if constexpr (std::is_same_v<T, void> || std::is_same_v<T, unit_t>)
           state_->deliver_impl(make_message());
         else
-          state_->deliver_impl(make_message(std::move(*x)));
+          state_->deliver_impl(detail::make_message_impl<true>(std::move(*x)));
       } else {
-        state_->deliver_impl(make_message(std::move(x.error())));
+        state_->deliver_impl(
+          detail::make_message_impl<true>(std::move(x.error())));
       }
       state_.reset();
     }
@@ -152,7 +157,8 @@ public:
                               std::forward<Ts>(xs)...);
       else
         state_->delegate_impl(actor_cast<abstract_actor*>(dest),
-                              make_message(std::forward<Ts>(xs)...));
+                              detail::make_message_impl<true>(
+                                std::forward<Ts>(xs)...));
       state_.reset();
     }
     return {};
@@ -130,7 +130,10 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
     exception_handler_(default_exception_handler)
 #endif // CAF_ENABLE_EXCEPTIONS
 {
-  // nop
+  // Detached actors run in their own thread and never need to yield.
+  if (!getf(is_detached_flag))
+    quota_ = detail::throughput_quota{
+      home_system().scheduler().max_resume_time()};
 }
 
 scheduled_actor::~scheduled_actor() {
@@ -277,20 +280,38 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
   if (!activate(ctx))
     return resumable::done;
   size_t consumed = 0;
+  // Stay within the time budget by consuming at most `quota` messages.
+  auto quota = quota_.get(max_throughput);
+  auto measure = quota_.enabled() || metrics_.resume_time != nullptr;
+  resume_start_ = measure ? clock_type::now() : clock_type::time_point{};
   auto reset_timeouts_if_needed = [&] {
     // Set a new receive timeout if we called our behavior at least once.
     if (consumed > 0)
       set_receive_timeout();
   };
+  auto update_quota = [&](bool backlog) {
+    if (!measure)
+      return;
+    auto elapsed = clock_type::now() - resume_start_;
+    quota_.update(consumed, elapsed, backlog);
+    if (metrics_.resume_time != nullptr) {
+      using fractional_seconds = std::chrono::duration<double>;
+      auto secs = std::chrono::duration_cast<fractional_seconds>(elapsed);
+      metrics_.resume_time->observe(secs.count());
+      if (quota_.enabled())
+        metrics_.throughput_quota->value(
+          static_cast<int64_t>(quota_.get(max_throughput)));
+    }
+  };
   // Callback for handling urgent and normal messages.
-  auto handle_async = [this, max_throughput, &consumed](mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &x] {
+  auto handle_async = [this, quota, &consumed](mailbox_element& x) {
+    return run_with_metrics(x, [this, quota, &consumed, &x] {
       switch (reactivate(x)) {
         case activation_result::terminated:
           return intrusive::task_result::stop;
         case activation_result::success:
-          return ++consumed < max_throughput ? intrusive::task_result::resume
-                                             : intrusive::task_result::stop_all;
+          return ++consumed < quota ? intrusive::task_result::resume
+                                    : intrusive::task_result::stop_all;
         case activation_result::skipped:
           return intrusive::task_result::skip;
         default:
@@ -299,7 +320,7 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     });
   };
   mailbox_element_ptr ptr;
-  while (consumed < max_throughput) {
+  while (consumed < quota) {
     CAF_LOG_DEBUG("start new DRR round");
     mailbox_.fetch_more();
     auto prev = consumed; // Caches the value before processing more.
@@ -324,22 +345,38 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
       home_system().base_metrics().processed_messages->inc(signed_val);
     } else {
       reset_timeouts_if_needed();
-      if (mailbox().try_block())
+      if (mailbox().try_block()) {
+        update_quota(false);
         return resumable::awaiting_message;
+      }
       CAF_LOG_DEBUG("mailbox().try_block() returned false");
     }
     CAF_LOG_DEBUG("check for shutdown");
     if (finalize())
       return resumable::done;
+    if (should_yield()) {
+      CAF_LOG_DEBUG("time budget exhausted or yield requested");
+      break;
+    }
   }
   CAF_LOG_DEBUG("max throughput reached");
   reset_timeouts_if_needed();
-  if (mailbox().try_block())
+  if (mailbox().try_block()) {
+    update_quota(false);
     return resumable::awaiting_message;
+  }
   // time's up
+  update_quota(true);
   return resumable::resume_later;
 }
 
+bool scheduled_actor::should_yield() const noexcept {
+  if (context_ != nullptr && context_->yield_requested())
+    return true;
+  return quota_.enabled()
+         && clock_type::now() - resume_start_ >= quota_.budget();
+}
+
 // -- scheduler callbacks ------------------------------------------------------
 
 proxy_registry* scheduled_actor::proxy_registry_ptr() {
@@ -17,6 +17,7 @@
 #include "caf/detail/behavior_stack.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/stream_bridge.hpp"
+#include "caf/detail/throughput_quota.hpp"
 #include "caf/disposable.hpp"
 #include "caf/error.hpp"
 #include "caf/extend.hpp"
@@ -273,6 +274,16 @@ public:
     return mailbox_;
   }
 
+  /// Returns whether the actor should return from its current message handler
+  /// as soon as possible to let other actors run. Message handlers that run
+  /// for a long time can poll this function to split their work into smaller
+  /// chunks, e.g., by sending a message to themselves for continuing later.
+  /// Returns `true` if the actor has used up its time budget (see
+  /// `caf.scheduler.max-resume-time`) or if the watchdog of the scheduler
+  /// detected that the actor blocks its worker thread (see
+  /// `caf.scheduler.watchdog-threshold`).
+  bool should_yield() const noexcept;
+
   // -- event handlers ---------------------------------------------------------
 
   /// Sets a custom handler for unexpected messages.
@@ -826,6 +837,13 @@ private:
   /// message.
   std::vector<action> actions_;
 
+  /// Limits how many messages the actor consumes per resume.
+  detail::throughput_quota quota_;
+
+  /// Stores when the current resume started if the actor has a time budget
+  /// or collects metrics.
+  clock_type::time_point resume_start_;
+
   /// Counter for scheduled_actor::delay to make sure
   /// scheduled_actor::run_actions does not end up in a busy loop that might
   /// starve other activities.
@@ -183,8 +183,16 @@ void abstract_coordinator::init(actor_system_config& cfg) {
   namespace sr = defaults::scheduler;
   max_throughput_ = get_or(cfg, "caf.scheduler.max-throughput",
                            sr::max_throughput);
+  max_resume_time_ = get_or(cfg, "caf.scheduler.max-resume-time",
+                            sr::max_resume_time);
+  watchdog_threshold_ = get_or(cfg, "caf.scheduler.watchdog-threshold",
+                               sr::watchdog_threshold);
+  if (watchdog_threshold_.count() <= 0)
+    watchdog_threshold_ = infinite;
   num_workers_ = get_or(cfg, "caf.scheduler.max-threads",
                         default_thread_count());
+  use_slab_allocator_ = get_or(cfg, "caf.scheduler.use-slab-allocator",
+                               sr::use_slab_allocator);
 }
 
 actor_system::module::id_t abstract_coordinator::id() const {
@@ -204,7 +212,13 @@ void abstract_coordinator::stop_actors() {
 }
 
 abstract_coordinator::abstract_coordinator(actor_system& sys)
-  : next_worker_(0), max_throughput_(0), num_workers_(0), system_(sys) {
+  : next_worker_(0),
+    max_throughput_(0),
+    max_resume_time_(infinite),
+    watchdog_threshold_(infinite),
+    num_workers_(0),
+    use_slab_allocator_(false),
+    system_(sys) {
   // nop
 }
 
@@ -12,6 +12,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/message.hpp"
+#include "caf/timespan.hpp"
 
 #include <atomic>
 #include <chrono>
@@ -52,10 +53,30 @@ public:
     return max_throughput_;
   }
 
+  /// Returns the time budget for a single resume of an actor.
+  timespan max_resume_time() const noexcept {
+    return max_resume_time_;
+  }
+
+  /// Returns after how long a single job on a worker counts as stalled.
+  timespan watchdog_threshold() const noexcept {
+    return watchdog_threshold_;
+  }
+
+  /// Returns whether the scheduler monitors its workers for stalled jobs.
+  bool watchdog_enabled() const noexcept {
+    return !is_infinite(watchdog_threshold_);
+  }
+
   size_t num_workers() const {
     return num_workers_;
   }
 
+  /// Returns whether workers allocate from thread-local slab caches.
+  bool use_slab_allocator() const noexcept {
+    return use_slab_allocator_;
+  }
+
   /// Returns `true` if this scheduler detaches its utility actors.
   virtual bool detaches_utility_actors() const;
 
@@ -82,9 +103,18 @@ protected:
   /// Number of messages each actor is allowed to consume per resume.
   size_t max_throughput_;
 
+  /// Time budget for adapting the throughput of each actor.
+  timespan max_resume_time_;
+
+  /// Time after which the watchdog considers a worker as stalled.
+  timespan watchdog_threshold_;
+
   /// Configured number of workers.
   size_t num_workers_;
 
+  /// Configures whether workers allocate from thread-local slab caches.
+  bool use_slab_allocator_;
+
   /// Background workers, e.g., printer.
   std::array<actor, max_id> utility_actors_;
 
@@ -10,9 +10,12 @@
 #include "caf/scheduler/abstract_coordinator.hpp"
 #include "caf/scheduler/worker.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 namespace caf::scheduler {
@@ -57,12 +60,26 @@ protected:
     // Start all workers.
     for (auto& w : workers_)
       w->start();
+    // Start the watchdog if configured.
+    if (watchdog_enabled())
+      watchdog_ = system().launch_thread("caf.watchdog",
+                                         thread_owner::scheduler,
+                                         [this] { run_watchdog(); });
     // Run remaining startup code.
     clock_.start_dispatch_loop(system());
     super::start();
   }
 
   void stop() override {
+    // Stop the watchdog before shutting down the workers.
+    if (watchdog_.joinable()) {
+      {
+        std::unique_lock<std::mutex> guard{watchdog_mtx_};
+        watchdog_stopped_ = true;
+      }
+      watchdog_cv_.notify_all();
+      watchdog_.join();
+    }
     // Shutdown workers.
     class shutdown_helper : public resumable, public ref_counted {
     public:
@@ -130,6 +147,27 @@ protected:
   }
 
 private:
+  /// Periodically checks whether a worker runs a single job for longer than
+  /// the configured threshold. On a stalled worker, the watchdog asks the job
+  /// to yield and lets the policy move queued jobs to other workers.
+  void run_watchdog() {
+    using clock_type = std::chrono::steady_clock;
+    auto threshold = watchdog_threshold();
+    auto interval = std::max(threshold / 2, timespan{100'000});
+    std::unique_lock<std::mutex> guard{watchdog_mtx_};
+    while (!watchdog_cv_.wait_for(guard, interval,
+                                  [this] { return watchdog_stopped_; })) {
+      auto now = clock_type::now();
+      for (auto& w : workers_) {
+        auto since = w->running_since();
+        if (since != clock_type::time_point{} && now - since >= threshold) {
+          w->request_yield(since);
+          policy_.redistribute(this, w.get());
+        }
+      }
+    }
+  }
+
   /// System-wide clock.
   detail::thread_safe_actor_clock clock_;
 
@@ -144,6 +182,18 @@ private:
 
   /// Thread for managing timeouts and delayed messages.
   std::thread timer_;
+
+  /// Thread for detecting stalled workers.
+  std::thread watchdog_;
+
+  /// Guards `watchdog_stopped_`.
+  std::mutex watchdog_mtx_;
+
+  /// Wakes up the watchdog on shutdown.
+  std::condition_variable watchdog_cv_;
+
+  /// Signals the watchdog to stop.
+  bool watchdog_stopped_ = false;
 };
 
 } // namespace caf::scheduler
@@ -6,11 +6,15 @@
 
 #include "caf/detail/double_ended_queue.hpp"
 #include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/slab_allocator.hpp"
 #include "caf/execution_unit.hpp"
 #include "caf/logger.hpp"
 #include "caf/resumable.hpp"
 #include "caf/thread_owner.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 
 namespace caf::scheduler {
@@ -25,6 +29,7 @@ public:
   using job_ptr = resumable*;
   using coordinator_ptr = coordinator<Policy>*;
   using policy_data = typename Policy::worker_data;
+  using clock_type = std::chrono::steady_clock;
 
   worker(size_t worker_id, coordinator_ptr worker_parent,
          const policy_data& init, size_t throughput)
@@ -86,16 +91,52 @@ public:
     return max_throughput_;
   }
 
+  /// Returns when the worker started to run its current job or a
+  /// default-constructed time point if the worker is idle. Always returns a
+  /// default-constructed time point if the scheduler runs no watchdog.
+  clock_type::time_point running_since() const noexcept {
+    auto ticks = running_since_.load(std::memory_order_relaxed);
+    return clock_type::time_point{clock_type::duration{ticks}};
+  }
+
+  /// Asks the worker to run other jobs after the job that started running at
+  /// `job_start`. Has no effect if the worker already runs another job. Safe
+  /// to call from any thread.
+  void request_yield(clock_type::time_point job_start) noexcept {
+    auto ticks = job_start.time_since_epoch().count();
+    yield_request_.store(ticks, std::memory_order_relaxed);
+  }
+
+  bool yield_requested() const noexcept override {
+    auto ticks = yield_request_.load(std::memory_order_relaxed);
+    return ticks != 0
+           && ticks == running_since_.load(std::memory_order_relaxed);
+  }
+
 private:
   void run() {
     CAF_SET_LOGGER_SYS(&system());
+    policy_.init_worker_thread(this);
+    if (parent_->use_slab_allocator())
+      detail::slab_allocator::attach_thread();
+    auto watchdog = parent_->watchdog_enabled();
+    auto last_start = clock_type::rep{0};
     // scheduling loop
     for (;;) {
       auto job = policy_.dequeue(this);
       CAF_ASSERT(job != nullptr);
       CAF_ASSERT(job->subtype() != resumable::io_actor);
       policy_.before_resume(this, job);
+      if (watchdog) {
+        // The start time also identifies the job in yield requests. Hence, no
+        // two jobs may start at the same tick.
+        auto now = clock_type::now().time_since_epoch().count();
+        last_start = std::max(now, last_start + 1);
+        running_since_.store(last_start, std::memory_order_relaxed);
+      }
       auto res = job->resume(this, max_throughput_);
+      if (watchdog)
+        running_since_.store(0, std::memory_order_relaxed);
       policy_.after_resume(this, job);
       switch (res) {
         case resumable::resume_later: {
@@ -116,6 +157,7 @@ private:
         case resumable::shutdown_execution_unit: {
           policy_.after_completion(this, job);
           policy_.before_shutdown(this);
+          detail::slab_allocator::detach_thread();
           return;
         }
       }
@@ -125,6 +167,10 @@ private:
   size_t max_throughput_;
   // the worker's thread
   std::thread this_thread_;
+  // start of the current job as reported to the watchdog or 0 if idle
+  std::atomic<clock_type::rep> running_since_{0};
+  // start of the job that the watchdog asked to yield or 0
+  std::atomic<clock_type::rep> yield_request_{0};
   // the worker's ID received from scheduler
   size_t id_;
   // pointer to central coordinator
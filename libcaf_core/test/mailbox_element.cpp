@@ -71,3 +71,64 @@ CAF_TEST(high_priority) {
                                  no_stages, 42);
   CHECK(m1->mid.category() == message_id::urgent_message_category);
 }
+
+CAF_TEST(small messages share a memory block with their mailbox element) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages, 1, 2,
+                                 3);
+  auto payload = m1->payload;
+  auto data = payload.cptr();
+  auto m1_end = reinterpret_cast<const std::byte*>(m1.get())
+                + detail::message_data::host_slot_size;
+  CHECK_EQ(static_cast<const void*>(m1_end), static_cast<const void*>(data));
+  MESSAGE("the memory in front of a message can host only one element");
+  auto m2 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 payload);
+  auto m2_end = reinterpret_cast<const std::byte*>(m2.get())
+                + detail::message_data::host_slot_size;
+  CHECK_NE(static_cast<const void*>(m2_end), static_cast<const void*>(data));
+  MESSAGE("the message outlives the element");
+  m1.reset();
+  m2.reset();
+  CHECK_EQ((fetch<int, int, int>(payload)), make_tuple(1, 2, 3));
+  MESSAGE("the element outlives the message");
+  auto m3 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 make_message(4, 5, 6));
+  CHECK_EQ((fetch<int, int, int>(*m3)), make_tuple(4, 5, 6));
+}
+
+CAF_TEST(only messages for the mailbox reserve memory for a mailbox element) {
+  auto payload = make_message(1, 2, 3);
+  auto data = payload.cptr();
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 payload);
+  auto m1_end = reinterpret_cast<const std::byte*>(m1.get())
+                + detail::message_data::host_slot_size;
+  CHECK_NE(static_cast<const void*>(m1_end), static_cast<const void*>(data));
+  CHECK_EQ((fetch<int, int, int>(*m1)), make_tuple(1, 2, 3));
+}
+
+CAF_TEST(responses reserve memory for a mailbox element) {
+  behavior bhvr{[](int x, int y) { return x + y; }};
+  auto request = make_message(1, 2);
+  auto response = bhvr(request);
+  if (CHECK(response)) {
+    auto data = response->cptr();
+    auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                   std::move(*response));
+    auto m1_end = reinterpret_cast<const std::byte*>(m1.get())
+                  + detail::message_data::host_slot_size;
+    CHECK_EQ(static_cast<const void*>(m1_end), static_cast<const void*>(data));
+    CHECK_EQ((fetch<int>(*m1)), make_tuple(3));
+  }
+}
+
+CAF_TEST(large messages use a separate memory block for the mailbox element) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 vector<int>{1, 2, 3}, string(100, 'x'),
+                                 string(100, 'y'), string(100, 'z'));
+  auto data = m1->payload.cptr();
+  auto m1_end = reinterpret_cast<const std::byte*>(m1.get())
+                + detail::message_data::host_slot_size;
+  CHECK_NE(static_cast<const void*>(m1_end), static_cast<const void*>(data));
+  CHECK_EQ(m1->content().size(), 4u);
+}
@@ -0,0 +1,78 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE should_yield
+
+#include "caf/scheduled_actor.hpp"
+
+#include "caf/all.hpp"
+
+#include "core-test.hpp"
+
+#include <chrono>
+#include <string>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct config : actor_system_config {
+  config(std::string policy, std::string_view key, timespan value) {
+    set("caf.logger.verbosity", "quiet");
+    set("caf.scheduler.policy", std::move(policy));
+    set("caf.scheduler.max-threads", 2);
+    if (!key.empty())
+      set(key, value);
+  }
+};
+
+// Replies `true` if `should_yield` returned `true` before `timeout` elapsed
+// and `false` otherwise.
+behavior busy_actor(event_based_actor* self, timespan timeout) {
+  return {
+    [self, timeout](get_atom) {
+      auto deadline = std::chrono::steady_clock::now() + timeout;
+      while (!self->should_yield())
+        if (std::chrono::steady_clock::now() >= deadline)
+          return false;
+      return true;
+    },
+  };
+}
+
+bool run(config& cfg, timespan timeout) {
+  actor_system sys{cfg};
+  auto worker = sys.spawn(busy_actor, timeout);
+  scoped_actor self{sys};
+  auto result = false;
+  self->request(worker, infinite, get_atom_v)
+    .receive([&result](bool value) { result = value; },
+             [](const error& err) { CAF_FAIL("request failed: " << err); });
+  self->send_exit(worker, exit_reason::user_shutdown);
+  return result;
+}
+
+} // namespace
+
+CAF_TEST(actors never yield without a time budget or watchdog) {
+  config cfg{"stealing", "", timespan{0}};
+  CHECK_EQ(run(cfg, 20ms), false);
+}
+
+CAF_TEST(actors yield after using up their time budget) {
+  for (auto policy : {"sharing", "stealing", "lock-free-stealing"}) {
+    MESSAGE("policy: " << policy);
+    config cfg{policy, "caf.scheduler.max-resume-time", 1ms};
+    CHECK_EQ(run(cfg, 10s), true);
+  }
+}
+
+CAF_TEST(the watchdog asks stalled actors to yield) {
+  for (auto policy : {"sharing", "stealing", "lock-free-stealing"}) {
+    MESSAGE("policy: " << policy);
+    config cfg{policy, "caf.scheduler.watchdog-threshold", 5ms};
+    CHECK_EQ(run(cfg, 10s), true);
+  }
+}
@@ -347,6 +347,10 @@ resumable::resume_result abstract_broker::resume(execution_unit* ctx,
   return scheduled_actor::resume(ctx, mt);
 }
 
+void abstract_broker::io_event_handled() {
+  // nop
+}
+
 const char* abstract_broker::name() const {
   return "user.broker";
 }
@@ -98,6 +98,12 @@ public:
 
   // -- modifiers --------------------------------------------------------------
 
+  /// Called by scribes, doormen, and datagram servants after the broker has
+  /// handled one of their events. Unlike messages from the mailbox, these
+  /// events never pass through `resume`. The default implementation does
+  /// nothing.
+  virtual void io_event_handled();
+
   /// Suspends activities on `hdl` unconditionally.
   template <class Handle>
   void halt(Handle hdl) {
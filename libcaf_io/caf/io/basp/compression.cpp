@@ -0,0 +1,68 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/io/basp/compression.hpp"
+
+#include <cstdint>
+#include <limits>
+
+#include <zlib.h>
+
+namespace caf::io::basp {
+
+namespace {
+
+constexpr size_t size_prefix_len = 4;
+
+// Upper bound for the compression ratio of deflate. We use this to reject
+// inputs that claim an absurd uncompressed size before allocating memory.
+constexpr size_t max_deflate_ratio = 1032;
+
+} // namespace
+
+bool compress_payload(const_byte_span input, byte_buffer& out) {
+  if (input.size() > std::numeric_limits<uint32_t>::max())
+    return false;
+  auto offset = out.size();
+  auto bound = compressBound(static_cast<uLong>(input.size()));
+  out.resize(offset + size_prefix_len + bound);
+  auto len = static_cast<uint32_t>(input.size());
+  auto prefix = out.data() + offset;
+  for (size_t i = 0; i < size_prefix_len; ++i)
+    prefix[i] = static_cast<std::byte>(len >> (24 - i * 8));
+  auto out_len = static_cast<uLongf>(bound);
+  auto rc = compress2(reinterpret_cast<Bytef*>(prefix + size_prefix_len),
+                      &out_len, reinterpret_cast<const Bytef*>(input.data()),
+                      static_cast<uLong>(input.size()), Z_BEST_SPEED);
+  if (rc != Z_OK) {
+    out.resize(offset);
+    return false;
+  }
+  out.resize(offset + size_prefix_len + out_len);
+  return true;
+}
+
+bool decompress_payload(const_byte_span input, byte_buffer& out) {
+  if (input.size() < size_prefix_len)
+    return false;
+  uint32_t len = 0;
+  for (size_t i = 0; i < size_prefix_len; ++i)
+    len = (len << 8) | static_cast<uint32_t>(input[i]);
+  auto compressed = input.subspan(size_prefix_len);
+  if (len > compressed.size() * max_deflate_ratio)
+    return false;
+  auto offset = out.size();
+  out.resize(offset + len);
+  auto out_len = static_cast<uLongf>(len);
+  auto rc = uncompress(reinterpret_cast<Bytef*>(out.data() + offset), &out_len,
+                       reinterpret_cast<const Bytef*>(compressed.data()),
+                       static_cast<uLong>(compressed.size()));
+  if (rc != Z_OK || out_len != len) {
+    out.resize(offset);
+    return false;
+  }
+  return true;
+}
+
+} // namespace caf::io::basp
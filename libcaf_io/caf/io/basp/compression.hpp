@@ -0,0 +1,33 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/detail/io_export.hpp"
+
+#include <string_view>
+
+namespace caf::io::basp {
+
+/// @addtogroup BASP
+/// @{
+
+/// Names the compression algorithm that BASP nodes may offer in their
+/// handshakes. Compressed payloads start with the size of the uncompressed
+/// payload as 32-bit integer in network byte order, followed by a zlib stream.
+constexpr std::string_view deflate_compression = "deflate";
+
+/// Compresses `input` and appends the result to `out`.
+/// @returns `true` on success, `false` otherwise.
+CAF_IO_EXPORT bool compress_payload(const_byte_span input, byte_buffer& out);
+
+/// Decompresses `input` and appends the result to `out`.
+/// @returns `true` on success, `false` if `input` is malformed.
+CAF_IO_EXPORT bool decompress_payload(const_byte_span input, byte_buffer& out);
+
+/// @}
+
+} // namespace caf::io::basp
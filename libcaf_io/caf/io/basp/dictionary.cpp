@@ -0,0 +1,361 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/io/basp/dictionary.hpp"
+
+#include "caf/detail/message_data.hpp"
+#include "caf/detail/meta_object.hpp"
+#include "caf/detail/type_id_list_builder.hpp"
+#include "caf/error_code.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/sec.hpp"
+
+#include <limits>
+
+namespace caf::io::basp {
+
+namespace {
+
+// -- varbyte encoding of references -------------------------------------------
+
+bool write_ref(binary_serializer& sink, uint32_t x) {
+  while (x > 0x7f) {
+    if (!sink.value(static_cast<uint8_t>((x & 0x7f) | 0x80)))
+      return false;
+    x >>= 7;
+  }
+  return sink.value(static_cast<uint8_t>(x));
+}
+
+bool read_ref(binary_deserializer& source, uint32_t& x) {
+  uint32_t result = 0;
+  int shift = 0;
+  uint8_t low7 = 0;
+  do {
+    if (shift > 28) {
+      source.emplace_error(sec::invalid_argument, "reference too large");
+      return false;
+    }
+    if (!source.value(low7))
+      return false;
+    result |= static_cast<uint32_t>(low7 & 0x7f) << shift;
+    shift += 7;
+  } while ((low7 & 0x80) != 0);
+  x = result;
+  return true;
+}
+
+// -- full encoding of dictionary values ---------------------------------------
+
+bool write_type_id_list(binary_serializer& sink, type_id_list types) {
+  if (!sink.begin_sequence(types.size()))
+    return false;
+  for (auto id : types)
+    if (!sink.value(id))
+      return false;
+  return sink.end_sequence();
+}
+
+bool read_type_id_list(binary_deserializer& source, type_id_list& types) {
+  size_t size = 0;
+  if (!source.begin_sequence(size))
+    return false;
+  using uint16_limits = std::numeric_limits<uint16_t>;
+  if (size > static_cast<size_t>(uint16_limits::max() - 1)) {
+    source.emplace_error(sec::invalid_argument, "too many types for message");
+    return false;
+  }
+  detail::type_id_list_builder ids;
+  ids.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    type_id_t id = 0;
+    if (!source.value(id))
+      return false;
+    ids.push_back(id);
+  }
+  types = ids.move_to_list();
+  return source.end_sequence();
+}
+
+bool load_values(binary_deserializer& source, type_id_list types,
+                 message& msg) {
+  if (types.empty()) {
+    msg = message{};
+    return true;
+  }
+  size_t data_size = 0;
+  for (auto id : types) {
+    if (auto meta = detail::global_meta_object_or_null(id)) {
+      data_size += meta->padded_size;
+    } else {
+      source.emplace_error(sec::unknown_type);
+      return false;
+    }
+  }
+  intrusive_ptr<detail::message_data> ptr;
+  if (auto raw_ptr = detail::message_data::try_make(types, data_size)) {
+    ptr.reset(raw_ptr, false);
+  } else {
+    source.emplace_error(sec::runtime_error, "unable to allocate memory");
+    return false;
+  }
+  auto gmos = detail::global_meta_objects();
+  auto pos = ptr->storage();
+  for (auto id : types) {
+    auto& meta = gmos[id];
+    meta.default_construct(pos);
+    ptr->inc_constructed_elements();
+    if (!meta.load_binary(source, pos))
+      return false;
+    pos += meta.padded_size;
+  }
+  msg = message{message::data_ptr{ptr.release(), false}};
+  return true;
+}
+
+bool write_table(binary_serializer& sink, dictionary_table table) {
+  return sink.value(static_cast<uint8_t>(table));
+}
+
+} // namespace
+
+// -- send_dictionary ----------------------------------------------------------
+
+uint32_t send_dictionary::find(type_id_list types) const noexcept {
+  auto i = type_ids_.find(types.data());
+  return i != type_ids_.end() ? i->second : 0;
+}
+
+uint32_t send_dictionary::find(const node_id& nid) const noexcept {
+  auto i = nodes_.find(nid);
+  return i != nodes_.end() ? i->second : 0;
+}
+
+uint32_t send_dictionary::find(const strong_actor_ptr& ptr) const noexcept {
+  if (ptr == nullptr)
+    return 0;
+  auto i = actors_.find(std::make_pair(ptr->node(), ptr->id()));
+  return i != actors_.end() ? i->second : 0;
+}
+
+bool send_dictionary::add(binary_serializer& sink, type_id_list types) {
+  if (find(types) != 0 || type_ids_.size() >= max_dictionary_size)
+    return true;
+  if (!write_table(sink, dictionary_table::type_ids)
+      || !write_type_id_list(sink, types))
+    return false;
+  auto ref = static_cast<uint32_t>(type_ids_.size() + 1);
+  type_ids_.emplace(types.data(), ref);
+  return true;
+}
+
+bool send_dictionary::add(binary_serializer& sink, const node_id& nid) {
+  if (find(nid) != 0 || nodes_.size() >= max_dictionary_size)
+    return true;
+  auto tmp = nid;
+  if (!write_table(sink, dictionary_table::nodes) || !sink.apply(tmp))
+    return false;
+  auto ref = static_cast<uint32_t>(nodes_.size() + 1);
+  nodes_.emplace(nid, ref);
+  return true;
+}
+
+bool send_dictionary::add(binary_serializer& sink,
+                          const strong_actor_ptr& ptr) {
+  if (ptr == nullptr || find(ptr) != 0
+      || actors_.size() >= max_dictionary_size)
+    return true;
+  auto nid = ptr->node();
+  auto aid = ptr->id();
+  if (!write_table(sink, dictionary_table::actors) || !sink.apply(nid)
+      || !sink.apply(aid))
+    return false;
+  auto ref = static_cast<uint32_t>(actors_.size() + 1);
+  actors_.emplace(std::make_pair(std::move(nid), aid), ref);
+  return true;
+}
+
+// -- receive_dictionary -------------------------------------------------------
+
+bool receive_dictionary::apply_update(binary_deserializer& source) {
+  while (source.remaining() > 0) {
+    uint8_t table = 0;
+    if (!source.value(table))
+      return false;
+    switch (static_cast<dictionary_table>(table)) {
+      case dictionary_table::type_ids: {
+        auto types = make_type_id_list();
+        if (!read_type_id_list(source, types))
+          return false;
+        if (type_ids_.size() < max_dictionary_size)
+          type_ids_.emplace_back(types);
+        break;
+      }
+      case dictionary_table::nodes: {
+        node_id nid;
+        if (!source.apply(nid))
+          return false;
+        if (nodes_.size() < max_dictionary_size)
+          nodes_.emplace_back(std::move(nid));
+        break;
+      }
+      case dictionary_table::actors: {
+        node_id nid;
+        actor_id aid = 0;
+        if (!source.apply(nid) || !source.apply(aid))
+          return false;
+        if (actors_.size() < max_dictionary_size)
+          actors_.emplace_back(std::move(nid), aid);
+        break;
+      }
+      default:
+        source.emplace_error(sec::invalid_argument,
+                             "unknown dictionary table");
+        return false;
+    }
+  }
+  return true;
+}
+
+type_id_list receive_dictionary::type_ids(uint32_t ref) const noexcept {
+  CAF_ASSERT(ref != 0);
+  if (ref > type_ids_.size())
+    return type_id_list{nullptr};
+  return type_ids_[ref - 1];
+}
+
+const node_id* receive_dictionary::node(uint32_t ref) const noexcept {
+  CAF_ASSERT(ref != 0);
+  if (ref > nodes_.size())
+    return nullptr;
+  return &nodes_[ref - 1];
+}
+
+const std::pair<node_id, actor_id>*
+receive_dictionary::actor(uint32_t ref) const noexcept {
+  CAF_ASSERT(ref != 0);
+  if (ref > actors_.size())
+    return nullptr;
+  return &actors_[ref - 1];
+}
+
+// -- free functions -----------------------------------------------------------
+
+bool write_node(binary_serializer& sink, const send_dictionary& dict,
+                const node_id& nid) {
+  auto ref = dict.find(nid);
+  if (!write_ref(sink, ref))
+    return false;
+  if (ref != 0)
+    return true;
+  auto tmp = nid;
+  return sink.apply(tmp);
+}
+
+bool read_node(binary_deserializer& source, const receive_dictionary& dict,
+               node_id& nid) {
+  uint32_t ref = 0;
+  if (!read_ref(source, ref))
+    return false;
+  if (ref == 0)
+    return source.apply(nid);
+  if (auto ptr = dict.node(ref)) {
+    nid = *ptr;
+    return true;
+  }
+  source.emplace_error(sec::invalid_argument, "unknown node reference");
+  return false;
+}
+
+bool write_stages(binary_serializer& sink, const send_dictionary& dict,
+                  const std::vector<strong_actor_ptr>& stages) {
+  if (!sink.begin_sequence(stages.size()))
+    return false;
+  for (auto stage : stages) {
+    auto ref = dict.find(stage);
+    if (!write_ref(sink, ref))
+      return false;
+    if (ref == 0) {
+      if (!sink.apply(stage))
+        return false;
+    } else if (auto err = save_actor(stage, sink.context(), stage->id(),
+                                     stage->node())) {
+      sink.emplace_error(err.value());
+      return false;
+    }
+  }
+  return sink.end_sequence();
+}
+
+bool read_stages(binary_deserializer& source, const receive_dictionary& dict,
+                 std::vector<strong_actor_ptr>& stages) {
+  size_t size = 0;
+  if (!source.begin_sequence(size))
+    return false;
+  stages.clear();
+  stages.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    uint32_t ref = 0;
+    if (!read_ref(source, ref))
+      return false;
+    auto& stage = stages.emplace_back();
+    if (ref == 0) {
+      if (!source.apply(stage))
+        return false;
+    } else if (auto addr = dict.actor(ref)) {
+      if (auto err = load_actor(stage, source.context(), addr->second,
+                                addr->first)) {
+        source.emplace_error(err.value());
+        return false;
+      }
+    } else {
+      source.emplace_error(sec::invalid_argument, "unknown actor reference");
+      return false;
+    }
+  }
+  return source.end_sequence();
+}
+
+bool write_type_ids(binary_serializer& sink, const send_dictionary& dict,
+                    type_id_list types) {
+  auto ref = dict.find(types);
+  if (!write_ref(sink, ref))
+    return false;
+  return ref != 0 || write_type_id_list(sink, types);
+}
+
+bool write_values(binary_serializer& sink, const message& msg) {
+  if (msg.empty())
+    return true;
+  auto gmos = detail::global_meta_objects();
+  auto storage = msg.cdata().storage();
+  for (auto id : msg.types()) {
+    auto& meta = gmos[id];
+    if (!meta.save_binary(sink, storage))
+      return false;
+    storage += meta.padded_size;
+  }
+  return true;
+}
+
+bool read_message(binary_deserializer& source, const receive_dictionary& dict,
+                  message& msg) {
+  uint32_t ref = 0;
+  if (!read_ref(source, ref))
+    return false;
+  auto types = make_type_id_list();
+  if (ref == 0) {
+    if (!read_type_id_list(source, types))
+      return false;
+  } else {
+    types = dict.type_ids(ref);
+    if (!types) {
+      source.emplace_error(sec::invalid_argument, "unknown type reference");
+      return false;
+    }
+  }
+  return load_values(source, types, msg);
+}
+
+} // namespace caf::io::basp
@@ -0,0 +1,141 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/actor_control_block.hpp"
+#include "caf/binary_deserializer.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/detail/io_export.hpp"
+#include "caf/message.hpp"
+#include "caf/node_id.hpp"
+#include "caf/type_id_list.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace caf::io::basp {
+
+/// @addtogroup BASP
+/// @{
+
+/// Names the handshake extension for connection-scoped dictionaries.
+constexpr std::string_view dictionary_extension = "dictionary";
+
+/// Limits the number of entries per dictionary table. Values that no longer
+/// fit into a table go over the wire in full.
+constexpr size_t max_dictionary_size = 4096;
+
+/// Identifies a table of a connection-scoped dictionary.
+enum class dictionary_table : uint8_t {
+  /// Stores the type ID lists of messages.
+  type_ids,
+  /// Stores node IDs.
+  nodes,
+  /// Stores actor addresses, i.e., pairs of node ID and actor ID.
+  actors,
+};
+
+/// Assigns indexes to frequently sent values on the sending side of a
+/// connection. On the wire, a value becomes a varbyte-encoded reference that is
+/// either 0, followed by the value in full, or the index of the value plus 1.
+class CAF_IO_EXPORT send_dictionary {
+public:
+  /// Returns the reference for `types` or 0 if the dictionary has no entry.
+  uint32_t find(type_id_list types) const noexcept;
+
+  /// Returns the reference for `nid` or 0 if the dictionary has no entry.
+  uint32_t find(const node_id& nid) const noexcept;
+
+  /// Returns the reference for `ptr` or 0 if the dictionary has no entry.
+  uint32_t find(const strong_actor_ptr& ptr) const noexcept;
+
+  /// Adds `types` to the dictionary unless it already has an entry for it or
+  /// its table is full. Writes new entries to `sink`, which must point to the
+  /// payload of a `dictionary_update` message.
+  bool add(binary_serializer& sink, type_id_list types);
+
+  /// @copydoc add
+  bool add(binary_serializer& sink, const node_id& nid);
+
+  /// @copydoc add
+  bool add(binary_serializer& sink, const strong_actor_ptr& ptr);
+
+private:
+  // Type ID lists are interned, so we can use their address as key.
+  std::unordered_map<const type_id_t*, uint32_t> type_ids_;
+  std::unordered_map<node_id, uint32_t> nodes_;
+  std::map<std::pair<node_id, actor_id>, uint32_t> actors_;
+};
+
+/// Resolves references on the receiving side of a connection. The BASP
+/// instance shares the dictionary with its workers and copies it before
+/// applying an update while workers may still read from it.
+class CAF_IO_EXPORT receive_dictionary {
+public:
+  /// Reads all entries from the payload of a `dictionary_update` message.
+  bool apply_update(binary_deserializer& source);
+
+  /// Returns the type ID list for `ref` or an invalid list if `ref` is unknown.
+  /// @pre `ref != 0`
+  type_id_list type_ids(uint32_t ref) const noexcept;
+
+  /// Returns the node ID for `ref` or `nullptr` if `ref` is unknown.
+  /// @pre `ref != 0`
+  const node_id* node(uint32_t ref) const noexcept;
+
+  /// Returns the actor address for `ref` or `nullptr` if `ref` is unknown.
+  /// @pre `ref != 0`
+  const std::pair<node_id, actor_id>* actor(uint32_t ref) const noexcept;
+
+private:
+  std::vector<type_id_list> type_ids_;
+  std::vector<node_id> nodes_;
+  std::vector<std::pair<node_id, actor_id>> actors_;
+};
+
+/// A shared, immutable snapshot of a receive dictionary.
+using receive_dictionary_ptr = std::shared_ptr<const receive_dictionary>;
+
+/// Writes a reference to `nid` or the full node ID if `dict` has no entry.
+CAF_IO_EXPORT bool write_node(binary_serializer& sink,
+                              const send_dictionary& dict, const node_id& nid);
+
+/// Reads a node ID that `write_node` has written.
+CAF_IO_EXPORT bool read_node(binary_deserializer& source,
+                             const receive_dictionary& dict, node_id& nid);
+
+/// Writes the forwarding stack `stages`, replacing actor addresses with
+/// references into `dict` where possible.
+CAF_IO_EXPORT bool write_stages(binary_serializer& sink,
+                                const send_dictionary& dict,
+                                const std::vector<strong_actor_ptr>& stages);
+
+/// Reads a forwarding stack that `write_stages` has written.
+CAF_IO_EXPORT bool read_stages(binary_deserializer& source,
+                               const receive_dictionary& dict,
+                               std::vector<strong_actor_ptr>& stages);
+
+/// Writes a reference to the type ID list `types` or the full list if `dict`
+/// has no entry.
+CAF_IO_EXPORT bool write_type_ids(binary_serializer& sink,
+                                  const send_dictionary& dict,
+                                  type_id_list types);
+
+/// Writes the elements of `msg` without any type information.
+CAF_IO_EXPORT bool write_values(binary_serializer& sink, const message& msg);
+
+/// Reads a message that the sender has written by calling `write_type_ids`
+/// followed by `write_values`.
+CAF_IO_EXPORT bool read_message(binary_deserializer& source,
+                                const receive_dictionary& dict, message& msg);
+
+/// @}
+
+} // namespace caf::io::basp
@@ -10,6 +10,10 @@ namespace caf::io::basp {
 
 const uint8_t header::named_receiver_flag;
 
+const uint8_t header::compressed_flag;
+
+const uint8_t header::dictionary_flag;
+
 std::string to_bin(uint8_t x) {
   std::string res;
   for (auto offset = 7; offset > -1; --offset)
@@ -65,6 +69,15 @@ bool down_message_valid(const header& hdr) {
          && !zero(hdr.payload_len) && zero(hdr.operation_data);
 }
 
+bool multicast_message_valid(const header& hdr) {
+  return !zero(hdr.dest_actor) && !zero(hdr.payload_len);
+}
+
+bool dictionary_update_valid(const header& hdr) {
+  return zero(hdr.source_actor) && zero(hdr.dest_actor)
+         && !zero(hdr.payload_len) && zero(hdr.operation_data);
+}
+
 bool heartbeat_valid(const header& hdr) {
   return zero(hdr.source_actor) && zero(hdr.dest_actor) && zero(hdr.payload_len)
          && zero(hdr.operation_data);
@@ -90,6 +103,10 @@ bool valid(const header& hdr) {
       return down_message_valid(hdr);
     case message_type::heartbeat:
       return heartbeat_valid(hdr);
+    case message_type::multicast_message:
+      return multicast_message_valid(hdr);
+    case message_type::dictionary_update:
+      return dictionary_update_valid(hdr);
   }
 }
 
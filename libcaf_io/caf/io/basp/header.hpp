@@ -48,6 +48,16 @@ struct header {
   /// Identifies a receiver by name rather than ID.
   static const uint8_t named_receiver_flag = 0x01;
 
+  /// Marks a payload that the sender has compressed with the algorithm that
+  /// both nodes agreed on in their handshakes.
+  static const uint8_t compressed_flag = 0x02;
+
+  /// Marks a payload that refers to entries of the connection-scoped
+  /// dictionary. Direct and multicast messages encode their forwarding stack
+  /// and type IDs as references, routed messages encode source and destination
+  /// node as references.
+  static const uint8_t dictionary_flag = 0x04;
+
   /// Identifies the config server.
   static const uint64_t config_server_id = 1;
 
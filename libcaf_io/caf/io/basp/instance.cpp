@@ -4,6 +4,7 @@
 
 #include "caf/io/basp/instance.hpp"
 
+#include "caf/io/basp/compression.hpp"
 #include "caf/io/basp/remote_message_handler.hpp"
 #include "caf/io/basp/version.hpp"
 #include "caf/io/basp/worker.hpp"
@@ -20,6 +21,27 @@
 
 namespace caf::io::basp {
 
+namespace {
+
+bool add_entries(binary_serializer& sink, send_dictionary& dict,
+                 const std::vector<strong_actor_ptr>& stages,
+                 const message& msg) {
+  for (auto& stage : stages)
+    if (!dict.add(sink, stage))
+      return false;
+  return dict.add(sink, msg.types());
+}
+
+bool write_route(binary_serializer& sink, const send_dictionary* dict,
+                 const node_id& source_node, const node_id& dest_node) {
+  if (dict != nullptr)
+    return write_node(sink, *dict, source_node)
+           && write_node(sink, *dict, dest_node);
+  return sink.apply(source_node) && sink.apply(dest_node);
+}
+
+} // namespace
+
 instance::callee::callee(actor_system& sys, proxy_registry::backend& backend)
   : namespace_(sys, backend) {
   // nop
@@ -39,6 +61,18 @@ instance::instance(abstract_broker* parent, callee& lstnr)
     workers = std::min(3u, std::thread::hardware_concurrency() / 4u) + 1;
   for (size_t i = 0; i < workers; ++i)
     hub_.add_new_worker(queue_, proxies());
+  auto algorithm = get_or(config(), "caf.middleman.compression",
+                          defaults::middleman::compression);
+  if (algorithm == deflate_compression)
+    compression_ = true;
+  else if (algorithm != "none")
+    CAF_LOG_WARNING("unknown compression algorithm, disable compression:"
+                    << CAF_ARG(algorithm));
+  compression_threshold_ = get_or(config(),
+                                  "caf.middleman.compression-threshold",
+                                  defaults::middleman::compression_threshold);
+  dictionaries_ = get_or(config(), "caf.middleman.enable-dictionaries",
+                         defaults::middleman::enable_dictionaries);
 }
 
 connection_state instance::handle(execution_unit* ctx, new_data_msg& dm,
@@ -58,6 +92,10 @@ connection_state instance::handle(execution_unit* ctx, new_data_msg& dm,
                       << hdr.payload_len << "bytes, got" << payload->size());
       return err(malformed_message);
     }
+    if (hdr.has(header::compressed_flag) && !decompress(ctx, hdr, dm.buf)) {
+      CAF_LOG_WARNING("received malformed compressed payload");
+      return err(malformed_message);
+    }
   } else {
     binary_deserializer source{ctx, dm.buf};
     if (!source.apply(hdr)) {
@@ -171,10 +209,21 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
                mid.integer_value(),
                sender ? sender->id() : invalid_actor_id,
                dest_actor};
-    auto writer = make_callback([&](binary_serializer& sink) { //
-      return sink.apply(forwarding_stack) && sink.apply(msg);
+    auto dict = send_dict(path->hdl);
+    if (dict != nullptr) {
+      auto update = make_callback([&](binary_serializer& sink) {
+        return add_entries(sink, *dict, forwarding_stack, msg);
+      });
+      write_dictionary_update(ctx, path->hdl, update);
+      hdr.flags = static_cast<uint8_t>(hdr.flags | header::dictionary_flag);
+    }
+    auto writer = make_callback([&](binary_serializer& sink) {
+      if (dict != nullptr)
+        return write_stages(sink, *dict, forwarding_stack)
+               && write_message(sink, msg, dict);
+      return sink.apply(forwarding_stack) && write_message(sink, msg, nullptr);
     });
-    write(ctx, callee_.get_buffer(path->hdl), hdr, &writer);
+    write_compressed(ctx, path->hdl, hdr, &writer);
   } else {
     header hdr{message_type::routed_message,
                flags,
@@ -182,21 +231,121 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
                mid.integer_value(),
                sender ? sender->id() : invalid_actor_id,
                dest_actor};
+    // Only source and destination node may use the dictionary, because
+    // intermediate hops forward the remainder of the payload as-is.
+    auto dict = send_dict(path->hdl);
+    if (dict != nullptr) {
+      auto update = make_callback([&](binary_serializer& sink) {
+        return dict->add(sink, source_node) && dict->add(sink, dest_node);
+      });
+      write_dictionary_update(ctx, path->hdl, update);
+      hdr.flags = static_cast<uint8_t>(hdr.flags | header::dictionary_flag);
+    }
     auto writer = make_callback([&](binary_serializer& sink) {
       CAF_LOG_DEBUG("send routed message: "
                     << CAF_ARG(source_node) << CAF_ARG(dest_node)
                     << CAF_ARG(forwarding_stack) << CAF_ARG(msg));
-      return sink.apply(source_node)         //
-             && sink.apply(dest_node)        //
-             && sink.apply(forwarding_stack) //
-             && sink.apply(msg);
+      return write_route(sink, dict, source_node, dest_node) //
+             && sink.apply(forwarding_stack)                 //
+             && write_message(sink, msg, nullptr);
     });
-    write(ctx, callee_.get_buffer(path->hdl), hdr, &writer);
+    write_compressed(ctx, path->hdl, hdr, &writer);
   }
   flush(*path);
   return true;
 }
 
+bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
+                        const std::vector<strong_actor_ptr>& forwarding_stack,
+                        const node_id& dest_node,
+                        const std::vector<actor_id>& dest_actors,
+                        message_id mid, const message& msg) {
+  CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(dest_node) << CAF_ARG(dest_actors)
+                                << CAF_ARG(mid) << CAF_ARG(msg));
+  CAF_ASSERT(dest_node && this_node_ != dest_node);
+  auto path = lookup(dest_node);
+  if (!path)
+    return false;
+  auto& source_node = sender ? sender->node() : this_node_;
+  if (dest_actors.size() < 2 || dest_node != path->next_hop
+      || source_node != this_node_ || !mid.is_async()) {
+    auto result = true;
+    for (auto dest_actor : dest_actors)
+      result = dispatch(ctx, sender, forwarding_stack, dest_node, dest_actor, 0,
+                        mid, msg)
+               && result;
+    return result;
+  }
+  header hdr{message_type::multicast_message,
+             0,
+             0,
+             mid.integer_value(),
+             sender ? sender->id() : invalid_actor_id,
+             static_cast<uint64_t>(dest_actors.size())};
+  auto dict = send_dict(path->hdl);
+  if (dict != nullptr) {
+    auto update = make_callback([&](binary_serializer& sink) {
+      return add_entries(sink, *dict, forwarding_stack, msg);
+    });
+    write_dictionary_update(ctx, path->hdl, update);
+    hdr.flags = static_cast<uint8_t>(hdr.flags | header::dictionary_flag);
+  }
+  auto writer = make_callback([&](binary_serializer& sink) {
+    if (!sink.apply(dest_actors))
+      return false;
+    if (dict != nullptr)
+      return write_stages(sink, *dict, forwarding_stack)
+             && write_message(sink, msg, dict);
+    return sink.apply(forwarding_stack) && write_message(sink, msg, nullptr);
+  });
+  write_compressed(ctx, path->hdl, hdr, &writer);
+  flush(*path);
+  return true;
+}
+
+void instance::clear_payload_cache() {
+  cached_msg_.reset();
+  cached_bytes_.clear();
+}
+
+void instance::erase_connection_state(connection_handle hdl) {
+  connections_.erase(hdl);
+}
+
+bool instance::write_message(binary_serializer& sink, const message& msg,
+                             const send_dictionary* dict) {
+  // Without a dictionary, this produces the same output as `sink.apply(msg)`.
+  auto types = msg.types();
+  if (dict != nullptr) {
+    if (!write_type_ids(sink, *dict, types))
+      return false;
+  } else {
+    if (!sink.begin_sequence(types.size()))
+      return false;
+    for (auto id : types)
+      if (!sink.value(id))
+        return false;
+    if (!sink.end_sequence())
+      return false;
+  }
+  // The cache only stores the values, since the type information depends on
+  // the dictionary of the connection.
+  auto ptr = msg.cptr();
+  if (ptr != nullptr && ptr == cached_msg_.cptr())
+    return sink.value(make_span(cached_bytes_));
+  // Only messages that some other mailbox element shares may show up again.
+  if (ptr == nullptr || ptr->unique())
+    return write_values(sink, msg);
+  auto offset = sink.write_pos();
+  if (!write_values(sink, msg))
+    return false;
+  auto first = sink.buf().begin() + static_cast<ptrdiff_t>(offset);
+  auto last = sink.buf().begin() + static_cast<ptrdiff_t>(sink.write_pos());
+  cached_bytes_.assign(first, last);
+  cached_msg_ = msg;
+  return true;
+}
+
 void instance::write(execution_unit* ctx, byte_buffer& buf, header& hdr,
                      payload_writer* pw) {
   CAF_ASSERT(ctx != nullptr);
@@ -223,6 +372,135 @@ void instance::write(execution_unit* ctx, byte_buffer& buf, header& hdr,
     CAF_LOG_ERROR(sink.get_error());
 }
 
+void instance::write_compressed(execution_unit* ctx, connection_handle hdl,
+                                header& hdr, payload_writer* pw) {
+  auto& buf = callee_.get_buffer(hdl);
+  auto offset = buf.size();
+  write(ctx, buf, hdr, pw);
+  compress(ctx, hdl, buf, offset, hdr);
+}
+
+void instance::compress(execution_unit* ctx, connection_handle hdl,
+                        byte_buffer& buf, size_t offset, header& hdr) {
+  if (hdr.payload_len == 0 || hdr.payload_len < compression_threshold_
+      || !compresses(hdl))
+    return;
+  auto& mm_metrics = ctx->system().middleman().metric_singletons;
+  auto t0 = telemetry::timer::clock_type::now();
+  auto payload = const_byte_span{buf.data() + offset + header_size,
+                                 hdr.payload_len};
+  compression_buf_.clear();
+  auto ok = compress_payload(payload, compression_buf_);
+  telemetry::timer::observe(mm_metrics.compression_time, t0);
+  // Send the payload as-is if compressing it does not pay off.
+  if (!ok || compression_buf_.size() >= payload.size())
+    return;
+  buf.resize(offset + header_size);
+  buf.insert(buf.end(), compression_buf_.begin(), compression_buf_.end());
+  hdr.flags = static_cast<uint8_t>(hdr.flags | header::compressed_flag);
+  hdr.payload_len = static_cast<uint32_t>(compression_buf_.size());
+  binary_serializer sink{ctx, buf};
+  sink.seek(offset);
+  if (!sink.apply(hdr))
+    CAF_LOG_ERROR(sink.get_error());
+}
+
+bool instance::decompress(execution_unit* ctx, header& hdr,
+                          byte_buffer& payload) {
+  auto& mm_metrics = ctx->system().middleman().metric_singletons;
+  auto t0 = telemetry::timer::clock_type::now();
+  compression_buf_.clear();
+  if (!decompress_payload(payload, compression_buf_))
+    return false;
+  telemetry::timer::observe(mm_metrics.decompression_time, t0);
+  payload.swap(compression_buf_);
+  hdr.flags = static_cast<uint8_t>(hdr.flags & ~header::compressed_flag);
+  hdr.payload_len = static_cast<uint32_t>(payload.size());
+  return true;
+}
+
+send_dictionary* instance::send_dict(connection_handle hdl) {
+  auto i = connections_.find(hdl);
+  if (i == connections_.end() || !i->second.dictionaries)
+    return nullptr;
+  return &i->second.send_dict;
+}
+
+receive_dictionary_ptr instance::recv_dict(connection_handle hdl) const {
+  auto i = connections_.find(hdl);
+  if (i == connections_.end())
+    return nullptr;
+  return i->second.recv_dict;
+}
+
+void instance::write_dictionary_update(execution_unit* ctx,
+                                       connection_handle hdl,
+                                       payload_writer& writer) {
+  auto& buf = callee_.get_buffer(hdl);
+  auto offset = buf.size();
+  header hdr{message_type::dictionary_update,
+             0,
+             0,
+             0,
+             invalid_actor_id,
+             invalid_actor_id};
+  write(ctx, buf, hdr, &writer);
+  if (hdr.payload_len == 0) {
+    // Nothing new to tell the other node.
+    buf.resize(offset);
+    return;
+  }
+  compress(ctx, hdl, buf, offset, hdr);
+}
+
+bool instance::apply_dictionary_update(execution_unit* ctx,
+                                       connection_handle hdl,
+                                       const byte_buffer& payload) {
+  auto i = connections_.find(hdl);
+  if (i == connections_.end() || !i->second.dictionaries)
+    return false;
+  // Workers may still read from the current dictionary. Checking the use
+  // count would not order their reads before our writes, so we always apply
+  // updates to a copy and never modify a dictionary after publishing it.
+  auto dict = std::make_shared<receive_dictionary>(*i->second.recv_dict);
+  binary_deserializer source{ctx, payload};
+  if (!dict->apply_update(source)) {
+    CAF_LOG_WARNING("unable to apply dictionary update:" << source.get_error());
+    return false;
+  }
+  i->second.recv_dict = std::move(dict);
+  return true;
+}
+
+std::vector<std::string> instance::extension_offer() const {
+  std::vector<std::string> result;
+  if (compression_)
+    result.emplace_back(deflate_compression);
+  if (dictionaries_)
+    result.emplace_back(dictionary_extension);
+  return result;
+}
+
+void instance::negotiate_extensions(connection_handle hdl,
+                                    const std::vector<std::string>& offer) {
+  auto offered = [&offer](std::string_view name) {
+    return std::find(offer.begin(), offer.end(), name) != offer.end();
+  };
+  connection_context cc;
+  cc.compression = compression_ && offered(deflate_compression);
+  cc.dictionaries = dictionaries_ && offered(dictionary_extension);
+  if (!cc.compression && !cc.dictionaries) {
+    connections_.erase(hdl);
+    return;
+  }
+  CAF_LOG_DEBUG("enable handshake extensions:"
+                << CAF_ARG(hdl) << CAF_ARG2("compression", cc.compression)
+                << CAF_ARG2("dictionaries", cc.dictionaries));
+  if (cc.dictionaries)
+    cc.recv_dict = std::make_shared<receive_dictionary>();
+  connections_.insert_or_assign(hdl, std::move(cc));
+}
+
 void instance::write_server_handshake(execution_unit* ctx, byte_buffer& out_buf,
                                       std::optional<uint16_t> port) {
   CAF_LOG_TRACE(CAF_ARG(port));
@@ -248,10 +526,12 @@ void instance::write_server_handshake(execution_unit* ctx, byte_buffer& out_buf,
       aid = pa->first->id();
       iface = pa->second;
     }
+    auto offer = extension_offer();
     return sink.apply(this_node_) //
            && sink.apply(app_ids) //
            && sink.apply(aid)     //
-           && sink.apply(iface);
+           && sink.apply(iface)   //
+           && sink.apply(offer);
   });
   header hdr{message_type::server_handshake,
              0,
@@ -264,7 +544,8 @@ void instance::write_server_handshake(execution_unit* ctx, byte_buffer& out_buf,
 
 void instance::write_client_handshake(execution_unit* ctx, byte_buffer& buf) {
   auto writer = make_callback([&](binary_serializer& sink) { //
-    return sink.apply(this_node_);
+    auto offer = extension_offer();
+    return sink.apply(this_node_) && sink.apply(offer);
   });
   header hdr{message_type::client_handshake,
              0,
@@ -326,10 +607,12 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
       string_list app_ids;
       actor_id aid = invalid_actor_id;
       std::set<std::string> sigs;
+      string_list extensions;
       if (!source.apply(source_node) //
           || !source.apply(app_ids)  //
           || !source.apply(aid)      //
-          || !source.apply(sigs)) {
+          || !source.apply(sigs)     //
+          || !source.apply(extensions)) {
         CAF_LOG_WARNING("unable to deserialize payload of server handshake:"
                         << source.get_error());
         return serializing_basp_payload_failed;
@@ -365,6 +648,7 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
       // Add direct route to this node and remove any indirect entry.
       CAF_LOG_DEBUG("new direct connection:" << CAF_ARG(source_node));
       tbl_.add_direct(hdl, source_node);
+      negotiate_extensions(hdl, extensions);
       auto was_indirect = tbl_.erase_indirect(source_node);
       // write handshake as client in response
       auto path = tbl_.lookup(source_node);
@@ -380,7 +664,8 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
       // Deserialize payload.
       binary_deserializer source{ctx, *payload};
       node_id source_node;
-      if (!source.apply(source_node)) {
+      std::vector<std::string> extensions;
+      if (!source.apply(source_node) || !source.apply(extensions)) {
         CAF_LOG_WARNING("unable to deserialize payload of client handshake:"
                         << source.get_error());
         return serializing_basp_payload_failed;
@@ -394,6 +679,7 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
       // Add direct route to this node and remove any indirect entry.
       CAF_LOG_DEBUG("new direct connection:" << CAF_ARG(source_node));
       tbl_.add_direct(hdl, source_node);
+      negotiate_extensions(hdl, extensions);
       auto was_indirect = tbl_.erase_indirect(source_node);
       callee_.learned_new_node_directly(source_node, was_indirect);
       break;
@@ -403,14 +689,27 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
       binary_deserializer source{ctx, *payload};
       node_id source_node;
       node_id dest_node;
-      if (!source.apply(source_node) || !source.apply(dest_node)) {
+      receive_dictionary_ptr dict;
+      if (hdr.has(header::dictionary_flag)) {
+        dict = recv_dict(hdl);
+        if (dict == nullptr) {
+          CAF_LOG_WARNING("received routed message with dictionary references "
+                          "on a connection without dictionaries");
+          return malformed_message;
+        }
+      }
+      auto ok = dict != nullptr
+                  ? read_node(source, *dict, source_node)
+                      && read_node(source, *dict, dest_node)
+                  : source.apply(source_node) && source.apply(dest_node);
+      if (!ok) {
         CAF_LOG_WARNING(
           "unable to deserialize source and destination for routed message:"
           << source.get_error());
         return serializing_basp_payload_failed;
       }
       if (dest_node != this_node_) {
-        forward(ctx, dest_node, hdr, *payload);
+        forward(ctx, source_node, dest_node, hdr, source.remainder());
         return await_header;
       }
       auto last_hop = tbl_.lookup_direct(hdl);
@@ -420,13 +719,23 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
         callee_.learned_new_node_indirectly(source_node);
     }
     // fall through
-    case message_type::direct_message: {
+    case message_type::direct_message:
+    case message_type::multicast_message: {
+      receive_dictionary_ptr dict;
+      if (hdr.has(header::dictionary_flag)) {
+        dict = recv_dict(hdl);
+        if (dict == nullptr) {
+          CAF_LOG_WARNING("received dictionary references on a connection "
+                          "without dictionaries");
+          return malformed_message;
+        }
+      }
       auto worker = hub_.pop();
       auto last_hop = tbl_.lookup_direct(hdl);
       if (worker != nullptr) {
         CAF_LOG_DEBUG("launch BASP worker for deserializing a"
                       << hdr.operation);
-        worker->launch(last_hop, hdr, *payload);
+        worker->launch(last_hop, hdr, *payload, std::move(dict));
       } else {
         CAF_LOG_DEBUG("out of BASP workers, continue deserializing a"
                       << hdr.operation);
@@ -435,13 +744,14 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
         struct handler : remote_message_handler<handler> {
           handler(message_queue* queue, proxy_registry* proxies,
                   actor_system* system, node_id last_hop, basp::header& hdr,
-                  byte_buffer& payload)
+                  byte_buffer& payload, receive_dictionary_ptr dict)
             : queue_(queue),
               proxies_(proxies),
               system_(system),
               last_hop_(std::move(last_hop)),
               hdr_(hdr),
-              payload_(payload) {
+              payload_(payload),
+              dict_(std::move(dict)) {
             msg_id_ = queue_->new_id();
           }
           message_queue* queue_;
@@ -450,9 +760,11 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
           node_id last_hop_;
           basp::header& hdr_;
           byte_buffer& payload_;
+          receive_dictionary_ptr dict_;
           uint64_t msg_id_;
         };
-        handler f{&queue_, &proxies(), &system(), last_hop, hdr, *payload};
+        handler f{&queue_, &proxies(), &system(), last_hop,
+                  hdr,     *payload,   std::move(dict)};
         f.handle_remote_message(callee_.current_execution_unit());
       }
       break;
@@ -500,6 +812,13 @@ connection_state instance::handle(execution_unit* ctx, connection_handle hdl,
       }
       break;
     }
+    case message_type::dictionary_update: {
+      if (!apply_dictionary_update(ctx, hdl, *payload)) {
+        CAF_LOG_WARNING("received malformed dictionary update");
+        return malformed_message;
+      }
+      break;
+    }
     case message_type::heartbeat: {
       CAF_LOG_TRACE("received heartbeat");
       callee_.handle_heartbeat();
@@ -518,16 +837,47 @@ void instance::forward(execution_unit* ctx, const node_id& dest_node,
   CAF_LOG_TRACE(CAF_ARG(dest_node) << CAF_ARG(hdr) << CAF_ARG(payload));
   auto path = lookup(dest_node);
   if (path) {
-    binary_serializer sink{ctx, callee_.get_buffer(path->hdl)};
+    auto& buf = callee_.get_buffer(path->hdl);
+    auto offset = buf.size();
+    binary_serializer sink{ctx, buf};
     if (!sink.apply(hdr)) {
       CAF_LOG_ERROR("unable to serialize BASP header:" << sink.get_error());
       return;
     }
     sink.value(span<const std::byte>{payload.data(), payload.size()});
+    auto fwd_hdr = hdr;
+    compress(ctx, path->hdl, buf, offset, fwd_hdr);
     flush(*path);
   } else {
     CAF_LOG_WARNING("cannot forward message, no route to destination");
   }
 }
 
+void instance::forward(execution_unit* ctx, const node_id& source_node,
+                       const node_id& dest_node, header hdr,
+                       const_byte_span remainder) {
+  CAF_LOG_TRACE(CAF_ARG(source_node) << CAF_ARG(dest_node) << CAF_ARG(hdr));
+  auto path = lookup(dest_node);
+  if (!path) {
+    CAF_LOG_WARNING("cannot forward message, no route to destination");
+    return;
+  }
+  auto dict = send_dict(path->hdl);
+  if (dict != nullptr) {
+    auto update = make_callback([&](binary_serializer& sink) {
+      return dict->add(sink, source_node) && dict->add(sink, dest_node);
+    });
+    write_dictionary_update(ctx, path->hdl, update);
+    hdr.flags = static_cast<uint8_t>(hdr.flags | header::dictionary_flag);
+  } else {
+    hdr.flags = static_cast<uint8_t>(hdr.flags & ~header::dictionary_flag);
+  }
+  auto writer = make_callback([&](binary_serializer& sink) {
+    return write_route(sink, dict, source_node, dest_node)
+           && sink.value(remainder);
+  });
+  write_compressed(ctx, path->hdl, hdr, &writer);
+  flush(*path);
+}
+
 } // namespace caf::io::basp
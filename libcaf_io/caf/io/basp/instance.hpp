@@ -5,6 +5,7 @@
 #pragma once
 
 #include "caf/io/basp/connection_state.hpp"
+#include "caf/io/basp/dictionary.hpp"
 #include "caf/io/basp/header.hpp"
 #include "caf/io/basp/message_queue.hpp"
 #include "caf/io/basp/message_type.hpp"
@@ -20,6 +21,10 @@
 #include "caf/error.hpp"
 
 #include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace caf::io::basp {
 
@@ -139,6 +144,39 @@ public:
                 const node_id& dest_node, uint64_t dest_actor, uint8_t flags,
                 message_id mid, const message& msg);
 
+  /// Sends `msg` to all actors in `dest_actors` on `dest_node`. Transmits the
+  /// message only once if `dest_node` is directly connected and `mid` denotes
+  /// an asynchronous message. Otherwise, falls back to calling `dispatch` for
+  /// each receiver.
+  /// @returns `true` if a path to destination existed, `false` otherwise.
+  bool dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
+                const std::vector<strong_actor_ptr>& forwarding_stack,
+                const node_id& dest_node,
+                const std::vector<actor_id>& dest_actors, message_id mid,
+                const message& msg);
+
+  /// Drops the serialized form of the last message that `dispatch` has sent.
+  /// The broker calls this function after processing a batch of messages.
+  void clear_payload_cache();
+
+  /// Returns whether this instance compresses payloads that it sends over
+  /// `hdl`, i.e., whether both nodes have agreed on compression.
+  bool compresses(connection_handle hdl) const {
+    auto i = connections_.find(hdl);
+    return i != connections_.end() && i->second.compression;
+  }
+
+  /// Returns whether this instance uses connection-scoped dictionaries for
+  /// `hdl`, i.e., whether both nodes have agreed on using dictionaries.
+  bool uses_dictionaries(connection_handle hdl) const {
+    auto i = connections_.find(hdl);
+    return i != connections_.end() && i->second.dictionaries;
+  }
+
+  /// Drops all per-connection state for `hdl`. The broker calls this function
+  /// when closing a connection.
+  void erase_connection_state(connection_handle hdl);
+
   /// Returns the actor namespace associated to this BASP protocol instance.
   proxy_registry& proxies() {
     return callee_.proxies();
@@ -212,15 +250,97 @@ public:
                           header& hdr, byte_buffer* payload);
 
 private:
+  /// Stores the handshake extensions that both nodes of a connection have
+  /// agreed on along with their state.
+  struct connection_context {
+    bool compression = false;
+    bool dictionaries = false;
+    send_dictionary send_dict;
+    receive_dictionary_ptr recv_dict;
+  };
+
   void forward(execution_unit* ctx, const node_id& dest_node, const header& hdr,
                byte_buffer& payload);
 
+  /// Forwards a routed message after re-encoding source and destination node
+  /// for the next hop. The `remainder` contains the payload after both nodes.
+  void forward(execution_unit* ctx, const node_id& source_node,
+               const node_id& dest_node, header hdr, const_byte_span remainder);
+
+  /// Serializes `msg` to `sink`, re-using the cached bytes if `msg` is the
+  /// message that `dispatch` has serialized last. Encodes the type IDs of
+  /// `msg` as reference if `dict` is not `nullptr`.
+  bool write_message(binary_serializer& sink, const message& msg,
+                     const send_dictionary* dict);
+
+  /// Returns the send dictionary for `hdl` or `nullptr` if the connection does
+  /// not use dictionaries.
+  send_dictionary* send_dict(connection_handle hdl);
+
+  /// Writes a `dictionary_update` message to the buffer of `hdl` unless
+  /// `writer` adds no new entries to the dictionary.
+  void write_dictionary_update(execution_unit* ctx, connection_handle hdl,
+                               payload_writer& writer);
+
+  /// Adds all entries of a received `dictionary_update` message to the receive
+  /// dictionary for `hdl`.
+  bool apply_dictionary_update(execution_unit* ctx, connection_handle hdl,
+                               const byte_buffer& payload);
+
+  /// Returns the receive dictionary for `hdl` or `nullptr` if the connection
+  /// does not use dictionaries.
+  receive_dictionary_ptr recv_dict(connection_handle hdl) const;
+
+  /// Writes a message to the buffer of `hdl` and compresses its payload if
+  /// both nodes agreed on compression for this connection.
+  void write_compressed(execution_unit* ctx, connection_handle hdl, header& hdr,
+                        payload_writer* pw);
+
+  /// Compresses the payload of the message at `offset` in `buf` and updates
+  /// `hdr` accordingly. Leaves the message as-is if the connection does not
+  /// use compression, the payload is too small or does not shrink.
+  void compress(execution_unit* ctx, connection_handle hdl, byte_buffer& buf,
+                size_t offset, header& hdr);
+
+  /// Decompresses `payload` in place and updates `hdr` accordingly.
+  bool decompress(execution_unit* ctx, header& hdr, byte_buffer& payload);
+
+  /// Returns the extensions that this node offers in handshakes.
+  std::vector<std::string> extension_offer() const;
+
+  /// Enables all extensions for `hdl` that both nodes support.
+  void negotiate_extensions(connection_handle hdl,
+                            const std::vector<std::string>& offer);
+
   routing_table tbl_;
   published_actor_map published_actors_;
   node_id this_node_;
   callee& callee_;
   message_queue queue_;
   detail::worker_hub<worker> hub_;
+
+  /// Stores the last message that `dispatch` has sent to some receiver while
+  /// other receivers may still wait for the same message.
+  message cached_msg_;
+
+  /// Stores the serialized form of `cached_msg_`.
+  byte_buffer cached_bytes_;
+
+  /// Configures whether this node offers compression in its handshakes.
+  bool compression_ = false;
+
+  /// Configures the minimum payload size for compressing messages.
+  size_t compression_threshold_ = 0;
+
+  /// Configures whether this node offers connection-scoped dictionaries in
+  /// its handshakes.
+  bool dictionaries_ = false;
+
+  /// Stores the negotiated extensions per connection.
+  std::unordered_map<connection_handle, connection_context> connections_;
+
+  /// Scratch space for compressing and decompressing payloads.
+  byte_buffer compression_buf_;
 };
 
 /// @}
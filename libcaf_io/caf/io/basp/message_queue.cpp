@@ -12,18 +12,47 @@ message_queue::message_queue() : next_id(0), next_undelivered(0) {
   // nop
 }
 
+namespace {
+
+void deliver(execution_unit* ctx, message_queue::actor_msg& x) {
+  for (auto& receiver : x.more_receivers) {
+    auto& content = *x.content;
+    receiver->enqueue(make_mailbox_element(content.sender, content.mid,
+                                           content.stages, content.payload),
+                      ctx);
+  }
+  if (x.receiver != nullptr)
+    x.receiver->enqueue(std::move(x.content), ctx);
+}
+
+} // namespace
+
 void message_queue::push(execution_unit* ctx, uint64_t id,
                          strong_actor_ptr receiver,
                          mailbox_element_ptr content) {
+  push(ctx, actor_msg{id, std::move(receiver), std::move(content), {}});
+}
+
+void message_queue::push(execution_unit* ctx, uint64_t id,
+                         std::vector<strong_actor_ptr> receivers,
+                         mailbox_element_ptr content) {
+  CAF_ASSERT(!receivers.empty());
+  auto receiver = std::move(receivers.back());
+  receivers.pop_back();
+  push(ctx, actor_msg{id, std::move(receiver), std::move(content),
+                      std::move(receivers)});
+}
+
+void message_queue::push(execution_unit* ctx, actor_msg msg) {
   std::unique_lock<std::mutex> guard{lock};
+  auto id = msg.id;
   CAF_ASSERT(id >= next_undelivered);
   CAF_ASSERT(id < next_id);
   auto first = pending.begin();
   auto last = pending.end();
   if (id == next_undelivered) {
     // Dispatch current head.
-    if (receiver != nullptr)
-      receiver->enqueue(std::move(content), ctx);
+    deliver(ctx, msg);
     auto next = id + 1;
     // Check whether we can deliver more.
     if (first == last || first->id != next) {
@@ -34,8 +63,7 @@ void message_queue::push(execution_unit* ctx, uint64_t id,
     // Deliver everything until reaching a non-consecutive ID or the end.
     auto i = first;
     for (; i != last && i->id == next; ++i, ++next)
-      if (i->receiver != nullptr)
-        i->receiver->enqueue(std::move(i->content), ctx);
+      deliver(ctx, *i);
     next_undelivered = next;
     pending.erase(first, i);
     CAF_ASSERT(next_undelivered <= next_id);
@@ -43,8 +71,7 @@ void message_queue::push(execution_unit* ctx, uint64_t id,
   }
   // Get the insertion point.
   auto pred = [&](const actor_msg& x) { return x.id >= id; };
-  pending.emplace(std::find_if(first, last, pred),
-                  actor_msg{id, std::move(receiver), std::move(content)});
+  pending.emplace(std::find_if(first, last, pred), std::move(msg));
 }
 
 void message_queue::drop(execution_unit* ctx, uint64_t id) {
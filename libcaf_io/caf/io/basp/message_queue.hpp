@@ -26,6 +26,8 @@ public:
     uint64_t id;
     strong_actor_ptr receiver;
     mailbox_element_ptr content;
+    /// Receives copies of `content` before `receiver` (multicast messages).
+    std::vector<strong_actor_ptr> more_receivers;
   };
 
   // -- constructors, destructors, and assignment operators --------------------
@@ -38,6 +40,16 @@ public:
   void push(execution_unit* ctx, uint64_t id, strong_actor_ptr receiver,
             mailbox_element_ptr content);
 
+  /// Adds a new message for multiple receivers to the queue or deliver it
+  /// immediately if possible.
+  /// @pre `!receivers.empty()`
+  void push(execution_unit* ctx, uint64_t id,
+            std::vector<strong_actor_ptr> receivers,
+            mailbox_element_ptr content);
+
+  /// Adds a new message to the queue or deliver it immediately if possible.
+  void push(execution_unit* ctx, actor_msg msg);
+
   /// Marks given ID as dropped, effectively skipping it without effect.
   void drop(execution_unit* ctx, uint64_t id);
 
@@ -60,6 +60,16 @@ enum class message_type : uint8_t {
   ///
   /// ![](heartbeat.png)
   heartbeat = 0x06,
+
+  /// Transmits a direct message from source to multiple actors on the
+  /// receiving node. The payload starts with the list of receivers and
+  /// `dest_actor` stores the number of receivers.
+  multicast_message = 0x07,
+
+  /// Adds entries to the connection-scoped dictionary of the receiving node.
+  /// The payload consists of the new entries in the order the sending node has
+  /// assigned indexes to them.
+  dictionary_update = 0x08,
 };
 
 CAF_IO_EXPORT std::string to_string(message_type);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "caf/io/basp/dictionary.hpp"
 #include "caf/io/basp/header.hpp"
 #include "caf/io/middleman.hpp"
 
@@ -37,17 +38,37 @@ public:
     auto& sys = *dref.system_;
     strong_actor_ptr src;
     strong_actor_ptr dst;
+    std::vector<strong_actor_ptr> multicast_receivers;
     std::vector<strong_actor_ptr> stages;
     message msg;
+    auto use_dict = false;
     auto mid = make_message_id(dref.hdr_.operation_data);
     binary_deserializer source{ctx, dref.payload_};
+    // Not null if and only if the header has the dictionary flag.
+    const receive_dictionary* dict = dref.dict_.get();
     // Make sure to drop the message in case we return abnormally.
     auto guard
       = detail::make_scope_guard([&] { dref.queue_->drop(ctx, dref.msg_id_); });
     // Registry setup.
     dref.proxies_->set_last_hop(&dref.last_hop_);
     // Get the local receiver.
-    if (dref.hdr_.has(basp::header::named_receiver_flag)) {
+    if (dref.hdr_.operation == basp::message_type::multicast_message) {
+      std::vector<actor_id> ids;
+      if (!source.apply(ids)) {
+        CAF_LOG_ERROR("failed to read receivers of multicast message:"
+                      << source.get_error());
+        return;
+      }
+      for (auto id : ids)
+        if (auto ptr = sys.registry().get(id))
+          multicast_receivers.emplace_back(std::move(ptr));
+      if (multicast_receivers.empty()) {
+        CAF_LOG_INFO("drop multicast message: unknown destinations");
+        return;
+      }
+      // Use the first receiver for the checks below.
+      dst = multicast_receivers.front();
+    } else if (dref.hdr_.has(basp::header::named_receiver_flag)) {
       // TODO: consider replacing hacky workaround (requires changing BASP).
       if (dref.hdr_.dest_actor == 1) {
         dst = sys.registry().get("ConfigServ");
@@ -66,12 +87,16 @@ public:
     if (dref.hdr_.operation == basp::message_type::routed_message) {
       node_id src_node;
       node_id dst_node;
-      if (!source.apply(src_node)) {
+      auto load_node = [&](node_id& nid) {
+        return dict != nullptr ? basp::read_node(source, *dict, nid)
+                               : source.apply(nid);
+      };
+      if (!load_node(src_node)) {
         CAF_LOG_ERROR(
           "failed to read source of routed message:" << source.get_error());
         return;
       }
-      if (!source.apply(dst_node)) {
+      if (!load_node(dst_node)) {
         CAF_LOG_ERROR("failed to read destination of routed message:"
                       << source.get_error());
         return;
@@ -83,8 +108,12 @@ public:
                 : dref.proxies_->get_or_put(src_node, dref.hdr_.source_actor);
       }
     } else {
-      CAF_ASSERT(dref.hdr_.operation == basp::message_type::direct_message);
+      CAF_ASSERT(dref.hdr_.operation == basp::message_type::direct_message
+                 || dref.hdr_.operation
+                      == basp::message_type::multicast_message);
       src = dref.proxies_->get_or_put(dref.last_hop_, dref.hdr_.source_actor);
+      // Routed messages only use the dictionary for source and destination.
+      use_dict = dict != nullptr;
     }
     // Send errors for dropped requests.
     if (dst == nullptr) {
@@ -95,13 +124,14 @@ public:
       return;
     }
     // Get the remainder of the message.
-    if (!source.apply(stages)) {
+    if (use_dict ? !read_stages(source, *dict, stages)
+                 : !source.apply(stages)) {
       CAF_LOG_ERROR("failed to read stages:" << source.get_error());
       return;
     }
     auto& mm_metrics = ctx->system().middleman().metric_singletons;
     auto t0 = telemetry::timer::clock_type::now();
-    if (!source.apply(msg)) {
+    if (use_dict ? !read_message(source, *dict, msg) : !source.apply(msg)) {
       CAF_LOG_ERROR("failed to read message content:" << source.get_error());
       return;
     }
@@ -130,6 +160,13 @@ public:
     }
     // Ship the message.
     guard.disable();
+    if (!multicast_receivers.empty()) {
+      dref.queue_->push(ctx, dref.msg_id_, std::move(multicast_receivers),
+                        make_mailbox_element(std::move(src), mid,
+                                             std::move(stages),
+                                             std::move(msg)));
+      return;
+    }
     dref.queue_->push(ctx, dref.msg_id_, std::move(dst),
                       make_mailbox_element(std::move(src), mid,
                                            std::move(stages), std::move(msg)));
@@ -26,14 +26,16 @@ worker::~worker() {
 // -- management ---------------------------------------------------------------
 
 void worker::launch(const node_id& last_hop, const basp::header& hdr,
-                    const byte_buffer& payload) {
+                    const byte_buffer& payload, receive_dictionary_ptr dict) {
   CAF_ASSERT(hdr.dest_actor != 0);
   CAF_ASSERT(hdr.operation == basp::message_type::direct_message
-             || hdr.operation == basp::message_type::routed_message);
+             || hdr.operation == basp::message_type::routed_message
+             || hdr.operation == basp::message_type::multicast_message);
   msg_id_ = queue_->new_id();
   last_hop_ = last_hop;
   memcpy(&hdr_, &hdr, sizeof(basp::header));
   payload_.assign(payload.begin(), payload.end());
+  dict_ = std::move(dict);
   ref();
   system_->scheduler().enqueue(this);
 }
@@ -43,6 +45,8 @@ void worker::launch(const node_id& last_hop, const basp::header& hdr,
 resumable::resume_result worker::resume(execution_unit* ctx, size_t) {
   ctx->proxy_registry_ptr(proxies_);
   handle_remote_message(ctx);
+  // Allow the BASP instance to update the dictionary without copying it.
+  dict_.reset();
   hub_->push(this);
   return resumable::awaiting_message;
 }
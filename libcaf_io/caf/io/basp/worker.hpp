@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "caf/io/basp/dictionary.hpp"
 #include "caf/io/basp/fwd.hpp"
 #include "caf/io/basp/header.hpp"
 #include "caf/io/basp/remote_message_handler.hpp"
@@ -49,7 +50,7 @@ public:
   // -- management -------------------------------------------------------------
 
   void launch(const node_id& last_hop, const basp::header& hdr,
-              const byte_buffer& payload);
+              const byte_buffer& payload, receive_dictionary_ptr dict);
 
   // -- implementation of resumable --------------------------------------------
 
@@ -95,6 +96,9 @@ private:
 
   /// Contains whatever this worker deserializes next.
   byte_buffer payload_;
+
+  /// Resolves references in `payload_` if `hdr_` has the dictionary flag.
+  receive_dictionary_ptr dict_;
 };
 
 } // namespace caf::io::basp
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <limits>
+#include <map>
 
 namespace {
 
@@ -59,6 +60,8 @@ basp_broker::~basp_broker() {
 // -- implementation of local_actor/broker -------------------------------------
 
 void basp_broker::on_exit() {
+  // Ship whatever we have buffered before shutting down.
+  flush_pending_writes();
   // Wait until all pending messages of workers have been shipped.
   // TODO: this blocks the calling thread. This is only safe because we know
   //       that the middleman calls this in its stop() function. However,
@@ -107,6 +110,21 @@ behavior basp_broker::make_behavior() {
     }
     automatic_connections = true;
   }
+  auto policy = get_or(config(), "caf.middleman.flush-policy",
+                       defaults::middleman::flush_policy);
+  if (policy == "immediate") {
+    flush_policy.immediate = true;
+  } else if (policy != "coalesce") {
+    CAF_LOG_WARNING("unknown flush policy, fall back to 'coalesce':"
+                    << CAF_ARG(policy));
+  }
+  flush_policy.threshold = get_or(config(), "caf.middleman.flush-threshold",
+                                  defaults::middleman::flush_threshold);
+  flush_policy.delay = get_or(config(), "caf.middleman.flush-delay",
+                              defaults::middleman::flush_delay);
+  CAF_LOG_DEBUG(CAF_ARG2("immediate", flush_policy.immediate)
+                << CAF_ARG2("threshold", flush_policy.threshold)
+                << CAF_ARG2("delay", flush_policy.delay));
   auto heartbeat_interval = get_or(config(), "caf.middleman.heartbeat-interval",
                                    defaults::middleman::heartbeat_interval);
   if (heartbeat_interval.count() > 0) {
@@ -164,6 +182,29 @@ behavior basp_broker::make_behavior() {
         srb(src, mid);
       }
     },
+    // received from middleman::multicast
+    [=](forward_atom, strong_actor_ptr& src,
+        const std::vector<strong_actor_ptr>& fwd_stack,
+        const std::vector<strong_actor_ptr>& dests, message_id mid,
+        const message& msg) {
+      CAF_LOG_TRACE(CAF_ARG(src)
+                    << CAF_ARG(dests) << CAF_ARG(mid) << CAF_ARG(msg));
+      if (src && system().node() == src->node())
+        system().registry().put(src->id(), src);
+      // Group the receivers by node to send the message once per node.
+      std::map<node_id, std::vector<actor_id>> groups;
+      for (auto& dest : dests) {
+        if (!dest || system().node() == dest->node()) {
+          CAF_LOG_WARNING("cannot forward to invalid or local actor:"
+                          << CAF_ARG(dest));
+          continue;
+        }
+        groups[dest->node()].emplace_back(dest->id());
+      }
+      for (auto& [nid, ids] : groups)
+        if (!instance.dispatch(context(), src, fwd_stack, nid, ids, mid, msg))
+          CAF_LOG_DEBUG("drop multicast message: no route to" << CAF_ARG(nid));
+    },
     // received from some system calls like whereis
     [=](forward_atom, const node_id& dest_node, uint64_t dest_id,
         const message& msg) -> result<message> {
@@ -289,14 +330,24 @@ behavior basp_broker::make_behavior() {
     },
     // received from middleman actor
     [=](publish_atom, doorman_ptr& ptr, uint16_t port,
-        const strong_actor_ptr& whom, std::set<std::string>& sigs) {
+        const strong_actor_ptr& whom,
+        std::set<std::string>& sigs) -> result<void> {
       CAF_LOG_TRACE(CAF_ARG(ptr)
                     << CAF_ARG(port) << CAF_ARG(whom) << CAF_ARG(sigs));
       CAF_ASSERT(ptr != nullptr);
+      // TCP and shared memory doormans may bind the same port number, but
+      // published actors and `close` operate on port numbers only.
+      if (instance.published_actors().count(port) > 0) {
+        CAF_LOG_WARNING("port already in use by another doorman:"
+                        << CAF_ARG(port));
+        return make_error(sec::cannot_open_port, "port already published",
+                          port);
+      }
       add_doorman(std::move(ptr));
       if (whom)
         system().registry().put(whom->id(), whom);
       instance.add_published_actor(port, whom, std::move(sigs));
+      return unit;
     },
     // received from test code to set up two instances without doorman
     [=](publish_atom, scribe_ptr& ptr, uint16_t port,
@@ -371,6 +422,10 @@ behavior basp_broker::make_behavior() {
       }
       return {x, std::move(addr), port};
     },
+    [=](flush_atom) {
+      flush_scheduled = false;
+      flush_pending_writes();
+    },
     [=](tick_atom, actor_clock::time_point::rep scheduled_rep,
         timespan heartbeat_interval, timespan connection_timeout) {
       auto scheduled_tse = actor_clock::time_point::duration{scheduled_rep};
@@ -424,11 +479,20 @@ proxy_registry* basp_broker::proxy_registry_ptr() {
 
 resumable::resume_result basp_broker::resume(execution_unit* ctx, size_t mt) {
   ctx->proxy_registry_ptr(&instance.proxies());
-  auto guard
-    = detail::make_scope_guard([=] { ctx->proxy_registry_ptr(nullptr); });
+  auto guard = detail::make_scope_guard([=] {
+    ctx->proxy_registry_ptr(nullptr);
+    instance.clear_payload_cache();
+    end_of_run();
+  });
   return super::resume(ctx, mt);
 }
 
+void basp_broker::io_event_handled() {
+  // Handling data from one connection may write to other connections, e.g.,
+  // when forwarding routed messages.
+  end_of_run();
+}
+
 strong_actor_ptr basp_broker::make_proxy(node_id nid, actor_id aid) {
   CAF_LOG_TRACE(CAF_ARG(nid) << CAF_ARG(aid));
   CAF_ASSERT(nid != this_node());
@@ -662,6 +726,8 @@ void basp_broker::set_context(connection_handle hdl) {
 
 void basp_broker::connection_cleanup(connection_handle hdl, sec code) {
   CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG(code));
+  pending_writes.erase(hdl);
+  instance.erase_connection_state(hdl);
   // Remove handle from the routing table, notify all observers, and clean up
   // any node-specific state we might still have.
   if (auto nid = instance.tbl().erase_direct(hdl)) {
@@ -688,7 +754,48 @@ byte_buffer& basp_broker::get_buffer(connection_handle hdl) {
 }
 
 void basp_broker::flush(connection_handle hdl) {
+  // BASP calls this function once per message, so we get an accurate count of
+  // messages per batch by counting calls until we actually flush.
+  if (flush_policy.immediate) {
+    flush_now(hdl, 1);
+    return;
+  }
+  if (pending_writes.empty() && flush_policy.delay.count() > 0)
+    first_pending_write = clock().now();
+  auto i = pending_writes.emplace(hdl, 0).first;
+  ++i->second;
+  if (wr_buf(hdl).size() >= flush_policy.threshold) {
+    flush_now(hdl, i->second);
+    pending_writes.erase(i);
+  }
+}
+
+void basp_broker::flush_pending_writes() {
+  for (auto& [hdl, num_messages] : pending_writes)
+    flush_now(hdl, num_messages);
+  pending_writes.clear();
+}
+
+void basp_broker::flush_now(connection_handle hdl, size_t num_messages) {
   super::flush(hdl);
+  auto& metrics = system().middleman().metric_singletons;
+  metrics.outbound_batch_size->observe(static_cast<int64_t>(num_messages));
+}
+
+void basp_broker::end_of_run() {
+  if (pending_writes.empty())
+    return;
+  if (flush_policy.delay.count() == 0) {
+    flush_pending_writes();
+    return;
+  }
+  auto deadline = first_pending_write + flush_policy.delay;
+  if (clock().now() >= deadline) {
+    flush_pending_writes();
+  } else if (!flush_scheduled) {
+    flush_scheduled = true;
+    scheduled_send(this, deadline, flush_atom_v);
+  }
 }
 
 void basp_broker::handle_heartbeat() {
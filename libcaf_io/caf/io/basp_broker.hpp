@@ -8,9 +8,11 @@
 #include "caf/io/broker.hpp"
 #include "caf/io/typed_broker.hpp"
 
+#include "caf/actor_clock.hpp"
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/byte_buffer.hpp"
+#include "caf/defaults.hpp"
 #include "caf/detail/io_export.hpp"
 #include "caf/forwarding_actor_proxy.hpp"
 #include "caf/proxy_registry.hpp"
@@ -41,6 +43,20 @@ public:
   using monitored_actor_map
     = std::unordered_map<actor_addr, std::unordered_set<node_id>>;
 
+  /// Configures when the broker flushes the write buffers of its connections.
+  struct flush_policy_t {
+    /// Flushes the write buffer after each message if `true`.
+    bool immediate = false;
+
+    /// Flushes the write buffer of a connection early once it contains at
+    /// least this many bytes.
+    size_t threshold = defaults::middleman::flush_threshold;
+
+    /// Maximum time for holding back coalesced writes. The broker flushes all
+    /// pending writes at the end of each run if this is 0.
+    timespan delay = defaults::middleman::flush_delay;
+  };
+
   // -- constructors, destructors, and assignment operators --------------------
 
   explicit basp_broker(actor_config& cfg);
@@ -59,6 +75,8 @@ public:
 
   resume_result resume(execution_unit*, size_t) override;
 
+  void io_event_handled() override;
+
   // -- implementation of proxy_registry::backend ------------------------------
 
   strong_actor_ptr make_proxy(node_id nid, actor_id aid) override;
@@ -104,6 +122,9 @@ public:
   /// Cleans up any state for `hdl`.
   void connection_cleanup(connection_handle hdl, sec code);
 
+  /// Flushes the write buffers of all connections with pending writes.
+  void flush_pending_writes();
+
   /// Sends a basp::down_message message to a remote node.
   void send_basp_down_message(const node_id& nid, actor_id aid, error err);
 
@@ -153,6 +174,23 @@ public:
 
   /// Keeps track of nodes that monitor local actors.
   monitored_actor_map monitored_actors;
+
+  /// Configures write coalescing for all connections.
+  flush_policy_t flush_policy;
+
+  /// Stores the number of unflushed messages per connection.
+  std::unordered_map<connection_handle, size_t> pending_writes;
+
+  /// Stores when the broker wrote the first message of the current batch.
+  actor_clock::time_point first_pending_write;
+
+  /// Signals whether the broker has scheduled a `flush_atom` to itself.
+  bool flush_scheduled = false;
+
+private:
+  void flush_now(connection_handle hdl, size_t num_messages);
+
+  void end_of_run();
 };
 
 } // namespace caf::io
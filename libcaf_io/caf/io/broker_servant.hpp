@@ -68,6 +68,7 @@ protected:
     auto guard = detail::make_scope_guard([=] {
       if (pfac)
         ctx->proxy_registry_ptr(nullptr);
+      self->io_event_handled();
     });
     self->activate(ctx, x);
   }
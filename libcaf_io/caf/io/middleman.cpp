@@ -75,6 +75,16 @@ auto make_metrics(telemetry::metric_registry& reg) {
     500'000,
     1'000'000,
   }};
+  std::array<int64_t, 8> default_batch_buckets{{
+    1,
+    2,
+    4,
+    8,
+    16,
+    32,
+    64,
+    128,
+  }};
   return middleman::metric_singletons_t{
     reg.histogram_singleton(
       "caf.middleman", "inbound-messages-size", default_size_buckets,
@@ -88,6 +98,15 @@ auto make_metrics(telemetry::metric_registry& reg) {
     reg.histogram_singleton<double>(
       "caf.middleman", "serialization-time", default_time_buckets,
       "Time the middleman needs to serialize outbound messages.", "seconds"),
+    reg.histogram_singleton<double>(
+      "caf.middleman", "compression-time", default_time_buckets,
+      "Time the middleman needs to compress outbound messages.", "seconds"),
+    reg.histogram_singleton<double>(
+      "caf.middleman", "decompression-time", default_time_buckets,
+      "Time the middleman needs to decompress inbound messages.", "seconds"),
+    reg.histogram_singleton(
+      "caf.middleman", "outbound-batch-size", default_batch_buckets,
+      "The number of BASP messages per flush of a connection."),
   };
 }
 
@@ -206,7 +225,23 @@ void middleman::add_module_options(actor_system_config& cfg) {
                "schedule utility actors instead of dedicating threads")
     .add<bool>("manual-multiplexing",
                "disables background activity of the multiplexer")
-    .add<size_t>("workers", "number of deserialization workers");
+    .add<size_t>("workers", "number of deserialization workers")
+    .add<std::string>("flush-policy",
+                      "either 'coalesce' (default) or 'immediate'")
+    .add<size_t>("flush-threshold",
+                 "max. buffered bytes per connection before flushing early")
+    .add<timespan>("flush-delay",
+                   "max. time for holding back coalesced writes (flushes at "
+                   "the end of each broker run if 0)")
+    .add<std::string>("compression",
+                      "either 'none' (default) or 'deflate'")
+    .add<size_t>("compression-threshold",
+                 "min. payload size in bytes for compressing BASP messages")
+    .add<bool>("enable-dictionaries",
+               "replaces repeated type IDs, node IDs and actor addresses in "
+               "BASP messages with per-connection indexes")
+    .add<size_t>("shm-buffer-size",
+                 "size in bytes of each ring buffer for shm:// connections");
   config_option_adder{cfg.custom_options(), "caf.middleman.prometheus-http"}
     .add<uint16_t>("port", "listening port for incoming scrapes")
     .add<std::string>("address", "bind address for the HTTP server socket");
@@ -222,6 +257,17 @@ void middleman::add_module_options(actor_system_config& cfg) {
               defaults::middleman::heartbeat_interval);
   put_missing(grp, "connection-timeout",
               defaults::middleman::connection_timeout);
+  put_missing(grp, "flush-policy",
+              std::string{defaults::middleman::flush_policy});
+  put_missing(grp, "flush-threshold", defaults::middleman::flush_threshold);
+  put_missing(grp, "flush-delay", defaults::middleman::flush_delay);
+  put_missing(grp, "compression",
+              std::string{defaults::middleman::compression});
+  put_missing(grp, "compression-threshold",
+              defaults::middleman::compression_threshold);
+  put_missing(grp, "enable-dictionaries",
+              defaults::middleman::enable_dictionaries);
+  put_missing(grp, "shm-buffer-size", defaults::middleman::shm_buffer_size);
 }
 
 actor_system::module* middleman::make(actor_system& sys, detail::type_list<>) {
@@ -280,6 +326,16 @@ expected<uint16_t> middleman::publish(const strong_actor_ptr& whom,
   return f(publish_atom_v, port, std::move(whom), std::move(sigs), in, ru);
 }
 
+expected<uint16_t> middleman::publish(const strong_actor_ptr& whom,
+                                      std::set<std::string> sigs,
+                                      const uri& locator, bool ru) {
+  CAF_LOG_TRACE(CAF_ARG(whom) << CAF_ARG(sigs) << CAF_ARG(locator));
+  if (!whom)
+    return sec::cannot_publish_invalid_actor;
+  auto f = make_function_view(actor_handle());
+  return f(publish_atom_v, locator, std::move(whom), std::move(sigs), ru);
+}
+
 expected<uint16_t> middleman::publish_local_groups(uint16_t port,
                                                    const char* in, bool reuse) {
   CAF_LOG_TRACE(CAF_ARG(port) << CAF_ARG(in));
@@ -324,6 +380,22 @@ expected<strong_actor_ptr> middleman::remote_actor(std::set<std::string> ifs,
   return ptr;
 }
 
+expected<strong_actor_ptr> middleman::remote_actor(std::set<std::string> ifs,
+                                                   const uri& locator) {
+  CAF_LOG_TRACE(CAF_ARG(ifs) << CAF_ARG(locator));
+  auto f = make_function_view(actor_handle());
+  auto res = f(connect_atom_v, locator);
+  if (!res)
+    return std::move(res.error());
+  strong_actor_ptr ptr = std::move(std::get<1>(*res));
+  if (!ptr)
+    return make_error(sec::no_actor_published_at_port, locator);
+  if (!system().assignable(std::get<2>(*res), ifs))
+    return make_error(sec::unexpected_actor_messaging_interface, std::move(ifs),
+                      std::move(std::get<2>(*res)));
+  return ptr;
+}
+
 expected<group> middleman::remote_group(const std::string& group_uri) {
   CAF_LOG_TRACE(CAF_ARG(group_uri));
   // format of group_identifier is group@host:port
@@ -408,6 +480,27 @@ void middleman::resolve_remote_group_intermediary(
   system().spawn(lookup, actor_handle());
 }
 
+void middleman::multicast(strong_actor_ptr sender,
+                          const std::vector<strong_actor_ptr>& receivers,
+                          message msg) {
+  CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(receivers) << CAF_ARG(msg));
+  std::vector<strong_actor_ptr> remote_receivers;
+  for (auto& receiver : receivers) {
+    if (receiver == nullptr)
+      continue;
+    if (receiver->node() == system().node())
+      receiver->enqueue(sender, make_message_id(), msg, nullptr);
+    else
+      remote_receivers.emplace_back(receiver);
+  }
+  if (remote_receivers.empty())
+    return;
+  auto basp = named_broker<basp_broker>("BASP");
+  std::vector<strong_actor_ptr> fwd_stack;
+  anon_send(basp, forward_atom_v, std::move(sender), std::move(fwd_stack),
+            std::move(remote_receivers), make_message_id(), std::move(msg));
+}
+
 strong_actor_ptr middleman::remote_lookup(std::string name,
                                           const node_id& nid) {
   CAF_LOG_TRACE(CAF_ARG(name) << CAF_ARG(nid));
@@ -19,6 +19,7 @@
 #include "caf/proxy_registry.hpp"
 #include "caf/send.hpp"
 #include "caf/timespan.hpp"
+#include "caf/uri.hpp"
 
 #include <chrono>
 #include <list>
@@ -48,6 +49,15 @@ public:
 
     /// Samples how long the middleman needs to serialize outbound messages.
     telemetry::dbl_histogram* serialization_time = nullptr;
+
+    /// Samples how long the middleman needs to compress outbound messages.
+    telemetry::dbl_histogram* compression_time = nullptr;
+
+    /// Samples how long the middleman needs to decompress inbound messages.
+    telemetry::dbl_histogram* decompression_time = nullptr;
+
+    /// Samples how many BASP messages the middleman writes per flush.
+    telemetry::int_histogram* outbound_batch_size = nullptr;
   };
 
   /// Independent tasks that run in the background, usually in their own thread.
@@ -88,6 +98,23 @@ public:
                    system().message_types(tk), port, in, reuse);
   }
 
+  /// Tries to publish `whom` at `locator` and returns either an `error` or the
+  /// bound port. The scheme of `locator` selects the transport:
+  /// - `tcp://<addr>:<port>` is equivalent to `publish(whom, port, addr)`
+  /// - `shm://localhost:<port>` accepts connections from nodes on the same
+  ///   host via shared memory (Linux only)
+  /// @param whom Actor that should be published at `locator`.
+  /// @param locator URI with scheme, host and port. Passing 0 as port selects
+  ///                an unused port.
+  /// @param reuse Create socket using `SO_REUSEADDR`.
+  template <class Handle>
+  expected<uint16_t> publish(Handle&& whom, const uri& locator,
+                             bool reuse = false) {
+    detail::type_list<typename std::decay<Handle>::type> tk;
+    return publish(actor_cast<strong_actor_ptr>(std::forward<Handle>(whom)),
+                   system().message_types(tk), locator, reuse);
+  }
+
   /// Makes *all* local groups accessible via network
   /// on address `addr` and `port`.
   /// @returns The actual port the OS uses after `bind()`. If `port == 0`
@@ -119,6 +146,21 @@ public:
     return actor_cast<ActorHandle>(std::move(*x));
   }
 
+  /// Establish a new connection to the actor at `locator`, whereby the scheme
+  /// selects the transport, i.e., either `tcp` or `shm`.
+  /// @param locator URI of the form `<scheme>://<host>:<port>`.
+  /// @returns An `actor` to the proxy instance representing
+  ///          a remote actor or an `error`.
+  template <class ActorHandle = actor>
+  expected<ActorHandle> remote_actor(const uri& locator) {
+    detail::type_list<ActorHandle> tk;
+    auto x = remote_actor(system().message_types(tk), locator);
+    if (!x)
+      return x.error();
+    CAF_ASSERT(x && *x);
+    return actor_cast<ActorHandle>(std::move(*x));
+  }
+
   /// Tries to connect to a group that runs on a different node in the network.
   /// @param group_locator Locator in the format `<group-name>@<host>:<port>`.
   expected<group> remote_group(const std::string& group_locator);
@@ -178,6 +220,12 @@ public:
   ///       or an error occurred.
   strong_actor_ptr remote_lookup(std::string name, const node_id& nid);
 
+  /// Sends `msg` as an asynchronous message to all `receivers`. Transmits
+  /// `msg` only once to each directly connected node that hosts some of the
+  /// receivers instead of serializing it once per receiver.
+  void multicast(strong_actor_ptr sender,
+                 const std::vector<strong_actor_ptr>& receivers, message msg);
+
   template <class Handle>
   expected<Handle>
   remote_spawn(const node_id& nid, std::string name, message args,
@@ -358,11 +406,18 @@ private:
                              std::set<std::string> sigs, uint16_t port,
                              const char* cstr, bool ru);
 
+  expected<uint16_t> publish(const strong_actor_ptr& whom,
+                             std::set<std::string> sigs, const uri& locator,
+                             bool ru);
+
   expected<void> unpublish(const actor_addr& whom, uint16_t port);
 
   expected<strong_actor_ptr> remote_actor(std::set<std::string> ifs,
                                           std::string host, uint16_t port);
 
+  expected<strong_actor_ptr> remote_actor(std::set<std::string> ifs,
+                                          const uri& locator);
+
   static int exec_slave_mode(actor_system&, const actor_system_config&);
 
   /// The actor environment.
@@ -7,6 +7,7 @@
 #include "caf/detail/io_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/typed_actor.hpp"
+#include "caf/uri.hpp"
 
 namespace caf::io {
 
@@ -28,6 +29,15 @@ namespace caf::io {
 ///    set<string> ifs, string addr, bool reuse_addr)
 ///   -> (uint16_t)
 ///
+///   // Same as above, but selects the transport via the URI scheme. The
+///   // scheme `tcp` uses the host as IP address to listen to and the scheme
+///   // `shm` accepts connections from nodes on the same host via shared
+///   // memory.
+///   // locator: URI of the form `<scheme>://<host>:<port>`.
+///   (publish_atom, uri locator, strong_actor_ptr whom, set<string> ifs,
+///    bool reuse_addr)
+///   -> (uint16_t)
+///
 ///   // Opens a new port other CAF instances can connect to. The
 ///   // difference between `PUBLISH` and `OPEN` is that no actor is mapped to
 ///   // this port, meaning that connecting nodes only get a valid `node_id`
@@ -48,6 +58,12 @@ namespace caf::io {
 ///   (connect_atom, string hostname, uint16_t port)
 ///   -> (node_id nid, strong_actor_ptr remote_actor, set<string> ifs)
 ///
+///   // Same as above, but selects the transport via the URI scheme, i.e.,
+///   // either `tcp` or `shm`.
+///   // locator: URI of the form `<scheme>://<host>:<port>`.
+///   (connect_atom, uri locator)
+///   -> (node_id nid, strong_actor_ptr remote_actor, set<string> ifs)
+///
 ///   // Closes `port` if it is mapped to `whom`.
 ///   // whom: A published actor.
 ///   // port: Used TCP port.
@@ -75,11 +91,16 @@ using middleman_actor = typed_actor< //
   result<uint16_t>(publish_atom, uint16_t, strong_actor_ptr,
                    std::set<std::string>, std::string, bool),
 
+  result<uint16_t>(publish_atom, uri, strong_actor_ptr, std::set<std::string>,
+                   bool),
+
   result<uint16_t>(open_atom, uint16_t, std::string, bool),
 
   result<node_id, strong_actor_ptr, std::set<std::string>>(
     connect_atom, std::string, uint16_t),
 
+  result<node_id, strong_actor_ptr, std::set<std::string>>(connect_atom, uri),
+
   result<void>(unpublish_atom, actor_addr, uint16_t),
 
   result<void>(close_atom, uint16_t),
@@ -8,6 +8,7 @@
 #include "caf/io/basp_broker.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
 #include "caf/io/network/interfaces.hpp"
+#include "caf/io/network/shm_channel.hpp"
 #include "caf/io/system_messages.hpp"
 
 #include "caf/actor.hpp"
@@ -18,6 +19,7 @@
 #include "caf/sec.hpp"
 #include "caf/send.hpp"
 #include "caf/typed_event_based_actor.hpp"
+#include "caf/uri.hpp"
 
 #include <stdexcept>
 #include <tuple>
@@ -72,58 +74,39 @@ auto middleman_actor_impl::make_behavior() -> behavior_type {
       mpi_set sigs;
       return put(port, whom, sigs, addr.c_str(), reuse);
     },
+    [=](publish_atom, uri& locator, strong_actor_ptr& whom, mpi_set& sigs,
+        bool reuse) -> put_res {
+      CAF_LOG_TRACE(CAF_ARG(locator));
+      auto& auth = locator.authority();
+      if (locator.scheme() == "tcp")
+        return put(auth.port, whom, sigs, auth.host_str().c_str(), reuse);
+      if (locator.scheme() != network::shm_scheme)
+        return make_error(sec::invalid_argument, "unsupported URI scheme",
+                          std::move(locator));
+      if (!network::is_local_host(auth.host_str()))
+        return make_error(sec::invalid_argument,
+                          "shm URIs must refer to the local host",
+                          std::move(locator));
+      return put_shm(auth.port, whom, sigs);
+    },
     [=](connect_atom, std::string& hostname, uint16_t port) -> get_res {
       CAF_LOG_TRACE(CAF_ARG(hostname) << CAF_ARG(port));
-      auto rp = make_response_promise();
-      endpoint key{std::move(hostname), port};
-      // respond immediately if endpoint is cached
-      auto x = cached_tcp(key);
-      if (x) {
-        CAF_LOG_DEBUG("found cached entry" << CAF_ARG(*x));
-        rp.deliver(get<0>(*x), get<1>(*x), get<2>(*x));
-        return get_delegated{};
-      }
-      // attach this promise to a pending request if possible
-      auto rps = pending(key);
-      if (rps) {
-        CAF_LOG_DEBUG("attach to pending request");
-        rps->emplace_back(std::move(rp));
-        return get_delegated{};
-      }
-      // connect to endpoint and initiate handhsake etc.
-      auto r = connect(key.first, port);
-      if (!r) {
-        rp.deliver(std::move(r.error()));
-        return get_delegated{};
-      }
-      auto& ptr = *r;
-      std::vector<response_promise> tmp{std::move(rp)};
-      pending_.emplace(key, std::move(tmp));
-      request(broker_, infinite, connect_atom_v, std::move(ptr), port)
-        .then(
-          [=](node_id& nid, strong_actor_ptr& addr, mpi_set& sigs) {
-            auto i = pending_.find(key);
-            if (i == pending_.end())
-              return;
-            if (nid && addr) {
-              monitor(addr);
-              cached_tcp_.emplace(key, std::make_tuple(nid, addr, sigs));
-            }
-            auto res = make_message(std::move(nid), std::move(addr),
-                                    std::move(sigs));
-            for (auto& promise : i->second)
-              promise.deliver(res);
-            pending_.erase(i);
-          },
-          [=](error& err) {
-            auto i = pending_.find(key);
-            if (i == pending_.end())
-              return;
-            for (auto& promise : i->second)
-              promise.deliver(err);
-            pending_.erase(i);
-          });
-      return get_delegated{};
+      return connect_endpoint(endpoint{std::move(hostname), port}, false);
+    },
+    [=](connect_atom, uri& locator) -> get_res {
+      CAF_LOG_TRACE(CAF_ARG(locator));
+      auto& auth = locator.authority();
+      if (locator.scheme() == "tcp")
+        return connect_endpoint(endpoint{auth.host_str(), auth.port}, false);
+      if (locator.scheme() != network::shm_scheme)
+        return make_error(sec::invalid_argument, "unsupported URI scheme",
+                          std::move(locator));
+      if (!network::is_local_host(auth.host_str()))
+        return make_error(sec::invalid_argument,
+                          "shm URIs must refer to the local host",
+                          std::move(locator));
+      // Use a key that cannot clash with any host name.
+      return connect_endpoint(endpoint{"shm://", auth.port}, true);
     },
     [=](unpublish_atom atm, actor_addr addr, uint16_t p) -> del_res {
       CAF_LOG_TRACE("");
@@ -193,9 +176,105 @@ middleman_actor_impl::put(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
     return std::move(res.error());
   auto& ptr = *res;
   actual_port = ptr->port();
-  anon_send(broker_, publish_atom_v, std::move(ptr), actual_port,
-            std::move(whom), std::move(sigs));
-  return actual_port;
+  // The broker rejects ports that already have a published actor, e.g., a
+  // shared memory doorman at the same port number.
+  auto rp = make_response_promise();
+  request(broker_, infinite, publish_atom_v, std::move(ptr), actual_port,
+          std::move(whom), std::move(sigs))
+    .then([rp, actual_port]() mutable { rp.deliver(actual_port); },
+          [rp](error& err) mutable { rp.deliver(std::move(err)); });
+  return delegated<uint16_t>{};
+}
+
+middleman_actor_impl::put_res
+middleman_actor_impl::put_shm(uint16_t port, strong_actor_ptr& whom,
+                              mpi_set& sigs) {
+  CAF_LOG_TRACE(CAF_ARG(port) << CAF_ARG(whom) << CAF_ARG(sigs));
+  auto rp = make_response_promise();
+  publish_shm(rp, port, std::move(whom), std::move(sigs), max_shm_attempts);
+  return delegated<uint16_t>{};
+}
+
+void middleman_actor_impl::publish_shm(response_promise rp, uint16_t port,
+                                       strong_actor_ptr whom, mpi_set sigs,
+                                       size_t attempts) {
+  CAF_LOG_TRACE(CAF_ARG(port) << CAF_ARG(whom) << CAF_ARG(sigs)
+                              << CAF_ARG(attempts));
+  auto res = open_shm(port);
+  if (!res) {
+    rp.deliver(std::move(res.error()));
+    return;
+  }
+  auto& ptr = *res;
+  auto actual_port = ptr->port();
+  // The broker rejects ports that already have a published actor. In this
+  // case, we pick another port unless the user has asked for this particular
+  // port.
+  request(broker_, infinite, publish_atom_v, std::move(ptr), actual_port, whom,
+          sigs)
+    .then([rp, actual_port]() mutable { rp.deliver(actual_port); },
+          [=](error& err) mutable {
+            if (port == 0 && attempts > 1 && err == sec::cannot_open_port)
+              publish_shm(std::move(rp), port, std::move(whom),
+                          std::move(sigs), attempts - 1);
+            else
+              rp.deliver(std::move(err));
+          });
+}
+
+middleman_actor_impl::get_res
+middleman_actor_impl::connect_endpoint(endpoint key, bool shm) {
+  CAF_LOG_TRACE(CAF_ARG(key) << CAF_ARG(shm));
+  auto rp = make_response_promise();
+  // respond immediately if endpoint is cached
+  auto x = cached_tcp(key);
+  if (x) {
+    CAF_LOG_DEBUG("found cached entry" << CAF_ARG(*x));
+    rp.deliver(get<0>(*x), get<1>(*x), get<2>(*x));
+    return get_delegated{};
+  }
+  // attach this promise to a pending request if possible
+  auto rps = pending(key);
+  if (rps) {
+    CAF_LOG_DEBUG("attach to pending request");
+    rps->emplace_back(std::move(rp));
+    return get_delegated{};
+  }
+  // connect to endpoint and initiate handhsake etc.
+  auto port = key.second;
+  auto r = shm ? connect_shm(port) : connect(key.first, port);
+  if (!r) {
+    rp.deliver(std::move(r.error()));
+    return get_delegated{};
+  }
+  auto& ptr = *r;
+  std::vector<response_promise> tmp{std::move(rp)};
+  pending_.emplace(key, std::move(tmp));
+  request(broker_, infinite, connect_atom_v, std::move(ptr), port)
+    .then(
+      [=](node_id& nid, strong_actor_ptr& addr, mpi_set& sigs) {
+        auto i = pending_.find(key);
+        if (i == pending_.end())
+          return;
+        if (nid && addr) {
+          monitor(addr);
+          cached_tcp_.emplace(key, std::make_tuple(nid, addr, sigs));
+        }
+        auto res = make_message(std::move(nid), std::move(addr),
+                                std::move(sigs));
+        for (auto& promise : i->second)
+          promise.deliver(res);
+        pending_.erase(i);
+      },
+      [=](error& err) {
+        auto i = pending_.find(key);
+        if (i == pending_.end())
+          return;
+        for (auto& promise : i->second)
+          promise.deliver(err);
+        pending_.erase(i);
+      });
+  return get_delegated{};
 }
 
 middleman_actor_impl::put_res
@@ -262,4 +341,12 @@ middleman_actor_impl::open_udp(uint16_t port, const char* addr, bool reuse) {
                                                                reuse);
 }
 
+expected<scribe_ptr> middleman_actor_impl::connect_shm(uint16_t port) {
+  return system().middleman().backend().new_shm_scribe(port);
+}
+
+expected<doorman_ptr> middleman_actor_impl::open_shm(uint16_t port) {
+  return system().middleman().backend().new_shm_doorman(port);
+}
+
 } // namespace caf::io
@@ -31,6 +31,9 @@ public:
 
   using endpoint = std::pair<std::string, uint16_t>;
 
+  /// Maximum number of ports that `put_shm` tries when asked for any port.
+  static constexpr size_t max_shm_attempts = 8;
+
   middleman_actor_impl(actor_config& cfg, actor default_broker);
 
   middleman_actor_impl(middleman_actor_impl&&) = delete;
@@ -67,6 +70,15 @@ protected:
   virtual expected<datagram_servant_ptr> open_udp(uint16_t port,
                                                   const char* addr, bool reuse);
 
+  /// Tries to connect to the shared memory doorman at `port`. The default
+  /// implementation calls
+  /// `system().middleman().backend().new_shm_scribe(port)`.
+  virtual expected<scribe_ptr> connect_shm(uint16_t port);
+
+  /// Tries to open a local shared memory port. The default implementation
+  /// calls `system().middleman().backend().new_shm_doorman(port)`.
+  virtual expected<doorman_ptr> open_shm(uint16_t port);
+
 private:
   put_res put(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
               const char* in = nullptr, bool reuse_addr = false);
@@ -74,6 +86,13 @@ private:
   put_res put_udp(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
                   const char* in = nullptr, bool reuse_addr = false);
 
+  put_res put_shm(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs);
+
+  void publish_shm(response_promise rp, uint16_t port, strong_actor_ptr whom,
+                   mpi_set sigs, size_t attempts);
+
+  get_res connect_endpoint(endpoint key, bool shm);
+
   endpoint_data* cached_tcp(const endpoint& ep);
   endpoint_data* cached_udp(const endpoint& ep);
 
@@ -22,14 +22,20 @@ constexpr size_t receive_buffer_size = std::numeric_limits<uint16_t>::max();
 namespace caf::io::network {
 
 datagram_handler::datagram_handler(default_multiplexer& backend_ref,
-                                   native_socket sockfd)
+                                   native_socket sockfd, size_t batch_size)
   : event_handler(backend_ref, sockfd),
     max_consecutive_reads_(get_or(backend().system().config(),
                                   "caf.middleman.max-consecutive-reads",
                                   defaults::middleman::max_consecutive_reads)),
     max_datagram_size_(receive_buffer_size),
-    rd_buf_(receive_buffer_size),
+    max_batch_size_(std::max(batch_size, size_t{1})),
+    num_datagrams_(0),
+    rd_pos_(0),
+    rd_bufs_(1),
+    rd_sizes_(1),
+    rd_senders_(1),
     send_buffer_size_(0) {
+  rd_bufs_.front().resize(max_datagram_size_);
   allow_udp_connreset(sockfd, false);
   auto es = send_buffer_size(sockfd);
   if (!es)
@@ -139,56 +145,82 @@ void datagram_handler::graceful_shutdown() {
 }
 
 void datagram_handler::prepare_next_read() {
-  CAF_LOG_TRACE(CAF_ARG(wr_buf_.second.size())
-                << CAF_ARG(wr_offline_buf_.size()));
-  rd_buf_.resize(max_datagram_size_);
+  CAF_LOG_TRACE(CAF_ARG(wr_offline_buf_.size()));
+  rd_bufs_[rd_pos_].resize(max_datagram_size_);
 }
 
 void datagram_handler::prepare_next_write() {
   CAF_LOG_TRACE(CAF_ARG(wr_offline_buf_.size()));
-  wr_buf_.second.clear();
   if (wr_offline_buf_.empty()) {
     state_.writing = false;
     backend().del(operation::write, fd(), this);
-  } else {
-    wr_buf_.swap(wr_offline_buf_.front());
-    wr_offline_buf_.pop_front();
   }
 }
 
 bool datagram_handler::handle_read_result(bool read_result) {
-  if (!read_result) {
-    reader_->io_failure(&backend(), operation::read);
-    passivate();
-    return false;
-  }
-  if (num_bytes_ > 0) {
-    rd_buf_.resize(num_bytes_);
-    auto itr = hdl_by_ep_.find(sender_);
+  // Deliver all datagrams of the batch before reporting an error.
+  for (rd_pos_ = 0; rd_pos_ < num_datagrams_; ++rd_pos_) {
+    if (rd_sizes_[rd_pos_] == 0)
+      continue;
+    auto& buf = rd_bufs_[rd_pos_];
+    buf.resize(rd_sizes_[rd_pos_]);
+    auto itr = hdl_by_ep_.find(rd_senders_[rd_pos_]);
     bool consumed = false;
     if (itr == hdl_by_ep_.end())
-      consumed = reader_->new_endpoint(rd_buf_);
+      consumed = reader_->new_endpoint(buf);
     else
-      consumed = reader_->consume(&backend(), itr->second, rd_buf_);
+      consumed = reader_->consume(&backend(), itr->second, buf);
     prepare_next_read();
     if (!consumed) {
+      rd_pos_ = 0;
       passivate();
       return false;
     }
   }
+  rd_pos_ = 0;
+  if (!read_result) {
+    reader_->io_failure(&backend(), operation::read);
+    passivate();
+    return false;
+  }
+  if (num_datagrams_ == rd_bufs_.size())
+    grow_read_buffers();
   return true;
 }
 
+void datagram_handler::grow_read_buffers() {
+  // Each buffer holds up to 64 KiB. Hence, we only add buffers while the
+  // socket has enough datagrams queued to fill all of them.
+  auto n = std::min(rd_bufs_.size() * 2, max_batch_size_);
+  if (n == rd_bufs_.size())
+    return;
+  CAF_LOG_DEBUG("grow receive buffers:" << CAF_ARG(n));
+  rd_bufs_.resize(n);
+  rd_sizes_.resize(n);
+  rd_senders_.resize(n);
+  for (auto& buf : rd_bufs_)
+    buf.resize(max_datagram_size_);
+}
+
 void datagram_handler::handle_write_result(bool write_result,
-                                           datagram_handle id, byte_buffer& buf,
-                                           size_t wb) {
+                                           size_t num_sent) {
+  // Acknowledge all datagrams that made it to the wire before reporting an
+  // error.
+  CAF_ASSERT(num_sent <= wr_offline_buf_.size());
+  for (size_t i = 0; i < num_sent; ++i) {
+    // Remove the job before calling the writer, since the writer may enqueue
+    // new datagrams.
+    auto [id, buf] = std::move(wr_offline_buf_.front());
+    wr_offline_buf_.pop_front();
+    if (state_.ack_writes && writer_) {
+      auto wb = buf.size();
+      writer_->datagram_sent(&backend(), id, wb, std::move(buf));
+    }
+  }
   if (!write_result) {
     writer_->io_failure(&backend(), operation::write);
     backend().del(operation::write, fd(), this);
-  } else if (wb > 0) {
-    CAF_ASSERT(wb == buf.size());
-    if (state_.ack_writes)
-      writer_->datagram_sent(&backend(), id, wb, std::move(buf));
+  } else if (num_sent > 0) {
     prepare_next_write();
   } else {
     if (writer_)
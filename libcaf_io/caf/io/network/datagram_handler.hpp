@@ -17,6 +17,8 @@
 #include "caf/raise_error.hpp"
 #include "caf/ref_counted.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <unordered_map>
 #include <vector>
 
@@ -32,7 +34,11 @@ public:
   /// A job for sending a datagram consisting of the sender and a buffer.
   using job_type = std::pair<datagram_handle, byte_buffer>;
 
-  datagram_handler(default_multiplexer& backend_ref, native_socket sockfd);
+  /// Creates a handler that receives and sends up to `batch_size` datagrams
+  /// per system call. The handler starts with a single receive buffer and
+  /// only adds more buffers while it receives full batches.
+  datagram_handler(default_multiplexer& backend_ref, native_socket sockfd,
+                   size_t batch_size);
 
   /// Starts reading data from the socket, forwarding incoming data to `mgr`.
   void start(datagram_manager* mgr);
@@ -60,11 +66,12 @@ public:
     wr_offline_buf_.emplace_back(hdl, std::move(buf));
   }
 
-  /// Returns the read buffer of this stream.
+  /// Returns the read buffer of the datagram that this handler currently
+  /// dispatches to its manager.
   /// @warning Must not be modified outside the IO multiplexers event loop
   ///          once the stream has been started.
   read_buffer_type& rd_buf() {
-    return rd_buf_;
+    return rd_bufs_[rd_pos_];
   }
 
   /// Sends the content of the write buffer, calling the `io_failure`
@@ -90,7 +97,7 @@ public:
   void remove_endpoint(datagram_handle hdl);
 
   ip_endpoint& sending_endpoint() {
-    return sender_;
+    return rd_senders_[rd_pos_];
   }
 
 protected:
@@ -102,31 +109,39 @@ protected:
       case io::network::operation::read: {
         // Loop until an error occurs or we have nothing more to read
         // or until we have handled `mcr` reads.
-        for (size_t i = 0; i < mcr; ++i) {
-          auto res = policy.read_datagram(num_bytes_, fd(), rd_buf_.data(),
-                                          rd_buf_.size(), sender_);
-          if (!handle_read_result(res))
+        for (size_t i = 0; i < mcr;) {
+          auto n = std::min(mcr - i, rd_bufs_.size());
+          auto res = policy.read_datagrams(num_datagrams_, fd(),
+                                           rd_bufs_.data(), rd_sizes_.data(),
+                                           rd_senders_.data(), n);
+          if (!handle_read_result(res) || num_datagrams_ < n)
             return;
+          i += n;
         }
         break;
       }
       case io::network::operation::write: {
-        size_t wb; // written bytes
-        auto itr = ep_by_hdl_.find(wr_buf_.first);
-        // maybe this could be an assert?
-        if (itr == ep_by_hdl_.end())
-          CAF_RAISE_ERROR("got write event for undefined endpoint");
-        auto& id = itr->first;
-        auto& ep = itr->second;
-        byte_buffer buf;
-        std::swap(buf, wr_buf_.second);
-        auto size_as_int = static_cast<int>(buf.size());
-        if (size_as_int > send_buffer_size_) {
-          send_buffer_size_ = size_as_int;
-          send_buffer_size(fd(), size_as_int);
+        // Send as many queued datagrams as possible with a single batch.
+        const byte_buffer* bufs[Policy::max_batch_size];
+        const ip_endpoint* eps[Policy::max_batch_size];
+        auto n = std::min(wr_offline_buf_.size(), Policy::max_batch_size);
+        for (size_t i = 0; i < n; ++i) {
+          auto& [hdl, buf] = wr_offline_buf_[i];
+          auto itr = ep_by_hdl_.find(hdl);
+          // maybe this could be an assert?
+          if (itr == ep_by_hdl_.end())
+            CAF_RAISE_ERROR("got write event for undefined endpoint");
+          auto size_as_int = static_cast<int>(buf.size());
+          if (size_as_int > send_buffer_size_) {
+            send_buffer_size_ = size_as_int;
+            send_buffer_size(fd(), size_as_int);
+          }
+          bufs[i] = &buf;
+          eps[i] = &itr->second;
         }
-        auto res = policy.write_datagram(wb, fd(), buf.data(), buf.size(), ep);
-        handle_write_result(res, id, buf, wb);
+        size_t num_sent = 0;
+        auto res = policy.write_datagrams(num_sent, fd(), bufs, eps, n);
+        handle_write_result(res, num_sent);
         break;
       }
       case operation::propagate_error:
@@ -144,8 +159,9 @@ private:
 
   bool handle_read_result(bool read_result);
 
-  void handle_write_result(bool write_result, datagram_handle id,
-                           byte_buffer& buf, size_t wb);
+  void grow_read_buffers();
+
+  void handle_write_result(bool write_result, size_t num_sent);
 
   void handle_error();
 
@@ -153,17 +169,20 @@ private:
   std::unordered_map<ip_endpoint, datagram_handle> hdl_by_ep_;
   std::unordered_map<datagram_handle, ip_endpoint> ep_by_hdl_;
 
-  // state for reading
+  // state for reading, whereby the handler receives datagrams in batches and
+  // then dispatches them one by one
   const size_t max_datagram_size_;
-  size_t num_bytes_;
-  read_buffer_type rd_buf_;
+  const size_t max_batch_size_;
+  size_t num_datagrams_;
+  size_t rd_pos_;
+  std::vector<read_buffer_type> rd_bufs_;
+  std::vector<size_t> rd_sizes_;
+  std::vector<ip_endpoint> rd_senders_;
   manager_ptr reader_;
-  ip_endpoint sender_;
 
   // state for writing
   int send_buffer_size_;
   std::deque<job_type> wr_offline_buf_;
-  job_type wr_buf_;
   manager_ptr writer_;
 };
 
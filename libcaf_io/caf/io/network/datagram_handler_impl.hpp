@@ -18,7 +18,8 @@ public:
   template <class... Ts>
   datagram_handler_impl(default_multiplexer& mpx, native_socket sockfd,
                         Ts&&... xs)
-    : datagram_handler(mpx, sockfd), policy_(std::forward<Ts>(xs)...) {
+    : datagram_handler(mpx, sockfd, ProtocolPolicy::max_batch_size),
+      policy_(std::forward<Ts>(xs)...) {
     // nop
   }
 
@@ -11,6 +11,9 @@
 #include "caf/io/network/interfaces.hpp"
 #include "caf/io/network/protocol.hpp"
 #include "caf/io/network/scribe_impl.hpp"
+#include "caf/io/network/shm_channel.hpp"
+#include "caf/io/network/shm_doorman.hpp"
+#include "caf/io/network/shm_scribe.hpp"
 
 #include "caf/actor_system_config.hpp"
 #include "caf/config.hpp"
@@ -683,6 +686,25 @@ expected<doorman_ptr> default_multiplexer::new_tcp_doorman(uint16_t port,
   return std::move(fd.error());
 }
 
+expected<scribe_ptr> default_multiplexer::new_shm_scribe(uint16_t port) {
+  CAF_LOG_TRACE(CAF_ARG(port));
+  auto res = shm_channel::connect(port);
+  if (!res)
+    return std::move(res.error());
+  auto& [efd, channel] = *res;
+  return make_counted<shm_scribe>(*this, efd, std::move(channel));
+}
+
+expected<doorman_ptr> default_multiplexer::new_shm_doorman(uint16_t port) {
+  CAF_LOG_TRACE(CAF_ARG(port));
+  auto res = new_shm_acceptor_impl(port);
+  if (!res)
+    return std::move(res.error());
+  auto capacity = get_or(system().config(), "caf.middleman.shm-buffer-size",
+                         defaults::middleman::shm_buffer_size);
+  return make_counted<shm_doorman>(*this, res->first, res->second, capacity);
+}
+
 datagram_servant_ptr
 default_multiplexer::new_datagram_servant(native_socket fd) {
   CAF_LOG_TRACE(CAF_ARG(fd));
@@ -109,6 +109,10 @@ public:
   expected<doorman_ptr> new_tcp_doorman(uint16_t port, const char* in,
                                         bool reuse_addr) override;
 
+  expected<scribe_ptr> new_shm_scribe(uint16_t port) override;
+
+  expected<doorman_ptr> new_shm_doorman(uint16_t port) override;
+
   datagram_servant_ptr new_datagram_servant(native_socket fd) override;
 
   datagram_servant_ptr
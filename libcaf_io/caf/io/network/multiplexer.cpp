@@ -6,6 +6,8 @@
 
 #include "caf/io/network/default_multiplexer.hpp" // default singleton
 
+#include "caf/sec.hpp"
+
 namespace caf::io::network {
 
 multiplexer::multiplexer(actor_system* sys)
@@ -18,6 +20,16 @@ multiplexer_ptr multiplexer::make(actor_system& sys) {
   return multiplexer_ptr{new default_multiplexer(&sys)};
 }
 
+expected<scribe_ptr> multiplexer::new_shm_scribe(uint16_t) {
+  return make_error(sec::unsupported_operation,
+                    "multiplexer does not support shared memory");
+}
+
+expected<doorman_ptr> multiplexer::new_shm_doorman(uint16_t) {
+  return make_error(sec::unsupported_operation,
+                    "multiplexer does not support shared memory");
+}
+
 multiplexer_backend* multiplexer::pimpl() {
   return nullptr;
 }
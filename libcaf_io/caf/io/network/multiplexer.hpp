@@ -53,6 +53,17 @@ public:
                                                 bool reuse_addr = false)
     = 0;
 
+  /// Tries to connect to the shared memory doorman at `port` on the local
+  /// host and returns a `scribe` instance on success. The default
+  /// implementation returns `sec::unsupported_operation`.
+  /// @threadsafe
+  virtual expected<scribe_ptr> new_shm_scribe(uint16_t port);
+
+  /// Tries to create a doorman for shared memory connections bound to `port`.
+  /// The default implementation returns `sec::unsupported_operation`.
+  /// @warning Do not call from outside the multiplexer's event loop.
+  virtual expected<doorman_ptr> new_shm_doorman(uint16_t port);
+
   /// Creates a new `datagram_servant` from a native socket handle.
   /// @threadsafe
   virtual datagram_servant_ptr new_datagram_servant(native_socket fd) = 0;
@@ -0,0 +1,490 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/io/network/shm_channel.hpp"
+
+#include "caf/config.hpp"
+#include "caf/detail/call_cfun.hpp"
+#include "caf/detail/socket_guard.hpp"
+#include "caf/logger.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+
+#ifdef CAF_LINUX
+#  include <sys/eventfd.h>
+#  include <sys/mman.h>
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/time.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+namespace caf::io::network {
+
+namespace {
+
+/// Identifies the handshake of a shared memory acceptor and the layout of its
+/// segments. Both sides must agree on the layout of `shm_channel::ring`.
+constexpr uint32_t shm_magic = 0xCAF5'0001;
+
+/// Each ring has at least this many bytes.
+constexpr size_t min_shm_capacity = 4096;
+
+/// Each ring has at most this many bytes.
+constexpr size_t max_shm_capacity = size_t{1} << 30;
+
+/// Receiving the segment from an acceptor takes at most this many seconds.
+constexpr time_t shm_connect_timeout = 10;
+
+/// Separates the members of the control block that different sides modify.
+constexpr size_t shm_cache_line_size = 64;
+
+} // namespace
+
+struct shm_channel::ring {
+  /// Stores the number of bytes the writer has written so far.
+  alignas(shm_cache_line_size) std::atomic<uint64_t> head;
+
+  /// Stores the number of bytes the reader has consumed so far.
+  alignas(shm_cache_line_size) std::atomic<uint64_t> tail;
+
+  /// Signals that the writer waits for the reader to make room.
+  alignas(shm_cache_line_size) std::atomic<uint32_t> writer_waiting;
+
+  /// Signals that the writer has shut down.
+  std::atomic<uint32_t> closed;
+
+  /// Stores the size of the buffer, which is always a power of two.
+  uint64_t capacity;
+
+  std::byte* data() noexcept {
+    return reinterpret_cast<std::byte*>(this + 1);
+  }
+};
+
+bool is_local_host(std::string_view host) noexcept {
+  return host.empty() || host == "localhost" || host == "127.0.0.1"
+         || host == "::1" || host == "[::1]";
+}
+
+#ifdef CAF_LINUX
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared memory channels require lock-free 64-bit atomics");
+
+static_assert(sizeof(shm_channel::ring) % shm_cache_line_size == 0);
+
+namespace {
+
+using ring = shm_channel::ring;
+
+size_t segment_size_for(size_t capacity) {
+  return 2 * (sizeof(ring) + capacity);
+}
+
+size_t normalize_capacity(size_t capacity) {
+  auto result = min_shm_capacity;
+  while (result < capacity && result < max_shm_capacity)
+    result <<= 1;
+  return result;
+}
+
+ring* second_ring(void* segment, size_t capacity) {
+  return reinterpret_cast<ring*>(static_cast<std::byte*>(segment)
+                                 + sizeof(ring) + capacity);
+}
+
+void notify(native_socket efd) {
+  uint64_t one = 1;
+  // Fails only if the counter would overflow, i.e., the other side has
+  // pending wakeups anyway.
+  [[maybe_unused]] auto res = ::write(efd, &one, sizeof(one));
+}
+
+void drain(native_socket efd) {
+  uint64_t tmp = 0;
+  [[maybe_unused]] auto res = ::read(efd, &tmp, sizeof(tmp));
+}
+
+std::pair<sockaddr_un, socklen_t> shm_address(uint16_t port) {
+  // Use the abstract namespace to have the kernel clean up after us.
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  auto name = "caf-shm-" + std::to_string(port);
+  std::memcpy(addr.sun_path + 1, name.data(), name.size());
+  auto len = offsetof(sockaddr_un, sun_path) + 1 + name.size();
+  return {addr, static_cast<socklen_t>(len)};
+}
+
+} // namespace
+
+shm_channel::shm_channel(void* segment, size_t segment_size, size_t capacity,
+                         ring* in, ring* out, native_socket peer_fd,
+                         uint16_t port) noexcept
+  : segment_(segment),
+    segment_size_(segment_size),
+    capacity_(capacity),
+    in_(in),
+    out_(out),
+    peer_fd_(peer_fd),
+    port_(port) {
+  // nop
+}
+
+shm_channel::shm_channel(shm_channel&& other) noexcept
+  : segment_(std::exchange(other.segment_, nullptr)),
+    segment_size_(std::exchange(other.segment_size_, 0)),
+    capacity_(std::exchange(other.capacity_, 0)),
+    in_(std::exchange(other.in_, nullptr)),
+    out_(std::exchange(other.out_, nullptr)),
+    peer_fd_(std::exchange(other.peer_fd_, invalid_native_socket)),
+    port_(other.port_) {
+  // nop
+}
+
+shm_channel& shm_channel::operator=(shm_channel&& other) noexcept {
+  shm_channel tmp{std::move(other)};
+  std::swap(segment_, tmp.segment_);
+  std::swap(segment_size_, tmp.segment_size_);
+  std::swap(capacity_, tmp.capacity_);
+  std::swap(in_, tmp.in_);
+  std::swap(out_, tmp.out_);
+  std::swap(peer_fd_, tmp.peer_fd_);
+  std::swap(port_, tmp.port_);
+  return *this;
+}
+
+shm_channel::~shm_channel() {
+  if (segment_ == nullptr)
+    return;
+  // Make sure the other side notices if we go away without a graceful
+  // shutdown. Otherwise, it would wait for data forever.
+  shutdown_write();
+  ::munmap(segment_, segment_size_);
+  close_socket(peer_fd_);
+}
+
+size_t shm_channel::capacity() const noexcept {
+  return capacity_;
+}
+
+rw_state shm_channel::read_some(size_t& result, native_socket fd, void* buf,
+                                size_t len) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(len));
+  result = 0;
+  auto tail = in_->tail.load(std::memory_order_relaxed);
+  auto head = in_->head.load(std::memory_order_acquire);
+  if (head == tail) {
+    // Consume pending wakeups before checking the ring again. Otherwise, we
+    // could miss data that arrives in between.
+    // The reloads of `head` must be sequentially consistent. Otherwise, they
+    // could miss data from a writer that saw the old `tail` in its check for
+    // an empty ring and therefore did not signal the eventfd again.
+    drain(fd);
+    head = in_->head.load();
+    if (head == tail) {
+      if (in_->closed.load(std::memory_order_acquire) != 0
+          && in_->head.load() == tail)
+        return rw_state::failure;
+      return rw_state::success;
+    }
+    // We may have consumed the wakeup for this data. Restore it in case the
+    // stream stops reading before the ring becomes empty.
+    notify(fd);
+  }
+  auto cap = capacity_;
+  if (head - tail > cap) {
+    CAF_LOG_ERROR("the other side corrupted the inbound ring");
+    return rw_state::failure;
+  }
+  auto n = static_cast<size_t>(std::min(head - tail, uint64_t{len}));
+  auto offset = static_cast<size_t>(tail & (cap - 1));
+  auto first = std::min(n, cap - offset);
+  auto dst = static_cast<std::byte*>(buf);
+  std::memcpy(dst, in_->data() + offset, first);
+  std::memcpy(dst + first, in_->data(), n - first);
+  in_->tail.store(tail + n);
+  // The writer sets the flag before checking for room once more. Hence, it
+  // either sees the new tail or we see the flag.
+  if (in_->writer_waiting.load() != 0 && in_->writer_waiting.exchange(0) != 0)
+    notify(peer_fd_);
+  result = n;
+  return rw_state::success;
+}
+
+bool shm_channel::write_to_ring(size_t& result, const std::byte* buf,
+                                size_t len) {
+  result = 0;
+  auto cap = capacity_;
+  auto head = out_->head.load(std::memory_order_relaxed);
+  auto tail = out_->tail.load();
+  if (head - tail > cap) {
+    CAF_LOG_ERROR("the other side corrupted the outbound ring");
+    return false;
+  }
+  auto n = static_cast<size_t>(std::min(cap - (head - tail), uint64_t{len}));
+  if (n == 0)
+    return true;
+  auto offset = static_cast<size_t>(head & (cap - 1));
+  auto first = std::min(n, cap - offset);
+  std::memcpy(out_->data() + offset, buf, first);
+  std::memcpy(out_->data(), buf + first, n - first);
+  out_->head.store(head + n);
+  // A reader that still has unread data picks up our bytes without further
+  // notice. Only a reader that has caught up may wait on its eventfd.
+  if (out_->tail.load() == head)
+    notify(peer_fd_);
+  result = n;
+  return true;
+}
+
+rw_state shm_channel::write_some(size_t& result, native_socket,
+                                 const void* buf, size_t len) {
+  CAF_LOG_TRACE(CAF_ARG(len));
+  auto bytes = static_cast<const std::byte*>(buf);
+  result = 0;
+  size_t n = 0;
+  if (!write_to_ring(n, bytes, len))
+    return rw_state::failure;
+  if (n < len) {
+    // Ask the reader to wake us up and try again, because the reader may have
+    // made room before it could see the flag.
+    out_->writer_waiting.store(1);
+    size_t m = 0;
+    if (!write_to_ring(m, bytes + n, len - n))
+      return rw_state::failure;
+    n += m;
+  }
+  result = n;
+  return n < len ? rw_state::want_read : rw_state::success;
+}
+
+void shm_channel::shutdown_write() {
+  if (out_ == nullptr || out_->closed.exchange(1) != 0)
+    return;
+  notify(peer_fd_);
+}
+
+expected<std::pair<native_socket, shm_channel>>
+shm_channel::accept(native_socket conn, size_t capacity, uint16_t port) {
+  CAF_LOG_TRACE(CAF_ARG(conn) << CAF_ARG(capacity) << CAF_ARG(port));
+  detail::socket_guard conn_guard{conn};
+  capacity = normalize_capacity(capacity);
+  auto segment_size = segment_size_for(capacity);
+  CALL_CFUN(mfd, detail::cc_not_minus1, "memfd_create",
+            ::memfd_create("caf-shm", MFD_CLOEXEC));
+  detail::socket_guard mfd_guard{mfd};
+  CALL_CFUN(res, detail::cc_zero, "ftruncate",
+            ::ftruncate(mfd, static_cast<off_t>(segment_size)));
+  auto segment = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, mfd, 0);
+  if (segment == MAP_FAILED)
+    return make_error(sec::network_syscall_failed, "mmap",
+                      last_socket_error_as_string());
+  // The kernel fills new segments with zeros, so the rings start out empty.
+  auto in = new (segment) ring;
+  auto out = new (second_ring(segment, capacity)) ring;
+  in->capacity = capacity;
+  out->capacity = capacity;
+  auto own_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  auto peer_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  // The channel owns the segment and the eventfd of the other side from here.
+  shm_channel result{segment, segment_size, capacity, in, out, peer_fd, port};
+  detail::socket_guard own_guard{own_fd};
+  if (own_fd == -1 || peer_fd == -1)
+    return make_error(sec::network_syscall_failed, "eventfd",
+                      last_socket_error_as_string());
+  // Pass the segment and both eventfds to the other side, which uses our
+  // eventfd for writing and its own eventfd for reading.
+  int fds[3] = {mfd, peer_fd, own_fd};
+  auto magic = shm_magic;
+  iovec iov{&magic, sizeof(magic)};
+  alignas(cmsghdr) char ctrl[CMSG_SPACE(sizeof(fds))];
+  std::memset(ctrl, 0, sizeof(ctrl));
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctrl;
+  msg.msg_controllen = sizeof(ctrl);
+  auto cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+  CALL_CFUN(sent, detail::cc_not_minus1, "sendmsg",
+            ::sendmsg(conn, &msg, MSG_NOSIGNAL));
+  if (static_cast<size_t>(sent) != sizeof(magic))
+    return make_error(sec::network_syscall_failed, "sendmsg",
+                      "unable to send the shared memory segment");
+  return std::make_pair(own_guard.release(), std::move(result));
+}
+
+expected<std::pair<native_socket, shm_channel>>
+shm_channel::connect(uint16_t port) {
+  CAF_LOG_TRACE(CAF_ARG(port));
+  CALL_CFUN(fd, detail::cc_valid_socket, "socket",
+            ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+  detail::socket_guard guard{fd};
+  auto [addr, addr_len] = shm_address(port);
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0)
+    return make_error(sec::cannot_connect_to_node,
+                      "no shared memory acceptor found", port);
+  timeval tv{shm_connect_timeout, 0};
+  CALL_CFUN(res, detail::cc_zero, "setsockopt",
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)));
+  int fds[3] = {-1, -1, -1};
+  uint32_t magic = 0;
+  iovec iov{&magic, sizeof(magic)};
+  alignas(cmsghdr) char ctrl[CMSG_SPACE(sizeof(fds))];
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctrl;
+  msg.msg_controllen = sizeof(ctrl);
+  CALL_CFUN(received, detail::cc_not_minus1, "recvmsg",
+            ::recvmsg(fd, &msg, MSG_CMSG_CLOEXEC));
+  if (auto cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET
+      && cmsg->cmsg_type == SCM_RIGHTS
+      && cmsg->cmsg_len == CMSG_LEN(sizeof(fds)))
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+  detail::socket_guard mfd_guard{fds[0]};
+  detail::socket_guard own_guard{fds[1]};
+  detail::socket_guard peer_guard{fds[2]};
+  if (static_cast<size_t>(received) != sizeof(magic) || magic != shm_magic
+      || fds[0] == -1)
+    return make_error(sec::cannot_connect_to_node,
+                      "received an invalid shared memory handshake", port);
+  struct stat info;
+  CALL_CFUN(stat_res, detail::cc_zero, "fstat", ::fstat(fds[0], &info));
+  auto segment_size = static_cast<size_t>(info.st_size);
+  if (segment_size < segment_size_for(min_shm_capacity))
+    return make_error(sec::cannot_connect_to_node,
+                      "received an invalid shared memory segment", port);
+  auto segment = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fds[0], 0);
+  if (segment == MAP_FAILED)
+    return make_error(sec::network_syscall_failed, "mmap",
+                      last_socket_error_as_string());
+  // The acceptor reads from the first ring and writes to the second one.
+  auto out = std::launder(reinterpret_cast<ring*>(segment));
+  auto capacity = static_cast<size_t>(out->capacity);
+  if (capacity < min_shm_capacity || (capacity & (capacity - 1)) != 0
+      || segment_size != segment_size_for(capacity)) {
+    ::munmap(segment, segment_size);
+    return make_error(sec::cannot_connect_to_node,
+                      "received an invalid shared memory segment", port);
+  }
+  auto in = std::launder(second_ring(segment, capacity));
+  shm_channel result{segment, segment_size, capacity, in, out,
+                     peer_guard.release(), port};
+  return std::make_pair(own_guard.release(), std::move(result));
+}
+
+expected<std::pair<native_socket, uint16_t>>
+new_shm_acceptor_impl(uint16_t port) {
+  CAF_LOG_TRACE(CAF_ARG(port));
+  CALL_CFUN(fd, detail::cc_valid_socket, "socket",
+            ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+  detail::socket_guard guard{fd};
+  auto try_bind = [fd](uint16_t x) {
+    auto [addr, addr_len] = shm_address(x);
+    return ::bind(fd, reinterpret_cast<sockaddr*>(&addr), addr_len) == 0;
+  };
+  if (port != 0) {
+    if (!try_bind(port))
+      return make_error(sec::cannot_open_port, "shm bind failed", port,
+                        last_socket_error_as_string());
+  } else {
+    // Pick a random port from the dynamic range and probe from there.
+    constexpr uint32_t first_port = 49152;
+    constexpr uint32_t num_ports = 65536 - first_port;
+    std::random_device rd;
+    auto offset = std::uniform_int_distribution<uint32_t>{0, num_ports - 1}(rd);
+    for (uint32_t i = 0; i < num_ports && port == 0; ++i) {
+      auto candidate = static_cast<uint16_t>(first_port
+                                             + (offset + i) % num_ports);
+      if (try_bind(candidate))
+        port = candidate;
+    }
+    if (port == 0)
+      return make_error(sec::cannot_open_port, "no free shm port available");
+  }
+  CALL_CFUN(res, detail::cc_zero, "listen", ::listen(fd, SOMAXCONN));
+  return std::make_pair(guard.release(), port);
+}
+
+#else // CAF_LINUX
+
+shm_channel::shm_channel(void*, size_t, size_t, ring*, ring*, native_socket,
+                         uint16_t) noexcept {
+  // nop
+}
+
+shm_channel::shm_channel(shm_channel&&) noexcept {
+  // nop
+}
+
+shm_channel& shm_channel::operator=(shm_channel&&) noexcept {
+  return *this;
+}
+
+shm_channel::~shm_channel() {
+  // nop
+}
+
+size_t shm_channel::capacity() const noexcept {
+  return 0;
+}
+
+rw_state shm_channel::read_some(size_t& result, native_socket, void*, size_t) {
+  result = 0;
+  return rw_state::failure;
+}
+
+bool shm_channel::write_to_ring(size_t& result, const std::byte*, size_t) {
+  result = 0;
+  return false;
+}
+
+rw_state shm_channel::write_some(size_t& result, native_socket, const void*,
+                                 size_t) {
+  result = 0;
+  return rw_state::failure;
+}
+
+void shm_channel::shutdown_write() {
+  // nop
+}
+
+expected<std::pair<native_socket, shm_channel>>
+shm_channel::accept(native_socket conn, size_t, uint16_t) {
+  close_socket(conn);
+  return make_error(sec::unsupported_operation,
+                    "shared memory channels require Linux");
+}
+
+expected<std::pair<native_socket, shm_channel>> shm_channel::connect(uint16_t) {
+  return make_error(sec::unsupported_operation,
+                    "shared memory channels require Linux");
+}
+
+expected<std::pair<native_socket, uint16_t>> new_shm_acceptor_impl(uint16_t) {
+  return make_error(sec::unsupported_operation,
+                    "shared memory channels require Linux");
+}
+
+#endif // CAF_LINUX
+
+} // namespace caf::io::network
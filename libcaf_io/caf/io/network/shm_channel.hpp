@@ -0,0 +1,135 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/rw_state.hpp"
+
+#include "caf/detail/io_export.hpp"
+#include "caf/expected.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+namespace caf::io::network {
+
+/// Names the URI scheme for shared memory connections.
+constexpr std::string_view shm_scheme = "shm";
+
+/// Transfers bytes between two nodes on the same host through a pair of
+/// single-producer, single-consumer ring buffers in a shared memory segment.
+/// Each side of the channel waits on its own eventfd, which the other side
+/// signals only after writing to an empty ring or after making room for a
+/// blocked writer. Hence, a busy channel transfers data without any system
+/// call.
+///
+/// The channel implements the policy interface of `stream_impl`, whereby the
+/// file descriptor of the stream is the eventfd of this side. Writing to a full
+/// ring returns `rw_state::want_read`, i.e., the stream stops writing until the
+/// reader has made room and signals the eventfd.
+/// @note Shared memory channels are only available on Linux.
+class CAF_IO_EXPORT shm_channel {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// The control block of a ring buffer in shared memory.
+  struct ring;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  shm_channel() = default;
+
+  shm_channel(shm_channel&& other) noexcept;
+
+  shm_channel& operator=(shm_channel&& other) noexcept;
+
+  shm_channel(const shm_channel&) = delete;
+
+  shm_channel& operator=(const shm_channel&) = delete;
+
+  /// Marks the outbound ring as closed, unmaps the shared memory segment and
+  /// closes the eventfd of the other side.
+  ~shm_channel();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the port of the acceptor for this channel.
+  uint16_t port() const noexcept {
+    return port_;
+  }
+
+  /// Returns the capacity of each ring buffer in bytes.
+  size_t capacity() const noexcept;
+
+  // -- protocol policy interface ----------------------------------------------
+
+  /// Copies up to `len` bytes from the inbound ring to `buf`. Returns
+  /// `rw_state::failure` once the ring is empty and the other side has closed
+  /// the channel.
+  rw_state read_some(size_t& result, native_socket fd, void* buf, size_t len);
+
+  /// Copies up to `len` bytes from `buf` to the outbound ring.
+  rw_state write_some(size_t& result, native_socket fd, const void* buf,
+                      size_t len);
+
+  /// Always returns `false`, because the channel never leaves data behind.
+  static constexpr bool must_read_more(native_socket, size_t) {
+    return false;
+  }
+
+  // -- graceful shutdown ------------------------------------------------------
+
+  /// Tells the other side that this side is not going to write any more data.
+  void shutdown_write();
+
+  // -- factory functions ------------------------------------------------------
+
+  /// Creates a new shared memory segment with two rings of `capacity` bytes
+  /// each and passes it to the other side via the Unix domain socket `conn`,
+  /// which this function closes afterwards.
+  /// @returns The eventfd for this side along with the channel.
+  static expected<std::pair<native_socket, shm_channel>>
+  accept(native_socket conn, size_t capacity, uint16_t port);
+
+  /// Connects to the shared memory acceptor at `port` and receives the shared
+  /// memory segment from it.
+  /// @returns The eventfd for this side along with the channel.
+  static expected<std::pair<native_socket, shm_channel>>
+  connect(uint16_t port);
+
+private:
+  shm_channel(void* segment, size_t segment_size, size_t capacity, ring* in,
+              ring* out, native_socket peer_fd, uint16_t port) noexcept;
+
+  /// Copies up to `len` bytes to the outbound ring and stores the number of
+  /// bytes in `result`. Returns `false` if the control block is corrupted.
+  bool write_to_ring(size_t& result, const std::byte* buf, size_t len);
+
+  void* segment_ = nullptr;
+  size_t segment_size_ = 0;
+
+  /// Caches the validated capacity of both rings. The other side may modify
+  /// the control blocks at any time, so we never read it from there again.
+  size_t capacity_ = 0;
+
+  ring* in_ = nullptr;
+  ring* out_ = nullptr;
+  native_socket peer_fd_ = invalid_native_socket;
+  uint16_t port_ = 0;
+};
+
+/// Creates a listening Unix domain socket for shared memory connections on
+/// `port` or on an unused port if `port == 0`. Shared memory ports use the
+/// abstract socket namespace and thus never conflict with TCP ports.
+/// @returns The socket along with the port.
+CAF_IO_EXPORT expected<std::pair<native_socket, uint16_t>>
+new_shm_acceptor_impl(uint16_t port);
+
+/// Checks whether `host` refers to the local host.
+CAF_IO_EXPORT bool is_local_host(std::string_view host) noexcept;
+
+} // namespace caf::io::network
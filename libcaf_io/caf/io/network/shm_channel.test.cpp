@@ -0,0 +1,199 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/io/network/shm_channel.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/config.hpp"
+#include "caf/raise_error.hpp"
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#ifdef CAF_LINUX
+#  include <sys/socket.h>
+#  include <unistd.h>
+#endif
+
+using namespace caf;
+using namespace caf::io::network;
+
+TEST("only local host names qualify for shared memory") {
+  check(is_local_host(""));
+  check(is_local_host("localhost"));
+  check(is_local_host("127.0.0.1"));
+  check(is_local_host("[::1]"));
+  check(!is_local_host("example.com"));
+  check(!is_local_host("10.0.0.1"));
+}
+
+#ifdef CAF_LINUX
+
+namespace {
+
+using byte_vector = std::vector<std::byte>;
+
+byte_vector make_bytes(size_t size) {
+  byte_vector result(size);
+  for (size_t i = 0; i < size; ++i)
+    result[i] = static_cast<std::byte>(i % 251);
+  return result;
+}
+
+/// Returns the counter of `efd`, i.e., the number of pending wakeups.
+uint64_t wakeups(native_socket efd) {
+  uint64_t result = 0;
+  if (::read(efd, &result, sizeof(result)) != sizeof(result))
+    return 0;
+  return result;
+}
+
+struct fixture {
+  fixture() {
+    auto acc = new_shm_acceptor_impl(0);
+    if (!acc)
+      CAF_RAISE_ERROR("new_shm_acceptor_impl failed");
+    acceptor_fd = acc->first;
+    port = acc->second;
+    // Connecting blocks until the acceptor sends the segment.
+    std::thread client_thread{[this] {
+      if (auto res = shm_channel::connect(port)) {
+        client_fd = res->first;
+        client = std::move(res->second);
+      }
+    }};
+    auto conn = ::accept(acceptor_fd, nullptr, nullptr);
+    auto res = shm_channel::accept(conn, 4096, port);
+    client_thread.join();
+    if (!res || client_fd == invalid_native_socket)
+      CAF_RAISE_ERROR("unable to connect shared memory channels");
+    server_fd = res->first;
+    server = std::move(res->second);
+  }
+
+  ~fixture() {
+    close_socket(acceptor_fd);
+    close_socket(server_fd);
+    close_socket(client_fd);
+  }
+
+  rw_state write(shm_channel& ch, native_socket fd, const byte_vector& xs,
+                 size_t& written) {
+    return ch.write_some(written, fd, xs.data(), xs.size());
+  }
+
+  byte_vector read(shm_channel& ch, native_socket fd, size_t max_size) {
+    byte_vector result(max_size);
+    size_t n = 0;
+    if (ch.read_some(n, fd, result.data(), result.size())
+        != rw_state::success)
+      return {};
+    result.resize(n);
+    return result;
+  }
+
+  native_socket acceptor_fd = invalid_native_socket;
+  native_socket server_fd = invalid_native_socket;
+  native_socket client_fd = invalid_native_socket;
+  uint16_t port = 0;
+  shm_channel server;
+  shm_channel client;
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("channels transfer data in both directions") {
+  check_eq(server.port(), port);
+  check_eq(client.port(), port);
+  check_eq(client.capacity(), 4096u);
+  auto data = make_bytes(100);
+  size_t written = 0;
+  check_eq(write(client, client_fd, data, written), rw_state::success);
+  check_eq(written, 100u);
+  check_eq(read(server, server_fd, 1024), data);
+  check_eq(write(server, server_fd, data, written), rw_state::success);
+  check_eq(read(client, client_fd, 1024), data);
+  SECTION("reading from an empty ring returns no data") {
+    size_t n = 42;
+    std::byte buf[16];
+    check_eq(server.read_some(n, server_fd, buf, sizeof(buf)),
+             rw_state::success);
+    check_eq(n, 0u);
+  }
+}
+
+TEST("writers signal the reader only after writing to an empty ring") {
+  auto data = make_bytes(10);
+  size_t written = 0;
+  write(client, client_fd, data, written);
+  write(client, client_fd, data, written);
+  write(client, client_fd, data, written);
+  check_eq(wakeups(server_fd), 1u);
+  check_eq(read(server, server_fd, 1024).size(), 30u);
+  write(client, client_fd, data, written);
+  check_eq(wakeups(server_fd), 1u);
+}
+
+TEST("data wraps around the end of the ring") {
+  auto data = make_bytes(3000);
+  size_t written = 0;
+  check_eq(write(client, client_fd, data, written), rw_state::success);
+  check_eq(read(server, server_fd, 4096), data);
+  check_eq(write(client, client_fd, data, written), rw_state::success);
+  check_eq(read(server, server_fd, 4096), data);
+}
+
+TEST("writers back off until the reader makes room") {
+  auto data = make_bytes(5000);
+  size_t written = 0;
+  check_eq(write(client, client_fd, data, written), rw_state::want_read);
+  check_eq(written, 4096u);
+  wakeups(client_fd);
+  auto first = read(server, server_fd, 8192);
+  check_eq(first.size(), 4096u);
+  check_eq(wakeups(client_fd), 1u);
+  byte_vector rest{data.begin() + 4096, data.end()};
+  check_eq(write(client, client_fd, rest, written), rw_state::success);
+  check_eq(written, 904u);
+  auto second = read(server, server_fd, 8192);
+  first.insert(first.end(), second.begin(), second.end());
+  check_eq(first, data);
+}
+
+TEST("readers fail after consuming all data of a closed channel") {
+  auto data = make_bytes(10);
+  size_t written = 0;
+  write(client, client_fd, data, written);
+  client.shutdown_write();
+  check_eq(read(server, server_fd, 1024), data);
+  size_t n = 0;
+  std::byte buf[16];
+  check_eq(server.read_some(n, server_fd, buf, sizeof(buf)), rw_state::failure);
+  SECTION("destroying a channel also closes it") {
+    { auto tmp = std::move(server); }
+    check_eq(client.read_some(n, client_fd, buf, sizeof(buf)),
+             rw_state::failure);
+  }
+}
+
+} // WITH_FIXTURE(fixture)
+
+TEST("connecting to an unused port fails") {
+  auto acc = new_shm_acceptor_impl(0);
+  check(acc.has_value());
+  if (acc) {
+    auto port = acc->second;
+    close_socket(acc->first);
+    check(!shm_channel::connect(port));
+  }
+}
+
+#endif // CAF_LINUX
+
+CAF_TEST_MAIN()
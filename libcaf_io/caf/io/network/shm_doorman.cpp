@@ -0,0 +1,71 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/io/network/shm_doorman.hpp"
+
+#include "caf/io/network/default_multiplexer.hpp"
+#include "caf/io/network/shm_channel.hpp"
+#include "caf/io/network/shm_scribe.hpp"
+
+#include "caf/logger.hpp"
+
+namespace caf::io::network {
+
+shm_doorman::shm_doorman(default_multiplexer& mx, native_socket sockfd,
+                         uint16_t port, size_t capacity)
+  : doorman(network::accept_hdl_from_socket(sockfd)),
+    acceptor_(mx, sockfd),
+    port_(port),
+    capacity_(capacity) {
+  // nop
+}
+
+bool shm_doorman::new_connection() {
+  CAF_LOG_TRACE("");
+  if (detached())
+    // see doorman_impl::new_connection
+    return false;
+  auto& dm = acceptor_.backend();
+  auto res = shm_channel::accept(acceptor_.accepted_socket(), capacity_,
+                                 port_);
+  if (!res) {
+    // A failed handshake only affects the connecting node.
+    CAF_LOG_WARNING("unable to set up shared memory:" << res.error());
+    return true;
+  }
+  auto& [efd, channel] = *res;
+  auto sptr = make_counted<shm_scribe>(dm, efd, std::move(channel));
+  auto hdl = sptr->hdl();
+  parent()->add_scribe(std::move(sptr));
+  return doorman::new_connection(&dm, hdl);
+}
+
+void shm_doorman::graceful_shutdown() {
+  CAF_LOG_TRACE("");
+  acceptor_.graceful_shutdown();
+  detach(&acceptor_.backend(), false);
+}
+
+void shm_doorman::launch() {
+  CAF_LOG_TRACE("");
+  acceptor_.start(this);
+}
+
+std::string shm_doorman::addr() const {
+  return "localhost";
+}
+
+uint16_t shm_doorman::port() const {
+  return port_;
+}
+
+void shm_doorman::add_to_loop() {
+  acceptor_.activate(this);
+}
+
+void shm_doorman::remove_from_loop() {
+  acceptor_.passivate();
+}
+
+} // namespace caf::io::network
@@ -0,0 +1,44 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/io/doorman.hpp"
+#include "caf/io/fwd.hpp"
+#include "caf/io/network/acceptor_impl.hpp"
+#include "caf/io/network/native_socket.hpp"
+
+#include "caf/detail/io_export.hpp"
+#include "caf/policy/tcp.hpp"
+
+namespace caf::io::network {
+
+/// A doorman for shared memory connections. Listens on a Unix domain socket
+/// and hands out a new shared memory segment to each connecting node.
+class CAF_IO_EXPORT shm_doorman : public doorman {
+public:
+  shm_doorman(default_multiplexer& mx, native_socket sockfd, uint16_t port,
+              size_t capacity);
+
+  bool new_connection() override;
+
+  void graceful_shutdown() override;
+
+  void launch() override;
+
+  std::string addr() const override;
+
+  uint16_t port() const override;
+
+  void add_to_loop() override;
+
+  void remove_from_loop() override;
+
+protected:
+  acceptor_impl<policy::tcp> acceptor_;
+  uint16_t port_;
+  size_t capacity_;
+};
+
+} // namespace caf::io::network
@@ -0,0 +1,75 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/io/network/shm_scribe.hpp"
+
+#include "caf/io/network/default_multiplexer.hpp"
+
+#include "caf/logger.hpp"
+
+namespace caf::io::network {
+
+shm_scribe::shm_scribe(default_multiplexer& mx, native_socket efd,
+                       shm_channel channel)
+  : scribe(network::conn_hdl_from_socket(efd)),
+    launched_(false),
+    stream_(mx, efd, std::move(channel)) {
+  // nop
+}
+
+void shm_scribe::configure_read(receive_policy::config config) {
+  CAF_LOG_TRACE("");
+  stream_.configure_read(config);
+  if (!launched_)
+    launch();
+}
+
+void shm_scribe::ack_writes(bool enable) {
+  CAF_LOG_TRACE(CAF_ARG(enable));
+  stream_.ack_writes(enable);
+}
+
+byte_buffer& shm_scribe::wr_buf() {
+  return stream_.wr_buf();
+}
+
+byte_buffer& shm_scribe::rd_buf() {
+  return stream_.rd_buf();
+}
+
+void shm_scribe::graceful_shutdown() {
+  CAF_LOG_TRACE("");
+  stream_.graceful_shutdown();
+  detach(&stream_.backend(), false);
+}
+
+void shm_scribe::flush() {
+  CAF_LOG_TRACE("");
+  stream_.flush(this);
+}
+
+std::string shm_scribe::addr() const {
+  return "localhost";
+}
+
+uint16_t shm_scribe::port() const {
+  return stream_.channel().port();
+}
+
+void shm_scribe::launch() {
+  CAF_LOG_TRACE("");
+  CAF_ASSERT(!launched_);
+  launched_ = true;
+  stream_.start(this);
+}
+
+void shm_scribe::add_to_loop() {
+  stream_.activate(this);
+}
+
+void shm_scribe::remove_from_loop() {
+  stream_.passivate();
+}
+
+} // namespace caf::io::network
@@ -0,0 +1,50 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/io/fwd.hpp"
+#include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/shm_channel.hpp"
+#include "caf/io/network/shm_stream.hpp"
+#include "caf/io/scribe.hpp"
+
+#include "caf/detail/io_export.hpp"
+
+namespace caf::io::network {
+
+/// A scribe for connections to nodes on the same host that transfers data
+/// through shared memory.
+class CAF_IO_EXPORT shm_scribe : public scribe {
+public:
+  shm_scribe(default_multiplexer& mx, native_socket efd, shm_channel channel);
+
+  void configure_read(receive_policy::config config) override;
+
+  void ack_writes(bool enable) override;
+
+  byte_buffer& wr_buf() override;
+
+  byte_buffer& rd_buf() override;
+
+  void graceful_shutdown() override;
+
+  void flush() override;
+
+  std::string addr() const override;
+
+  uint16_t port() const override;
+
+  void launch();
+
+  void add_to_loop() override;
+
+  void remove_from_loop() override;
+
+protected:
+  bool launched_;
+  shm_stream stream_;
+};
+
+} // namespace caf::io::network
@@ -0,0 +1,42 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/io/network/shm_channel.hpp"
+#include "caf/io/network/stream.hpp"
+
+#include <utility>
+
+namespace caf::io::network {
+
+/// A stream that transfers data through shared memory. The file descriptor of
+/// the stream is the eventfd of this side of the channel.
+class shm_stream : public stream {
+public:
+  shm_stream(default_multiplexer& mpx, native_socket efd, shm_channel channel)
+    : stream(mpx, efd), channel_(std::move(channel)) {
+    // nop
+  }
+
+  void handle_event(io::network::operation op) override {
+    this->handle_event_impl(op, channel_);
+  }
+
+  const shm_channel& channel() const noexcept {
+    return channel_;
+  }
+
+protected:
+  /// Marks the outbound ring as closed instead of shutting down a socket.
+  void send_fin() override {
+    CAF_LOG_TRACE(CAF_ARG2("fd", fd()));
+    channel_.shutdown_write();
+  }
+
+private:
+  shm_channel channel_;
+};
+
+} // namespace caf::io::network
@@ -72,6 +72,10 @@ public:
   void force_empty_write(const manager_ptr& mgr);
 
 protected:
+  /// Initiates a graceful shutdown of the connection by sending FIN on the TCP
+  /// connection.
+  virtual void send_fin();
+
   template <class Policy>
   void handle_event_impl(io::network::operation op, Policy& policy) {
     CAF_LOG_TRACE(CAF_ARG(op));
@@ -119,10 +123,6 @@ private:
 
   void handle_error_propagation();
 
-  /// Initiates a graceful shutdown of the connection by sending FIN on the TCP
-  /// connection.
-  void send_fin();
-
   size_t max_consecutive_reads_;
 
   // State for reading.
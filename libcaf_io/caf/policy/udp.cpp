@@ -8,6 +8,9 @@
 
 #include "caf/logger.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #ifdef CAF_WINDOWS
 #  include <winsock2.h>
 #else
@@ -65,4 +68,114 @@ bool udp::write_datagram(size_t& result, native_socket fd, void* buf,
   return true;
 }
 
+#ifdef CAF_LINUX
+
+bool udp::read_datagrams(size_t& result, native_socket fd,
+                         io::network::receive_buffer* bufs, size_t* sizes,
+                         io::network::ip_endpoint* eps, size_t num_bufs) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(num_bufs));
+  result = 0;
+  auto n = std::min(num_bufs, max_batch_size);
+  mmsghdr hdrs[max_batch_size];
+  iovec iovs[max_batch_size];
+  memset(hdrs, 0, n * sizeof(mmsghdr));
+  for (size_t i = 0; i < n; ++i) {
+    memset(eps[i].address(), 0, sizeof(sockaddr_storage));
+    iovs[i] = iovec{bufs[i].data(), bufs[i].size()};
+    auto& hdr = hdrs[i].msg_hdr;
+    hdr.msg_name = eps[i].address();
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  auto sres = ::recvmmsg(fd, hdrs, static_cast<unsigned>(n), 0, nullptr);
+  if (is_error(sres, true)) {
+    auto err = last_socket_error();
+    CAF_IGNORE_UNUSED(err);
+    CAF_LOG_ERROR("recvmmsg failed:" << socket_error_as_string(err));
+    return false;
+  }
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  for (size_t i = 0; i < result; ++i) {
+    if ((hdrs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0)
+      CAF_LOG_WARNING("recvmmsg cut of message, only received "
+                      << CAF_ARG2("buf_len", bufs[i].size()) << " bytes");
+    sizes[i] = hdrs[i].msg_len;
+    *eps[i].length() = static_cast<size_t>(hdrs[i].msg_hdr.msg_namelen);
+  }
+  return true;
+}
+
+bool udp::write_datagrams(size_t& result, native_socket fd,
+                          const byte_buffer* const* bufs,
+                          const io::network::ip_endpoint* const* eps,
+                          size_t num_bufs) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(num_bufs));
+  result = 0;
+  auto n = std::min(num_bufs, max_batch_size);
+  mmsghdr hdrs[max_batch_size];
+  iovec iovs[max_batch_size];
+  memset(hdrs, 0, n * sizeof(mmsghdr));
+  for (size_t i = 0; i < n; ++i) {
+    iovs[i] = iovec{const_cast<std::byte*>(bufs[i]->data()), bufs[i]->size()};
+    auto& hdr = hdrs[i].msg_hdr;
+    hdr.msg_name = const_cast<sockaddr*>(eps[i]->caddress());
+    hdr.msg_namelen = static_cast<socklen_t>(*eps[i]->clength());
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  auto sres = ::sendmmsg(fd, hdrs, static_cast<unsigned>(n), 0);
+  if (is_error(sres, true)) {
+    auto err = last_socket_error();
+    CAF_IGNORE_UNUSED(err);
+    CAF_LOG_ERROR("sendmmsg failed:" << socket_error_as_string(err));
+    return false;
+  }
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  return true;
+}
+
+#else // CAF_LINUX
+
+bool udp::read_datagrams(size_t& result, native_socket fd,
+                         io::network::receive_buffer* bufs, size_t* sizes,
+                         io::network::ip_endpoint* eps, size_t num_bufs) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(num_bufs));
+  auto n = std::min(num_bufs, max_batch_size);
+  result = 0;
+  // Stop at the first empty read, since `read_datagram` cannot tell empty
+  // datagrams apart from an empty socket buffer.
+  while (result < n) {
+    auto& buf = bufs[result];
+    if (!read_datagram(sizes[result], fd, buf.data(), buf.size(), eps[result]))
+      return false;
+    if (sizes[result] == 0)
+      return true;
+    ++result;
+  }
+  return true;
+}
+
+bool udp::write_datagrams(size_t& result, native_socket fd,
+                          const byte_buffer* const* bufs,
+                          const io::network::ip_endpoint* const* eps,
+                          size_t num_bufs) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(num_bufs));
+  auto n = std::min(num_bufs, max_batch_size);
+  result = 0;
+  while (result < n) {
+    auto& buf = *bufs[result];
+    size_t written = 0;
+    if (!write_datagram(written, fd, const_cast<std::byte*>(buf.data()),
+                        buf.size(), *eps[result]))
+      return false;
+    if (written != buf.size())
+      return true;
+    ++result;
+  }
+  return true;
+}
+
+#endif // CAF_LINUX
+
 } // namespace caf::policy
@@ -6,9 +6,13 @@
 
 #include "caf/io/network/ip_endpoint.hpp"
 #include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/receive_buffer.hpp"
 
+#include "caf/byte_buffer.hpp"
 #include "caf/detail/io_export.hpp"
 
+#include <cstddef>
+
 namespace caf::policy {
 
 /// Policy object for wrapping default UDP operations.
@@ -29,6 +33,29 @@ struct CAF_IO_EXPORT udp {
                              void* buf, size_t buf_len,
                              const io::network::ip_endpoint& ep);
 
+  /// Maximum number of datagrams that a single batch operation transmits.
+  static constexpr size_t max_batch_size = 8;
+
+  /// Receives up to `num_bufs` datagrams from `fd` with a single system call
+  /// if the platform supports it (`recvmmsg`). The i-th datagram goes to
+  /// `bufs[i]`, its size to `sizes[i]` and its sender to `eps[i]`. Returns
+  /// `true` if no IO error occurred. The number of received datagrams is
+  /// stored in `result` (can be 0), also if an error occurred after receiving
+  /// some datagrams of the batch.
+  static bool read_datagrams(size_t& result, io::network::native_socket fd,
+                             io::network::receive_buffer* bufs, size_t* sizes,
+                             io::network::ip_endpoint* eps, size_t num_bufs);
+
+  /// Sends up to `num_bufs` datagrams to `fd` with a single system call if the
+  /// platform supports it (`sendmmsg`). The i-th datagram consists of
+  /// `*bufs[i]` and goes to `*eps[i]`. Returns `true` if no IO error occurred.
+  /// The number of sent datagrams is stored in `result`, also if an error
+  /// occurred after sending some datagrams of the batch.
+  static bool write_datagrams(size_t& result, io::network::native_socket fd,
+                              const byte_buffer* const* bufs,
+                              const io::network::ip_endpoint* const* eps,
+                              size_t num_bufs);
+
   /// Always returns `false`. Native UDP I/O event handlers only rely on the
   /// socket buffer.
   static constexpr bool must_read_more(io::network::native_socket, size_t) {
@@ -0,0 +1,131 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/policy/udp.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/io/network/default_multiplexer.hpp"
+#include "caf/io/network/ip_endpoint.hpp"
+#include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/protocol.hpp"
+
+#include "caf/raise_error.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace caf;
+using namespace caf::io;
+
+namespace {
+
+using string_list = std::vector<std::string>;
+
+byte_buffer to_buf(std::string_view str) {
+  auto first = reinterpret_cast<const std::byte*>(str.data());
+  return byte_buffer{first, first + str.size()};
+}
+
+struct fixture {
+  fixture() {
+    auto lep = network::new_local_udp_endpoint_impl(0, "127.0.0.1");
+    if (!lep)
+      CAF_RAISE_ERROR("unable to open a local UDP endpoint");
+    receive_fd = lep->first;
+    auto port = network::local_port_of_fd(receive_fd);
+    if (!port)
+      CAF_RAISE_ERROR("unable to retrieve the port of the UDP endpoint");
+    auto rep = network::new_remote_udp_endpoint_impl("127.0.0.1", *port,
+                                                     network::protocol::ipv4);
+    if (!rep)
+      CAF_RAISE_ERROR("unable to open a remote UDP endpoint");
+    send_fd = rep->first;
+    receiver = rep->second;
+    if (auto sport = network::local_port_of_fd(send_fd))
+      sender_port = *sport;
+    else
+      CAF_RAISE_ERROR("unable to retrieve the port of the sender");
+    if (!network::nonblocking(receive_fd, true)
+        || !network::nonblocking(send_fd, true))
+      CAF_RAISE_ERROR("unable to set the UDP sockets to nonblocking");
+  }
+
+  ~fixture() {
+    network::close_socket(send_fd);
+    network::close_socket(receive_fd);
+  }
+
+  // Sends all `strs` as datagrams to the receiver.
+  size_t write(const string_list& strs) {
+    std::vector<byte_buffer> bufs;
+    for (auto& str : strs)
+      bufs.emplace_back(to_buf(str));
+    std::vector<const byte_buffer*> buf_ptrs;
+    std::vector<const network::ip_endpoint*> ep_ptrs;
+    for (auto& buf : bufs) {
+      buf_ptrs.emplace_back(&buf);
+      ep_ptrs.emplace_back(&receiver);
+    }
+    size_t result = 0;
+    if (!policy::udp::write_datagrams(result, send_fd, buf_ptrs.data(),
+                                      ep_ptrs.data(), bufs.size()))
+      CAF_RAISE_ERROR("write_datagrams failed");
+    return result;
+  }
+
+  // Reads up to `num_bufs` datagrams with a single batch.
+  string_list read(size_t num_bufs) {
+    std::vector<network::receive_buffer> bufs(num_bufs);
+    for (auto& buf : bufs)
+      buf.resize(1024);
+    std::vector<size_t> sizes(num_bufs);
+    std::vector<network::ip_endpoint> eps(num_bufs);
+    size_t n = 0;
+    if (!policy::udp::read_datagrams(n, receive_fd, bufs.data(), sizes.data(),
+                                     eps.data(), num_bufs))
+      CAF_RAISE_ERROR("read_datagrams failed");
+    string_list result;
+    for (size_t i = 0; i < n; ++i) {
+      result.emplace_back(reinterpret_cast<const char*>(bufs[i].data()),
+                          sizes[i]);
+      if (network::port(eps[i]) != sender_port)
+        CAF_RAISE_ERROR("received a datagram from an unexpected sender");
+    }
+    return result;
+  }
+
+  network::native_socket send_fd = network::invalid_native_socket;
+  network::native_socket receive_fd = network::invalid_native_socket;
+  network::ip_endpoint receiver;
+  uint16_t sender_port = 0;
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("batch operations transfer multiple datagrams at once") {
+  check_eq(read(4), string_list{});
+  check_eq(write({"first", "second", "third"}), 3u);
+  check_eq(read(4), string_list({"first", "second", "third"}));
+  SECTION("reading stops after filling all buffers") {
+    check_eq(write({"1", "2", "3"}), 3u);
+    check_eq(read(2), string_list({"1", "2"}));
+    check_eq(read(2), string_list({"3"}));
+  }
+  SECTION("batch operations transfer at most max_batch_size datagrams") {
+    string_list strs(policy::udp::max_batch_size + 1, "x");
+    check_eq(write(strs), policy::udp::max_batch_size);
+    strs.pop_back();
+    check_eq(read(policy::udp::max_batch_size + 1), strs);
+  }
+}
+
+} // WITH_FIXTURE(fixture)
+
+CAF_TEST_MAIN()
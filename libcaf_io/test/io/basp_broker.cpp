@@ -19,6 +19,7 @@
 #include <condition_variable>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -91,17 +92,25 @@ struct node {
 
 class fixture {
 public:
-  fixture(bool autoconn = false)
+  fixture(bool autoconn = false, bool compress = false,
+          bool dictionaries = false, size_t workers = 0)
     : sys(cfg.load<io::middleman, network::test_multiplexer>()
             .set("caf.middleman.enable-automatic-connections", autoconn)
+            .set("caf.middleman.compression", compress ? "deflate" : "none")
+            .set("caf.middleman.enable-dictionaries", dictionaries)
             .set("caf.middleman.heartbeat-interval", timespan{0})
             .set("caf.middleman.connection-timeout", timespan{0})
-            .set("caf.middleman.workers", size_t{0})
+            .set("caf.middleman.workers", workers)
             .set("caf.scheduler.policy", autoconn ? "testing" : "stealing")
             .set("caf.logger.inline-output", true)
             .set("caf.logger.console.verbosity", "debug")
             .set("caf.middleman.attach-utility-actors", autoconn)) {
     app_ids.emplace_back(std::string{defaults::middleman::app_identifier});
+    if (compress)
+      extensions.emplace_back(basp::deflate_compression);
+    if (dictionaries)
+      extensions.emplace_back(basp::dictionary_extension);
+    remote_extensions = extensions;
     auto& mm = sys.middleman();
     mpx_ = dynamic_cast<network::test_multiplexer*>(&mm.backend());
     CAF_REQUIRE(mpx_ != nullptr);
@@ -229,6 +238,21 @@ public:
     to_buf(buf, hdr, &pw);
   }
 
+  // Publishes `whom` at `port` via the middleman actor, which waits for the
+  // BASP broker. The broker only runs as part of the test multiplexer.
+  uint16_t publish(const actor& whom, uint16_t port) {
+    scoped_actor tmp{sys};
+    tmp->send(sys.middleman().actor_handle(), publish_atom_v, port,
+              actor_cast<strong_actor_ptr>(whom), std::set<std::string>{},
+              std::string{}, false);
+    while (instance().published_actors().count(port) == 0)
+      mpx()->exec_runnable();
+    uint16_t result = 0;
+    tmp->receive([&result](uint16_t x) { result = x; },
+                 [](const error& err) { CAF_FAIL("publish failed: " << err); });
+    return result;
+  }
+
   std::pair<basp::header, byte_buffer> from_buf(const byte_buffer& buf) {
     basp::header hdr;
     binary_deserializer source{mpx_, buf};
@@ -236,8 +260,8 @@ public:
       CAF_FAIL("failed to deserialize header: " << source.get_error());
     byte_buffer payload;
     if (hdr.payload_len > 0) {
-      std::copy(buf.begin() + basp::header_size, buf.end(),
-                std::back_inserter(payload));
+      auto first = buf.begin() + basp::header_size;
+      std::copy(first, first + hdr.payload_len, std::back_inserter(payload));
     }
     return {hdr, std::move(payload)};
   }
@@ -254,20 +278,30 @@ public:
     mpx_->accept_connection(src);
     // technically, the server handshake arrives
     // before we send the client handshake
-    mock(hdl,
-         {basp::message_type::client_handshake, 0, 0, 0, invalid_actor_id,
-          invalid_actor_id},
-         n.id)
-      .receive(hdl, basp::message_type::server_handshake, no_flags, any_vals,
-               basp::version, invalid_actor_id, invalid_actor_id, this_node(),
-               app_ids, published_actor_id, published_actor_ifs)
-      // upon receiving our client handshake, BASP will check
-      // whether there is a SpawnServ actor on this node
-      .receive(hdl, basp::message_type::direct_message,
-               basp::header::named_receiver_flag, any_vals,
-               default_operation_data, any_vals, spawn_serv_id,
-               std::vector<strong_actor_ptr>{},
-               make_message(sys_atom_v, get_atom_v, "info"));
+    auto m = mock(hdl,
+                  {basp::message_type::client_handshake, 0, 0, 0,
+                   invalid_actor_id, invalid_actor_id},
+                  n.id, remote_extensions);
+    m.receive(hdl, basp::message_type::server_handshake, no_flags, any_vals,
+              basp::version, invalid_actor_id, invalid_actor_id, this_node(),
+              app_ids, published_actor_id, published_actor_ifs, extensions);
+    // upon receiving our client handshake, BASP will check
+    // whether there is a SpawnServ actor on this node
+    if (instance().uses_dictionaries(hdl)) {
+      auto update = read_from_out_buf(hdl);
+      CHECK_EQ(update.first.operation, basp::message_type::dictionary_update);
+      apply_update(hdl, update.second);
+      auto request = read_from_out_buf(hdl);
+      CHECK_EQ(request.first.operation, basp::message_type::direct_message);
+      CHECK_EQ(request.first.flags, basp::header::named_receiver_flag
+                                      | basp::header::dictionary_flag);
+    } else {
+      m.receive(hdl, basp::message_type::direct_message,
+                basp::header::named_receiver_flag, any_vals,
+                default_operation_data, any_vals, spawn_serv_id,
+                std::vector<strong_actor_ptr>{},
+                make_message(sys_atom_v, get_atom_v, "info"));
+    }
     // test whether basp instance correctly updates the
     // routing table upon receiving client handshakes
     auto path = tbl().lookup(n.id);
@@ -276,7 +310,8 @@ public:
     CHECK_EQ(path->next_hop, n.id);
   }
 
-  auto read_from_out_buf(connection_handle hdl) {
+  std::pair<basp::header, byte_buffer>
+  read_from_out_buf(connection_handle hdl) {
     MESSAGE("read from output buffer for connection " << hdl.id());
     auto& buf = mpx_->output_buffer(hdl);
     while (buf.size() < basp::header_size)
@@ -287,6 +322,25 @@ public:
     return result;
   }
 
+  // Applies a dictionary update of this node to the mirrored dictionary.
+  void apply_update(connection_handle hdl, const byte_buffer& payload) {
+    binary_deserializer source{mpx_, payload};
+    if (!dicts[hdl].apply_update(source))
+      CAF_FAIL("failed to apply dictionary update: " << source.get_error());
+  }
+
+  // Reads the next message other than a dictionary update from the output
+  // buffer and applies all dictionary updates before it.
+  std::pair<basp::header, byte_buffer>
+  read_skipping_updates(connection_handle hdl) {
+    for (;;) {
+      auto result = read_from_out_buf(hdl);
+      if (result.first.operation != basp::message_type::dictionary_update)
+        return result;
+      apply_update(hdl, result.second);
+    }
+  }
+
   void dispatch_out_buf(connection_handle hdl) {
     basp::header hdr;
     byte_buffer buf;
@@ -369,6 +423,16 @@ public:
     size_t num = 1;
   };
 
+  // Sends a BASP message from the remote node at `hdl`, whereby `f` writes
+  // the payload.
+  template <class F>
+  void send_from(connection_handle hdl, basp::header hdr, F f) {
+    byte_buffer buf;
+    auto writer = make_callback(f);
+    to_buf(buf, hdr, &writer);
+    mpx()->virtual_send(hdl, buf);
+  }
+
   template <class... Ts>
   mock_t mock(connection_handle hdl, basp::header hdr, const Ts&... xs) {
     byte_buffer buf;
@@ -387,6 +451,12 @@ public:
   actor_system_config cfg;
   actor_system sys;
   std::vector<std::string> app_ids;
+  // Handshake extensions that this node offers.
+  std::vector<std::string> extensions;
+  // Handshake extensions that the remote nodes offer.
+  std::vector<std::string> remote_extensions;
+  // Mirrors the dictionaries that this node uses for sending.
+  std::map<connection_handle, basp::receive_dictionary> dicts;
 
 private:
   basp_broker* aut_;
@@ -425,10 +495,28 @@ public:
               std::move(sigs), "", false);
     expect((publish_atom, uint16_t, strong_actor_ptr, sig_t, std::string, bool),
            from(tmp).to(mma));
+    // Process the publish request in the BASP broker and its result in the
+    // middleman actor.
+    mpx()->flush_runnables();
+    sched.run();
     expect((uint16_t), from(mma).to(tmp).with(port));
   }
 };
 
+template <bool Compress, bool Dictionaries, size_t Workers = 0>
+class extensions_fixture : public fixture {
+public:
+  extensions_fixture() : fixture(false, Compress, Dictionaries, Workers) {
+    // nop
+  }
+};
+
+using compression_enabled_fixture = extensions_fixture<true, false>;
+
+using dictionaries_enabled_fixture = extensions_fixture<false, true>;
+
+using dictionaries_and_workers_fixture = extensions_fixture<false, true, 2>;
+
 } // namespace
 
 BEGIN_FIXTURE_SCOPE(fixture)
@@ -478,7 +566,8 @@ CAF_TEST(non_empty_server_handshake) {
   if (!sink.apply(instance().this_node()) //
       || !sink.apply(app_ids)             //
       || !sink.apply(id)                  //
-      || !sink.apply(ifs))
+      || !sink.apply(ifs)                 //
+      || !sink.apply(extensions))
     CAF_FAIL("serializing handshake failed: " << sink.get_error());
   CHECK_EQ(hexstr(payload), hexstr(expected_payload));
 }
@@ -549,9 +638,7 @@ CAF_TEST(message_forwarding) {
 CAF_TEST(publish_and_connect) {
   auto ax = accept_handle::from_int(4242);
   mpx()->provide_acceptor(4242, ax);
-  auto res = sys.middleman().publish(self(), 4242);
-  CAF_REQUIRE(res == 4242);
-  mpx()->flush_runnables(); // process publish message in basp_broker
+  CAF_REQUIRE_EQUAL(publish(self(), 4242), 4242u);
   connect_node(jupiter(), ax, self()->id());
 }
 
@@ -574,10 +661,10 @@ CAF_TEST(remote_actor_and_send) {
        {basp::message_type::server_handshake, 0, 0, basp::version,
         invalid_actor_id, invalid_actor_id},
        jupiter().id, app_ids, jupiter().dummy_actor->id(),
-       std::set<std::string>{})
+       std::set<std::string>{}, remote_extensions)
     .receive(jupiter().connection, basp::message_type::client_handshake,
              no_flags, any_vals, no_operation_data, invalid_actor_id,
-             invalid_actor_id, this_node())
+             invalid_actor_id, this_node(), extensions)
     .receive(jupiter().connection, basp::message_type::direct_message,
              basp::header::named_receiver_flag, any_vals,
              default_operation_data, any_vals, spawn_serv_id,
@@ -655,6 +742,97 @@ CAF_TEST(actor_serialize_and_deserialize) {
                  prx->id(), std::vector<strong_actor_ptr>{}, msg);
 }
 
+CAF_TEST(sending the same message to multiple proxies) {
+  connect_node(jupiter());
+  auto prx1 = proxies().get_or_put(jupiter().id, jupiter().dummy_actor->id());
+  auto prx2 = proxies().get_or_put(jupiter().id, 4711);
+  mock()
+    .receive(jupiter().connection, basp::message_type::monitor_message,
+             no_flags, any_vals, no_operation_data, invalid_actor_id,
+             prx1->id(), this_node(), jupiter().id)
+    .receive(jupiter().connection, basp::message_type::monitor_message,
+             no_flags, any_vals, no_operation_data, invalid_actor_id,
+             prx2->id(), this_node(), jupiter().id);
+  auto msg = make_message("hello", 42);
+  MESSAGE("the BASP broker serializes shared messages only once");
+  anon_send(actor_cast<actor>(prx1), msg);
+  anon_send(actor_cast<actor>(prx2), msg);
+  mpx()->flush_runnables();
+  mock()
+    .receive(jupiter().connection, basp::message_type::direct_message,
+             no_flags, any_vals, default_operation_data, invalid_actor_id,
+             prx1->id(), std::vector<strong_actor_ptr>{}, msg)
+    .receive(jupiter().connection, basp::message_type::direct_message,
+             no_flags, any_vals, default_operation_data, invalid_actor_id,
+             prx2->id(), std::vector<strong_actor_ptr>{}, msg);
+  MESSAGE("multicast sends the message once per node");
+  auto sender = actor_cast<strong_actor_ptr>(self());
+  sys.middleman().multicast(sender, {prx1, prx2}, msg);
+  mpx()->flush_runnables();
+  mock().receive(jupiter().connection, basp::message_type::multicast_message,
+                 no_flags, any_vals, default_operation_data, self()->id(),
+                 actor_id{2}, std::vector<actor_id>{prx1->id(), prx2->id()},
+                 std::vector<strong_actor_ptr>{}, msg);
+}
+
+CAF_TEST(the BASP broker coalesces writes according to its flush policy) {
+  connect_node(jupiter());
+  auto prx = proxies().get_or_put(jupiter().id, jupiter().dummy_actor->id());
+  mock().receive(jupiter().connection, basp::message_type::monitor_message,
+                 no_flags, any_vals, no_operation_data, invalid_actor_id,
+                 prx->id(), this_node(), jupiter().id);
+  auto hist = sys.middleman().metric_singletons.outbound_batch_size;
+  auto count = [hist] {
+    int64_t result = 0;
+    for (auto& bucket : hist->buckets())
+      result += bucket.count.value();
+    return result;
+  };
+  auto send_messages = [this, prx] {
+    for (int i = 1; i <= 3; ++i) {
+      anon_send(actor_cast<actor>(prx), i);
+      mpx()->flush_runnables();
+      mock().receive(jupiter().connection, basp::message_type::direct_message,
+                     no_flags, any_vals, default_operation_data,
+                     invalid_actor_id, prx->id(),
+                     std::vector<strong_actor_ptr>{}, make_message(i));
+    }
+  };
+  MESSAGE("with a flush delay, the broker flushes all messages at once");
+  aut()->flush_policy.delay = std::chrono::hours{1};
+  auto sum_before = hist->sum();
+  auto count_before = count();
+  send_messages();
+  CHECK_EQ(aut()->pending_writes.size(), 1u);
+  CHECK_EQ(count() - count_before, 0);
+  anon_send(actor_cast<actor>(aut()), flush_atom_v);
+  mpx()->flush_runnables();
+  CHECK(aut()->pending_writes.empty());
+  CHECK_EQ(hist->sum() - sum_before, 3);
+  CHECK_EQ(count() - count_before, 1);
+  MESSAGE("with the immediate policy, the broker flushes each message");
+  aut()->flush_policy.immediate = true;
+  sum_before = hist->sum();
+  count_before = count();
+  send_messages();
+  CHECK(aut()->pending_writes.empty());
+  CHECK_EQ(hist->sum() - sum_before, 3);
+  CHECK_EQ(count() - count_before, 3);
+}
+
+CAF_TEST(receiving multicast messages) {
+  connect_node(jupiter());
+  scoped_actor other{sys};
+  registry()->put(other->id(), actor_cast<strong_actor_ptr>(other));
+  mock(jupiter().connection,
+       {basp::message_type::multicast_message, 0, 0, 0,
+        jupiter().dummy_actor->id(), 3},
+       std::vector<actor_id>{self()->id(), 4711, other->id()},
+       std::vector<strong_actor_ptr>{}, make_message(42));
+  self()->receive([](int x) { CHECK_EQ(x, 42); });
+  other->receive([](int x) { CHECK_EQ(x, 42); });
+}
+
 CAF_TEST(indirect_connections) {
   // this node receives a message from jupiter via mars and responds via mars
   // and any ad-hoc automatic connection requests are ignored
@@ -662,8 +840,7 @@ CAF_TEST(indirect_connections) {
   MESSAGE("publish self at port 4242");
   auto ax = accept_handle::from_int(4242);
   mpx()->provide_acceptor(4242, ax);
-  sys.middleman().publish(self(), 4242);
-  mpx()->flush_runnables(); // process publish message in basp_broker
+  publish(self(), 4242);
   MESSAGE("connect to Mars");
   connect_node(mars(), ax, self()->id());
   MESSAGE("actor from Jupiter sends a message to us via Mars");
@@ -768,10 +945,10 @@ CAF_TEST(automatic_connection) {
        {basp::message_type::server_handshake, no_flags, 0, basp::version,
         invalid_actor_id, invalid_actor_id},
        jupiter().id, app_ids, jupiter().dummy_actor->id(),
-       std::set<std::string>{})
+       std::set<std::string>{}, remote_extensions)
     .receive(jupiter().connection, basp::message_type::client_handshake,
              no_flags, any_vals, no_operation_data, invalid_actor_id,
-             invalid_actor_id, this_node());
+             invalid_actor_id, this_node(), extensions);
   CHECK_EQ(tbl().lookup_indirect(jupiter().id), none);
   CHECK_EQ(tbl().lookup_indirect(mars().id), none);
   check_node_in_tbl(jupiter());
@@ -792,3 +969,335 @@ CAF_TEST(automatic_connection) {
 }
 
 END_FIXTURE_SCOPE()
+
+BEGIN_FIXTURE_SCOPE(compression_enabled_fixture)
+
+CAF_TEST(nodes with compression compress large payloads) {
+  connect_node(jupiter());
+  CHECK(instance().compresses(jupiter().connection));
+  auto prx = proxies().get_or_put(jupiter().id, jupiter().dummy_actor->id());
+  mock().receive(jupiter().connection, basp::message_type::monitor_message,
+                 no_flags, any_vals, no_operation_data, invalid_actor_id,
+                 prx->id(), this_node(), jupiter().id);
+  MESSAGE("small payloads remain uncompressed");
+  anon_send(actor_cast<actor>(prx), "hello");
+  mpx()->flush_runnables();
+  mock().receive(jupiter().connection, basp::message_type::direct_message,
+                 no_flags, any_vals, default_operation_data, invalid_actor_id,
+                 prx->id(), std::vector<strong_actor_ptr>{},
+                 make_message("hello"));
+  MESSAGE("large payloads get compressed");
+  auto msg = make_message(std::string(4096, 'x'));
+  anon_send(actor_cast<actor>(prx), msg);
+  mpx()->flush_runnables();
+  basp::header hdr;
+  byte_buffer payload;
+  std::tie(hdr, payload) = read_from_out_buf(jupiter().connection);
+  CHECK_EQ(hdr.operation, basp::message_type::direct_message);
+  CHECK(hdr.has(basp::header::compressed_flag));
+  byte_buffer expected;
+  to_payload(expected, std::vector<strong_actor_ptr>{}, msg);
+  CHECK_LT(payload.size(), expected.size());
+  byte_buffer decompressed;
+  CHECK(basp::decompress_payload(payload, decompressed));
+  CHECK_EQ(hexstr(decompressed), hexstr(expected));
+  MESSAGE("BASP decompresses incoming messages");
+  byte_buffer buf;
+  basp::header in_hdr{basp::message_type::direct_message,
+                      basp::header::compressed_flag,
+                      0,
+                      make_message_id().integer_value(),
+                      jupiter().dummy_actor->id(),
+                      self()->id()};
+  byte_buffer compressed;
+  CHECK(basp::compress_payload(expected, compressed));
+  in_hdr.payload_len = static_cast<uint32_t>(compressed.size());
+  binary_serializer sink{mpx(), buf};
+  if (!sink.apply(in_hdr))
+    CAF_FAIL("failed to serialize header: " << sink.get_error());
+  buf.insert(buf.end(), compressed.begin(), compressed.end());
+  mpx()->virtual_send(jupiter().connection, buf);
+  mpx()->flush_runnables();
+  self()->receive([](const std::string& str) { CHECK_EQ(str.size(), 4096u); });
+}
+
+CAF_TEST(nodes without compression on the remote side send raw payloads) {
+  remote_extensions.clear();
+  connect_node(jupiter());
+  CHECK(!instance().compresses(jupiter().connection));
+}
+
+END_FIXTURE_SCOPE()
+
+BEGIN_FIXTURE_SCOPE(dictionaries_enabled_fixture)
+
+CAF_TEST(nodes with dictionaries replace repeated values with references) {
+  connect_node(jupiter());
+  CHECK(instance().uses_dictionaries(jupiter().connection));
+  auto prx = proxies().get_or_put(jupiter().id, jupiter().dummy_actor->id());
+  mock().receive(jupiter().connection, basp::message_type::monitor_message,
+                 no_flags, any_vals, no_operation_data, invalid_actor_id,
+                 prx->id(), this_node(), jupiter().id);
+  auto msg = make_message("hello", int32_t{42});
+  byte_buffer full_payload;
+  to_payload(full_payload, std::vector<strong_actor_ptr>{}, msg);
+  MESSAGE("the first message announces its type IDs in a dictionary update");
+  anon_send(actor_cast<actor>(prx), msg);
+  mpx()->flush_runnables();
+  basp::header hdr;
+  std::tie(hdr, std::ignore) = read_from_out_buf(jupiter().connection);
+  CHECK_EQ(hdr.operation, basp::message_type::dictionary_update);
+  byte_buffer payload;
+  std::tie(hdr, payload) = read_from_out_buf(jupiter().connection);
+  CHECK_EQ(hdr.operation, basp::message_type::direct_message);
+  CHECK(hdr.has(basp::header::dictionary_flag));
+  CHECK_LT(payload.size(), full_payload.size());
+  MESSAGE("subsequent messages refer to the existing entries");
+  anon_send(actor_cast<actor>(prx), msg);
+  mpx()->flush_runnables();
+  byte_buffer payload2;
+  std::tie(hdr, payload2) = read_from_out_buf(jupiter().connection);
+  CHECK_EQ(hdr.operation, basp::message_type::direct_message);
+  CHECK_EQ(hexstr(payload2), hexstr(payload));
+  MESSAGE("BASP resolves references in incoming messages");
+  basp::send_dictionary remote_dict;
+  byte_buffer buf;
+  basp::header update_hdr{basp::message_type::dictionary_update,
+                          no_flags,
+                          0,
+                          no_operation_data,
+                          invalid_actor_id,
+                          invalid_actor_id};
+  auto add_entries = make_callback([&](binary_serializer& sink) { //
+    return remote_dict.add(sink, msg.types());
+  });
+  to_buf(buf, update_hdr, &add_entries);
+  mpx()->virtual_send(jupiter().connection, buf);
+  buf.clear();
+  basp::header in_hdr{basp::message_type::direct_message,
+                      basp::header::dictionary_flag,
+                      0,
+                      default_operation_data,
+                      jupiter().dummy_actor->id(),
+                      self()->id()};
+  auto write_payload = make_callback([&](binary_serializer& sink) {
+    return basp::write_stages(sink, remote_dict, {})
+           && basp::write_type_ids(sink, remote_dict, msg.types())
+           && basp::write_values(sink, msg);
+  });
+  to_buf(buf, in_hdr, &write_payload);
+  mpx()->virtual_send(jupiter().connection, buf);
+  mpx()->flush_runnables();
+  self()->receive([](const std::string& str, int32_t x) {
+    CHECK_EQ(str, "hello");
+    CHECK_EQ(x, 42);
+  });
+}
+
+CAF_TEST(nodes without dictionaries on the remote side send full values) {
+  remote_extensions.clear();
+  connect_node(jupiter());
+  CHECK(!instance().uses_dictionaries(jupiter().connection));
+}
+
+CAF_TEST(routed messages refer to source and destination node only) {
+  connect_node(jupiter());
+  MESSAGE("Earth reaches Mars via Jupiter");
+  tbl().add_indirect(jupiter().id, mars().id);
+  auto prx = proxies().get_or_put(mars().id, mars().dummy_actor->id());
+  auto msg = make_message("hello", int32_t{42});
+  anon_send(actor_cast<actor>(prx), msg);
+  mpx()->flush_runnables();
+  basp::header hdr;
+  byte_buffer payload;
+  do {
+    std::tie(hdr, payload) = read_skipping_updates(jupiter().connection);
+  } while (hdr.operation != basp::message_type::routed_message);
+  CHECK(hdr.has(basp::header::dictionary_flag));
+  auto& dict = dicts[jupiter().connection];
+  binary_deserializer source{mpx(), payload};
+  node_id source_node;
+  node_id dest_node;
+  std::vector<strong_actor_ptr> stages;
+  message content;
+  CHECK(basp::read_node(source, dict, source_node));
+  CHECK(basp::read_node(source, dict, dest_node));
+  CHECK(source.apply(stages));
+  CHECK(source.apply(content));
+  CHECK_EQ(source.remaining(), 0u);
+  CHECK_EQ(source_node, this_node());
+  CHECK_EQ(dest_node, mars().id);
+  CHECK(stages.empty());
+  CHECK_EQ(to_string(content), to_string(msg));
+}
+
+CAF_TEST(forwarding re-encodes routed messages for the next hop) {
+  connect_node(jupiter());
+  connect_node(mars());
+  auto msg = make_message("hello", int32_t{42});
+  MESSAGE("Jupiter sends a message to Mars that refers to its dictionary");
+  basp::send_dictionary remote_dict;
+  send_from(jupiter().connection,
+            {basp::message_type::dictionary_update, no_flags, 0,
+             no_operation_data, invalid_actor_id, invalid_actor_id},
+            [&](binary_serializer& sink) {
+              return remote_dict.add(sink, jupiter().id)
+                     && remote_dict.add(sink, mars().id);
+            });
+  auto write_routed = [&](binary_serializer& sink) {
+    return basp::write_node(sink, remote_dict, jupiter().id)
+           && basp::write_node(sink, remote_dict, mars().id)
+           && sink.apply(std::vector<strong_actor_ptr>{}) && sink.apply(msg);
+  };
+  send_from(jupiter().connection,
+            {basp::message_type::routed_message, basp::header::dictionary_flag,
+             0, default_operation_data, invalid_actor_id,
+             mars().dummy_actor->id()},
+            write_routed);
+  MESSAGE("Earth replaces the references with the ones for Mars");
+  auto [hdr, payload] = read_skipping_updates(mars().connection);
+  CHECK_EQ(hdr.operation, basp::message_type::routed_message);
+  CHECK(hdr.has(basp::header::dictionary_flag));
+  CHECK_EQ(hdr.dest_actor, mars().dummy_actor->id());
+  binary_deserializer source{mpx(), payload};
+  node_id source_node;
+  node_id dest_node;
+  CHECK(basp::read_node(source, dicts[mars().connection], source_node));
+  CHECK(basp::read_node(source, dicts[mars().connection], dest_node));
+  CHECK_EQ(source_node, jupiter().id);
+  CHECK_EQ(dest_node, mars().id);
+  byte_buffer remainder;
+  to_payload(remainder, std::vector<strong_actor_ptr>{}, msg);
+  auto rest = source.remainder();
+  CHECK_EQ(hexstr(byte_buffer{rest.begin(), rest.end()}), hexstr(remainder));
+}
+
+CAF_TEST(forwarding writes full node IDs for next hops without dictionaries) {
+  connect_node(jupiter());
+  remote_extensions.clear();
+  connect_node(mars());
+  CHECK(!instance().uses_dictionaries(mars().connection));
+  auto msg = make_message("hello", int32_t{42});
+  basp::send_dictionary remote_dict;
+  send_from(jupiter().connection,
+            {basp::message_type::dictionary_update, no_flags, 0,
+             no_operation_data, invalid_actor_id, invalid_actor_id},
+            [&](binary_serializer& sink) {
+              return remote_dict.add(sink, jupiter().id)
+                     && remote_dict.add(sink, mars().id);
+            });
+  send_from(jupiter().connection,
+            {basp::message_type::routed_message, basp::header::dictionary_flag,
+             0, default_operation_data, invalid_actor_id,
+             mars().dummy_actor->id()},
+            [&](binary_serializer& sink) {
+              return basp::write_node(sink, remote_dict, jupiter().id)
+                     && basp::write_node(sink, remote_dict, mars().id)
+                     && sink.apply(std::vector<strong_actor_ptr>{})
+                     && sink.apply(msg);
+            });
+  mock().receive(mars().connection, basp::message_type::routed_message,
+                 no_flags, any_vals, default_operation_data, invalid_actor_id,
+                 mars().dummy_actor->id(), jupiter().id, mars().id,
+                 std::vector<strong_actor_ptr>{}, msg);
+}
+
+CAF_TEST(multicast messages use dictionaries) {
+  connect_node(jupiter());
+  auto prx1 = proxies().get_or_put(jupiter().id, jupiter().dummy_actor->id());
+  auto prx2 = proxies().get_or_put(jupiter().id, 4711);
+  auto msg = make_message("hello", int32_t{42});
+  MESSAGE("outgoing multicast messages refer to the dictionary");
+  auto sender = actor_cast<strong_actor_ptr>(self());
+  sys.middleman().multicast(sender, {prx1, prx2}, msg);
+  mpx()->flush_runnables();
+  basp::header hdr;
+  byte_buffer payload;
+  do {
+    std::tie(hdr, payload) = read_skipping_updates(jupiter().connection);
+  } while (hdr.operation != basp::message_type::multicast_message);
+  CHECK(hdr.has(basp::header::dictionary_flag));
+  auto& dict = dicts[jupiter().connection];
+  binary_deserializer source{mpx(), payload};
+  std::vector<actor_id> receivers;
+  std::vector<strong_actor_ptr> stages;
+  message content;
+  CHECK(source.apply(receivers));
+  CHECK(basp::read_stages(source, dict, stages));
+  CHECK(basp::read_message(source, dict, content));
+  CHECK_EQ(receivers, std::vector<actor_id>({prx1->id(), prx2->id()}));
+  CHECK(stages.empty());
+  CHECK_EQ(to_string(content), to_string(msg));
+  MESSAGE("BASP resolves references in incoming multicast messages");
+  scoped_actor other{sys};
+  registry()->put(other->id(), actor_cast<strong_actor_ptr>(other));
+  basp::send_dictionary remote_dict;
+  send_from(jupiter().connection,
+            {basp::message_type::dictionary_update, no_flags, 0,
+             no_operation_data, invalid_actor_id, invalid_actor_id},
+            [&](binary_serializer& sink) {
+              return remote_dict.add(sink, msg.types());
+            });
+  send_from(jupiter().connection,
+            {basp::message_type::multicast_message,
+             basp::header::dictionary_flag, 0, default_operation_data,
+             jupiter().dummy_actor->id(), 2},
+            [&](binary_serializer& sink) {
+              return sink.apply(std::vector<actor_id>{self()->id(),
+                                                      other->id()})
+                     && basp::write_stages(sink, remote_dict, {})
+                     && basp::write_type_ids(sink, remote_dict, msg.types())
+                     && basp::write_values(sink, msg);
+            });
+  auto check_msg = [](const std::string& str, int32_t x) {
+    CHECK_EQ(str, "hello");
+    CHECK_EQ(x, 42);
+  };
+  self()->receive(check_msg);
+  other->receive(check_msg);
+}
+
+END_FIXTURE_SCOPE()
+
+BEGIN_FIXTURE_SCOPE(dictionaries_and_workers_fixture)
+
+CAF_TEST(BASP workers resolve references with the current dictionary) {
+  connect_node(jupiter());
+  basp::send_dictionary remote_dict;
+  auto send_msg = [&](const message& msg) {
+    if (remote_dict.find(msg.types()) == 0)
+      send_from(jupiter().connection,
+                {basp::message_type::dictionary_update, no_flags, 0,
+                 no_operation_data, invalid_actor_id, invalid_actor_id},
+                [&](binary_serializer& sink) {
+                  return remote_dict.add(sink, msg.types());
+                });
+    send_from(jupiter().connection,
+              {basp::message_type::direct_message,
+               basp::header::dictionary_flag, 0, default_operation_data,
+               jupiter().dummy_actor->id(), self()->id()},
+              [&](binary_serializer& sink) {
+                return basp::write_stages(sink, remote_dict, {})
+                       && basp::write_type_ids(sink, remote_dict, msg.types())
+                       && basp::write_values(sink, msg);
+              });
+  };
+  MESSAGE("updates between two messages leave pending messages intact");
+  send_msg(make_message("hello", int32_t{42}));
+  send_msg(make_message(int32_t{1}, int32_t{2}));
+  send_msg(make_message("hello", int32_t{23}));
+  self()->receive([](const std::string& str, int32_t x) {
+    CHECK_EQ(str, "hello");
+    CHECK_EQ(x, 42);
+  });
+  self()->receive([](int32_t x, int32_t y) {
+    CHECK_EQ(x, 1);
+    CHECK_EQ(y, 2);
+  });
+  self()->receive([](const std::string& str, int32_t x) {
+    CHECK_EQ(str, "hello");
+    CHECK_EQ(x, 23);
+  });
+}
+
+END_FIXTURE_SCOPE()
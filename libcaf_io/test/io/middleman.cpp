@@ -16,6 +16,7 @@
 #include "caf/actor_system.hpp"
 #include "caf/behavior.hpp"
 #include "caf/scoped_actor.hpp"
+#include "caf/uri.hpp"
 
 #include "io-test.hpp"
 #include <sys/socket.h>
@@ -34,6 +35,8 @@ struct node_fixture {
       set("caf.scheduler.policy", "sharing");
       set("caf.scheduler.max-threads", 1);
       set("caf.middleman.workers", 0);
+      // Heartbeats would flush pending writes eventually and thus hide stalls.
+      set("caf.middleman.heartbeat-interval", timespan{0});
     }
   };
 
@@ -49,6 +52,19 @@ struct node_fixture {
   actor basp_broker;
 };
 
+// Connects jupiter to earth only via mars.
+struct relay_fixture {
+  node_fixture earth;
+  node_fixture mars;
+  node_fixture jupiter;
+};
+
+// Connects two nodes only on demand.
+struct shm_fixture {
+  node_fixture earth;
+  node_fixture mars;
+};
+
 struct fixture {
   node_fixture earth;
   node_fixture mars;
@@ -102,3 +118,131 @@ CAF_TEST(remote_lookup allows registry lookups on other nodes) {
 }
 
 END_FIXTURE_SCOPE()
+
+BEGIN_FIXTURE_SCOPE(relay_fixture)
+
+CAF_TEST(relay nodes forward messages without waiting for other events) {
+  auto testee = earth.sys.spawn([]() -> behavior {
+    return {
+      [](int32_t x, int32_t y) { return x + y; },
+    };
+  });
+  auto earth_port = earth.mm.publish(testee, 0);
+  if (!earth_port)
+    CAF_FAIL("publish failed: " << earth_port.error());
+  auto testee_on_mars = mars.mm.remote_actor("localhost", *earth_port);
+  if (!testee_on_mars)
+    CAF_FAIL("remote_actor failed: " << testee_on_mars.error());
+  auto relay = mars.sys.spawn([hdl = *testee_on_mars]() -> behavior {
+    return {
+      [hdl](get_atom) { return hdl; },
+    };
+  });
+  auto mars_port = mars.mm.publish(relay, 0);
+  if (!mars_port)
+    CAF_FAIL("publish failed: " << mars_port.error());
+  auto relay_on_jupiter = jupiter.mm.remote_actor("localhost", *mars_port);
+  if (!relay_on_jupiter)
+    CAF_FAIL("remote_actor failed: " << relay_on_jupiter.error());
+  actor testee_on_jupiter;
+  jupiter.self
+    ->request(*relay_on_jupiter, std::chrono::seconds(5), get_atom_v)
+    .receive([&](actor& hdl) { testee_on_jupiter = std::move(hdl); },
+             [](caf::error& err) { CAF_FAIL("request failed: " << err); });
+  CHECK_EQ(testee_on_jupiter.node(), earth.sys.node());
+  MESSAGE("messages from jupiter to earth travel via mars");
+  jupiter.self
+    ->request(testee_on_jupiter, std::chrono::seconds(5), int32_t{7},
+              int32_t{8})
+    .receive([](int32_t result) { CHECK_EQ(result, 15); },
+             [](caf::error& err) { CAF_FAIL("request failed: " << err); });
+  anon_send_exit(relay, exit_reason::user_shutdown);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+END_FIXTURE_SCOPE()
+
+#ifdef CAF_LINUX
+
+BEGIN_FIXTURE_SCOPE(shm_fixture)
+
+CAF_TEST(nodes on the same host may connect via shared memory) {
+  auto testee_impl = []() -> behavior {
+    return {
+      [](int32_t x, int32_t y) { return x + y; },
+      [](std::string& str) { return std::move(str); },
+    };
+  };
+  auto testee = earth.sys.spawn(testee_impl);
+  auto port = earth.mm.publish(testee, unbox(make_uri("shm://localhost:0")));
+  if (!port)
+    CAF_FAIL("publish failed: " << port.error());
+  auto locator = unbox(make_uri("shm://localhost:" + std::to_string(*port)));
+  auto testee_proxy = mars.mm.remote_actor(locator);
+  if (!testee_proxy)
+    CAF_FAIL("remote_actor failed: " << testee_proxy.error());
+  CHECK_EQ(testee->node(), testee_proxy->node());
+  CHECK_EQ(testee->id(), testee_proxy->id());
+  for (int32_t i = 0; i < 10; ++i)
+    mars.self
+      ->request(*testee_proxy, std::chrono::minutes(1), i, int32_t{8})
+      .receive([i](int32_t result) { CHECK_EQ(result, i + 8); },
+               [](caf::error& err) { CAF_FAIL("request failed: " << err); });
+  MESSAGE("messages may exceed the size of the ring buffers");
+  std::string large(1024 * 1024, 'x');
+  mars.self->request(*testee_proxy, std::chrono::minutes(1), large)
+    .receive([&large](std::string& result) { CHECK_EQ(result, large); },
+             [](caf::error& err) { CAF_FAIL("request failed: " << err); });
+  MESSAGE("connecting again returns the cached connection");
+  auto again = mars.mm.remote_actor(locator);
+  CHECK_EQ(again, testee_proxy);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+CAF_TEST(publish and remote_actor reject unsupported URIs) {
+  auto testee = earth.sys.spawn([]() -> behavior {
+    return {
+      [](int32_t x) { return x; },
+    };
+  });
+  CHECK(!earth.mm.publish(testee, unbox(make_uri("foo://localhost:0"))));
+  CHECK(!earth.mm.publish(testee, unbox(make_uri("shm://example.com:0"))));
+  CHECK(!mars.mm.remote_actor(unbox(make_uri("foo://localhost:1234"))));
+  CHECK(!mars.mm.remote_actor(unbox(make_uri("shm://example.com:1234"))));
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+CAF_TEST(shared memory ports never clash with published TCP ports) {
+  auto testee = earth.sys.spawn([]() -> behavior {
+    return {
+      [](int32_t x) { return x; },
+    };
+  });
+  auto tcp_port = earth.mm.publish(testee, 0);
+  if (!tcp_port)
+    CAF_FAIL("publish failed: " << tcp_port.error());
+  auto locator = "shm://localhost:" + std::to_string(*tcp_port);
+  CHECK(!earth.mm.publish(testee, unbox(make_uri(locator))));
+  MESSAGE("the TCP port still refers to the published actor");
+  auto proxy = mars.mm.remote_actor("localhost", *tcp_port);
+  if (!proxy)
+    CAF_FAIL("remote_actor failed: " << proxy.error());
+  CHECK_EQ(testee->id(), proxy->id());
+  MESSAGE("TCP publishes fail for ports of shared memory doormen");
+  auto shm_port = earth.mm.publish(testee,
+                                   unbox(make_uri("shm://localhost:0")));
+  if (!shm_port)
+    CAF_FAIL("publish failed: " << shm_port.error());
+  CHECK(!earth.mm.publish(testee, *shm_port));
+  MESSAGE("the shared memory port still refers to the published actor");
+  locator = "shm://localhost:" + std::to_string(*shm_port);
+  auto shm_proxy = mars.mm.remote_actor(unbox(make_uri(locator)));
+  if (!shm_proxy)
+    CAF_FAIL("remote_actor failed: " << shm_proxy.error());
+  CHECK_EQ(testee->id(), shm_proxy->id());
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+END_FIXTURE_SCOPE()
+
+#endif // CAF_LINUX
@@ -117,7 +117,7 @@ CAF_TEST(deliver serialized message) {
                        42,
                        testee.id()};
   MESSAGE("launch worker");
-  w->launch(last_hop, hdr, payload);
+  w->launch(last_hop, hdr, payload, nullptr);
   sched.run_once();
   expect((ok_atom), from(_).to(testee));
 }
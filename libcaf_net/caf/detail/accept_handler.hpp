@@ -95,7 +95,13 @@ public:
     if (open_connections_ == max_connections_) {
       owner_->deregister_reading();
     } else if (auto conn = accept(acc_)) {
-      auto child = factory_->make(owner_->mpx_ptr(), std::move(*conn));
+      // Note: all connections of a server share the state of the factory, in
+      //       particular the producer for accept events in the server
+      //       factories. Since the child may run in another multiplexer, it
+      //       may push to this producer concurrently to other connections.
+      //       This is safe, because `blocking_producer::push` is thread-safe.
+      auto* mpx = owner_->mpx().next_for_connection();
+      auto child = factory_->make(mpx, std::move(*conn));
       if (!child) {
         CAF_LOG_ERROR("factory failed to create a new child");
         on_conn_close_.dispose();
@@ -104,8 +110,20 @@ public:
       }
       if (++open_connections_ == max_connections_)
         owner_->deregister_reading();
-      child->add_cleanup_listener(on_conn_close_);
-      std::ignore = child->start();
+      if (mpx == owner_->mpx_ptr()) {
+        child->add_cleanup_listener(on_conn_close_);
+        std::ignore = child->start();
+      } else {
+        // The child runs in another thread. Hence, we need to route the
+        // cleanup callback back to our multiplexer.
+        auto ctx = async::execution_context_ptr{owner_->mpx_ptr()};
+        child->add_cleanup_listener(
+          make_action([ctx, cb = on_conn_close_] {
+            if (!cb.disposed())
+              ctx->schedule(cb);
+          }));
+        mpx->start(std::move(child));
+      }
     } else if (conn.error() == sec::unavailable_or_would_block) {
       // Encountered a "soft" error: simply try again later.
       CAF_LOG_DEBUG("accept failed:" << conn.error());
@@ -0,0 +1,113 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/http_route_tree.hpp"
+
+#include "caf/net/http/route.hpp"
+
+#include <algorithm>
+
+namespace caf::detail {
+
+namespace {
+
+// Stores the arguments on the path from the root to the current node as a
+// linked list on the stack.
+struct arg_frame {
+  std::string_view value;
+  const arg_frame* prev;
+};
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+http_route_tree::http_route_tree() = default;
+
+http_route_tree::http_route_tree(std::vector<net::http::route_ptr> routes)
+  : routes_(std::move(routes)) {
+  for (size_t index = 0; index < routes_.size(); ++index) {
+    auto path = routes_[index]->path();
+    if (path.empty() || path.front() != '/')
+      fallbacks_.push_back(index);
+    else
+      insert(index, path);
+  }
+}
+
+http_route_tree::~http_route_tree() {
+  // nop
+}
+
+// -- lookup -------------------------------------------------------------------
+
+namespace {
+
+template <class Node, class F>
+void match_impl(const Node& pos, std::string_view path, const arg_frame* args,
+                size_t num_args, F& on_leaf) {
+  if (path.empty()) {
+    on_leaf(pos, args, num_args);
+    return;
+  }
+  auto [head, tail] = next_path_component(path);
+  if (auto i = pos.children.find(head); i != pos.children.end())
+    match_impl(*i->second, tail, args, num_args, on_leaf);
+  if (pos.arg_child) {
+    auto next = arg_frame{head, args};
+    match_impl(*pos.arg_child, tail, &next, num_args + 1, on_leaf);
+  }
+}
+
+} // namespace
+
+void http_route_tree::match(net::http::method method, std::string_view path,
+                            std::vector<candidate>& result,
+                            std::vector<std::string_view>& args) const {
+  result.clear();
+  args.clear();
+  if (!path.empty() && path.front() == '/') {
+    auto on_leaf = [&](const node& leaf, const arg_frame* frame,
+                       size_t num_args) {
+      if (leaf.leaves.empty())
+        return;
+      auto offset = args.size();
+      args.resize(offset + num_args);
+      for (auto pos = offset + num_args; pos > offset; --pos) {
+        args[pos - 1] = frame->value;
+        frame = frame->prev;
+      }
+      for (auto index : leaf.leaves) {
+        auto filter = routes_[index]->request_method();
+        if (!filter || *filter == method)
+          result.push_back(candidate{index, offset, num_args});
+      }
+    };
+    match_impl(root_, path, nullptr, 0, on_leaf);
+  }
+  for (auto index : fallbacks_)
+    result.push_back(candidate{index, args.size(), 0});
+  // Routes registered first take precedence.
+  std::sort(result.begin(), result.end(),
+            [](const candidate& x, const candidate& y) {
+              return x.index < y.index;
+            });
+}
+
+// -- private utility functions ------------------------------------------------
+
+void http_route_tree::insert(size_t index, std::string_view path) {
+  auto* pos = &root_;
+  while (!path.empty()) {
+    auto [head, tail] = next_path_component(path);
+    auto& child = head == "<arg>" ? pos->arg_child : pos->children[head];
+    if (!child)
+      child = std::make_unique<node>();
+    pos = child.get();
+    path = tail;
+  }
+  pos->leaves.push_back(index);
+}
+
+} // namespace caf::detail
@@ -0,0 +1,88 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/net/fwd.hpp"
+#include "caf/net/http/method.hpp"
+
+#include "caf/detail/net_export.hpp"
+#include "caf/span.hpp"
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace caf::detail {
+
+/// Indexes HTTP routes by the segments of their path for finding all routes
+/// that match a request in a single pass over its path. Literal segments map
+/// to their child via hash lookup, while `<arg>` placeholders have a dedicated
+/// child that matches any segment.
+///
+/// Routes without a path (see @ref net::http::route::path) perform their own
+/// matching. Hence, the tree considers them candidates for any request.
+class CAF_NET_EXPORT http_route_tree {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// A route that matches the path of a request.
+  struct candidate {
+    /// The position of the route in the list of routes.
+    size_t index;
+
+    /// The position of the first argument in the argument buffer.
+    size_t args_offset;
+
+    /// The number of arguments for the route.
+    size_t num_args;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  http_route_tree();
+
+  explicit http_route_tree(std::vector<net::http::route_ptr> routes);
+
+  http_route_tree(const http_route_tree&) = delete;
+
+  http_route_tree& operator=(const http_route_tree&) = delete;
+
+  ~http_route_tree();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns all routes in order of insertion.
+  const std::vector<net::http::route_ptr>& routes() const noexcept {
+    return routes_;
+  }
+
+  // -- lookup -----------------------------------------------------------------
+
+  /// Collects all routes that match `method` and `path` into `result`, ordered
+  /// by their position in the list of routes. Stores the path segments for
+  /// `<arg>` placeholders in `args`.
+  void match(net::http::method method, std::string_view path,
+             std::vector<candidate>& result,
+             std::vector<std::string_view>& args) const;
+
+private:
+  struct node {
+    std::unordered_map<std::string_view, std::unique_ptr<node>> children;
+    std::unique_ptr<node> arg_child;
+    std::vector<size_t> leaves;
+  };
+
+  void insert(size_t index, std::string_view path);
+
+  std::vector<net::http::route_ptr> routes_;
+
+  /// Routes without a path, i.e., routes that do their own matching.
+  std::vector<size_t> fallbacks_;
+
+  node root_;
+};
+
+} // namespace caf::detail
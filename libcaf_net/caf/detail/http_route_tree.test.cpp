@@ -0,0 +1,144 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/http_route_tree.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/net/http/responder.hpp"
+#include "caf/net/http/route.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace http = caf::net::http;
+
+using http::responder;
+
+namespace {
+
+struct match_result {
+  std::vector<size_t> indexes;
+  std::vector<std::vector<std::string_view>> args;
+};
+
+match_result match(const detail::http_route_tree& tree, http::method method,
+                   std::string_view path) {
+  std::vector<detail::http_route_tree::candidate> candidates;
+  std::vector<std::string_view> args;
+  tree.match(method, path, candidates, args);
+  match_result result;
+  for (auto& x : candidates) {
+    result.indexes.push_back(x.index);
+    auto first = args.begin() + static_cast<ptrdiff_t>(x.args_offset);
+    auto last = first + static_cast<ptrdiff_t>(x.num_args);
+    result.args.emplace_back(first, last);
+  }
+  return result;
+}
+
+template <class Expected>
+http::route_ptr route(Expected res) {
+  if (!res)
+    CAF_RAISE_ERROR("failed to create a route");
+  return std::move(*res);
+}
+
+using strings = std::vector<std::string_view>;
+
+using indexes = std::vector<size_t>;
+
+} // namespace
+
+TEST("the route tree matches literal paths") {
+  std::vector<http::route_ptr> routes;
+  routes.push_back(route(http::make_route("/", [](responder&) {})));
+  routes.push_back(route(http::make_route("/foo", [](responder&) {})));
+  routes.push_back(route(http::make_route("/foo/", [](responder&) {})));
+  routes.push_back(route(http::make_route("/foo/bar", [](responder&) {})));
+  detail::http_route_tree tree{std::move(routes)};
+  check_eq(tree.routes().size(), 4u);
+  check_eq(match(tree, http::method::get, "/").indexes, indexes{0});
+  check_eq(match(tree, http::method::get, "/foo").indexes, indexes{1});
+  check_eq(match(tree, http::method::get, "/foo/").indexes, indexes{2});
+  check_eq(match(tree, http::method::get, "/foo/bar").indexes, indexes{3});
+  check_eq(match(tree, http::method::get, "/bar").indexes, indexes{});
+  check_eq(match(tree, http::method::get, "/foo/bar/baz").indexes, indexes{});
+  check_eq(match(tree, http::method::get, "").indexes, indexes{});
+}
+
+TEST("the route tree extracts the segments for <arg> placeholders") {
+  std::vector<http::route_ptr> routes;
+  routes.push_back(
+    route(http::make_route("/user/<arg>", [](responder&, int) {})));
+  routes.push_back(route(http::make_route("/user/<arg>/post/<arg>",
+                                          [](responder&, int, int) {})));
+  detail::http_route_tree tree{std::move(routes)};
+  SECTION("a single argument") {
+    auto res = match(tree, http::method::get, "/user/42");
+    check_eq(res.indexes, indexes{0});
+    check_eq(res.args, std::vector<strings>{{"42"}});
+  }
+  SECTION("multiple arguments") {
+    auto res = match(tree, http::method::get, "/user/42/post/7");
+    check_eq(res.indexes, indexes{1});
+    check_eq(res.args, std::vector<strings>{{"42", "7"}});
+  }
+  SECTION("non-matching paths") {
+    check_eq(match(tree, http::method::get, "/user").indexes, indexes{});
+    check_eq(match(tree, http::method::get, "/user/42/post").indexes,
+             indexes{});
+    check_eq(match(tree, http::method::get, "/post/42").indexes, indexes{});
+  }
+}
+
+TEST("routes registered first take precedence") {
+  std::vector<http::route_ptr> routes;
+  routes.push_back(
+    route(http::make_route("/foo/<arg>", [](responder&, std::string) {})));
+  routes.push_back(route(http::make_route("/foo/bar", [](responder&) {})));
+  routes.push_back(
+    route(http::make_route("/<arg>/bar", [](responder&, std::string) {})));
+  detail::http_route_tree tree{std::move(routes)};
+  auto res = match(tree, http::method::get, "/foo/bar");
+  check_eq(res.indexes, indexes{0, 1, 2});
+  check_eq(res.args, std::vector<strings>{{"bar"}, {}, {"foo"}});
+  res = match(tree, http::method::get, "/foo/baz");
+  check_eq(res.indexes, indexes{0});
+  check_eq(res.args, std::vector<strings>{{"baz"}});
+}
+
+TEST("the route tree filters routes by their method") {
+  std::vector<http::route_ptr> routes;
+  routes.push_back(route(
+    http::make_route("/foo", http::method::post, [](responder&) {})));
+  routes.push_back(route(http::make_route(
+    "/foo/<arg>", http::method::get, [](responder&, int) {})));
+  routes.push_back(route(http::make_route("/foo", [](responder&) {})));
+  detail::http_route_tree tree{std::move(routes)};
+  check_eq(match(tree, http::method::post, "/foo").indexes, indexes{0, 2});
+  check_eq(match(tree, http::method::get, "/foo").indexes, indexes{2});
+  check_eq(match(tree, http::method::get, "/foo/1").indexes, indexes{1});
+  check_eq(match(tree, http::method::put, "/foo/1").indexes, indexes{});
+}
+
+TEST("catch-all routes match any path") {
+  std::vector<http::route_ptr> routes;
+  routes.push_back(route(http::make_route("/foo", [](responder&) {})));
+  routes.push_back(route(http::make_route([](responder&) {})));
+  routes.push_back(
+    route(http::make_route("/<arg>", [](responder&, std::string) {})));
+  detail::http_route_tree tree{std::move(routes)};
+  check_eq(match(tree, http::method::get, "/foo").indexes, indexes{0, 1, 2});
+  check_eq(match(tree, http::method::get, "/bar").indexes, indexes{1, 2});
+  check_eq(match(tree, http::method::get, "/foo/bar").indexes, indexes{1});
+  check_eq(match(tree, http::method::get, "*").indexes, indexes{1});
+}
+
+CAF_TEST_MAIN()
@@ -5,26 +5,169 @@
 #include "caf/detail/rfc6455.hpp"
 
 #include "caf/detail/network_order.hpp"
+#include "caf/detail/rfc3629.hpp"
 
+#include <algorithm>
 #include <cstring>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#  define CAF_RFC6455_HAS_SSE2
+#  include <emmintrin.h>
+#  if defined(__GNUC__) || defined(__clang__)
+#    define CAF_RFC6455_HAS_AVX2
+#    include <immintrin.h>
+#  endif
+#endif
+
 namespace caf::detail {
 
+namespace {
+
+// Note: all algorithms expect `key` to be in network byte order, i.e., the
+//       first byte of the key applies to the first byte of the data.
+
+void mask_scalar(const std::byte* key, std::byte* first, size_t size) {
+  for (size_t i = 0; i < size; ++i)
+    first[i] ^= key[i % 4];
+}
+
+void mask_word(const std::byte* key, std::byte* first, size_t size) {
+  uint64_t pattern;
+  memcpy(&pattern, key, 4);
+  memcpy(reinterpret_cast<std::byte*>(&pattern) + 4, key, 4);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t block;
+    memcpy(&block, first + i, 8);
+    block ^= pattern;
+    memcpy(first + i, &block, 8);
+  }
+  // Since i is a multiple of 4, the remainder starts with the first key byte.
+  mask_scalar(key, first + i, size - i);
+}
+
+#ifdef CAF_RFC6455_HAS_SSE2
+
+void mask_sse2(const std::byte* key, std::byte* first, size_t size) {
+  int32_t key_val;
+  memcpy(&key_val, key, 4);
+  auto pattern = _mm_set1_epi32(key_val);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    auto ptr = reinterpret_cast<__m128i*>(first + i);
+    _mm_storeu_si128(ptr, _mm_xor_si128(_mm_loadu_si128(ptr), pattern));
+  }
+  mask_word(key, first + i, size - i);
+}
+
+#endif
+
+#ifdef CAF_RFC6455_HAS_AVX2
+
+__attribute__((target("avx2"))) void
+mask_avx2(const std::byte* key, std::byte* first, size_t size) {
+  int32_t key_val;
+  memcpy(&key_val, key, 4);
+  auto pattern = _mm256_set1_epi32(key_val);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    auto ptr = reinterpret_cast<__m256i*>(first + i);
+    _mm256_storeu_si256(ptr,
+                        _mm256_xor_si256(_mm256_loadu_si256(ptr), pattern));
+  }
+  mask_sse2(key, first + i, size - i);
+}
+
+#endif
+
+rfc6455::mask_algorithm select_mask_algorithm() noexcept {
+  using algorithm = rfc6455::mask_algorithm;
+  for (auto x : {algorithm::avx2, algorithm::sse2})
+    if (rfc6455::supports(x))
+      return x;
+  return algorithm::word;
+}
+
+} // namespace
+
 void rfc6455::mask_data(uint32_t key, span<char> data) {
   mask_data(key, as_writable_bytes(data));
 }
 
 void rfc6455::mask_data(uint32_t key, byte_span data) {
+  mask_data(default_mask_algorithm(), key, data);
+}
+
+void rfc6455::mask_data(mask_algorithm algorithm, uint32_t key,
+                        byte_span data) {
   auto no_key = to_network_order(key);
   std::byte arr[4];
   memcpy(arr, &no_key, 4);
-  size_t i = 0;
-  for (auto& x : data) {
-    x = x ^ arr[i];
-    i = (i + 1) % 4;
+  switch (algorithm) {
+#ifdef CAF_RFC6455_HAS_AVX2
+    case mask_algorithm::avx2:
+      mask_avx2(arr, data.data(), data.size());
+      break;
+#endif
+#ifdef CAF_RFC6455_HAS_SSE2
+    case mask_algorithm::sse2:
+      mask_sse2(arr, data.data(), data.size());
+      break;
+#endif
+    case mask_algorithm::word:
+      mask_word(arr, data.data(), data.size());
+      break;
+    default:
+      mask_scalar(arr, data.data(), data.size());
   }
 }
 
+bool rfc6455::mask_and_validate(uint32_t key, byte_span data) {
+  // Must be a multiple of 4 to keep the key aligned to the start of a block.
+  constexpr size_t block_size = 4096;
+  auto algorithm = default_mask_algorithm();
+  size_t validated = 0;
+  for (size_t offset = 0; offset < data.size(); offset += block_size) {
+    auto n = std::min(block_size, data.size() - offset);
+    mask_data(algorithm, key, data.subspan(offset, n));
+    // A code point may span two blocks. In this case, the validation of the
+    // next block starts at the incomplete code point.
+    auto unchecked = data.subspan(validated, offset + n - validated);
+    auto [index, incomplete] = rfc3629::validate(unchecked);
+    validated += index;
+    if (index != unchecked.size() && !incomplete)
+      return false;
+  }
+  return validated == data.size();
+}
+
+bool rfc6455::supports(mask_algorithm algorithm) noexcept {
+  switch (algorithm) {
+    case mask_algorithm::scalar:
+    case mask_algorithm::word:
+      return true;
+    case mask_algorithm::sse2:
+#ifdef CAF_RFC6455_HAS_SSE2
+      return true;
+#else
+      return false;
+#endif
+    case mask_algorithm::avx2:
+#ifdef CAF_RFC6455_HAS_AVX2
+      return __builtin_cpu_supports("avx2");
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+rfc6455::mask_algorithm rfc6455::default_mask_algorithm() noexcept {
+  static const auto result = select_mask_algorithm();
+  return result;
+}
+
 void rfc6455::assemble_frame(uint32_t mask_key, span<const char> data,
                              byte_buffer& out) {
   assemble_frame(text_frame, mask_key, as_bytes(data), out);
@@ -72,13 +215,15 @@ void rfc6455::assemble_frame(uint8_t opcode, uint32_t mask_key,
   out.insert(out.end(), data.begin(), data.end());
 }
 
-ptrdiff_t rfc6455::decode_header(const_byte_span data, header& hdr) {
+ptrdiff_t rfc6455::decode_header(const_byte_span data, header& hdr,
+                                 uint8_t allowed_rsv) {
   if (data.size() < 2)
     return 0;
   auto byte1 = std::to_integer<uint8_t>(data[0]);
   auto byte2 = std::to_integer<uint8_t>(data[1]);
   // Fetch FIN flag and opcode.
   hdr.fin = (byte1 & 0x80) != 0;
+  hdr.rsv = byte1 & 0x70;
   hdr.opcode = byte1 & 0x0F;
   // Decode mask bit and payload length field.
   bool masked = (byte2 & 0x80) != 0;
@@ -118,8 +263,8 @@ ptrdiff_t rfc6455::decode_header(const_byte_span data, header& hdr) {
   } else {
     hdr.mask_key = 0;
   }
-  // No extension bits allowed.
-  if (byte1 & 0x70)
+  // Only allow extension bits that were negotiated.
+  if ((hdr.rsv & ~allowed_rsv) != 0)
     return -1;
   // Verify opcode and return number of consumed bytes.
   switch (hdr.opcode) {
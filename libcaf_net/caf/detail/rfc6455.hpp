@@ -19,11 +19,24 @@ struct CAF_NET_EXPORT rfc6455 {
 
   struct header {
     bool fin;
+    uint8_t rsv;
     uint8_t opcode;
     uint32_t mask_key;
     uint64_t payload_len;
   };
 
+  /// Selects an implementation for masking payloads.
+  enum class mask_algorithm {
+    /// Processes one byte at a time.
+    scalar,
+    /// Processes 8 bytes at a time.
+    word,
+    /// Processes 16 bytes at a time using SSE2 instructions.
+    sse2,
+    /// Processes 32 bytes at a time using AVX2 instructions.
+    avx2,
+  };
+
   // -- constants --------------------------------------------------------------
 
   static constexpr uint8_t continuation_frame = 0x00;
@@ -40,12 +53,34 @@ struct CAF_NET_EXPORT rfc6455 {
 
   static constexpr uint8_t fin_flag = 0x80;
 
+  /// Marks compressed messages when using the extension `permessage-deflate`.
+  static constexpr uint8_t rsv1_flag = 0x40;
+
   // -- utility functions ------------------------------------------------------
 
   static void mask_data(uint32_t key, span<char> data);
 
   static void mask_data(uint32_t key, byte_span data);
 
+  /// Masks `data` with `key` using `algorithm`.
+  /// @pre `supports(algorithm)`
+  static void mask_data(mask_algorithm algorithm, uint32_t key,
+                        byte_span data);
+
+  /// Unmasks `data` with `key` and checks whether the result is valid UTF-8.
+  /// Processes the payload in blocks that fit into the L1 cache to read each
+  /// byte only once from memory.
+  /// @returns `true` if `data` is valid UTF-8 after unmasking, `false`
+  ///          otherwise. On error, parts of `data` may remain masked.
+  static bool mask_and_validate(uint32_t key, byte_span data);
+
+  /// Checks whether the current CPU supports `algorithm`.
+  static bool supports(mask_algorithm algorithm) noexcept;
+
+  /// Returns the fastest algorithm the current CPU supports. The overloads of
+  /// `mask_data` without an explicit algorithm always use this algorithm.
+  static mask_algorithm default_mask_algorithm() noexcept;
+
   static void assemble_frame(uint32_t mask_key, span<const char> data,
                              byte_buffer& out);
 
@@ -56,7 +91,14 @@ struct CAF_NET_EXPORT rfc6455 {
                              const_byte_span data, byte_buffer& out,
                              uint8_t flags = fin_flag);
 
-  static ptrdiff_t decode_header(const_byte_span data, header& hdr);
+  /// Decodes the header of a frame.
+  /// @param data The received bytes.
+  /// @param hdr Receives the decoded header.
+  /// @param allowed_rsv The RSV bits that extensions have negotiated.
+  /// @returns the number of bytes of the header, 0 if `data` contains only a
+  ///          partial header or -1 if the header is malformed.
+  static ptrdiff_t decode_header(const_byte_span data, header& hdr,
+                                 uint8_t allowed_rsv = 0);
 
   static constexpr bool is_control_frame(uint8_t opcode) noexcept {
     return opcode > binary_frame;
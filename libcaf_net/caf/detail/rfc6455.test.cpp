@@ -55,6 +55,64 @@ TEST("masking") {
   }
 }
 
+TEST("all masking algorithms produce the same output") {
+  using algorithm = impl::mask_algorithm;
+  auto key = uint32_t{0xDEADC0DE};
+  byte_buffer data;
+  for (size_t i = 0; i < 203; ++i)
+    data.push_back(static_cast<std::byte>(i));
+  for (auto alg : {algorithm::word, algorithm::sse2, algorithm::avx2}) {
+    if (!impl::supports(alg))
+      continue;
+    // Cover all combinations of misaligned inputs and trailing bytes.
+    for (size_t first = 0; first < 8; ++first) {
+      for (size_t size = 0; size + first < data.size(); size += 5) {
+        auto expected = data;
+        impl::mask_data(algorithm::scalar, key,
+                        make_span(expected).subspan(first, size));
+        auto masked = data;
+        impl::mask_data(alg, key, make_span(masked).subspan(first, size));
+        check_eq(masked, expected);
+      }
+    }
+  }
+  check(impl::supports(impl::default_mask_algorithm()));
+}
+
+TEST("unmasking and validating text in a single pass") {
+  auto key = uint32_t{0xDEADC0DE};
+  auto masked = [key](byte_buffer data) {
+    impl::mask_data(impl::mask_algorithm::scalar, key, data);
+    return data;
+  };
+  // Place a three-byte code point at the border between two blocks.
+  auto text = byte_buffer(4095, std::byte{'a'});
+  for (auto x : {0xE2, 0x82, 0xAC}) // Euro sign.
+    text.push_back(static_cast<std::byte>(x));
+  text.resize(9000, std::byte{'b'});
+  SECTION("valid text") {
+    auto data = masked(text);
+    check(impl::mask_and_validate(key, data));
+    check_eq(data, text);
+  }
+  SECTION("invalid text") {
+    auto invalid = text;
+    invalid[8000] = std::byte{0xFF};
+    auto data = masked(invalid);
+    check(!impl::mask_and_validate(key, data));
+  }
+  SECTION("incomplete text") {
+    auto incomplete = text;
+    incomplete.resize(4097);
+    auto data = masked(incomplete);
+    check(!impl::mask_and_validate(key, data));
+  }
+  SECTION("empty text") {
+    byte_buffer data;
+    check(impl::mask_and_validate(key, data));
+  }
+}
+
 TEST("decoding a frame with RSV bits fails") {
   std::vector<uint8_t> data;
   byte_buffer out = bytes({
@@ -65,6 +123,31 @@ TEST("decoding a frame with RSV bits fails") {
   check_eq(impl::decode_header(out, hdr), -1);
 }
 
+TEST("decoding a frame with negotiated RSV bits succeeds") {
+  byte_buffer out;
+  impl::assemble_frame(impl::text_frame, 0, bytes({0x01}), out,
+                       impl::fin_flag | impl::rsv1_flag);
+  check_eq(out, bytes({
+                  0xC1, // FIN + RSV1 + text frame opcode
+                  0x01, // data size = 1
+                  0x01, // payload
+                }));
+  impl::header hdr;
+  SECTION("RSV1 is rejected unless allowed") {
+    check_eq(impl::decode_header(out, hdr), -1);
+  }
+  SECTION("RSV1 is accepted if allowed") {
+    check_eq(impl::decode_header(out, hdr, impl::rsv1_flag), 2);
+    check_eq(hdr.fin, true);
+    check_eq(hdr.rsv, impl::rsv1_flag);
+    check_eq(hdr.opcode, impl::text_frame);
+  }
+  SECTION("other RSV bits are still rejected") {
+    out[0] |= std::byte{0x20};
+    check_eq(impl::decode_header(out, hdr, impl::rsv1_flag), -1);
+  }
+}
+
 TEST("decode a header with no mask key and no data") {
   std::vector<uint8_t> data;
   byte_buffer out;
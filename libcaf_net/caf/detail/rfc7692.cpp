@@ -0,0 +1,445 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/rfc7692.hpp"
+
+#include "caf/error.hpp"
+#include "caf/sec.hpp"
+#include "caf/string_algorithms.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
+
+namespace caf::detail {
+
+namespace {
+
+// -- memory management --------------------------------------------------------
+
+// Keeps track of all allocations by zlib for a single connection.
+struct memory_tracker {
+  size_t allocated = 0;
+  size_t limit = 0;
+};
+
+// Prefix for each allocation that stores the size of the allocation.
+constexpr size_t alloc_header_size = sizeof(std::max_align_t);
+
+voidpf tracked_alloc(voidpf opaque, uInt items, uInt size) {
+  auto* tracker = static_cast<memory_tracker*>(opaque);
+  auto n = static_cast<size_t>(items) * size;
+  if (tracker->limit != 0 && tracker->allocated + n > tracker->limit)
+    return Z_NULL;
+  auto* ptr = static_cast<std::byte*>(malloc(n + alloc_header_size));
+  if (ptr == nullptr)
+    return Z_NULL;
+  memcpy(ptr, &n, sizeof(size_t));
+  tracker->allocated += n;
+  return ptr + alloc_header_size;
+}
+
+void tracked_free(voidpf opaque, voidpf addr) {
+  auto* tracker = static_cast<memory_tracker*>(opaque);
+  auto* ptr = static_cast<std::byte*>(addr) - alloc_header_size;
+  size_t n;
+  memcpy(&n, ptr, sizeof(size_t));
+  tracker->allocated -= n;
+  free(ptr);
+}
+
+// Estimates the memory for a compressor based on the formula in zlib's
+// documentation (zconf.h) plus a safety margin for the internal state.
+size_t deflate_memory(int window_bits, int mem_level) {
+  return (size_t{1} << (window_bits + 2)) + (size_t{5} << (mem_level + 7))
+         + 8192;
+}
+
+// Estimates the memory for a decompressor (see above).
+size_t inflate_memory(int window_bits) {
+  return (size_t{1} << window_bits) + 8192;
+}
+
+// A sync flush in deflate produces an empty stored block that ends with these
+// four bytes. RFC 7692 removes them from the payload of each message.
+constexpr std::byte empty_block_tail[] = {std::byte{0x00}, std::byte{0x00},
+                                          std::byte{0xFF}, std::byte{0xFF}};
+
+// Converts a pointer for passing it to zlib, which expects mutable pointers
+// even for its input.
+Bytef* as_bytef(const std::byte* ptr) {
+  return reinterpret_cast<Bytef*>(const_cast<std::byte*>(ptr));
+}
+
+// -- parsing of extension offers ----------------------------------------------
+
+using param_list = std::vector<std::pair<std::string_view, std::string_view>>;
+
+// Splits an extension such as "foo; bar=1; baz" into its name and its list of
+// parameters.
+std::string_view parse_extension(std::string_view str, param_list& params) {
+  params.clear();
+  auto [name, tail] = split_by(str, ";");
+  while (!tail.empty()) {
+    auto [param, remainder] = split_by(tail, ";");
+    auto [key, value] = split_by(param, "=");
+    key = trim(key);
+    value = trim(value);
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+      value = value.substr(1, value.size() - 2);
+    params.emplace_back(key, value);
+    tail = remainder;
+  }
+  return trim(name);
+}
+
+// Parses a window size parameter. Returns 0 for invalid inputs.
+int parse_window_bits(std::string_view str) {
+  auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+  if (str.empty() || str.size() > 2
+      || !std::all_of(str.begin(), str.end(), is_digit))
+    return 0;
+  auto result = 0;
+  for (auto c : str)
+    result = result * 10 + (c - '0');
+  return result >= 8 && result <= rfc7692::max_window_bits ? result : 0;
+}
+
+// Stores the parsed parameters of a single offer or response.
+struct negotiation_params {
+  bool server_no_context_takeover = false;
+  bool client_no_context_takeover = false;
+  int server_max_window_bits = 0;
+  bool has_client_max_window_bits = false;
+  int client_max_window_bits = 0;
+
+  // Returns false if `params` contains duplicates, unknown parameters or
+  // invalid values.
+  bool assign(const param_list& params) {
+    auto seen = std::vector<std::string_view>{};
+    for (auto& [key, value] : params) {
+      if (std::find(seen.begin(), seen.end(), key) != seen.end())
+        return false;
+      seen.push_back(key);
+      if (key == "server_no_context_takeover" && value.empty()) {
+        server_no_context_takeover = true;
+      } else if (key == "client_no_context_takeover" && value.empty()) {
+        client_no_context_takeover = true;
+      } else if (key == "server_max_window_bits") {
+        server_max_window_bits = parse_window_bits(value);
+        if (server_max_window_bits == 0)
+          return false;
+      } else if (key == "client_max_window_bits") {
+        has_client_max_window_bits = true;
+        if (!value.empty()) {
+          client_max_window_bits = parse_window_bits(value);
+          if (client_max_window_bits == 0)
+            return false;
+        }
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+std::optional<rfc7692::params> accept_single_offer(const param_list& offer,
+                                                   const rfc7692::params& cfg,
+                                                   std::string& response) {
+  negotiation_params got;
+  if (!got.assign(offer))
+    return std::nullopt;
+  auto result = cfg;
+  // Our compressor must not use a larger window than the client allows.
+  if (got.server_max_window_bits != 0)
+    result.deflate_window_bits = std::min(result.deflate_window_bits,
+                                          got.server_max_window_bits);
+  if (result.deflate_window_bits < rfc7692::min_window_bits)
+    return std::nullopt;
+  // We can only limit the window of the client if it supports the parameter.
+  if (got.has_client_max_window_bits) {
+    if (got.client_max_window_bits != 0)
+      result.inflate_window_bits = std::min(result.inflate_window_bits,
+                                            got.client_max_window_bits);
+  } else if (result.inflate_window_bits < rfc7692::max_window_bits) {
+    return std::nullopt;
+  }
+  result.deflate_no_context_takeover |= got.server_no_context_takeover;
+  result.inflate_no_context_takeover |= got.client_no_context_takeover;
+  // Generate the response.
+  response = rfc7692::name;
+  if (result.deflate_no_context_takeover)
+    response += "; server_no_context_takeover";
+  if (result.inflate_no_context_takeover)
+    response += "; client_no_context_takeover";
+  if (got.server_max_window_bits != 0
+      || result.deflate_window_bits < rfc7692::max_window_bits) {
+    response += "; server_max_window_bits=";
+    response += std::to_string(result.deflate_window_bits);
+  }
+  if (result.inflate_window_bits < rfc7692::max_window_bits) {
+    response += "; client_max_window_bits=";
+    response += std::to_string(result.inflate_window_bits);
+  }
+  return result;
+}
+
+} // namespace
+
+// -- codec --------------------------------------------------------------------
+
+struct rfc7692::codec::impl {
+  explicit impl(const params& cfg) : cfg(cfg) {
+    tracker.limit = cfg.max_memory;
+  }
+
+  ~impl() {
+    if (has_deflater)
+      deflateEnd(&deflater);
+    if (has_inflater)
+      inflateEnd(&inflater);
+  }
+
+  void init(z_stream& strm) {
+    memset(&strm, 0, sizeof(z_stream));
+    strm.zalloc = tracked_alloc;
+    strm.zfree = tracked_free;
+    strm.opaque = &tracker;
+  }
+
+  bool init_deflater() {
+    if (has_deflater)
+      return true;
+    init(deflater);
+    auto rc = deflateInit2(&deflater, cfg.level, Z_DEFLATED,
+                           -cfg.deflate_window_bits, cfg.mem_level,
+                           Z_DEFAULT_STRATEGY);
+    has_deflater = rc == Z_OK;
+    return has_deflater;
+  }
+
+  bool init_inflater() {
+    if (has_inflater)
+      return true;
+    init(inflater);
+    auto rc = inflateInit2(&inflater, -cfg.inflate_window_bits);
+    has_inflater = rc == Z_OK;
+    return has_inflater;
+  }
+
+  // Feeds `input` into the decompressor. Returns false on error. Sets `done`
+  // to true if the input contained the final block of the stream.
+  bool inflate_some(const_byte_span input, byte_buffer& out, size_t offset,
+                    size_t max_size, bool& done) {
+    auto& strm = inflater;
+    strm.next_in = as_bytef(input.data());
+    strm.avail_in = static_cast<uInt>(input.size());
+    for (;;) {
+      auto used = out.size();
+      auto chunk = std::max(input.size() * 2, size_t{4096});
+      out.resize(used + chunk);
+      strm.next_out = as_bytef(out.data() + used);
+      strm.avail_out = static_cast<uInt>(chunk);
+      auto rc = inflate(&strm, Z_SYNC_FLUSH);
+      out.resize(used + chunk - strm.avail_out);
+      if (out.size() - offset > max_size)
+        return false;
+      if (rc == Z_STREAM_END) {
+        // The sender has set the BFINAL bit. Any remaining input is garbage.
+        done = true;
+        return inflateReset(&strm) == Z_OK;
+      }
+      if (rc != Z_OK && rc != Z_BUF_ERROR)
+        return false;
+      if (strm.avail_in == 0 && strm.avail_out != 0)
+        return true;
+      if (rc == Z_BUF_ERROR && strm.avail_out != 0)
+        return false;
+    }
+  }
+
+  params cfg;
+  memory_tracker tracker;
+  z_stream deflater;
+  bool has_deflater = false;
+  z_stream inflater;
+  bool has_inflater = false;
+};
+
+rfc7692::codec::codec(const params& cfg) : impl_(new impl(cfg)) {
+  // nop
+}
+
+rfc7692::codec::~codec() {
+  // nop
+}
+
+bool rfc7692::codec::compress(const_byte_span payload, byte_buffer& out) {
+  if (payload.size() > std::numeric_limits<uInt>::max()
+      || !impl_->init_deflater())
+    return false;
+  auto& strm = impl_->deflater;
+  strm.next_in = as_bytef(payload.data());
+  strm.avail_in = static_cast<uInt>(payload.size());
+  auto offset = out.size();
+  // Add some extra space for the sync flush to avoid another iteration.
+  auto chunk = deflateBound(&strm, static_cast<uLong>(payload.size())) + 16;
+  for (;;) {
+    auto used = out.size();
+    out.resize(used + chunk);
+    strm.next_out = as_bytef(out.data() + used);
+    strm.avail_out = static_cast<uInt>(chunk);
+    auto rc = deflate(&strm, Z_SYNC_FLUSH);
+    out.resize(used + chunk - strm.avail_out);
+    if (rc != Z_OK && rc != Z_BUF_ERROR)
+      return false;
+    if (strm.avail_in == 0 && strm.avail_out != 0)
+      break;
+  }
+  // Drop the tail of the empty block (see RFC 7692, Section 7.2.1).
+  auto tail_size = sizeof(empty_block_tail);
+  if (out.size() - offset >= tail_size
+      && memcmp(out.data() + out.size() - tail_size, empty_block_tail,
+                tail_size)
+           == 0)
+    out.resize(out.size() - tail_size);
+  // Zlib produces no output when flushing without new input. In this case, we
+  // send the header of an empty block (see RFC 7692, Section 7.2.3.6).
+  if (out.size() == offset)
+    out.push_back(std::byte{0x00});
+  if (impl_->cfg.deflate_no_context_takeover)
+    return deflateReset(&strm) == Z_OK;
+  return true;
+}
+
+bool rfc7692::codec::decompress(const_byte_span payload, byte_buffer& out,
+                                size_t max_size) {
+  if (payload.size() > std::numeric_limits<uInt>::max()
+      || !impl_->init_inflater())
+    return false;
+  auto offset = out.size();
+  auto done = false;
+  // Restore the tail of the empty block (see RFC 7692, Section 7.2.2).
+  if (!impl_->inflate_some(payload, out, offset, max_size, done)
+      || (!done
+          && !impl_->inflate_some(make_span(empty_block_tail), out, offset,
+                                  max_size, done)))
+    return false;
+  if (impl_->cfg.inflate_no_context_takeover && !done)
+    return inflateReset(&impl_->inflater) == Z_OK;
+  return true;
+}
+
+size_t rfc7692::codec::memory_usage() const noexcept {
+  return impl_->tracker.allocated;
+}
+
+// -- negotiation --------------------------------------------------------------
+
+std::optional<rfc7692::params>
+rfc7692::fit(const net::web_socket::deflate_options& opts) {
+  if (opts.level < 1 || opts.level > 9 || opts.max_window_bits < min_window_bits
+      || opts.max_window_bits > max_window_bits)
+    return std::nullopt;
+  params result;
+  result.level = opts.level;
+  result.deflate_no_context_takeover = !opts.context_takeover;
+  result.inflate_no_context_takeover = !opts.context_takeover;
+  result.max_memory = opts.max_memory;
+  for (auto bits = opts.max_window_bits; bits >= min_window_bits; --bits) {
+    for (auto mem_level = 8; mem_level >= 1; --mem_level) {
+      auto required = deflate_memory(bits, mem_level) + inflate_memory(bits);
+      if (opts.max_memory == 0 || required <= opts.max_memory) {
+        result.mem_level = mem_level;
+        result.deflate_window_bits = bits;
+        result.inflate_window_bits = bits;
+        return result;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::string rfc7692::make_offer(const params& cfg) {
+  std::string result{name};
+  if (cfg.deflate_no_context_takeover)
+    result += "; client_no_context_takeover";
+  if (cfg.inflate_no_context_takeover)
+    result += "; server_no_context_takeover";
+  if (cfg.inflate_window_bits < max_window_bits) {
+    result += "; server_max_window_bits=";
+    result += std::to_string(cfg.inflate_window_bits);
+  }
+  result += "; client_max_window_bits";
+  if (cfg.deflate_window_bits < max_window_bits) {
+    result += '=';
+    result += std::to_string(cfg.deflate_window_bits);
+  }
+  return result;
+}
+
+std::optional<rfc7692::params> rfc7692::accept_offer(std::string_view offers,
+                                                     const params& cfg,
+                                                     std::string& response) {
+  param_list params;
+  while (!offers.empty()) {
+    auto [offer, tail] = split_by(offers, ",");
+    offers = tail;
+    if (parse_extension(offer, params) != name)
+      continue;
+    if (auto result = accept_single_offer(params, cfg, response))
+      return result;
+  }
+  return std::nullopt;
+}
+
+expected<std::optional<rfc7692::params>>
+rfc7692::accept_response(std::string_view str, const params& cfg) {
+  param_list params;
+  std::optional<negotiation_params> got;
+  while (!str.empty()) {
+    auto [ext, tail] = split_by(str, ",");
+    str = tail;
+    if (parse_extension(ext, params) != name)
+      continue;
+    if (got)
+      return make_error(sec::protocol_error,
+                        "server accepted permessage-deflate more than once");
+    got.emplace();
+    if (!got->assign(params))
+      return make_error(sec::protocol_error,
+                        "invalid parameters for permessage-deflate");
+  }
+  if (!got)
+    return std::optional<rfc7692::params>{};
+  auto result = cfg;
+  // The server must confirm the window size we have asked for.
+  if (got->server_max_window_bits != 0) {
+    if (got->server_max_window_bits > cfg.inflate_window_bits)
+      return make_error(sec::protocol_error,
+                        "server_max_window_bits exceeds the offered value");
+    result.inflate_window_bits = got->server_max_window_bits;
+  } else if (cfg.inflate_window_bits < max_window_bits) {
+    return make_error(sec::protocol_error,
+                      "server ignored server_max_window_bits");
+  }
+  if (got->has_client_max_window_bits) {
+    if (got->client_max_window_bits < min_window_bits)
+      return make_error(sec::protocol_error,
+                        "unsupported value for client_max_window_bits");
+    result.deflate_window_bits = std::min(result.deflate_window_bits,
+                                          got->client_max_window_bits);
+  }
+  result.deflate_no_context_takeover |= got->client_no_context_takeover;
+  result.inflate_no_context_takeover = got->server_no_context_takeover;
+  return std::optional<rfc7692::params>{result};
+}
+
+} // namespace caf::detail
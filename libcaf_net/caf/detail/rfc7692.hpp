@@ -0,0 +1,123 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/net/web_socket/deflate_options.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/expected.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace caf::detail {
+
+/// Implements the WebSocket extension `permessage-deflate` as defined in
+/// RFC 7692.
+struct CAF_NET_EXPORT rfc7692 {
+  // -- member types -----------------------------------------------------------
+
+  /// Stores the outcome of the extension negotiation from the perspective of
+  /// one endpoint.
+  struct params {
+    /// The compression level for outgoing messages.
+    int level = 6;
+
+    /// The memory level for the compressor (see zlib).
+    int mem_level = 8;
+
+    /// The LZ77 window size (base-2 logarithm) for outgoing messages.
+    int deflate_window_bits = 15;
+
+    /// The LZ77 window size (base-2 logarithm) for incoming messages.
+    int inflate_window_bits = 15;
+
+    /// Resets the compression context after each outgoing message.
+    bool deflate_no_context_takeover = false;
+
+    /// Resets the decompression context after each incoming message.
+    bool inflate_no_context_takeover = false;
+
+    /// Upper bound for the memory of the compression state or 0 for no limit.
+    size_t max_memory = 0;
+  };
+
+  /// Compresses and decompresses messages with negotiated parameters.
+  class CAF_NET_EXPORT codec {
+  public:
+    explicit codec(const params& cfg);
+
+    codec(const codec&) = delete;
+
+    codec& operator=(const codec&) = delete;
+
+    ~codec();
+
+    /// Compresses the payload of a message and appends the result to `out`.
+    bool compress(const_byte_span payload, byte_buffer& out);
+
+    /// Decompresses the payload of a message and appends the result to `out`.
+    /// Fails if the result would exceed `max_size` bytes.
+    bool decompress(const_byte_span payload, byte_buffer& out,
+                    size_t max_size);
+
+    /// Returns the number of bytes currently allocated by zlib.
+    size_t memory_usage() const noexcept;
+
+  private:
+    struct impl;
+    std::unique_ptr<impl> impl_;
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  /// The name of the extension.
+  static constexpr std::string_view name = "permessage-deflate";
+
+  /// Smallest window size that zlib supports for raw deflate streams.
+  static constexpr int min_window_bits = 9;
+
+  /// Largest window size that RFC 7692 permits.
+  static constexpr int max_window_bits = 15;
+
+  // -- negotiation ------------------------------------------------------------
+
+  /// Computes the parameters that fit into the memory limit of `opts`.
+  /// @returns `std::nullopt` if the limit is too small or the options are
+  ///          invalid.
+  static std::optional<params>
+  fit(const net::web_socket::deflate_options& opts);
+
+  /// Generates the value for the `Sec-WebSocket-Extensions` field that a client
+  /// sends to the server.
+  static std::string make_offer(const params& cfg);
+
+  /// Selects the first acceptable offer from the `Sec-WebSocket-Extensions`
+  /// field of a client.
+  /// @param offers The value of the `Sec-WebSocket-Extensions` field.
+  /// @param cfg The parameters from `fit`.
+  /// @param response Receives the value for the `Sec-WebSocket-Extensions`
+  ///                 field of the response on success.
+  /// @returns the negotiated parameters for the server or `std::nullopt` if
+  ///          the client offered no acceptable configuration.
+  static std::optional<params> accept_offer(std::string_view offers,
+                                            const params& cfg,
+                                            std::string& response);
+
+  /// Checks the `Sec-WebSocket-Extensions` field of the server response for a
+  /// client that sent the offer generated by `make_offer(cfg)`.
+  /// @returns the negotiated parameters for the client, `std::nullopt` if the
+  ///          server declined the offer or an error if the server responded
+  ///          with invalid parameters.
+  static expected<std::optional<params>> accept_response(std::string_view str,
+                                                         const params& cfg);
+};
+
+} // namespace caf::detail
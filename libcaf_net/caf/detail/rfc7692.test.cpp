@@ -0,0 +1,228 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/rfc7692.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/span.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+using namespace caf;
+using namespace std::literals;
+
+using impl = detail::rfc7692;
+
+using deflate_options = net::web_socket::deflate_options;
+
+namespace {
+
+auto bytes(std::initializer_list<uint8_t> xs) {
+  byte_buffer result;
+  for (auto x : xs)
+    result.emplace_back(static_cast<std::byte>(x));
+  return result;
+}
+
+auto bytes(std::string_view str) {
+  auto first = reinterpret_cast<const std::byte*>(str.data());
+  return byte_buffer{first, first + str.size()};
+}
+
+} // namespace
+
+TEST("the codec restores compressed messages") {
+  impl::params cfg;
+  impl::codec sender{cfg};
+  impl::codec receiver{cfg};
+  auto round_trip = [&](std::string_view str) {
+    byte_buffer compressed;
+    byte_buffer decompressed;
+    if (!sender.compress(bytes(str), compressed))
+      return "<compress failed>"s;
+    if (!receiver.decompress(compressed, decompressed, 1024))
+      return "<decompress failed>"s;
+    return std::string{reinterpret_cast<const char*>(decompressed.data()),
+                       decompressed.size()};
+  };
+  SECTION("messages with payload") {
+    check_eq(round_trip("Hello"), "Hello");
+    check_eq(round_trip("Hello, World! Hello, World!"),
+             "Hello, World! Hello, World!");
+  }
+  SECTION("empty messages") {
+    check_eq(round_trip(""), "");
+    check_eq(round_trip("Hello"), "Hello");
+    check_eq(round_trip(""), "");
+  }
+  SECTION("repeated messages benefit from the context takeover") {
+    byte_buffer first;
+    byte_buffer second;
+    check(sender.compress(bytes("Hello, World!"), first));
+    check(sender.compress(bytes("Hello, World!"), second));
+    check(second.size() < first.size());
+    byte_buffer out;
+    check(receiver.decompress(first, out, 1024));
+    check(receiver.decompress(second, out, 1024));
+    check_eq(out, bytes("Hello, World!Hello, World!"));
+  }
+}
+
+TEST("the codec decodes the examples from RFC 7692") {
+  impl::params cfg;
+  impl::codec receiver{cfg};
+  SECTION("a message compressed with a single block") {
+    byte_buffer out;
+    check(receiver.decompress(bytes({0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00}),
+                              out, 1024));
+    check_eq(out, bytes("Hello"));
+  }
+  SECTION("a message that refers to a previous message") {
+    byte_buffer out;
+    check(receiver.decompress(bytes({0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00}),
+                              out, 1024));
+    check(receiver.decompress(bytes({0xf2, 0x00, 0x11, 0x00, 0x00}), out,
+                              1024));
+    check_eq(out, bytes("HelloHello"));
+  }
+  SECTION("a message that uses an uncompressed block") {
+    byte_buffer out;
+    check(receiver.decompress(bytes({0x00, 0x05, 0x00, 0xfa, 0xff, 0x48, 0x65,
+                                     0x6c, 0x6c, 0x6f, 0x00}),
+                              out, 1024));
+    check_eq(out, bytes("Hello"));
+  }
+}
+
+TEST("the codec rejects messages that exceed the maximum size") {
+  impl::params cfg;
+  impl::codec sender{cfg};
+  impl::codec receiver{cfg};
+  byte_buffer input(4096, std::byte{'x'});
+  byte_buffer compressed;
+  check(sender.compress(input, compressed));
+  byte_buffer out;
+  check(!receiver.decompress(compressed, out, 1024));
+}
+
+TEST("fit reduces the window size to stay within the memory limit") {
+  SECTION("without a limit, fit uses the maximum window size") {
+    auto res = impl::fit(deflate_options{});
+    check(res.has_value());
+    if (res) {
+      check_eq(res->deflate_window_bits, 15);
+      check_eq(res->inflate_window_bits, 15);
+      check_eq(res->mem_level, 8);
+    }
+  }
+  SECTION("a limit reduces the window size and the memory level") {
+    deflate_options opts;
+    opts.max_memory = 128 * 1024;
+    auto res = impl::fit(opts);
+    check(res.has_value());
+    if (res) {
+      check(res->deflate_window_bits < 15);
+      impl::codec uut{*res};
+      byte_buffer input(64 * 1024, std::byte{'x'});
+      byte_buffer compressed;
+      byte_buffer out;
+      check(uut.compress(input, compressed));
+      check(uut.decompress(compressed, out, input.size()));
+      check_eq(out, input);
+      check(uut.memory_usage() <= opts.max_memory);
+    }
+  }
+  SECTION("fit fails if the limit is too small") {
+    deflate_options opts;
+    opts.max_memory = 1024;
+    check(!impl::fit(opts).has_value());
+  }
+  SECTION("fit fails for invalid options") {
+    deflate_options opts;
+    opts.level = 10;
+    check(!impl::fit(opts).has_value());
+    opts.level = 6;
+    opts.max_window_bits = 8;
+    check(!impl::fit(opts).has_value());
+  }
+}
+
+TEST("servers accept offers from clients") {
+  impl::params cfg;
+  std::string response;
+  SECTION("the server accepts an offer without parameters") {
+    auto res = impl::accept_offer("permessage-deflate", cfg, response);
+    check(res.has_value());
+    if (res) {
+      check_eq(response, "permessage-deflate");
+      check_eq(res->deflate_window_bits, 15);
+      check_eq(res->inflate_window_bits, 15);
+    }
+  }
+  SECTION("the server respects the window sizes of the client") {
+    auto res = impl::accept_offer("permessage-deflate; server_max_window_bits="
+                                  "10; client_max_window_bits=12",
+                                  cfg, response);
+    check(res.has_value());
+    if (res) {
+      check_eq(res->deflate_window_bits, 10);
+      check_eq(res->inflate_window_bits, 12);
+    }
+  }
+  SECTION("the server picks the first acceptable offer") {
+    auto res = impl::accept_offer("x-webkit-deflate-frame, permessage-deflate;"
+                                  " server_max_window_bits=8,"
+                                  " permessage-deflate",
+                                  cfg, response);
+    check(res.has_value());
+    if (res)
+      check_eq(response, "permessage-deflate");
+  }
+  SECTION("the server declines offers with invalid parameters") {
+    check(!impl::accept_offer("permessage-deflate; foo", cfg, response));
+    check(!impl::accept_offer("permessage-deflate; server_max_window_bits=16",
+                              cfg, response));
+    check(!impl::accept_offer("permessage-deflate; server_no_context_takeover;"
+                              " server_no_context_takeover",
+                              cfg, response));
+  }
+  SECTION("the server ignores unknown extensions") {
+    check(!impl::accept_offer("foo, bar; baz=1", cfg, response));
+    check(!impl::accept_offer("", cfg, response));
+  }
+}
+
+TEST("clients check the response of the server") {
+  impl::params cfg;
+  check_eq(impl::make_offer(cfg), "permessage-deflate; client_max_window_bits");
+  SECTION("the server declines the offer") {
+    auto res = impl::accept_response("", cfg);
+    check(res.has_value());
+    if (res)
+      check(!res->has_value());
+  }
+  SECTION("the server accepts the offer") {
+    auto res = impl::accept_response("permessage-deflate; "
+                                     "client_max_window_bits=10",
+                                     cfg);
+    check(res.has_value() && res->has_value());
+    if (res && *res) {
+      check_eq((*res)->deflate_window_bits, 10);
+      check_eq((*res)->inflate_window_bits, 15);
+    }
+  }
+  SECTION("the server responds with invalid parameters") {
+    check(!impl::accept_response("permessage-deflate; foo", cfg));
+    check(!impl::accept_response("permessage-deflate, permessage-deflate",
+                                 cfg));
+  }
+}
+
+CAF_TEST_MAIN()
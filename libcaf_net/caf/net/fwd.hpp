@@ -31,6 +31,7 @@ class actor_shell;
 class actor_shell_ptr;
 class middleman;
 class multiplexer;
+class shared_bytes;
 class socket_manager;
 class this_host;
 
@@ -116,6 +117,8 @@ class lower_layer;
 class server;
 class upper_layer;
 
+struct deflate_options;
+
 template <class Trait, class... Ts>
 class server_factory;
 
@@ -125,6 +128,7 @@ enum class status : uint16_t;
 
 namespace caf::net::http {
 
+class chunk;
 class lower_layer;
 class request;
 class request_header;
@@ -0,0 +1,79 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/net/shared_bytes.hpp"
+
+#include "caf/byte_span.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/fwd.hpp"
+
+#include <utility>
+
+namespace caf::net::http {
+
+/// An implicitly shared type for a piece of an HTTP body.
+class CAF_NET_EXPORT chunk {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  chunk() = default;
+
+  chunk(chunk&&) = default;
+
+  chunk(const chunk&) = default;
+
+  chunk& operator=(chunk&&) = default;
+
+  chunk& operator=(const chunk&) = default;
+
+  explicit chunk(const_byte_span buf) : data_(buf) {
+    // nop
+  }
+
+  explicit chunk(shared_bytes data) noexcept : data_(std::move(data)) {
+    // nop
+  }
+
+  // -- factory functions ------------------------------------------------------
+
+  template <class... ByteBuffers>
+  static chunk from_buffers(const ByteBuffers&... buffers) {
+    return chunk{shared_bytes::from_buffers(buffers...)};
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  explicit operator bool() const noexcept {
+    return static_cast<bool>(data_);
+  }
+
+  size_t size() const noexcept {
+    return data_.size();
+  }
+
+  bool empty() const noexcept {
+    return data_.empty();
+  }
+
+  void swap(chunk& other) noexcept {
+    data_.swap(other.data_);
+  }
+
+  const_byte_span bytes() const noexcept {
+    return data_.bytes();
+  }
+
+  /// Returns the bytes of this chunk for passing them to a transport without
+  /// copying them.
+  const shared_bytes& shared() const noexcept {
+    return data_;
+  }
+
+private:
+  shared_bytes data_;
+};
+
+} // namespace caf::net::http
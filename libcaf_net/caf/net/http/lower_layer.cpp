@@ -4,8 +4,10 @@
 
 #include "caf/net/http/lower_layer.hpp"
 
+#include "caf/net/http/chunk.hpp"
 #include "caf/net/http/status.hpp"
 
+#include <charconv>
 #include <string>
 #include <string_view>
 
@@ -17,6 +19,18 @@ lower_layer::~lower_layer() {
   // nop
 }
 
+size_t lower_layer::current_request_id() const noexcept {
+  return 0;
+}
+
+void lower_layer::select_request(size_t) {
+  // nop
+}
+
+bool lower_layer::send_chunk(const chunk& item) {
+  return send_chunk(item.bytes());
+}
+
 bool lower_layer::send_response(status code) {
   begin_header(code);
   add_header_field("Content-Length"sv, "0"sv);
@@ -25,10 +39,14 @@ bool lower_layer::send_response(status code) {
 
 bool lower_layer::send_response(status code, std::string_view content_type,
                                 const_byte_span content) {
-  auto content_size = std::to_string(content.size());
+  char content_size[24];
+  auto res = std::to_chars(content_size, content_size + sizeof(content_size),
+                           content.size());
+  auto content_size_len = static_cast<size_t>(res.ptr - content_size);
   begin_header(code);
   add_header_field("Content-Type"sv, content_type);
-  add_header_field("Content-Length"sv, content_size);
+  add_header_field("Content-Length"sv,
+                   std::string_view{content_size, content_size_len});
   return end_header() && send_payload(content);
 }
 
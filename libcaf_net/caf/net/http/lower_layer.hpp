@@ -11,6 +11,7 @@
 #include "caf/error.hpp"
 #include "caf/fwd.hpp"
 
+#include <cstddef>
 #include <string_view>
 
 namespace caf::net::http {
@@ -43,9 +44,25 @@ public:
   /// send.
   virtual bool send_chunk(const_byte_span bytes) = 0;
 
+  /// Sends a chunk of data if the full payload is unknown when starting to
+  /// send. Allows implementations to pass the bytes of `item` to the
+  /// transport without copying them. The default implementation calls
+  /// `send_chunk(item.bytes())`.
+  virtual bool send_chunk(const chunk& item);
+
   /// Sends the last chunk, completing a chunked payload.
   virtual bool send_end_of_chunks() = 0;
 
+  /// Returns an ID for the request that the upper layer currently processes.
+  /// Upper layers that respond asynchronously store this ID and pass it to
+  /// `select_request` before sending the response.
+  virtual size_t current_request_id() const noexcept;
+
+  /// Selects the request for the next response. Allows the HTTP layer to send
+  /// responses in the same order as it has received the requests, even if the
+  /// upper layer completes them out of order.
+  virtual void select_request(size_t id);
+
   /// Sends a response that only consists of a header with a status code such as
   /// `status::no_content`.
   bool send_response(status code);
@@ -20,4 +20,12 @@ void request::respond(status code, std::string_view content_type,
   pimpl_->prom.set_value(response{code, std::move(fields), std::move(body)});
 }
 
+void request::respond(status code, std::string_view content_type,
+                      async::consumer_resource<chunk> content) const {
+  unordered_flat_map<std::string, std::string> fields;
+  fields.emplace("Content-Type"sv, content_type);
+  fields.emplace("Transfer-Encoding"sv, "chunked"sv);
+  pimpl_->prom.set_value(response{code, std::move(fields), std::move(content)});
+}
+
 } // namespace caf::net::http
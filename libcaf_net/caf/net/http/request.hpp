@@ -5,13 +5,16 @@
 #pragma once
 
 #include "caf/net/fwd.hpp"
+#include "caf/net/http/chunk.hpp"
 #include "caf/net/http/request_header.hpp"
 #include "caf/net/http/response.hpp"
 
 #include "caf/async/execution_context.hpp"
 #include "caf/async/promise.hpp"
+#include "caf/async/spsc_buffer.hpp"
 #include "caf/byte_span.hpp"
 #include "caf/detail/net_export.hpp"
+#include "caf/flow/fwd.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -29,6 +32,7 @@ public:
     request_header hdr;
     std::vector<std::byte> body;
     async::promise<response> prom;
+    async::consumer_resource<chunk> body_stream;
   };
 
   request() = default;
@@ -59,6 +63,32 @@ public:
     return make_span(pimpl_->body);
   }
 
+  /// Checks whether the client sends the body in pieces. In this case, `body`
+  /// returns an empty span and users read the body via `body_stream` or
+  /// `observe_body` instead.
+  /// @pre `valid()`
+  bool has_body_stream() const {
+    return static_cast<bool>(pimpl_->body_stream);
+  }
+
+  /// Returns the body as a stream of chunks if the client sends the body in
+  /// pieces or an invalid resource otherwise.
+  /// @pre `valid()`
+  async::consumer_resource<chunk> body_stream() const {
+    return pimpl_->body_stream;
+  }
+
+  /// Returns an observable on `ctx` that emits the body of the request. Emits
+  /// the entire body as a single chunk if the client did not send the body in
+  /// pieces.
+  /// @pre `valid()`
+  template <class Coordinator>
+  flow::observable<chunk> observe_body(Coordinator* ctx) const {
+    if (has_body_stream())
+      return pimpl_->body_stream.observe_on(ctx);
+    return ctx->make_observable().just(chunk{body()}).as_observable();
+  }
+
   /// Sends an HTTP response message to the client. Automatically sets the
   /// `Content-Type` and `Content-Length` header fields.
   /// @pre `valid()`
@@ -73,6 +103,14 @@ public:
     return respond(code, content_type, as_bytes(make_span(content)));
   }
 
+  /// Sends an HTTP response message with chunked transfer encoding to the
+  /// client. The server reads the next chunk from `content` only when the
+  /// socket accepts more data. Automatically sets the `Content-Type` and
+  /// `Transfer-Encoding` header fields.
+  /// @pre `valid()`
+  void respond(status code, std::string_view content_type,
+               async::consumer_resource<chunk> content) const;
+
 private:
   std::shared_ptr<impl> pimpl_;
 };
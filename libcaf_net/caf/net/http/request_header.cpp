@@ -4,6 +4,9 @@
 #include "caf/logger.hpp"
 #include "caf/string_algorithms.hpp"
 
+#include <algorithm>
+#include <cctype>
+
 namespace caf::net::http {
 
 namespace {
@@ -28,6 +31,22 @@ bool for_each_line(std::string_view input, F&& f) {
   return true;
 }
 
+// Checks whether `str` is an absolute path without query, fragment or
+// percent-encoded characters. For such paths, the URI parser simply returns
+// the input as path. Hence, we can skip the parser and the allocations for
+// constructing the URI.
+bool is_plain_path(std::string_view str) noexcept {
+  // A leading "//" introduces an authority.
+  if (str.size() > 1 && str[1] == '/')
+    return false;
+  constexpr std::string_view special_chars = "?#%[]@!$&'()*+,;=<>";
+  auto plain = [special_chars](char c) {
+    return isprint(static_cast<unsigned char>(c)) != 0
+           && special_chars.find(c) == std::string_view::npos;
+  };
+  return std::all_of(str.begin(), str.end(), plain);
+}
+
 } // namespace
 
 request_header::request_header(const request_header& other) {
@@ -48,10 +67,15 @@ void request_header::assign(const request_header& other) {
   method_ = other.method_;
   uri_ = other.uri_;
   if (other.valid()) {
-    raw_.assign(other.raw_.begin(), other.raw_.end());
+    buf_.assign(other.raw_.begin(), other.raw_.end());
+    raw_ = std::string_view{buf_.data(), buf_.size()};
     auto base = other.raw_.data();
-    auto new_base = raw_.data();
+    auto new_base = buf_.data();
     version_ = remap(base, other.version_, new_base);
+    if (uri_.empty())
+      path_ = remap(base, other.path_, new_base);
+    else
+      path_ = uri_.path();
     auto& fields = fields_.container();
     auto& other_fields = other.fields_.container();
     fields.resize(other_fields.size());
@@ -60,42 +84,58 @@ void request_header::assign(const request_header& other) {
       fields[index].second = remap(base, other_fields[index].second, new_base);
     }
   } else {
-    raw_.clear();
-    version_ = std::string_view{};
-    fields_.clear();
+    reset();
   }
 }
 
 std::pair<status, std::string_view>
 request_header::parse(std::string_view raw) {
   CAF_LOG_TRACE(CAF_ARG(raw));
-  // Sanity checking and copying of the raw input.
+  buf_.assign(raw.begin(), raw.end());
+  raw_ = std::string_view{buf_.data(), buf_.size()};
+  return parse_impl();
+}
+
+std::pair<status, std::string_view>
+request_header::parse_view(std::string_view raw) {
+  CAF_LOG_TRACE(CAF_ARG(raw));
+  buf_.clear();
+  raw_ = raw;
+  return parse_impl();
+}
+
+std::pair<status, std::string_view> request_header::parse_impl() {
+  // Sanity checking.
   using namespace literals;
-  if (raw.empty()) {
-    raw_.clear();
+  if (raw_.empty()) {
+    reset();
     return {status::bad_request, "Empty header."};
   };
-  raw_.assign(raw.begin(), raw.end());
   // Parse the first line, i.e., "METHOD REQUEST-URI VERSION".
-  auto [first_line, remainder]
-    = split_by(std::string_view{raw_.data(), raw_.size()}, eol);
+  auto [first_line, remainder] = split_by(raw_, eol);
   auto [method_str, first_line_remainder] = split_by(first_line, " ");
   auto [request_uri_str, version] = split_by(first_line_remainder, " ");
   // The path must be absolute.
   if (request_uri_str.empty() || request_uri_str.front() != '/') {
     CAF_LOG_DEBUG("Malformed Request-URI: expected an absolute path.");
-    raw_.clear();
+    reset();
     return {status::bad_request,
             "Malformed Request-URI: expected an absolute path."};
   }
-  // The path must form a valid URI when prefixing a scheme. We don't actually
-  // care about the scheme, so just use "foo" here for the validation step.
-  if (auto res = make_uri("nil:" + std::string{request_uri_str})) {
+  if (is_plain_path(request_uri_str)) {
+    // Fast path: the URI parser would only copy the path.
+    uri_ = uri{};
+    path_ = request_uri_str;
+  } else if (auto res = make_uri("nil:" + std::string{request_uri_str})) {
+    // The path must form a valid URI when prefixing a scheme. We don't
+    // actually care about the scheme, so just use "nil" here for the
+    // validation step.
     uri_ = std::move(*res);
+    path_ = uri_.path();
   } else {
     CAF_LOG_DEBUG("Failed to parse URI" << request_uri_str << "->"
                                         << res.error());
-    raw_.clear();
+    reset();
     return {status::bad_request, "Malformed Request-URI."};
   }
   // Verify and store the method.
@@ -117,7 +157,7 @@ request_header::parse(std::string_view raw) {
     method_ = method::trace;
   } else {
     CAF_LOG_DEBUG("Invalid HTTP method.");
-    raw_.clear();
+    reset();
     return {status::bad_request, "Invalid HTTP method."};
   }
   // Store the remaining header fields.
@@ -140,13 +180,19 @@ request_header::parse(std::string_view raw) {
   if (ok) {
     return {status::ok, "OK"};
   } else {
-    raw_.clear();
-    version_ = std::string_view{};
-    fields_.clear();
+    reset();
     return {status::bad_request, "Malformed header fields."};
   }
 }
 
+void request_header::reset() noexcept {
+  raw_ = std::string_view{};
+  buf_.clear();
+  path_ = std::string_view{};
+  version_ = std::string_view{};
+  fields_.clear();
+}
+
 bool request_header::chunked_transfer_encoding() const {
   return field("Transfer-Encoding").find("chunked") != std::string_view::npos;
 }
@@ -13,7 +13,10 @@
 #include "caf/string_algorithms.hpp"
 #include "caf/uri.hpp"
 
+#include <charconv>
+#include <optional>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace caf::net::http {
@@ -51,7 +54,7 @@ public:
 
   /// Returns the path part of the request URI.
   std::string_view path() const noexcept {
-    return uri_.path();
+    return path_;
   }
 
   /// Returns the query part of the request URI as a map.
@@ -117,9 +120,19 @@ public:
   template <class T>
   std::optional<T> field_as(std::string_view key) const noexcept {
     if (auto i = fields_.find(key); i != fields_.end()) {
-      caf::config_value val{std::string{i->second}};
-      if (auto res = caf::get_as<T>(val))
-        return std::move(*res);
+      if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        // Parse integers in place instead of going through a config_value.
+        auto first = i->second.data();
+        auto last = first + i->second.size();
+        T res = 0;
+        if (auto [ptr, ec] = std::from_chars(first, last, res);
+            ec == std::errc{} && ptr == last)
+          return res;
+      } else {
+        caf::config_value val{std::string{i->second}};
+        if (auto res = caf::get_as<T>(val))
+          return std::move(*res);
+      }
     }
     return {};
   }
@@ -150,16 +163,32 @@ public:
   ///          of the error, `status::ok` otherwise.
   std::pair<status, std::string_view> parse(std::string_view raw);
 
+  /// Parses a raw request header string like `parse` but without copying it.
+  /// The header refers to `raw` afterwards and remains valid only as long as
+  /// `raw` remains valid. Copying the header always creates a deep copy.
+  std::pair<status, std::string_view> parse_view(std::string_view raw);
+
 private:
-  /// Stores the raw HTTP input.
-  std::vector<char> raw_;
+  std::pair<status, std::string_view> parse_impl();
+
+  void reset() noexcept;
+
+  /// Points to the raw HTTP input, either in `buf_` or in an external buffer.
+  std::string_view raw_;
+
+  /// Stores a copy of the raw HTTP input unless parsed via `parse_view`.
+  std::vector<char> buf_;
 
   /// Stores the HTTP method that we've parsed from the raw input.
   http::method method_;
 
-  /// Stores the HTTP request URI that we've parsed from the raw input.
+  /// Stores the HTTP request URI that we've parsed from the raw input. Remains
+  /// default-constructed for plain paths without query or fragment.
   uri uri_;
 
+  /// Stores the path of the request URI.
+  std::string_view path_;
+
   /// Stores the Version of the parsed HTTP input.
   std::string_view version_;
 
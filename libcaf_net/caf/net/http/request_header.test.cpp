@@ -0,0 +1,88 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/net/http/request_header.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/test.hpp"
+
+#include <string>
+#include <string_view>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace http = caf::net::http;
+
+namespace {
+
+constexpr std::string_view request = "GET /foo/bar HTTP/1.1\r\n"
+                                     "Host: localhost:8090\r\n"
+                                     "Content-Length: 42\r\n"
+                                     "X-Number: -7\r\n"
+                                     "X-Invalid: 12abc\r\n\r\n";
+
+} // namespace
+
+TEST("parse_view refers to the input without copying it") {
+  http::request_header hdr;
+  auto [code, msg] = hdr.parse_view(request);
+  check_eq(code, http::status::ok);
+  check_eq(hdr.path(), "/foo/bar");
+  check_eq(hdr.version(), "HTTP/1.1");
+  check_eq(hdr.field("Host"), "localhost:8090");
+  check_eq(hdr.field("Host").data(), request.data() + 29);
+}
+
+TEST("copying a header creates a deep copy") {
+  std::string input{request};
+  http::request_header copy;
+  {
+    http::request_header hdr;
+    hdr.parse_view(input);
+    copy = hdr;
+  }
+  input.assign(input.size(), 'x');
+  check(copy.valid());
+  check_eq(copy.method(), http::method::get);
+  check_eq(copy.path(), "/foo/bar");
+  check_eq(copy.version(), "HTTP/1.1");
+  check_eq(copy.field("Host"), "localhost:8090");
+  check_eq(copy.content_length(), std::optional<size_t>{42});
+}
+
+TEST("the header parses URIs with query and fragment") {
+  http::request_header hdr;
+  auto [code, msg] = hdr.parse("GET /foo/bar?user=foo&pw=bar#baz HTTP/1.1\r\n"
+                               "Host: localhost:8090\r\n\r\n");
+  check_eq(code, http::status::ok);
+  check_eq(hdr.path(), "/foo/bar");
+  check_eq(hdr.query().size(), 2u);
+  check_eq(hdr.fragment(), "baz");
+  SECTION("copies retain the URI") {
+    auto copy = hdr;
+    check_eq(copy.path(), "/foo/bar");
+    check_eq(copy.query().size(), 2u);
+    check_eq(copy.fragment(), "baz");
+  }
+}
+
+TEST("the header rejects malformed request URIs") {
+  http::request_header hdr;
+  auto [code, msg] = hdr.parse("GET foo HTTP/1.1\r\n\r\n");
+  check_eq(code, http::status::bad_request);
+  check(!hdr.valid());
+}
+
+TEST("field_as converts integers without allocating a config_value") {
+  http::request_header hdr;
+  hdr.parse_view(request);
+  check_eq(hdr.field_as<size_t>("Content-Length"), std::optional<size_t>{42});
+  check_eq(hdr.field_as<int>("X-Number"), std::optional<int>{-7});
+  check_eq(hdr.field_as<size_t>("X-Number"), std::optional<size_t>{});
+  check_eq(hdr.field_as<int>("X-Invalid"), std::optional<int>{});
+  check_eq(hdr.field_as<int>("X-Missing"), std::optional<int>{});
+}
+
+CAF_TEST_MAIN()
@@ -7,6 +7,7 @@ namespace caf::net::http {
 
 responder::promise_state::~promise_state() {
   if (!completed_) {
+    down_->select_request(request_id_);
     down_->send_response(status::internal_server_error, "text/plain",
                          "Internal server error: broken responder promise.");
   }
@@ -17,6 +18,19 @@ responder::promise::promise(responder& parent)
   // nop
 }
 
+bool responder::has_body_stream() const noexcept {
+  return router_->has_body_stream();
+}
+
+async::consumer_resource<chunk> responder::body_stream() {
+  return router_->take_body_stream();
+}
+
+void responder::respond(status code, std::string_view content_type,
+                        async::consumer_resource<chunk> content) {
+  router_->respond(code, content_type, std::move(content));
+}
+
 actor_shell* responder::self() {
   return router_->self();
 }
@@ -5,9 +5,11 @@
 #pragma once
 
 #include "caf/net/fwd.hpp"
+#include "caf/net/http/chunk.hpp"
 #include "caf/net/http/lower_layer.hpp"
 #include "caf/net/http/request_header.hpp"
 
+#include "caf/async/spsc_buffer.hpp"
 #include "caf/byte_span.hpp"
 #include "caf/detail/net_export.hpp"
 
@@ -29,7 +31,8 @@ public:
   /// Implementation detail for `promise`.
   class CAF_NET_EXPORT promise_state : public ref_counted {
   public:
-    explicit promise_state(lower_layer* down) : down_(down) {
+    explicit promise_state(lower_layer* down)
+      : down_(down), request_id_(down->current_request_id()) {
       // nop
     }
 
@@ -39,8 +42,10 @@ public:
 
     ~promise_state() override;
 
-    /// Returns a pointer to the HTTP layer.
+    /// Returns a pointer to the HTTP layer after selecting the request of this
+    /// promise for the next response.
     lower_layer* down() {
+      down_->select_request(request_id_);
       return down_;
     }
 
@@ -51,6 +56,7 @@ public:
 
   private:
     lower_layer* down_;
+    size_t request_id_;
     bool completed_ = false;
   };
 
@@ -134,6 +140,16 @@ public:
     return body_;
   }
 
+  /// Checks whether the client sends the body in pieces. In this case, `body`
+  /// returns an empty span and users read the body via `body_stream` instead.
+  bool has_body_stream() const noexcept;
+
+  /// Returns the body as a stream of chunks if the client sends the body in
+  /// pieces. The server discards the body unless the route calls this
+  /// function or `to_request` while handling the request. Only the first call
+  /// returns a valid resource.
+  async::consumer_resource<chunk> body_stream();
+
   /// Returns the router that has created this responder.
   http::router* router() const noexcept {
     return router_;
@@ -177,6 +193,13 @@ public:
     down()->send_response(code, what);
   }
 
+  /// Sends an HTTP response message with chunked transfer encoding to the
+  /// client. The server reads the next chunk from `content` only when the
+  /// socket accepts more data. Automatically sets the `Content-Type` and
+  /// `Transfer-Encoding` header fields.
+  void respond(status code, std::string_view content_type,
+               async::consumer_resource<chunk> content);
+
   /// Starts writing an HTTP header.
   void begin_header(status code) {
     down()->begin_header(code);
@@ -7,7 +7,14 @@
 namespace caf::net::http {
 
 response::response(status code, fields_map fm, std::vector<std::byte> body) {
-  pimpl_ = std::make_shared<impl>(impl{code, std::move(fm), std::move(body)});
+  pimpl_ = std::make_shared<impl>(
+    impl{code, std::move(fm), std::move(body), {}});
+}
+
+response::response(status code, fields_map fm,
+                   async::consumer_resource<chunk> body) {
+  pimpl_ = std::make_shared<impl>(
+    impl{code, std::move(fm), byte_buffer{}, std::move(body)});
 }
 
 } // namespace caf::net::http
@@ -5,8 +5,10 @@
 #pragma once
 
 #include "caf/net/fwd.hpp"
+#include "caf/net/http/chunk.hpp"
 
 #include "caf/async/promise.hpp"
+#include "caf/async/spsc_buffer.hpp"
 #include "caf/byte_buffer.hpp"
 #include "caf/default_enum_inspect.hpp"
 #include "caf/detail/net_export.hpp"
@@ -29,10 +31,14 @@ public:
     status code;
     fields_map fields;
     byte_buffer body;
+    async::consumer_resource<chunk> body_stream;
   };
 
   response(status code, fields_map fields, byte_buffer body);
 
+  response(status code, fields_map fields,
+           async::consumer_resource<chunk> body);
+
   /// Returns the HTTP status code.
   status code() const {
     return pimpl_->code;
@@ -48,6 +54,12 @@ public:
     return make_span(pimpl_->body);
   }
 
+  /// Returns the HTTP body as a stream of chunks for responses with chunked
+  /// transfer encoding or an invalid resource otherwise.
+  const async::consumer_resource<chunk>& body_stream() const {
+    return pimpl_->body_stream;
+  }
+
 private:
   std::shared_ptr<impl> pimpl_;
 };
@@ -13,6 +13,19 @@ route::~route() {
   // nop
 }
 
+bool route::exec_matched(const request_header& hdr, const_byte_span body,
+                         router* parent, span<const std::string_view>) {
+  return exec(hdr, body, parent);
+}
+
+std::string_view route::path() const noexcept {
+  return {};
+}
+
+std::optional<http::method> route::request_method() const noexcept {
+  return std::nullopt;
+}
+
 void route::init() {
   // nop
 }
@@ -63,4 +76,13 @@ bool http_simple_route_base::exec(const net::http::request_header& hdr,
   return false;
 }
 
+bool http_simple_route_base::exec_matched(const net::http::request_header& hdr,
+                                          const_byte_span body,
+                                          net::http::router* parent,
+                                          span<const std::string_view>) {
+  net::http::responder rp{&hdr, body, parent};
+  do_apply(rp);
+  return true;
+}
+
 } // namespace caf::detail
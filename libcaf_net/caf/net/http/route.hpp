@@ -14,7 +14,9 @@
 #include "caf/detail/net_export.hpp"
 #include "caf/intrusive_ptr.hpp"
 #include "caf/ref_counted.hpp"
+#include "caf/span.hpp"
 
+#include <optional>
 #include <string_view>
 #include <tuple>
 
@@ -36,11 +38,54 @@ public:
   exec(const request_header& hdr, const_byte_span body, router* parent)
     = 0;
 
+  /// Processes an HTTP request after the @ref router has matched its method
+  /// and path against `request_method()` and `path()`. The default
+  /// implementation calls `exec`.
+  /// @param hdr The HTTP request header from the client.
+  /// @param body The payload from the client.
+  /// @param parent Pointer to the object that uses this route.
+  /// @param args The path segments for all `<arg>` placeholders in `path()`.
+  /// @return `true` if the route accepts the request, `false` otherwise.
+  virtual bool exec_matched(const request_header& hdr, const_byte_span body,
+                            router* parent, span<const std::string_view> args);
+
+  /// Returns the path pattern of this route, e.g., `/users/<arg>`, or an empty
+  /// string if the route does its own matching in `exec`. The @ref router uses
+  /// the pattern for dispatching requests without trying each route in turn.
+  /// The default implementation returns an empty string.
+  virtual std::string_view path() const noexcept;
+
+  /// Returns the HTTP method of this route or `std::nullopt` for "any". The
+  /// default implementation returns `std::nullopt`.
+  virtual std::optional<http::method> request_method() const noexcept;
+
   /// Called by the HTTP server when starting up. May be used to spin up workers
   /// that the path dispatches to. The default implementation does nothing.
   virtual void init();
+
+  /// Checks whether this route reads large or chunked request bodies in pieces
+  /// via `body_stream()`. The @ref router passes the body in one piece to all
+  /// other routes.
+  bool streams_body() const noexcept {
+    return streams_body_;
+  }
+
+  /// Configures whether this route reads large or chunked request bodies in
+  /// pieces via `body_stream()`.
+  void streams_body(bool value) noexcept {
+    streams_body_ = value;
+  }
+
+private:
+  bool streams_body_ = false;
 };
 
+/// Tag type for creating routes that read request bodies in pieces.
+struct stream_body_t {};
+
+/// Tag for creating routes that read request bodies in pieces.
+constexpr stream_body_t stream_body = stream_body_t{};
+
 } // namespace caf::net::http
 
 namespace caf::detail {
@@ -95,6 +140,23 @@ public:
     // nop
   }
 
+  bool exec_matched(const net::http::request_header& hdr, const_byte_span body,
+                    net::http::router* parent,
+                    span<const std::string_view> args) override {
+    if (args.size() != sizeof...(Ts))
+      return false;
+    using iseq = std::make_index_sequence<sizeof...(Ts)>;
+    return exec_dis(hdr, body, parent, iseq{}, args.data());
+  }
+
+  std::string_view path() const noexcept override {
+    return path_;
+  }
+
+  std::optional<net::http::method> request_method() const noexcept override {
+    return method_;
+  }
+
   bool exec(const net::http::request_header& hdr, const_byte_span body,
             net::http::router* parent) override {
     if (method_ && *method_ != hdr.method())
@@ -121,7 +183,7 @@ public:
   template <size_t... Is>
   bool exec_dis(const net::http::request_header& hdr, const_byte_span body,
                 net::http::router* parent, std::index_sequence<Is...>,
-                std::string_view* arr) {
+                const std::string_view* arr) {
     return exec_impl(hdr, body, parent,
                      std::get<Is>(parsers_).parse(arr[Is])...);
   }
@@ -183,6 +245,18 @@ public:
   bool exec(const net::http::request_header& hdr, const_byte_span body,
             net::http::router* parent) override;
 
+  bool exec_matched(const net::http::request_header& hdr, const_byte_span body,
+                    net::http::router* parent,
+                    span<const std::string_view> args) override;
+
+  std::string_view path() const noexcept override {
+    return path_;
+  }
+
+  std::optional<net::http::method> request_method() const noexcept override {
+    return method_;
+  }
+
 private:
   virtual void do_apply(net::http::responder&) = 0;
 
@@ -287,6 +361,23 @@ make_route(std::string path, std::optional<http::method> method, F f) {
   return detail::make_http_route_impl(path, method, f, f_args{});
 }
 
+/// Creates a @ref route object from a function object that reads the body of
+/// large or chunked requests via `responder::body_stream`.
+/// @param path Description of the path, optionally with `<arg>` placeholders.
+/// @param method The HTTP method for the path or `std::nullopt` for "any".
+/// @param f The callback for the path.
+/// @returns a @ref path on success, an error when failing to parse the path or
+///          to match it to the signature of `f`.
+template <class F>
+expected<route_ptr> make_route(std::string path,
+                               std::optional<http::method> method,
+                               stream_body_t, F f) {
+  auto result = make_route(std::move(path), method, std::move(f));
+  if (result)
+    (*result)->streams_body(true);
+  return result;
+}
+
 /// Convenience function for calling `make_route(path, std::nullopt, f)`.
 template <class F>
 expected<route_ptr> make_route(std::string path, F f) {
@@ -298,7 +389,7 @@ template <class F>
 expected<route_ptr> make_route(F f) {
   // F must have signature void (responder&).
   using f_trait = detail::get_callable_trait_t<F>;
-  static_assert(std::is_same_v<typename f_trait::f_sig, void(responder&)>);
+  static_assert(std::is_same_v<typename f_trait::fun_sig, void(responder&)>);
   using impl_t = detail::http_catch_all_route_impl<F>;
   return make_counted<impl_t>(std::move(f));
 }
@@ -8,10 +8,25 @@
 #include "caf/async/future.hpp"
 #include "caf/disposable.hpp"
 
+#include <algorithm>
+
 namespace caf::net::http {
 
 // -- constructors and destructors ---------------------------------------------
 
+router::router() : routes_(compile({})) {
+  // nop
+}
+
+router::router(std::vector<route_ptr> routes)
+  : routes_(compile(std::move(routes))) {
+  // nop
+}
+
+router::router(route_tree_ptr routes) : routes_(std::move(routes)) {
+  // nop
+}
+
 router::~router() {
   for (auto& [id, hdl] : pending_)
     hdl.dispose();
@@ -23,6 +38,14 @@ std::unique_ptr<router> router::make(std::vector<route_ptr> routes) {
   return std::make_unique<router>(std::move(routes));
 }
 
+std::unique_ptr<router> router::make(route_tree_ptr routes) {
+  return std::make_unique<router>(std::move(routes));
+}
+
+router::route_tree_ptr router::compile(std::vector<route_ptr> routes) {
+  return std::make_shared<detail::http_route_tree>(std::move(routes));
+}
+
 // -- properties ---------------------------------------------------------------
 
 actor_shell* router::self() {
@@ -39,20 +62,28 @@ request router::lift(responder&& res) {
   auto prom = async::promise<response>();
   auto fut = prom.get_future();
   auto buf = std::vector<std::byte>{res.payload().begin(), res.payload().end()};
-  auto impl = request::impl{res.header(), std::move(buf), std::move(prom)};
+  auto impl = request::impl{res.header(), std::move(buf), std::move(prom),
+                            take_body_stream()};
   auto lifted = request{std::make_shared<request::impl>(std::move(impl))};
   auto request_id = request_id_++;
+  // Restores the order of responses for pipelined requests.
+  auto http_request_id = down_->current_request_id();
   auto hdl = fut.bind_to(down_->mpx())
                .then(
-                 [this, request_id](const response& res) {
+                 [this, request_id, http_request_id](const response& res) {
+                   down_->select_request(http_request_id);
                    down_->begin_header(res.code());
                    for (auto& [key, val] : res.header_fields())
                      down_->add_header_field(key, val);
                    std::ignore = down_->end_header();
-                   down_->send_payload(res.body());
+                   if (auto body = res.body_stream())
+                     add_response_body(std::move(body));
+                   else
+                     down_->send_payload(res.body());
                    pending_.erase(request_id);
                  },
-                 [this, request_id](const error& err) {
+                 [this, request_id, http_request_id](const error& err) {
+                   down_->select_request(http_request_id);
                    auto description = to_string(err);
                    down_->send_response(status::internal_server_error,
                                         "text/plain", description);
@@ -67,20 +98,87 @@ void router::shutdown(const error& err) {
   down_->shutdown(err);
 }
 
+void router::respond(status code, std::string_view content_type,
+                     async::consumer_resource<chunk> body) {
+  down_->begin_header(code);
+  down_->add_header_field("Content-Type", content_type);
+  down_->add_header_field("Transfer-Encoding", "chunked");
+  std::ignore = down_->end_header();
+  add_response_body(std::move(body));
+}
+
+void router::add_response_body(async::consumer_resource<chunk> body) {
+  auto buf = body.try_open();
+  if (!buf) {
+    down_->send_end_of_chunks();
+    return;
+  }
+  auto do_wakeup = make_action([this] { prepare_send(); });
+  auto in = async::consumer_adapter<chunk>::make(std::move(buf), &down_->mpx(),
+                                                 std::move(do_wakeup));
+  response_bodies_.emplace(down_->current_request_id(), std::move(in));
+  prepare_send();
+}
+
 // -- http::upper_layer implementation -----------------------------------------
 
 void router::prepare_send() {
-  // nop
+  if (response_bodies_.empty())
+    return;
+  // Only the oldest response may write chunks, since the server sends all
+  // responses in the order of their requests.
+  auto selected = down_->current_request_id();
+  chunk item;
+  while (!response_bodies_.empty()) {
+    auto i = response_bodies_.begin();
+    down_->select_request(i->first);
+    if (!down_->can_send_more())
+      break;
+    auto& in = i->second;
+    auto res = in.pull(async::delay_errors, item);
+    if (res == async::read_result::ok) {
+      // Note: an empty chunk would terminate the body.
+      if (!item.empty())
+        down_->send_chunk(item);
+    } else if (res == async::read_result::stop) {
+      down_->send_end_of_chunks();
+      response_bodies_.erase(i);
+    } else if (res == async::read_result::abort) {
+      // We have already sent the header. Hence, the only way to signal the
+      // error to the client is closing the connection.
+      auto reason = in.abort_reason();
+      response_bodies_.erase(i);
+      shutdown(reason);
+      return;
+    } else {
+      break;
+    }
+  }
+  down_->select_request(selected);
 }
 
 bool router::done_sending() {
-  return true;
+  if (response_bodies_.empty())
+    return true;
+  auto selected = down_->current_request_id();
+  auto& [id, in] = *response_bodies_.begin();
+  down_->select_request(id);
+  auto result = !in.has_consumer_event() || !down_->can_send_more();
+  down_->select_request(selected);
+  return result;
 }
 
-void router::abort(const error&) {
+void router::abort(const error& reason) {
   for (auto& [id, hdl] : pending_)
     hdl.dispose();
   pending_.clear();
+  response_bodies_.clear();
+  if (body_producer_) {
+    if (reason)
+      body_producer_.abort(reason);
+    else
+      body_producer_.close();
+  }
 }
 
 error router::start(lower_layer* down) {
@@ -90,11 +188,70 @@ error router::start(lower_layer* down) {
 }
 
 ptrdiff_t router::consume(const request_header& hdr, const_byte_span payload) {
-  for (auto& ptr : routes_)
-    if (ptr->exec(hdr, payload, this))
+  routes_->match(hdr.method(), hdr.path(), candidates_, args_);
+  auto& routes = routes_->routes();
+  for (auto& match : candidates_) {
+    auto args = make_span(args_.data() + match.args_offset, match.num_args);
+    if (routes[match.index]->exec_matched(hdr, payload, this, args))
       return static_cast<ptrdiff_t>(payload.size());
+  }
   down_->send_response(http::status::not_found, "text/plain", "Not found.");
   return static_cast<ptrdiff_t>(payload.size());
 }
 
+bool router::begin_body(const request_header& hdr) {
+  // Only routes that read the body in pieces get it before it is complete.
+  // For all other routes, the server collects the body or rejects it.
+  routes_->match(hdr.method(), hdr.path(), candidates_, args_);
+  auto& routes = routes_->routes();
+  auto streams_body = [&routes](const auto& match) {
+    return routes[match.index]->streams_body();
+  };
+  if (std::none_of(candidates_.begin(), candidates_.end(), streams_body))
+    return false;
+  auto [pull, push] = async::make_spsc_buffer_resource<chunk>(body_buffer_size,
+                                                              1);
+  auto do_resume = make_action([this] { down_->request_messages(); });
+  auto do_cancel = make_action([this] {
+    // Discard the remainder of the body if the consumer lost interest.
+    body_producer_.close();
+    down_->request_messages();
+  });
+  body_producer_ = async::producer_adapter<chunk>::make(push.try_open(),
+                                                        &down_->mpx(),
+                                                        std::move(do_resume),
+                                                        std::move(do_cancel));
+  body_stream_ = std::move(pull);
+  streaming_ = true;
+  auto accepted = false;
+  for (auto& match : candidates_) {
+    if (!streams_body(match))
+      continue;
+    auto args = make_span(args_.data() + match.args_offset, match.num_args);
+    if (routes[match.index]->exec_matched(hdr, const_byte_span{}, this, args)) {
+      accepted = true;
+      break;
+    }
+  }
+  streaming_ = false;
+  // Discard the body if the route has not taken it.
+  if (body_stream_) {
+    body_stream_ = nullptr;
+    body_producer_.close();
+  }
+  return accepted;
+}
+
+ptrdiff_t router::consume_body(const_byte_span bytes) {
+  if (body_producer_ && !bytes.empty()) {
+    if (body_producer_.push(chunk{bytes}) == 0)
+      down_->suspend_reading();
+  }
+  return static_cast<ptrdiff_t>(bytes.size());
+}
+
+void router::end_body() {
+  body_producer_.close();
+}
+
 } // namespace caf::net::http
@@ -6,11 +6,16 @@
 
 #include "caf/net/actor_shell.hpp"
 #include "caf/net/http/arg_parser.hpp"
+#include "caf/net/http/chunk.hpp"
 #include "caf/net/http/lower_layer.hpp"
 #include "caf/net/http/responder.hpp"
 #include "caf/net/http/route.hpp"
 #include "caf/net/http/upper_layer.hpp"
 
+#include "caf/async/consumer_adapter.hpp"
+#include "caf/async/producer_adapter.hpp"
+#include "caf/async/spsc_buffer.hpp"
+#include "caf/detail/http_route_tree.hpp"
 #include "caf/detail/print.hpp"
 #include "caf/detail/type_list.hpp"
 #include "caf/detail/type_traits.hpp"
@@ -20,6 +25,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <map>
+#include <memory>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
@@ -30,13 +37,25 @@ namespace caf::net::http {
 /// user-defined handlers.
 class CAF_NET_EXPORT router : public upper_layer {
 public:
+  // -- member types -----------------------------------------------------------
+
+  using route_tree_ptr = std::shared_ptr<const detail::http_route_tree>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum number of chunks that the router buffers for a streamed request
+  /// body before it stops reading from the socket.
+  static constexpr size_t body_buffer_size = 8;
+
   // -- constructors and destructors -------------------------------------------
 
-  router() = default;
+  router();
 
-  explicit router(std::vector<route_ptr> routes) : routes_(std::move(routes)) {
-    // nop
-  }
+  explicit router(std::vector<route_ptr> routes);
+
+  /// Creates a router from precompiled routes. Allows multiple routers to share
+  /// the same routes without compiling them again.
+  explicit router(route_tree_ptr routes);
 
   ~router() override;
 
@@ -44,6 +63,11 @@ public:
 
   static std::unique_ptr<router> make(std::vector<route_ptr> routes);
 
+  static std::unique_ptr<router> make(route_tree_ptr routes);
+
+  /// Compiles `routes` for passing them to multiple routers.
+  static route_tree_ptr compile(std::vector<route_ptr> routes);
+
   // -- properties -------------------------------------------------------------
 
   /// Returns a pointer to the underlying HTTP layer.
@@ -63,6 +87,25 @@ public:
 
   void shutdown(const error& err);
 
+  /// Checks whether the client sends the body of the current request in
+  /// pieces.
+  bool has_body_stream() const noexcept {
+    return streaming_;
+  }
+
+  /// Transfers the body of the current request to the caller. Returns an
+  /// invalid resource if the request has no streamed body or if the body was
+  /// already taken.
+  async::consumer_resource<chunk> take_body_stream() {
+    return std::exchange(body_stream_, async::consumer_resource<chunk>{});
+  }
+
+  /// Sends a response with chunked transfer encoding for the current request.
+  /// The router reads the next chunk from `body` only when the socket accepts
+  /// more data.
+  void respond(status code, std::string_view content_type,
+               async::consumer_resource<chunk> body);
+
   // -- http::upper_layer implementation ---------------------------------------
 
   error start(lower_layer* down) override;
@@ -70,6 +113,12 @@ public:
   ptrdiff_t consume(const request_header& hdr,
                     const_byte_span payload) override;
 
+  bool begin_body(const request_header& hdr) override;
+
+  ptrdiff_t consume_body(const_byte_span bytes) override;
+
+  void end_body() override;
+
   void prepare_send() override;
 
   bool done_sending() override;
@@ -77,11 +126,21 @@ public:
   void abort(const error& reason) override;
 
 private:
+  /// Writes the chunks from `body` for the current request after the caller
+  /// has sent a header with chunked transfer encoding.
+  void add_response_body(async::consumer_resource<chunk> body);
+
   /// Handle to the underlying HTTP layer.
   lower_layer* down_ = nullptr;
 
-  /// List of user-defined routes.
-  std::vector<route_ptr> routes_;
+  /// User-defined routes, indexed by their path.
+  route_tree_ptr routes_;
+
+  /// Stores the matching routes for the current request.
+  std::vector<detail::http_route_tree::candidate> candidates_;
+
+  /// Stores the path arguments for the matching routes.
+  std::vector<std::string_view> args_;
 
   /// Generates ascending IDs for `pending_`.
   size_t request_id_ = 0;
@@ -91,6 +150,19 @@ private:
 
   /// Lazily initialized for allowing a @ref route to interact with actors.
   actor_shell_ptr shell_;
+
+  /// Stores whether the router currently dispatches a request with a streamed
+  /// body.
+  bool streaming_ = false;
+
+  /// Stores the body of the current request until a route takes it.
+  async::consumer_resource<chunk> body_stream_;
+
+  /// Forwards the streamed body of the current request to its consumer.
+  async::producer_adapter<chunk> body_producer_;
+
+  /// Reads the streamed bodies of responses, ordered by the ID of the request.
+  std::map<size_t, async::consumer_adapter<chunk>> response_bodies_;
 };
 
 } // namespace caf::net::http
@@ -1,9 +1,58 @@
 #include "caf/net/http/server.hpp"
 
+#include "caf/net/http/chunk.hpp"
 #include "caf/net/octet_stream/lower_layer.hpp"
 
+#include "caf/string_algorithms.hpp"
+
+#include <charconv>
+#include <optional>
+#include <utility>
+
 namespace caf::net::http {
 
+namespace {
+
+/// Splits `input` at the first CRLF. Returns an empty remainder and sets
+/// `found` to `false` if `input` contains no CRLF.
+std::pair<std::string_view, byte_span> split_line(byte_span input,
+                                                  bool& found) {
+  std::string_view str{reinterpret_cast<const char*>(input.data()),
+                       input.size()};
+  if (auto pos = str.find("\r\n"); pos != std::string_view::npos) {
+    found = true;
+    return {str.substr(0, pos), input.subspan(pos + 2)};
+  }
+  found = false;
+  return {std::string_view{}, byte_span{}};
+}
+
+/// Parses the size of a chunk while ignoring any chunk extension.
+std::optional<size_t> parse_chunk_size(std::string_view line) {
+  line = line.substr(0, line.find(';'));
+  while (!line.empty() && (line.back() == ' ' || line.back() == '\t'))
+    line.remove_suffix(1);
+  size_t result = 0;
+  auto first = line.data();
+  auto last = line.data() + line.size();
+  auto [ptr, ec] = std::from_chars(first, last, result, 16);
+  if (first == last || ec != std::errc{} || ptr != last)
+    return std::nullopt;
+  return result;
+}
+
+/// Writes the size line of a chunk to `buf`.
+void write_chunk_size(size_t size, byte_buffer& buf) {
+  char size_str[24];
+  auto res = std::to_chars(size_str, size_str + sizeof(size_str), size, 16);
+  for (auto i = size_str; i != res.ptr; ++i)
+    buf.emplace_back(static_cast<std::byte>(*i));
+  buf.emplace_back(std::byte{'\r'});
+  buf.emplace_back(std::byte{'\n'});
+}
+
+} // namespace
+
 // -- factories ----------------------------------------------------------------
 
 std::unique_ptr<server> server::make(upper_layer_ptr up) {
@@ -17,6 +66,11 @@ multiplexer& server::mpx() noexcept {
 }
 
 bool server::can_send_more() const noexcept {
+  // Responses that wait for previous responses may not grow indefinitely.
+  if (writer_id_ > head_request_id_) {
+    auto i = parked_.find(writer_id_);
+    return i == parked_.end() || i->second.buf.size() < max_request_size_;
+  }
   return down_->can_send_more();
 }
 
@@ -42,46 +96,68 @@ void server::suspend_reading() {
 }
 
 void server::begin_header(status code) {
-  down_->begin_output();
-  v1::begin_header(code, down_->output_buffer());
+  expects_payload_ = true;
+  v1::begin_header(code, begin_output());
 }
 
 void server::add_header_field(std::string_view key, std::string_view val) {
-  v1::add_header_field(key, val, down_->output_buffer());
+  if (icase_equal(key, "Content-Length"))
+    expects_payload_ = val != "0";
+  v1::add_header_field(key, val, begin_output());
 }
 
 bool server::end_header() {
-  return v1::end_header(down_->output_buffer()) && down_->end_output();
+  auto ok = v1::end_header(begin_output()) && end_output();
+  if (!expects_payload_)
+    complete_response();
+  return ok;
 }
 
 bool server::send_payload(const_byte_span bytes) {
-  down_->begin_output();
-  auto& buf = down_->output_buffer();
+  auto& buf = begin_output();
   buf.insert(buf.end(), bytes.begin(), bytes.end());
-  down_->end_output();
+  end_output();
+  complete_response();
   return true;
 }
 
 bool server::send_chunk(const_byte_span bytes) {
-  down_->begin_output();
-  auto& buf = down_->output_buffer();
-  auto size = bytes.size();
-  detail::append_hex(buf, &size, sizeof(size));
+  auto& buf = begin_output();
+  write_chunk_size(bytes.size(), buf);
+  buf.insert(buf.end(), bytes.begin(), bytes.end());
   buf.emplace_back(std::byte{'\r'});
   buf.emplace_back(std::byte{'\n'});
-  buf.insert(buf.end(), bytes.begin(), bytes.end());
+  return end_output();
+}
+
+bool server::send_chunk(const chunk& item) {
+  // Parked responses must copy the bytes anyway.
+  if (writer_id_ > head_request_id_)
+    return send_chunk(item.bytes());
+  write_chunk_size(item.size(), begin_output());
+  down_->append_output(item.shared());
+  auto& buf = down_->output_buffer();
   buf.emplace_back(std::byte{'\r'});
   buf.emplace_back(std::byte{'\n'});
-  return down_->end_output();
+  return end_output();
 }
 
 bool server::send_end_of_chunks() {
   std::string_view str = "0\r\n\r\n";
   auto bytes = as_bytes(make_span(str));
-  down_->begin_output();
-  auto& buf = down_->output_buffer();
+  auto& buf = begin_output();
   buf.insert(buf.end(), bytes.begin(), bytes.end());
-  return down_->end_output();
+  auto ok = end_output();
+  complete_response();
+  return ok;
+}
+
+size_t server::current_request_id() const noexcept {
+  return writer_id_;
+}
+
+void server::select_request(size_t id) {
+  writer_id_ = id;
 }
 
 void server::switch_protocol(std::unique_ptr<octet_stream::upper_layer> next) {
@@ -134,19 +210,34 @@ ptrdiff_t server::consume(byte_span input, byte_span) {
           input = remainder;
           // Transition to the next mode.
           if (hdr_.chunked_transfer_encoding()) {
+            streaming_ = begin_body();
+            // We need a copy of the header if we collect the body ourselves.
+            if (!streaming_)
+              hdr_ = request_header{hdr_};
             mode_ = mode::read_chunks;
           } else if (auto len = hdr_.content_length()) {
-            // Protect against payloads that exceed the maximum size.
+            // Payloads that exceed the maximum size must go to an upper layer
+            // that consumes them in pieces.
             if (*len >= max_request_size_) {
-              up_->abort(make_error(sec::protocol_error,
-                                    "payload exceeds maximum size"));
-              write_response(status::payload_too_large,
-                             "Payload exceeds maximum size.");
-              return -1;
+              if (!begin_body()) {
+                up_->abort(make_error(sec::protocol_error,
+                                      "payload exceeds maximum size"));
+                write_response(status::payload_too_large,
+                               "Payload exceeds maximum size.");
+                return -1;
+              }
+              streaming_ = true;
+              payload_len_ = *len;
+              mode_ = mode::stream_payload;
+              break;
             }
             // Transition to read_payload mode and continue.
             payload_len_ = *len;
             mode_ = mode::read_payload;
+            // The header refers to the input buffer. Hence, we need a copy if
+            // the payload arrives in a later call.
+            if (input.size() < payload_len_)
+              hdr_ = request_header{hdr_};
           } else {
             // TODO: we may *still* have a payload since HTTP can omit the
             //       Content-Length field and simply close the connection
@@ -169,11 +260,97 @@ ptrdiff_t server::consume(byte_span input, byte_span) {
         }
         break;
       }
+      case mode::stream_payload: {
+        if (input.empty())
+          return consumed;
+        auto n = std::min(input.size(), payload_len_);
+        if (!handle_body(input.subspan(0, n)))
+          return -1;
+        consumed += static_cast<ptrdiff_t>(n);
+        input = input.subspan(n);
+        payload_len_ -= n;
+        if (payload_len_ == 0 && !end_body())
+          return -1;
+        // Stop if the upper layer applies backpressure.
+        if (!down_->is_reading())
+          return consumed;
+        break;
+      }
       case mode::read_chunks: {
-        // TODO: implement me
-        write_response(status::not_implemented,
-                       "Chunked transfer not implemented yet.");
-        return -1;
+        bool found = false;
+        auto [line, remainder] = split_line(input, found);
+        if (!found) {
+          if (input.size() >= max_request_size_) {
+            up_->abort(make_error(sec::protocol_error, "malformed chunk"));
+            write_response(status::bad_request, "Malformed chunk.");
+            return -1;
+          }
+          return consumed;
+        }
+        auto size = parse_chunk_size(line);
+        if (!size) {
+          up_->abort(make_error(sec::protocol_error, "malformed chunk"));
+          write_response(status::bad_request, "Malformed chunk.");
+          return -1;
+        }
+        consumed += static_cast<ptrdiff_t>(line.size() + 2);
+        input = remainder;
+        if (*size == 0) {
+          mode_ = mode::read_trailer;
+        } else {
+          payload_len_ = *size;
+          mode_ = mode::read_chunk_data;
+        }
+        break;
+      }
+      case mode::read_chunk_data: {
+        if (input.empty())
+          return consumed;
+        auto n = std::min(input.size(), payload_len_);
+        if (!handle_body(input.subspan(0, n)))
+          return -1;
+        consumed += static_cast<ptrdiff_t>(n);
+        input = input.subspan(n);
+        payload_len_ -= n;
+        if (payload_len_ == 0)
+          mode_ = mode::read_chunk_end;
+        // Stop if the upper layer applies backpressure.
+        if (!down_->is_reading())
+          return consumed;
+        break;
+      }
+      case mode::read_chunk_end: {
+        if (input.size() < 2)
+          return consumed;
+        if (input[0] != std::byte{'\r'} || input[1] != std::byte{'\n'}) {
+          up_->abort(make_error(sec::protocol_error, "malformed chunk"));
+          write_response(status::bad_request, "Malformed chunk.");
+          return -1;
+        }
+        consumed += 2;
+        input = input.subspan(2);
+        mode_ = mode::read_chunks;
+        break;
+      }
+      case mode::read_trailer: {
+        // We ignore all trailer fields and wait for the empty line.
+        bool found = false;
+        auto [line, remainder] = split_line(input, found);
+        if (!found) {
+          if (input.size() >= max_request_size_) {
+            up_->abort(
+              make_error(sec::protocol_error, "trailer exceeds maximum size"));
+            write_response(status::request_header_fields_too_large,
+                           "Trailer exceeds maximum size.");
+            return -1;
+          }
+          return consumed;
+        }
+        consumed += static_cast<ptrdiff_t>(line.size() + 2);
+        input = remainder;
+        if (line.empty() && !end_body())
+          return -1;
+        break;
       }
     }
   }
@@ -181,6 +358,46 @@ ptrdiff_t server::consume(byte_span input, byte_span) {
 
 // -- utility functions ------------------------------------------------------
 
+byte_buffer& server::begin_output() {
+  // Late writes to already completed responses (e.g., an empty payload after
+  // a header with "Content-Length: 0") go to the transport as well.
+  if (writer_id_ <= head_request_id_) {
+    down_->begin_output();
+    return down_->output_buffer();
+  }
+  return parked_[writer_id_].buf;
+}
+
+bool server::end_output() {
+  if (writer_id_ <= head_request_id_)
+    return down_->end_output();
+  return true;
+}
+
+void server::complete_response() {
+  if (writer_id_ < head_request_id_)
+    return;
+  if (writer_id_ > head_request_id_) {
+    parked_[writer_id_].done = true;
+    return;
+  }
+  // Flush all parked responses that are next in line.
+  ++head_request_id_;
+  while (!parked_.empty() && parked_.begin()->first == head_request_id_) {
+    auto i = parked_.begin();
+    auto& [buf, done] = i->second;
+    down_->begin_output();
+    down_->append_output(std::move(buf));
+    down_->end_output();
+    // An incomplete response continues writing to the transport directly.
+    auto was_done = done;
+    parked_.erase(i);
+    if (!was_done)
+      break;
+    ++head_request_id_;
+  }
+}
+
 void server::write_response(status code, std::string_view content) {
   down_->begin_output();
   v1::write_response(code, "text/plain", content, down_->output_buffer());
@@ -188,12 +405,49 @@ void server::write_response(status code, std::string_view content) {
 }
 
 bool server::invoke_upper_layer(const_byte_span payload) {
+  writer_id_ = next_request_id_++;
   return up_->consume(hdr_, payload) >= 0;
 }
 
+bool server::begin_body() {
+  // Only claim the ID if the upper layer accepts the body. Otherwise, we call
+  // invoke_upper_layer later with the same ID.
+  writer_id_ = next_request_id_;
+  if (!up_->begin_body(hdr_))
+    return false;
+  ++next_request_id_;
+  return true;
+}
+
+bool server::handle_body(const_byte_span bytes) {
+  if (streaming_)
+    return up_->consume_body(bytes) >= 0;
+  if (body_buf_.size() + bytes.size() >= max_request_size_) {
+    up_->abort(make_error(sec::protocol_error, "payload exceeds maximum size"));
+    write_response(status::payload_too_large, "Payload exceeds maximum size.");
+    return false;
+  }
+  body_buf_.insert(body_buf_.end(), bytes.begin(), bytes.end());
+  return true;
+}
+
+bool server::end_body() {
+  mode_ = mode::read_header;
+  if (streaming_) {
+    streaming_ = false;
+    up_->end_body();
+    return true;
+  }
+  auto ok = invoke_upper_layer(body_buf_);
+  body_buf_.clear();
+  return ok;
+}
+
 bool server::handle_header(std::string_view http) {
-  // Parse the header and reject invalid inputs.
-  auto [code, msg] = hdr_.parse(http);
+  // Parse the header and reject invalid inputs. The header may point into the
+  // input buffer, since the upper layer either processes the request right
+  // away or copies the header.
+  auto [code, msg] = hdr_.parse_view(http);
   if (code != status::ok) {
     CAF_LOG_DEBUG("received malformed header");
     up_->abort(make_error(sec::protocol_error, "received malformed header"));
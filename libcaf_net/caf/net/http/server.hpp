@@ -26,6 +26,7 @@
 #include "caf/unordered_flat_map.hpp"
 
 #include <algorithm>
+#include <map>
 
 namespace caf::net::http {
 
@@ -38,7 +39,11 @@ public:
   enum class mode {
     read_header,
     read_payload,
+    stream_payload,
     read_chunks,
+    read_chunk_data,
+    read_chunk_end,
+    read_trailer,
   };
 
   using upper_layer_ptr = std::unique_ptr<http::upper_layer>;
@@ -102,8 +107,14 @@ public:
 
   bool send_chunk(const_byte_span bytes) override;
 
+  bool send_chunk(const chunk& item) override;
+
   bool send_end_of_chunks() override;
 
+  size_t current_request_id() const noexcept override;
+
+  void select_request(size_t id) override;
+
   void switch_protocol(std::unique_ptr<octet_stream::upper_layer>) override;
 
   // -- octet_stream::upper_layer implementation -------------------------------
@@ -119,12 +130,40 @@ public:
   ptrdiff_t consume(byte_span input, byte_span) override;
 
 private:
+  // -- member types -----------------------------------------------------------
+
+  /// Stores a response that waits for the responses to previous requests.
+  struct parked_response {
+    byte_buffer buf;
+    bool done = false;
+  };
+
   // -- utility functions ------------------------------------------------------
 
+  /// Returns the buffer for the response of the selected request.
+  byte_buffer& begin_output();
+
+  /// Flushes the output if the selected request may write to the transport.
+  bool end_output();
+
+  /// Marks the response to the selected request as complete.
+  void complete_response();
+
   void write_response(status code, std::string_view content);
 
   bool invoke_upper_layer(const_byte_span payload);
 
+  /// Asks the upper layer whether it consumes the body of the current request
+  /// in pieces.
+  bool begin_body();
+
+  /// Passes a piece of the body to the upper layer or appends it to
+  /// `body_buf_`.
+  bool handle_body(const_byte_span bytes);
+
+  /// Completes a request after receiving its body.
+  bool end_body();
+
   bool handle_header(std::string_view http);
 
   octet_stream::lower_layer* down_;
@@ -137,11 +176,37 @@ private:
   /// Stores whether we are currently waiting for the payload.
   mode mode_ = mode::read_header;
 
-  /// Stores the expected payload size when in read_payload mode.
+  /// Stores the expected payload size when in read_payload or stream_payload
+  /// mode and the remaining size of the current chunk in read_chunk_data mode.
   size_t payload_len_ = 0;
 
+  /// Stores whether the upper layer consumes the body of the current request
+  /// in pieces.
+  bool streaming_ = false;
+
+  /// Collects the body of a chunked request if the upper layer does not
+  /// consume it in pieces.
+  byte_buffer body_buf_;
+
   /// Maximum size for incoming HTTP requests.
   size_t max_request_size_ = default_max_request_size;
+
+  /// ID for the next incoming request.
+  size_t next_request_id_ = 0;
+
+  /// ID of the oldest request without a complete response. Only the response
+  /// to this request may go to the transport directly.
+  size_t head_request_id_ = 0;
+
+  /// ID of the request that we currently write a response for.
+  size_t writer_id_ = 0;
+
+  /// Stores whether the header of the current response announces a payload.
+  bool expects_payload_ = false;
+
+  /// Buffers responses to pipelined requests that completed before the
+  /// response to `head_request_id_`.
+  std::map<size_t, parked_response> parked_;
 };
 
 } // namespace caf::net::http
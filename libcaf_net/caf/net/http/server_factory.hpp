@@ -74,7 +74,7 @@ public:
 
   http_conn_factory(std::vector<net::http::route_ptr> routes,
                     size_t max_consecutive_reads)
-    : routes_(std::move(routes)),
+    : routes_(net::http::router::compile(std::move(routes))),
       max_consecutive_reads_(max_consecutive_reads) {
     // nop
   }
@@ -92,7 +92,9 @@ public:
   }
 
 private:
-  std::vector<net::http::route_ptr> routes_;
+  /// Compiled once and then shared by the routers of all connections.
+  net::http::router::route_tree_ptr routes_;
+
   size_t max_consecutive_reads_;
   action monitor_;
 };
@@ -164,6 +166,28 @@ public:
     return *this;
   }
 
+  /// Adds a new route to the HTTP server that reads the body of large or
+  /// chunked requests in pieces via `responder::body_stream`.
+  /// @param path The path on this server for the new route.
+  /// @param method The allowed HTTP method on the new route.
+  /// @param f The function object for handling requests on the new route.
+  /// @return a reference to `*this`.
+  template <class F>
+  server_factory& route(std::string path, http::method method,
+                        http::stream_body_t, F f) {
+    auto& cfg = super::config();
+    if (cfg.failed())
+      return *this;
+    auto new_route = make_route(std::move(path), method, http::stream_body,
+                                std::move(f));
+    if (!new_route) {
+      cfg.fail(std::move(new_route.error()));
+    } else {
+      cfg.routes.push_back(std::move(*new_route));
+    }
+    return *this;
+  }
+
   /// Starts a server that makes HTTP requests without a fixed route available
   /// to an observer.
   template <class OnStart>
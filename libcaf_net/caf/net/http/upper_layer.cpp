@@ -12,4 +12,16 @@ upper_layer::~upper_layer() {
   // nop
 }
 
+bool upper_layer::begin_body(const request_header&) {
+  return false;
+}
+
+ptrdiff_t upper_layer::consume_body(const_byte_span) {
+  return -1;
+}
+
+void upper_layer::end_body() {
+  // nop
+}
+
 } // namespace caf::net::http
@@ -30,6 +30,28 @@ public:
   /// @note Discarded data is lost permanently.
   virtual ptrdiff_t consume(const request_header& hdr, const_byte_span payload)
     = 0;
+
+  /// Starts consuming an HTTP message with a body that the server passes to
+  /// the upper layer in pieces. The server calls this function instead of
+  /// `consume` for requests with chunked transfer encoding or with a body that
+  /// exceeds the maximum request size.
+  /// @param hdr The header fields for the received message.
+  /// @returns `true` if the upper layer accepts the body in pieces, `false`
+  ///          otherwise. On `false`, the server collects the body of chunked
+  ///          requests up to the maximum request size and then calls `consume`
+  ///          or rejects the request if the body is too large.
+  /// @note The default implementation returns `false`.
+  virtual bool begin_body(const request_header& hdr);
+
+  /// Consumes the next piece of the body after a call to `begin_body`.
+  /// @returns The number of consumed bytes or a negative value to signal an
+  ///          error.
+  /// @note The upper layer may call `suspend_reading` on the lower layer to
+  ///       stop receiving more data until calling `request_messages`.
+  virtual ptrdiff_t consume_body(const_byte_span bytes);
+
+  /// Signals that the server has received the complete body.
+  virtual void end_body();
 };
 
 } // namespace caf::net::http
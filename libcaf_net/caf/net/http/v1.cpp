@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
 #include <cstddef>
+#include <string>
 #include <string_view>
 
 using namespace std::literals;
@@ -15,11 +17,6 @@ struct writer {
   byte_buffer* buf;
 };
 
-writer& operator<<(writer& out, char x) {
-  out.buf->push_back(static_cast<std::byte>(x));
-  return out;
-}
-
 writer& operator<<(writer& out, std::string_view str) {
   auto bytes = as_bytes(make_span(str));
   out.buf->insert(out.buf->end(), bytes.begin(), bytes.end());
@@ -30,6 +27,42 @@ writer& operator<<(writer& out, const std::string& str) {
   return out << std::string_view{str};
 }
 
+writer& operator<<(writer& out, size_t x) {
+  char buf[24];
+  auto res = std::to_chars(buf, buf + sizeof(buf), x);
+  return out << std::string_view{buf, static_cast<size_t>(res.ptr - buf)};
+}
+
+constexpr size_t min_status_code = 100;
+
+constexpr size_t max_status_code = 599;
+
+std::string make_status_line(status code) {
+  std::string result = "HTTP/1.1 ";
+  result += std::to_string(static_cast<int>(code));
+  result += ' ';
+  result += phrase(code);
+  result += "\r\n";
+  return result;
+}
+
+// Writes "HTTP/1.1 <code> <phrase>\r\n" to `out`. Uses precomputed lines for
+// all valid status codes.
+void write_status_line(writer& out, status code) {
+  using table_type = std::array<std::string, max_status_code + 1>;
+  static const auto tbl = [] {
+    table_type result;
+    for (auto index = min_status_code; index <= max_status_code; ++index)
+      result[index] = make_status_line(static_cast<status>(index));
+    return result;
+  }();
+  if (auto index = static_cast<size_t>(code);
+      index >= min_status_code && index <= max_status_code)
+    out << tbl[index];
+  else
+    out << make_status_line(code);
+}
+
 } // namespace
 
 std::pair<std::string_view, byte_span> split_header(byte_span bytes) {
@@ -55,8 +88,7 @@ std::pair<std::string_view, byte_span> split_header(byte_span bytes) {
 void write_header(status code, span<const string_view_pair> fields,
                   byte_buffer& buf) {
   writer out{&buf};
-  out << "HTTP/1.1 "sv << std::to_string(static_cast<int>(code)) << ' '
-      << phrase(code) << "\r\n"sv;
+  write_status_line(out, code);
   for (auto& [key, val] : fields)
     out << key << ": "sv << val << "\r\n"sv;
   out << "\r\n"sv;
@@ -64,8 +96,7 @@ void write_header(status code, span<const string_view_pair> fields,
 
 void begin_header(status code, byte_buffer& buf) {
   writer out{&buf};
-  out << "HTTP/1.1 "sv << std::to_string(static_cast<int>(code)) << ' '
-      << phrase(code) << "\r\n"sv;
+  write_status_line(out, code);
 }
 
 void add_header_field(std::string_view key, std::string_view val,
@@ -83,18 +114,15 @@ bool end_header(byte_buffer& buf) {
 void write_response(status code, std::string_view content_type,
                     std::string_view content, byte_buffer& buf) {
   write_response(code, content_type, content, {}, buf);
-  writer out{&buf};
-  out << content;
 }
 
 void write_response(status code, std::string_view content_type,
                     std::string_view content,
                     span<const string_view_pair> fields, byte_buffer& buf) {
   writer out{&buf};
-  out << "HTTP/1.1 "sv << std::to_string(static_cast<int>(code)) << ' '
-      << phrase(code) << "\r\n"sv;
+  write_status_line(out, code);
   out << "Content-Type: "sv << content_type << "\r\n"sv;
-  out << "Content-Length: "sv << std::to_string(content.size()) << "\r\n"sv;
+  out << "Content-Length: "sv << content.size() << "\r\n"sv;
   for (auto& [key, val] : fields)
     out << key << ": "sv << val << "\r\n"sv;
   out << "\r\n"sv;
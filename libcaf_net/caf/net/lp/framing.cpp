@@ -8,6 +8,8 @@
 #include "caf/logger.hpp"
 #include "caf/sec.hpp"
 
+#include <algorithm>
+
 namespace caf::net::lp {
 
 // -- factories ----------------------------------------------------------------
@@ -29,15 +31,17 @@ void framing::abort(const error& reason) {
 
 ptrdiff_t framing::consume(byte_span input, byte_span) {
   CAF_LOG_TRACE("got" << input.size() << "bytes\n");
-  if (input.size() < sizeof(uint32_t)) {
+  if (input.size() < hdr_size) {
     CAF_LOG_ERROR("received too few bytes from underlying transport");
     up_->abort(make_error(sec::logic_error,
                           "received too few bytes from underlying transport"));
     return -1;
-  } else if (input.size() == hdr_size) {
-    auto u32_size = uint32_t{0};
-    memcpy(&u32_size, input.data(), sizeof(uint32_t));
-    auto msg_size = static_cast<size_t>(detail::from_network_order(u32_size));
+  }
+  // Slice out all complete frames and carry over any partial frame.
+  size_t consumed = 0;
+  size_t required = hdr_size;
+  while (input.size() - consumed >= hdr_size) {
+    auto [msg_size, msg] = split(input.subspan(consumed));
     if (msg_size == 0) {
       // Ignore empty messages.
       CAF_LOG_ERROR("received empty message");
@@ -49,28 +53,22 @@ ptrdiff_t framing::consume(byte_span input, byte_span) {
       up_->abort(
         make_error(sec::protocol_error, "exceeded maximum message size"));
       return -1;
-    } else {
+    } else if (msg.size() < msg_size) {
       CAF_LOG_DEBUG("wait for payload of size" << msg_size);
-      down_->configure_read(receive_policy::exactly(hdr_size + msg_size));
-      return 0;
+      required = hdr_size + msg_size;
+      break;
     }
-  } else {
-    auto [msg_size, msg] = split(input);
-    if (msg_size == msg.size() && msg_size + hdr_size == input.size()) {
-      CAF_LOG_DEBUG("got message of size" << msg_size);
-      if (up_->consume(msg) >= 0) {
-        if (down_->is_reading())
-          down_->configure_read(receive_policy::exactly(hdr_size));
-        return static_cast<ptrdiff_t>(input.size());
-      } else {
-        return -1;
-      }
-    } else {
-      CAF_LOG_DEBUG("received malformed message");
-      up_->abort(make_error(sec::protocol_error, "received malformed message"));
+    CAF_LOG_DEBUG("got message of size" << msg_size);
+    if (up_->consume(msg.subspan(0, msg_size)) < 0)
       return -1;
-    }
+    consumed += hdr_size + msg_size;
+    // The upper layer may have called suspend_reading.
+    if (!down_->is_reading())
+      return static_cast<ptrdiff_t>(consumed);
   }
+  // Make sure the transport delivers the next frame in one piece.
+  down_->configure_read(read_policy(required));
+  return static_cast<ptrdiff_t>(consumed);
 }
 
 void framing::prepare_send() {
@@ -105,7 +103,7 @@ void framing::write_later() {
 
 void framing::request_messages() {
   if (!down_->is_reading())
-    down_->configure_read(receive_policy::exactly(hdr_size));
+    down_->configure_read(read_policy(hdr_size));
 }
 
 void framing::begin_message() {
@@ -143,6 +141,12 @@ void framing::shutdown() {
 
 // -- utility functions ------------------------------------------------------
 
+receive_policy framing::read_policy(size_t required) noexcept {
+  auto min_size = static_cast<uint32_t>(required);
+  return receive_policy::between(min_size,
+                                 std::max(min_size, max_read_chunk_size));
+}
+
 std::pair<size_t, byte_span> framing::split(byte_span buffer) noexcept {
   CAF_ASSERT(buffer.size() >= sizeof(uint32_t));
   auto u32_size = uint32_t{0};
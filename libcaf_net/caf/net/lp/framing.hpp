@@ -10,6 +10,7 @@
 #include "caf/net/lp/upper_layer.hpp"
 #include "caf/net/middleman.hpp"
 #include "caf/net/octet_stream/upper_layer.hpp"
+#include "caf/net/receive_policy.hpp"
 
 #include "caf/actor_system.hpp"
 #include "caf/async/spsc_buffer.hpp"
@@ -30,6 +31,11 @@ namespace caf::net::lp {
 /// but messages (including the 4 Bytes for the length prefix) are limited to a
 /// maximum size of INT32_MAX. This limitation comes from the POSIX API (recv)
 /// on 32-bit platforms.
+///
+/// The framing reads the Byte stream in chunks of up to `max_read_chunk_size`
+/// Bytes and dispatches all complete messages in a chunk at once. A partial
+/// message at the end of a chunk remains in the buffer of the transport until
+/// the remaining Bytes arrive.
 class CAF_NET_EXPORT framing : public octet_stream::upper_layer,
                                public lp::lower_layer {
 public:
@@ -43,6 +49,10 @@ public:
 
   static constexpr size_t max_message_length = INT32_MAX - sizeof(uint32_t);
 
+  /// Configures how many Bytes the framing asks the transport to read at once
+  /// unless a single message is larger.
+  static constexpr uint32_t max_read_chunk_size = 64 * 1024;
+
   // -- constructors, destructors, and assignment operators --------------------
 
   explicit framing(upper_layer_ptr up) : up_(std::move(up)) {
@@ -91,6 +101,9 @@ public:
 
   static std::pair<size_t, byte_span> split(byte_span buffer) noexcept;
 
+  /// Returns the receive policy for reading at least `required` Bytes.
+  static receive_policy read_policy(size_t required) noexcept;
+
 private:
   // -- member variables -------------------------------------------------------
 
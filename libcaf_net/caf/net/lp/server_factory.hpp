@@ -43,9 +43,6 @@ public:
 
   using producer_type = async::blocking_producer<accept_event>;
 
-  // Note: this is shared with the connection factory. In general, this is
-  //       *unsafe*. However, we exploit the fact that there is currently only
-  //       one thread running in the multiplexer (which makes this safe).
   using shared_producer_type = std::shared_ptr<producer_type>;
 
   lp_server_flow_bridge(shared_producer_type producer)
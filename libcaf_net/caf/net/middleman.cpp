@@ -12,6 +12,7 @@
 #include "caf/net/this_host.hpp"
 
 #include "caf/actor_system_config.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/set_thread_name.hpp"
 #include "caf/expected.hpp"
 #include "caf/raise_error.hpp"
@@ -20,6 +21,8 @@
 #include "caf/thread_owner.hpp"
 #include "caf/uri.hpp"
 
+#include <optional>
+
 namespace caf::net {
 
 namespace {
@@ -47,6 +50,13 @@ void launch_prom_server(actor_system& sys, const prom_config& cfg) {
     CAF_LOG_WARNING("failed to start Prometheus server: " << server.error());
 }
 
+// The configuration uses the short names of the backends, e.g., "epoll".
+bool backend_from_config(std::string_view str, multiplexer_backend& out) {
+  std::string full_name = "caf::net::multiplexer_backend::";
+  full_name += str;
+  return from_string(full_name, out);
+}
+
 void launch_background_tasks(actor_system& sys) {
   auto& cfg = sys.config();
   if (auto pcfg = get_as<prom_config>(cfg, "caf.middleman.prometheus-http")) {
@@ -80,30 +90,83 @@ middleman::~middleman() {
 
 void middleman::start() {
   if (!get_or(config(), "caf.middleman.manual-multiplexing", false)) {
-    auto fn = [this] {
+    // When pinning threads, we assign CPUs starting at the last one to stay
+    // away from scheduler workers, which start at the first CPU.
+    std::optional<detail::cpu_topology> topology;
+    if (get_or(config(), "caf.middleman.pin-multiplexer-threads", false))
+      topology = detail::cpu_topology::read();
+    auto pin = [topology](size_t index) {
+      if (topology && topology->size() > 0) {
+        auto pos = topology->size() - 1 - index % topology->size();
+        if (!detail::cpu_topology::pin_this_thread(topology->cpus()[pos].id))
+          CAF_LOG_WARNING("failed to pin multiplexer thread to a CPU");
+      }
+    };
+    auto fn = [this, pin] {
+      pin(0);
       mpx_->set_thread_id();
       launch_background_tasks(sys_);
       mpx_->run();
     };
     mpx_thread_ = sys_.launch_thread("caf.net.mpx", thread_owner::system, fn);
+    for (size_t index = 0; index < mpx_pool_.size(); ++index) {
+      auto mpx = mpx_pool_[index];
+      auto loop = [mpx, pin, index] {
+        pin(index + 1);
+        mpx->set_thread_id();
+        mpx->run();
+      };
+      mpx_pool_threads_.emplace_back(
+        sys_.launch_thread("caf.net.mpx", thread_owner::system, loop));
+    }
   } else {
     mpx_->set_thread_id();
   }
 }
 
 void middleman::stop() {
+  for (auto& mpx : mpx_pool_)
+    mpx->shutdown();
   mpx_->shutdown();
+  for (auto& thread : mpx_pool_threads_)
+    thread.join();
   if (mpx_thread_.joinable())
     mpx_thread_.join();
   else
     mpx_->run();
 }
 
-void middleman::init(actor_system_config&) {
-  if (auto err = mpx_->init()) {
+void middleman::init(actor_system_config& cfg) {
+  auto backend = multiplexer::default_backend();
+  if (auto str = get_as<std::string>(cfg, "caf.middleman.multiplexer-backend");
+      str && !backend_from_config(*str, backend)) {
+    CAF_LOG_ERROR("invalid multiplexer backend: " << *str);
+    CAF_RAISE_ERROR("invalid value for caf.middleman.multiplexer-backend");
+  }
+  if (auto err = mpx_->init(backend)) {
     CAF_LOG_ERROR("mpx_->init() failed: " << err);
     CAF_RAISE_ERROR("mpx_->init() failed");
   }
+  // Manual multiplexing implies running everything in a single thread.
+  if (get_or(cfg, "caf.middleman.manual-multiplexing", false))
+    return;
+  auto num_threads = get_or(cfg, "caf.middleman.multiplexer-threads", size_t{1});
+  for (size_t index = 1; index < num_threads; ++index) {
+    auto mpx = multiplexer::make(this);
+    if (auto err = mpx->init(backend)) {
+      CAF_LOG_ERROR("mpx->init() failed: " << err);
+      CAF_RAISE_ERROR("mpx->init() failed");
+    }
+    mpx_pool_.emplace_back(std::move(mpx));
+  }
+}
+
+multiplexer* middleman::next_mpx() noexcept {
+  if (mpx_pool_.empty())
+    return mpx_.get();
+  auto index = next_mpx_.fetch_add(1, std::memory_order_relaxed)
+               % (mpx_pool_.size() + 1);
+  return index == 0 ? mpx_.get() : mpx_pool_[index - 1].get();
 }
 
 middleman::module::id_t middleman::id() const {
@@ -121,7 +184,14 @@ actor_system::module* middleman::make(actor_system& sys, detail::type_list<>) {
 void middleman::add_module_options(actor_system_config& cfg) {
   config_option_adder{cfg.custom_options(), "caf.middleman"} //
     .add<bool>("manual-multiplexing",
-               "disables background activity of the multiplexer");
+               "disables background activity of the multiplexer")
+    .add<std::string>("multiplexer-backend",
+                      "selects 'epoll' (Linux only) or 'poll' for waiting on "
+                      "socket events")
+    .add<size_t>("multiplexer-threads",
+                 "number of multiplexers (one thread each) for connections")
+    .add<bool>("pin-multiplexer-threads",
+               "binds each multiplexer thread to a dedicated CPU");
   config_option_adder{cfg.custom_options(), "caf.middleman.prometheus-http"}
     .add<uint16_t>("port", "listening port for incoming scrapes")
     .add<std::string>("address", "bind address for the HTTP server socket");
@@ -14,10 +14,12 @@
 #include "caf/fwd.hpp"
 #include "caf/scoped_actor.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace caf::net {
 
@@ -93,6 +95,16 @@ public:
     return mpx_.get();
   }
 
+  /// Returns the number of multiplexers, each running in its own thread.
+  size_t num_multiplexers() const noexcept {
+    return mpx_pool_.size() + 1;
+  }
+
+  /// Returns the multiplexer for the next incoming connection in round-robin
+  /// order. Always returns `mpx_ptr()` when running a single multiplexer.
+  /// @thread-safe
+  multiplexer* next_mpx() noexcept;
+
 private:
   // -- member variables -------------------------------------------------------
 
@@ -104,6 +116,16 @@ private:
 
   /// Runs the multiplexer's event loop
   std::thread mpx_thread_;
+
+  /// Stores additional multiplexers for distributing connections when setting
+  /// `caf.middleman.multiplexer-threads` to a value greater than 1.
+  std::vector<multiplexer_ptr> mpx_pool_;
+
+  /// Runs the event loops of the multiplexers in `mpx_pool_`.
+  std::vector<std::thread> mpx_pool_threads_;
+
+  /// Selects the multiplexer for the next call to `next_mpx`.
+  std::atomic<size_t> next_mpx_ = 0;
 };
 
 } // namespace caf::net
@@ -25,10 +25,15 @@
 #ifndef CAF_WINDOWS
 #  include <poll.h>
 #  include <signal.h>
+#  include <unistd.h>
 #else
 #  include "caf/detail/socket_sys_includes.hpp"
 #endif // CAF_WINDOWS
 
+#ifdef CAF_LINUX
+#  include <sys/epoll.h>
+#endif // CAF_LINUX
+
 namespace caf::net {
 
 #ifndef POLLRDHUP
@@ -53,6 +58,27 @@ const short error_mask = POLLRDHUP | POLLERR | POLLHUP | POLLNVAL;
 
 const short output_mask = POLLOUT;
 
+#ifdef CAF_LINUX
+
+// Maximum number of events we process per call to epoll_wait.
+constexpr int max_epoll_events = 64;
+
+// On Linux, the poll and epoll flags share the same values. This allows us to
+// pass event masks through without translation.
+static_assert(POLLIN == EPOLLIN && POLLPRI == EPOLLPRI && POLLOUT == EPOLLOUT
+              && POLLERR == EPOLLERR && POLLHUP == EPOLLHUP
+              && POLLRDHUP == EPOLLRDHUP);
+
+epoll_event make_epoll_event(socket_id fd, short events) {
+  epoll_event result;
+  result.events = static_cast<uint32_t>(static_cast<unsigned short>(events));
+  result.data.u64 = 0;
+  result.data.fd = fd;
+  return result;
+}
+
+#endif // CAF_LINUX
+
 } // namespace
 
 // -- static utility functions -------------------------------------------------
@@ -78,6 +104,14 @@ void multiplexer::block_sigpipe() {
 
 #endif
 
+multiplexer_backend multiplexer::default_backend() noexcept {
+#ifdef CAF_LINUX
+  return multiplexer_backend::epoll;
+#else
+  return multiplexer_backend::poll;
+#endif
+}
+
 multiplexer* multiplexer::from(actor_system& sys) {
   return sys.network_manager().mpx_ptr();
 }
@@ -89,12 +123,40 @@ multiplexer::multiplexer(middleman* owner) : owner_(owner) {
 }
 
 multiplexer::~multiplexer() {
-  // nop
+#ifdef CAF_LINUX
+  if (epoll_fd_ != invalid_socket_id)
+    ::close(epoll_fd_);
+#endif
 }
 
 // -- initialization -----------------------------------------------------------
 
 error multiplexer::init() {
+  return init(default_backend());
+}
+
+error multiplexer::init(multiplexer_backend backend) {
+  switch (backend) {
+    case multiplexer_backend::poll:
+      break;
+    case multiplexer_backend::epoll: {
+#ifdef CAF_LINUX
+      epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+      if (epoll_fd_ < 0) {
+        epoll_fd_ = invalid_socket_id;
+        return make_error(sec::network_syscall_failed, "epoll_create1",
+                          last_socket_error_as_string());
+      }
+      break;
+#else
+      return make_error(sec::invalid_argument,
+                        "the epoll backend is only available on Linux");
+#endif
+    }
+    default:
+      return make_error(sec::invalid_argument, "invalid multiplexer backend");
+  }
+  backend_ = backend;
   auto pipe_handles = make_pipe();
   if (!pipe_handles)
     return std::move(pipe_handles.error());
@@ -103,8 +165,7 @@ error multiplexer::init() {
   if (auto err = mgr->start())
     return err;
   write_handle_ = pipe_handles->second;
-  pollset_.emplace_back(pollfd{pipe_handles->first.id, input_mask, 0});
-  managers_.emplace_back(mgr);
+  add_entry(pipe_handles->first, input_mask, std::move(mgr));
   return none;
 }
 
@@ -115,18 +176,16 @@ size_t multiplexer::num_socket_managers() const noexcept {
 }
 
 ptrdiff_t multiplexer::index_of(const socket_manager_ptr& mgr) const noexcept {
-  auto first = managers_.begin();
-  auto last = managers_.end();
-  auto i = std::find(first, last, mgr);
-  return i == last ? -1 : std::distance(first, i);
+  if (!mgr)
+    return -1;
+  auto index = index_of(mgr->handle());
+  return index != -1 && managers_[index] == mgr ? index : -1;
 }
 
 ptrdiff_t multiplexer::index_of(socket fd) const noexcept {
-  auto first = pollset_.begin();
-  auto last = pollset_.end();
-  auto i = std::find_if(first, last,
-                        [fd](const pollfd& x) { return x.fd == fd.id; });
-  return i == last ? -1 : std::distance(first, i);
+  if (auto i = indexes_.find(fd.id); i != indexes_.end())
+    return static_cast<ptrdiff_t>(i->second);
+  return -1;
 }
 
 middleman& multiplexer::owner() {
@@ -134,6 +193,10 @@ middleman& multiplexer::owner() {
   return *owner_;
 }
 
+multiplexer* multiplexer::next_for_connection() noexcept {
+  return owner_ != nullptr ? owner_->next_mpx() : this;
+}
+
 actor_system& multiplexer::system() {
   return owner().system();
 }
@@ -226,34 +289,10 @@ bool multiplexer::poll_once(bool blocking) {
     return false;
   // We'll call poll() until poll() succeeds or fails.
   for (;;) {
-    int presult =
-#ifdef CAF_WINDOWS
-      ::WSAPoll(pollset_.data(), static_cast<ULONG>(pollset_.size()),
-                blocking ? -1 : 0);
-#else
-      ::poll(pollset_.data(), static_cast<nfds_t>(pollset_.size()),
-             blocking ? -1 : 0);
-#endif
+    auto presult = backend_ == multiplexer_backend::epoll
+                     ? poll_once_with_epoll(blocking)
+                     : poll_once_with_poll(blocking);
     if (presult > 0) {
-      CAF_LOG_DEBUG("poll() on" << pollset_.size() << "sockets reported"
-                                << presult << "event(s)");
-      // Scan pollset for events.
-      if (auto revents = pollset_[0].revents; revents != 0) {
-        // Index 0 is always the pollset updater. This is the only handler that
-        // is allowed to modify pollset_ and managers_. Since this may very well
-        // mess with the for loop below, we process this handler first.
-        auto mgr = managers_[0];
-        handle(mgr, pollset_[0].events, revents);
-        --presult;
-      }
-      apply_updates();
-      for (size_t i = 1; i < pollset_.size() && presult > 0; ++i) {
-        if (auto revents = pollset_[i].revents; revents != 0) {
-          handle(managers_[i], pollset_[i].events, revents);
-          --presult;
-        }
-      }
-      apply_updates();
       return true;
     } else if (presult == 0) {
       // No activity.
@@ -296,17 +335,13 @@ void multiplexer::apply_updates() {
     if (!updates_.empty()) {
       for (auto& [fd, update] : updates_) {
         if (auto index = index_of(fd); index == -1) {
-          if (update.events != 0) {
-            pollfd new_entry{socket_cast<socket_id>(fd), update.events, 0};
-            pollset_.emplace_back(new_entry);
-            managers_.emplace_back(std::move(update.mgr));
-          }
+          if (update.events != 0)
+            add_entry(fd, update.events, std::move(update.mgr));
         } else if (update.events != 0) {
-          pollset_[index].events = update.events;
+          modify_entry(static_cast<size_t>(index), update.events);
           managers_[index].swap(update.mgr);
         } else {
-          pollset_.erase(pollset_.begin() + index);
-          managers_.erase(managers_.begin() + index);
+          remove_entry(static_cast<size_t>(index));
         }
       }
       updates_.clear();
@@ -432,6 +467,153 @@ short multiplexer::active_mask_of(const socket_manager* mgr) const noexcept {
   }
 }
 
+void multiplexer::add_entry(socket fd, short events, socket_manager_ptr mgr) {
+  CAF_LOG_TRACE(CAF_ARG2("socket", fd.id) << CAF_ARG(events));
+#ifdef CAF_LINUX
+  if (backend_ == multiplexer_backend::epoll) {
+    auto ev = make_epoll_event(fd.id, events);
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd.id, &ev) < 0) {
+      // The kernel may still know the descriptor if a socket got closed and the
+      // OS re-used its number before we have seen the removal.
+      if (errno != EEXIST
+          || epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd.id, &ev) < 0) {
+        CAF_LOG_ERROR("epoll_ctl failed to add socket"
+                      << fd.id << ":" << last_socket_error_as_string());
+      }
+    }
+  }
+#endif
+  indexes_.emplace(fd.id, pollset_.size());
+  pollset_.emplace_back(pollfd{fd.id, events, 0});
+  managers_.emplace_back(std::move(mgr));
+}
+
+void multiplexer::modify_entry(size_t index, short events) {
+  auto& entry = pollset_[index];
+  if (entry.events == events)
+    return;
+  entry.events = events;
+#ifdef CAF_LINUX
+  if (backend_ == multiplexer_backend::epoll) {
+    auto ev = make_epoll_event(entry.fd, events);
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, entry.fd, &ev) < 0) {
+      // Closing a socket implicitly removes it from the epoll set. Hence, the
+      // descriptor may refer to a new socket with the same number.
+      if (errno != ENOENT
+          || epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, entry.fd, &ev) < 0) {
+        CAF_LOG_ERROR("epoll_ctl failed to modify socket"
+                      << entry.fd << ":" << last_socket_error_as_string());
+      }
+    }
+  }
+#endif
+}
+
+void multiplexer::remove_entry(size_t index) {
+  auto fd = pollset_[index].fd;
+  CAF_LOG_TRACE(CAF_ARG2("socket", fd));
+#ifdef CAF_LINUX
+  if (backend_ == multiplexer_backend::epoll) {
+    // Closed sockets are already gone from the epoll set, so we ignore errors.
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  }
+#endif
+  indexes_.erase(fd);
+  if (index == 0) {
+    // Index 0 is reserved for the pollset updater. Hence, we must preserve the
+    // order of the remaining entries here.
+    pollset_.erase(pollset_.begin());
+    managers_.erase(managers_.begin());
+    for (auto& [key, pos] : indexes_)
+      --pos;
+    return;
+  }
+  // Move the last entry into the gap for removing in constant time.
+  auto last = pollset_.size() - 1;
+  if (index != last) {
+    pollset_[index] = pollset_[last];
+    managers_[index] = std::move(managers_[last]);
+    indexes_[pollset_[index].fd] = index;
+  }
+  pollset_.pop_back();
+  managers_.pop_back();
+}
+
+int multiplexer::poll_once_with_poll(bool blocking) {
+  int presult =
+#ifdef CAF_WINDOWS
+    ::WSAPoll(pollset_.data(), static_cast<ULONG>(pollset_.size()),
+              blocking ? -1 : 0);
+#else
+    ::poll(pollset_.data(), static_cast<nfds_t>(pollset_.size()),
+           blocking ? -1 : 0);
+#endif
+  if (presult <= 0)
+    return presult;
+  CAF_LOG_DEBUG("poll() on" << pollset_.size() << "sockets reported" << presult
+                            << "event(s)");
+  auto result = presult;
+  // Scan pollset for events.
+  if (auto revents = pollset_[0].revents; revents != 0) {
+    // Index 0 is always the pollset updater. This is the only handler that
+    // is allowed to modify pollset_ and managers_. Since this may very well
+    // mess with the for loop below, we process this handler first.
+    auto mgr = managers_[0];
+    handle(mgr, pollset_[0].events, revents);
+    --presult;
+  }
+  apply_updates();
+  for (size_t i = 1; i < pollset_.size() && presult > 0; ++i) {
+    if (auto revents = pollset_[i].revents; revents != 0) {
+      handle(managers_[i], pollset_[i].events, revents);
+      --presult;
+    }
+  }
+  apply_updates();
+  return result;
+}
+
+#ifdef CAF_LINUX
+
+int multiplexer::poll_once_with_epoll(bool blocking) {
+  epoll_event events[max_epoll_events];
+  auto presult = epoll_wait(epoll_fd_, events, max_epoll_events,
+                            blocking ? -1 : 0);
+  if (presult <= 0)
+    return presult;
+  CAF_LOG_DEBUG("epoll_wait() on" << pollset_.size() << "sockets reported"
+                                  << presult << "event(s)");
+  // Same as for poll: the pollset updater may modify pollset_ and managers_,
+  // so we run it before all other handlers.
+  auto updater_fd = pollset_[0].fd;
+  for (int i = 0; i < presult; ++i) {
+    if (events[i].data.fd == updater_fd) {
+      auto mgr = managers_[0];
+      handle(mgr, pollset_[0].events, static_cast<short>(events[i].events));
+      events[i].data.fd = invalid_socket_id;
+      break;
+    }
+  }
+  apply_updates();
+  for (int i = 0; i < presult; ++i) {
+    // Skips the pollset updater as well as sockets that the pollset updater
+    // has removed in the meantime.
+    if (auto index = index_of(socket{events[i].data.fd}); index > 0)
+      handle(managers_[index], pollset_[index].events,
+             static_cast<short>(events[i].events));
+  }
+  apply_updates();
+  return presult;
+}
+
+#else // CAF_LINUX
+
+int multiplexer::poll_once_with_epoll(bool) {
+  CAF_CRITICAL("the epoll backend is only available on Linux");
+}
+
+#endif // CAF_LINUX
+
 // -- internal callbacks the pollset updater -----------------------------------
 
 void multiplexer::do_shutdown() {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "caf/net/fwd.hpp"
+#include "caf/net/multiplexer_backend.hpp"
 #include "caf/net/pipe_socket.hpp"
 #include "caf/net/socket.hpp"
 
@@ -18,7 +19,10 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 
 extern "C" {
 
@@ -51,6 +55,10 @@ public:
 
   // -- static utility functions -----------------------------------------------
 
+  /// Returns the backend for the current platform: `epoll` on Linux and `poll`
+  /// everywhere else.
+  static multiplexer_backend default_backend() noexcept;
+
   /// Blocks the PIPE signal on the current thread when running on a POSIX
   /// windows. Has no effect when running on Windows.
   static void block_sigpipe();
@@ -75,10 +83,19 @@ public:
 
   // -- initialization ---------------------------------------------------------
 
+  /// Initializes the multiplexer with the default backend.
   error init();
 
+  /// Initializes the multiplexer with the given backend.
+  error init(multiplexer_backend backend);
+
   // -- properties -------------------------------------------------------------
 
+  /// Returns the backend for waiting on socket events.
+  multiplexer_backend backend() const noexcept {
+    return backend_;
+  }
+
   /// Returns the number of currently active socket managers.
   size_t num_socket_managers() const noexcept;
 
@@ -91,6 +108,11 @@ public:
   /// Returns the owning @ref middleman instance.
   middleman& owner();
 
+  /// Returns the multiplexer for the next incoming connection. Returns `this`
+  /// unless the @ref middleman runs multiple multiplexers, in which case it
+  /// picks one in round-robin order.
+  multiplexer* next_for_connection() noexcept;
+
   /// Returns the enclosing @ref actor_system.
   actor_system& system();
 
@@ -186,6 +208,21 @@ protected:
   /// Queries the currently active event bitmask for `mgr`.
   short active_mask_of(const socket_manager* mgr) const noexcept;
 
+  /// Adds a new entry to the pollset and registers it with the backend.
+  void add_entry(socket fd, short events, socket_manager_ptr mgr);
+
+  /// Changes the event mask of the entry at given index.
+  void modify_entry(size_t index, short events);
+
+  /// Removes the entry at given index from the pollset and the backend.
+  void remove_entry(size_t index);
+
+  /// Waits for events using `poll` and dispatches them.
+  int poll_once_with_poll(bool blocking);
+
+  /// Waits for events using `epoll` and dispatches them.
+  int poll_once_with_epoll(bool blocking);
+
   // -- member variables -------------------------------------------------------
 
   /// Bookkeeping data for managed sockets.
@@ -195,6 +232,9 @@ protected:
   /// order as their sockets appear in `pollset_`.
   manager_list managers_;
 
+  /// Maps sockets to their position in `pollset_` and `managers_`.
+  std::unordered_map<socket_id, size_t> indexes_;
+
   /// Caches changes to the events mask of managed sockets until they can safely
   /// take place.
   poll_update_map updates_;
@@ -212,6 +252,12 @@ protected:
   /// Points to the owning middleman.
   middleman* owner_;
 
+  /// Selects the system facility for waiting on socket events.
+  multiplexer_backend backend_ = multiplexer_backend::poll;
+
+  /// Stores the file descriptor for `epoll` if `backend_` is `epoll`.
+  socket_id epoll_fd_ = invalid_socket_id;
+
   /// Signals whether shutdown has been requested.
   bool shutting_down_ = false;
 
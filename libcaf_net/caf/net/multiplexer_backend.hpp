@@ -0,0 +1,41 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/default_enum_inspect.hpp"
+#include "caf/detail/net_export.hpp"
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace caf::net {
+
+/// Selects the system facility that a @ref multiplexer uses for waiting on
+/// socket events.
+enum class multiplexer_backend {
+  /// Uses `poll` (or `WSAPoll` on Windows). Available on all platforms.
+  poll,
+  /// Uses `epoll` in level-triggered mode. Only available on Linux.
+  epoll,
+};
+
+/// @relates multiplexer_backend
+CAF_NET_EXPORT std::string to_string(multiplexer_backend);
+
+/// @relates multiplexer_backend
+CAF_NET_EXPORT bool from_string(std::string_view, multiplexer_backend&);
+
+/// @relates multiplexer_backend
+CAF_NET_EXPORT bool from_integer(std::underlying_type_t<multiplexer_backend>,
+                                 multiplexer_backend&);
+
+/// @relates multiplexer_backend
+template <class Inspector>
+bool inspect(Inspector& f, multiplexer_backend& x) {
+  return default_enum_inspect(f, x);
+}
+
+} // namespace caf::net
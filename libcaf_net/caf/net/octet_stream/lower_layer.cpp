@@ -4,10 +4,25 @@
 
 #include "caf/net/octet_stream/lower_layer.hpp"
 
+#include "caf/net/shared_bytes.hpp"
+
+#include "caf/byte_buffer.hpp"
+
 namespace caf::net::octet_stream {
 
 lower_layer::~lower_layer() {
   // nop
 }
 
+void lower_layer::append_output(byte_buffer buf) {
+  auto& out = output_buffer();
+  out.insert(out.end(), buf.begin(), buf.end());
+}
+
+void lower_layer::append_output(const shared_bytes& item) {
+  auto bytes = item.bytes();
+  auto& out = output_buffer();
+  out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
 } // namespace caf::net::octet_stream
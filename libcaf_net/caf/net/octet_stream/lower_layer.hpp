@@ -40,6 +40,19 @@ public:
   /// registering sockets for write events.
   virtual bool end_output() = 0;
 
+  /// Appends `buf` to the outgoing data without copying its content into the
+  /// output buffer. The default implementation falls back to copying.
+  /// @pre Users may only call this function between calling `begin_output()`
+  ///      and `end_output()`.
+  virtual void append_output(byte_buffer buf);
+
+  /// Appends the bytes of `item` to the outgoing data. Implementations may
+  /// keep a reference to `item` until writing its bytes to the socket instead
+  /// of copying them. The default implementation falls back to copying.
+  /// @pre Users may only call this function between calling `begin_output()`
+  ///      and `end_output()`.
+  virtual void append_output(const shared_bytes& item);
+
   /// Asks the stream to swap the current upper layer with `next` after
   /// returning from `consume()`.
   /// @note may only be called from the upper layer in `consume`.
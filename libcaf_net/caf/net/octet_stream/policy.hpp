@@ -28,6 +28,13 @@ public:
   /// Writes data from the buffer to the socket.
   virtual ptrdiff_t write(const_byte_span buf) = 0;
 
+  /// Writes data from multiple buffers to the socket. The default
+  /// implementation writes one buffer at a time and stops at the first partial
+  /// write.
+  /// @returns The total number of written bytes or the result of the first
+  ///          failed write if no byte was written.
+  virtual ptrdiff_t write(span<const const_byte_span> bufs);
+
   /// Returns the last socket error on this thread.
   virtual errc last_error(ptrdiff_t) = 0;
 
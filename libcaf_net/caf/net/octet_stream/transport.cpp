@@ -9,11 +9,23 @@
 #include "caf/net/socket_manager.hpp"
 
 #include "caf/defaults.hpp"
+#include "caf/span.hpp"
 
+#include <algorithm>
 #include <new>
 
 namespace caf::net::octet_stream {
 
+namespace {
+
+const_byte_span bytes_of(const transport::output_item& x) {
+  if (auto buf = std::get_if<byte_buffer>(&x))
+    return *buf;
+  return std::get<shared_bytes>(x).bytes();
+}
+
+} // namespace
+
 // -- nested types -------------------------------------------------------------
 
 stream_socket transport::policy_impl::handle() const {
@@ -28,6 +40,10 @@ ptrdiff_t transport::policy_impl::write(const_byte_span buf) {
   return net::write(fd, buf);
 }
 
+ptrdiff_t transport::policy_impl::write(span<const const_byte_span> bufs) {
+  return net::write(fd, bufs);
+}
+
 errc transport::policy_impl::last_error(ptrdiff_t) {
   return last_socket_error_is_temporary() ? errc::temporary : errc::permanent;
 }
@@ -79,7 +95,7 @@ multiplexer& transport::mpx() noexcept {
 }
 
 bool transport::can_send_more() const noexcept {
-  return write_buf_.size() < max_write_buf_size_;
+  return pending_output() < max_write_buf_size_;
 }
 
 void transport::configure_read(receive_policy rd) {
@@ -87,8 +103,10 @@ void transport::configure_read(receive_policy rd) {
   min_read_size_ = rd.min_size;
   max_read_size_ = rd.max_size;
   if (restarting && !parent_->is_reading()) {
-    if (buffered_ > 0 && buffered_ >= min_read_size_
-        && delta_offset_ < buffered_) {
+    // The upper layer may have stopped reading after consuming only parts of
+    // the buffer. Hence, it must see the remaining bytes again.
+    delta_offset_ = 0;
+    if (buffered_ > 0 && buffered_ >= min_read_size_) {
       // We can already make progress with the data we have. Hence, we need
       // schedule a call to read from our buffer before we can wait for
       // additional data from the peer.
@@ -106,7 +124,7 @@ void transport::configure_read(receive_policy rd) {
 }
 
 void transport::begin_output() {
-  if (write_buf_.empty())
+  if (pending_output() == 0)
     parent_->register_writing();
 }
 
@@ -118,6 +136,27 @@ bool transport::end_output() {
   return true;
 }
 
+void transport::append_output(byte_buffer buf) {
+  if (buf.size() < min_append_size) {
+    write_buf_.insert(write_buf_.end(), buf.begin(), buf.end());
+    return;
+  }
+  seal_write_buffer();
+  write_queue_size_ += buf.size();
+  write_queue_.emplace_back(std::move(buf));
+}
+
+void transport::append_output(const shared_bytes& item) {
+  auto bytes = item.bytes();
+  if (bytes.size() < min_append_size) {
+    write_buf_.insert(write_buf_.end(), bytes.begin(), bytes.end());
+    return;
+  }
+  seal_write_buffer();
+  write_queue_size_ += bytes.size();
+  write_queue_.emplace_back(item);
+}
+
 bool transport::is_reading() const noexcept {
   return max_read_size_ > 0;
 }
@@ -127,7 +166,7 @@ void transport::write_later() {
 }
 
 void transport::shutdown() {
-  if (write_buf_.empty()) {
+  if (pending_output() == 0) {
     parent_->shutdown();
   } else {
     configure_read(receive_policy::stop());
@@ -308,6 +347,59 @@ void transport::fail(const error& reason) {
   parent_->shutdown();
 }
 
+void transport::seal_write_buffer() {
+  if (write_buf_.empty())
+    return;
+  if (write_buf_.size() < min_append_size) {
+    // Keep the (large) capacity of the write buffer for the next writes.
+    write_queue_size_ += write_buf_.size();
+    write_queue_.emplace_back(byte_buffer{write_buf_.begin(), write_buf_.end()});
+    write_buf_.clear();
+    return;
+  }
+  // Hand over the buffer. The new write buffer grows on demand instead of
+  // allocating the maximum size up front for every sealed buffer.
+  write_queue_size_ += write_buf_.size();
+  write_queue_.emplace_back(std::move(write_buf_));
+  write_buf_ = byte_buffer{};
+}
+
+ptrdiff_t transport::write_pending_output() {
+  if (write_queue_.empty())
+    return policy_->write(write_buf_);
+  iov_.clear();
+  for (auto& item : write_queue_) {
+    if (iov_.size() == max_iov_count)
+      break;
+    auto bytes = bytes_of(item);
+    if (iov_.empty())
+      bytes = bytes.subspan(write_queue_offset_);
+    iov_.emplace_back(bytes);
+  }
+  if (iov_.size() < max_iov_count && !write_buf_.empty())
+    iov_.emplace_back(write_buf_);
+  return policy_->write(make_span(iov_));
+}
+
+void transport::erase_pending_output(size_t num_bytes) {
+  while (num_bytes > 0 && !write_queue_.empty()) {
+    auto remaining = bytes_of(write_queue_.front()).size()
+                     - write_queue_offset_;
+    if (num_bytes < remaining) {
+      write_queue_offset_ += num_bytes;
+      write_queue_size_ -= num_bytes;
+      return;
+    }
+    num_bytes -= remaining;
+    write_queue_size_ -= remaining;
+    write_queue_offset_ = 0;
+    write_queue_.pop_front();
+  }
+  CAF_ASSERT(num_bytes <= write_buf_.size());
+  write_buf_.erase(write_buf_.begin(),
+                   write_buf_.begin() + static_cast<ptrdiff_t>(num_bytes));
+}
+
 void transport::handle_write_event() {
   CAF_LOG_TRACE(CAF_ARG2("socket", handle()));
   // Resume a read operation if the transport waited for the socket to be
@@ -325,7 +417,7 @@ void transport::handle_write_event() {
   }
   // When shutting down, we flush our buffer and then shut down the manager.
   if (flags_.shutting_down) {
-    if (write_buf_.empty()) {
+    if (pending_output() == 0) {
       parent_->shutdown();
       return;
     }
@@ -333,10 +425,10 @@ void transport::handle_write_event() {
     // Allow the upper layer to add extra data to the write buffer.
     up_->prepare_send();
   }
-  auto write_res = policy_->write(write_buf_);
+  auto write_res = write_pending_output();
   if (write_res > 0) {
-    write_buf_.erase(write_buf_.begin(), write_buf_.begin() + write_res);
-    if (write_buf_.empty() && up_->done_sending()) {
+    erase_pending_output(static_cast<size_t>(write_res));
+    if (pending_output() == 0 && up_->done_sending()) {
       if (!flags_.shutting_down) {
         parent_->deregister_writing();
       } else {
@@ -371,7 +463,7 @@ void transport::abort(const error& reason) {
 }
 
 bool transport::finalized() const noexcept {
-  return write_buf_.empty();
+  return pending_output() == 0;
 }
 
 } // namespace caf::net::octet_stream
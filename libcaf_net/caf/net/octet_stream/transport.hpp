@@ -8,6 +8,7 @@
 #include "caf/net/octet_stream/lower_layer.hpp"
 #include "caf/net/octet_stream/policy.hpp"
 #include "caf/net/octet_stream/upper_layer.hpp"
+#include "caf/net/shared_bytes.hpp"
 #include "caf/net/socket_event_layer.hpp"
 #include "caf/net/stream_socket.hpp"
 
@@ -17,6 +18,8 @@
 #include "caf/fwd.hpp"
 
 #include <deque>
+#include <variant>
+#include <vector>
 
 namespace caf::net::octet_stream {
 
@@ -32,6 +35,9 @@ public:
   /// An owning smart pointer type for storing an upper layer object.
   using upper_layer_ptr = std::unique_ptr<octet_stream::upper_layer>;
 
+  /// An output buffer that an upper layer handed over via `append_output`.
+  using output_item = std::variant<byte_buffer, shared_bytes>;
+
   /// Bundles various flags into a single block of memory.
   struct flags_t {
     /// Stores whether we left a read handler due to want_write.
@@ -56,6 +62,8 @@ public:
 
     ptrdiff_t write(const_byte_span) override;
 
+    ptrdiff_t write(span<const const_byte_span>) override;
+
     octet_stream::errc last_error(ptrdiff_t) override;
 
     ptrdiff_t connect() override;
@@ -71,6 +79,10 @@ public:
 
   static constexpr size_t default_buf_size = 4 * 1024; // 4 KiB
 
+  /// Buffers below this size are cheaper to copy into the write buffer than
+  /// to send as a separate element of a scatter-gather write.
+  static constexpr size_t min_append_size = 1024; // 1 KiB
+
   // -- constructors, destructors, and assignment operators --------------------
 
   transport(stream_socket fd, upper_layer_ptr up);
@@ -101,6 +113,10 @@ public:
 
   bool end_output() override;
 
+  void append_output(byte_buffer buf) override;
+
+  void append_output(const shared_bytes& item) override;
+
   bool is_reading() const noexcept override;
 
   void write_later() override;
@@ -129,6 +145,12 @@ public:
     return write_buf_;
   }
 
+  /// Returns the number of bytes that wait for transfer, i.e., the bytes in
+  /// the write buffer plus all buffers added via `append_output`.
+  size_t pending_output() const noexcept {
+    return write_queue_size_ + write_buf_.size();
+  }
+
   auto& upper_layer() noexcept {
     return *up_;
   }
@@ -172,6 +194,17 @@ protected:
   /// Calls abort on the upper layer and deregisters the transport from events.
   void fail(const error& reason);
 
+  /// Moves the content of the write buffer to the write queue to make sure
+  /// that the next item in the queue follows after the buffered bytes.
+  void seal_write_buffer();
+
+  /// Writes as much pending output as possible with a single call to the
+  /// policy.
+  ptrdiff_t write_pending_output();
+
+  /// Drops the first `num_bytes` bytes of the pending output.
+  void erase_pending_output(size_t num_bytes);
+
   // -- member variables -------------------------------------------------------
 
   /// Stores temporary flags.
@@ -200,9 +233,23 @@ protected:
   /// Caches incoming data.
   byte_buffer read_buf_;
 
-  /// Caches outgoing data.
+  /// Caches outgoing data. Bytes in this buffer follow after the buffers in
+  /// `write_queue_`.
   byte_buffer write_buf_;
 
+  /// Stores buffers that upper layers handed over without copying them.
+  std::deque<output_item> write_queue_;
+
+  /// Stores how many bytes of the first item in `write_queue_` we have
+  /// already written to the socket.
+  size_t write_queue_offset_ = 0;
+
+  /// Stores how many bytes in `write_queue_` still wait for transfer.
+  size_t write_queue_size_ = 0;
+
+  /// Caches the buffers for scatter-gather writes.
+  std::vector<const_byte_span> iov_;
+
   /// Processes incoming data and generates outgoing data.
   upper_layer_ptr up_;
 
@@ -0,0 +1,55 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/net/shared_bytes.hpp"
+
+#include "caf/raise_error.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <numeric>
+
+namespace caf::net {
+
+namespace {
+
+shared_bytes::data* make_data(size_t size) {
+  auto vptr = malloc(sizeof(shared_bytes::data) + size);
+  if (vptr == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  return new (vptr) shared_bytes::data(size);
+}
+
+} // namespace
+
+void shared_bytes::data::deref() const noexcept {
+  if (unique() || rc_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    this->~data();
+    free(const_cast<data*>(this));
+  }
+}
+
+shared_bytes::shared_bytes(const_byte_span buf) {
+  auto ptr = make_data(buf.size());
+  if (!buf.empty())
+    memcpy(ptr->storage(), buf.data(), buf.size());
+  data_.reset(ptr, false);
+}
+
+shared_bytes::shared_bytes(span<const const_byte_span> bufs) {
+  auto fn = [](size_t n, const_byte_span buf) { return n + buf.size(); };
+  auto total_size = std::accumulate(bufs.begin(), bufs.end(), size_t{0}, fn);
+  auto ptr = make_data(total_size);
+  auto pos = ptr->storage();
+  for (const auto& buf : bufs) {
+    if (!buf.empty()) {
+      memcpy(pos, buf.data(), buf.size());
+      pos += buf.size();
+    }
+  }
+  data_.reset(ptr, false);
+}
+
+} // namespace caf::net
@@ -0,0 +1,150 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/byte_span.hpp"
+#include "caf/config.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/span.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+#ifdef CAF_CLANG
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wc99-extensions"
+#elif defined(CAF_GCC)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wpedantic"
+#elif defined(CAF_MSVC)
+#  pragma warning(push)
+#  pragma warning(disable : 4200)
+#endif
+
+namespace caf::net {
+
+/// An immutable, implicitly shared sequence of bytes. Protocol layers use this
+/// type for handing data to a transport that keeps a reference to the bytes
+/// until writing them to the socket instead of copying them.
+class CAF_NET_EXPORT shared_bytes {
+public:
+  // -- member types -----------------------------------------------------------
+
+  class data {
+  public:
+    data() = delete;
+
+    data(const data&) = delete;
+
+    data& operator=(const data&) = delete;
+
+    explicit data(size_t size) noexcept : rc_(1), size_(size) {
+      // nop
+    }
+
+    // -- reference counting ---------------------------------------------------
+
+    bool unique() const noexcept {
+      return rc_ == 1;
+    }
+
+    void ref() const noexcept {
+      rc_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void deref() const noexcept;
+
+    friend void intrusive_ptr_add_ref(const data* ptr) {
+      ptr->ref();
+    }
+
+    friend void intrusive_ptr_release(const data* ptr) {
+      ptr->deref();
+    }
+
+    // -- properties -----------------------------------------------------------
+
+    size_t size() const noexcept {
+      return size_;
+    }
+
+    std::byte* storage() noexcept {
+      return storage_;
+    }
+
+    const std::byte* storage() const noexcept {
+      return storage_;
+    }
+
+  private:
+    mutable std::atomic<size_t> rc_;
+    size_t size_;
+    std::byte storage_[];
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  shared_bytes() = default;
+
+  shared_bytes(shared_bytes&&) = default;
+
+  shared_bytes(const shared_bytes&) = default;
+
+  shared_bytes& operator=(shared_bytes&&) = default;
+
+  shared_bytes& operator=(const shared_bytes&) = default;
+
+  /// Copies `buf` into a new block of memory.
+  explicit shared_bytes(const_byte_span buf);
+
+  /// Copies the concatenation of `bufs` into a new block of memory.
+  explicit shared_bytes(span<const const_byte_span> bufs);
+
+  // -- factory functions ------------------------------------------------------
+
+  template <class... ByteBuffers>
+  static shared_bytes from_buffers(const ByteBuffers&... buffers) {
+    static_assert(sizeof...(ByteBuffers) > 0);
+    const_byte_span bufs[sizeof...(ByteBuffers)] = {make_span(buffers)...};
+    return shared_bytes(make_span(bufs));
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  explicit operator bool() const noexcept {
+    return static_cast<bool>(data_);
+  }
+
+  size_t size() const noexcept {
+    return data_ ? data_->size() : 0;
+  }
+
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  const_byte_span bytes() const noexcept {
+    return data_ ? const_byte_span{data_->storage(), data_->size()}
+                 : const_byte_span{};
+  }
+
+  void swap(shared_bytes& other) noexcept {
+    data_.swap(other.data_);
+  }
+
+private:
+  intrusive_ptr<const data> data_;
+};
+
+} // namespace caf::net
+
+#ifdef CAF_CLANG
+#  pragma clang diagnostic pop
+#elif defined(CAF_GCC)
+#  pragma GCC diagnostic pop
+#elif defined(CAF_MSVC)
+#  pragma warning(pop)
+#endif
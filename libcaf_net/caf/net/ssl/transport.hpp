@@ -25,6 +25,8 @@ public:
 
   class policy_impl : public octet_stream::policy {
   public:
+    using octet_stream::policy::write;
+
     explicit policy_impl(connection conn);
 
     stream_socket handle() const override;
@@ -14,7 +14,9 @@
 #include "caf/logger.hpp"
 #include "caf/span.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 #ifdef CAF_POSIX
 #  include <sys/uio.h>
@@ -182,6 +184,21 @@ ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
   return (res == 0) ? bytes_sent : -1;
 }
 
+ptrdiff_t write(stream_socket x, span<const const_byte_span> bufs) {
+  CAF_LOG_TRACE(CAF_ARG2("socket", x.id) << CAF_ARG2("buffers", bufs.size()));
+  WSABUF buf_array[max_iov_count];
+  auto n = std::min(bufs.size(), max_iov_count);
+  for (size_t i = 0; i < n; ++i) {
+    auto data = const_cast<std::byte*>(bufs[i].data());
+    buf_array[i] = WSABUF{static_cast<ULONG>(bufs[i].size()),
+                          reinterpret_cast<CHAR*>(data)};
+  }
+  DWORD bytes_sent = 0;
+  auto res = WSASend(x.id, buf_array, static_cast<DWORD>(n), &bytes_sent, 0,
+                     nullptr, nullptr);
+  return (res == 0) ? static_cast<ptrdiff_t>(bytes_sent) : -1;
+}
+
 #else // CAF_WINDOWS
 
 ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
@@ -194,6 +211,21 @@ ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
   return writev(x.id, buf_array, static_cast<int>(bufs.size()));
 }
 
+ptrdiff_t write(stream_socket x, span<const const_byte_span> bufs) {
+  CAF_LOG_TRACE(CAF_ARG2("socket", x.id) << CAF_ARG2("buffers", bufs.size()));
+  iovec buf_array[max_iov_count];
+  auto n = std::min(bufs.size(), max_iov_count);
+  for (size_t i = 0; i < n; ++i)
+    buf_array[i] = iovec{const_cast<std::byte*>(bufs[i].data()),
+                         bufs[i].size()};
+  // Unlike writev, sendmsg allows us to pass MSG_NOSIGNAL.
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = buf_array;
+  msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(n);
+  return ::sendmsg(x.id, &msg, no_sigpipe_io_flag);
+}
+
 #endif // CAF_WINDOWS
 
 } // namespace caf::net
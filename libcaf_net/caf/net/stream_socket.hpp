@@ -79,4 +79,17 @@ ptrdiff_t CAF_NET_EXPORT write(stream_socket x, const_byte_span buf);
 ptrdiff_t CAF_NET_EXPORT write(stream_socket x,
                                std::initializer_list<const_byte_span> bufs);
 
+/// Transmits data from `x` to its peer with a single system call.
+/// @param x A connected endpoint.
+/// @param bufs Points to the message to send, scattered across any number of
+///             buffers. Sends at most `max_iov_count` buffers at once.
+/// @returns The number of written bytes on success, 0 if the socket is closed,
+///          or -1 in case of an error.
+/// @relates stream_socket
+ptrdiff_t CAF_NET_EXPORT write(stream_socket x,
+                               span<const const_byte_span> bufs);
+
+/// Maximum number of buffers that a single scatter-gather write transmits.
+constexpr size_t max_iov_count = 64;
+
 } // namespace caf::net
@@ -17,6 +17,16 @@
 #include "caf/logger.hpp"
 #include "caf/span.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#ifdef CAF_LINUX
+#  include <netinet/udp.h>
+#endif
+
 namespace {
 
 #if defined(CAF_WINDOWS) || defined(CAF_MACOS) || defined(CAF_IOS)             \
@@ -26,6 +36,25 @@ constexpr int no_sigpipe_io_flag = 0;
 constexpr int no_sigpipe_io_flag = MSG_NOSIGNAL;
 #endif
 
+#ifdef CAF_LINUX
+
+// Control buffer for the `UDP_GRO` and `UDP_SEGMENT` messages.
+union offload_control {
+  cmsghdr align;
+  char buf[CMSG_SPACE(sizeof(int))];
+};
+
+#endif // CAF_LINUX
+
+#if defined(CAF_LINUX) && defined(UDP_SEGMENT)
+
+// Becomes `true` after the kernel rejected `UDP_SEGMENT` with `EIO`, i.e., the
+// network device lacks checksum offload. CAF then splits all payloads in user
+// space.
+std::atomic<bool> segmentation_offload_failed;
+
+#endif // CAF_LINUX && UDP_SEGMENT
+
 } // namespace
 
 namespace caf::net {
@@ -75,4 +104,206 @@ ptrdiff_t write(udp_datagram_socket x, const_byte_span buf, ip_endpoint ep) {
                   static_cast<socklen_t>(len));
 }
 
+#ifdef CAF_LINUX
+
+ptrdiff_t read(udp_datagram_socket x, span<received_datagram> msgs) {
+  auto n = std::min(msgs.size(), max_datagram_batch_size);
+  if (n == 0)
+    return 0;
+  mmsghdr hdrs[max_datagram_batch_size];
+  iovec iovs[max_datagram_batch_size];
+  sockaddr_storage addrs[max_datagram_batch_size];
+  offload_control ctrls[max_datagram_batch_size];
+  memset(hdrs, 0, n * sizeof(mmsghdr));
+  for (size_t i = 0; i < n; ++i) {
+    iovs[i] = iovec{msgs[i].payload.data(), msgs[i].payload.size()};
+    auto& hdr = hdrs[i].msg_hdr;
+    hdr.msg_name = &addrs[i];
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = ctrls[i].buf;
+    hdr.msg_controllen = sizeof(ctrls[i].buf);
+  }
+  // MSG_WAITFORONE returns as soon as at least one datagram is available.
+  auto res = ::recvmmsg(x.id, hdrs, static_cast<unsigned>(n), MSG_WAITFORONE,
+                        nullptr);
+  if (res <= 0)
+    return res;
+  for (size_t i = 0; i < static_cast<size_t>(res); ++i) {
+    auto& msg = msgs[i];
+    auto& hdr = hdrs[i].msg_hdr;
+    msg.payload = msg.payload.first(
+      std::min(size_t{hdrs[i].msg_len}, msg.payload.size()));
+    msg.truncated = (hdr.msg_flags & MSG_TRUNC) != 0;
+    msg.segment_size = 0;
+#  ifdef UDP_GRO
+    for (auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+      if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+        int segment_size = 0;
+        memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(int));
+        msg.segment_size = static_cast<size_t>(segment_size);
+      }
+    }
+#  endif // UDP_GRO
+    std::ignore = detail::convert(addrs[i], msg.source);
+  }
+  return res;
+}
+
+namespace {
+
+// Sends `msgs` with a single `sendmmsg` call. Passes segmented payloads to the
+// kernel if `offload` is `true` and splits them in user space otherwise.
+// Returns the number of sent datagrams, counting each segment separately.
+ptrdiff_t send_batch(udp_datagram_socket x, span<const outgoing_datagram> msgs,
+                     [[maybe_unused]] bool offload) {
+  mmsghdr hdrs[max_datagram_batch_size];
+  iovec iovs[max_datagram_batch_size];
+  sockaddr_storage addrs[max_datagram_batch_size];
+  // Stores how many datagrams each entry of `hdrs` puts on the wire.
+  size_t segments[max_datagram_batch_size];
+  memset(hdrs, 0, sizeof(hdrs));
+  size_t n = 0;
+  auto add = [&](size_t index, const_byte_span bytes) -> msghdr& {
+    iovs[n] = iovec{const_cast<std::byte*>(bytes.data()), bytes.size()};
+    auto& hdr = hdrs[n].msg_hdr;
+    hdr.msg_name = &addrs[index];
+    hdr.msg_namelen = msgs[index].destination.address().embeds_v4()
+                        ? sizeof(sockaddr_in)
+                        : sizeof(sockaddr_in6);
+    hdr.msg_iov = &iovs[n];
+    hdr.msg_iovlen = 1;
+    segments[n++] = 1;
+    return hdr;
+  };
+#  ifdef UDP_SEGMENT
+  offload_control ctrls[max_datagram_batch_size];
+#  endif
+  // Each element of `msgs` occupies at least one entry. Hence, `i < n` holds
+  // for all indexes into `addrs`.
+  for (size_t i = 0; i < msgs.size() && n < max_datagram_batch_size; ++i) {
+    auto& msg = msgs[i];
+    addrs[i] = sockaddr_storage{};
+    detail::convert(msg.destination, addrs[i]);
+    auto payload = msg.payload;
+    auto segment_size = msg.segment_size > 0 ? msg.segment_size
+                                             : payload.size();
+#  ifdef UDP_SEGMENT
+    if (offload && segment_size < payload.size()) {
+      // Let the kernel split the payload into multiple datagrams.
+      auto& ctrl = ctrls[n];
+      auto& hdr = add(i, payload);
+      segments[n - 1] = num_segments(msg);
+      memset(ctrl.buf, 0, sizeof(ctrl.buf));
+      hdr.msg_control = ctrl.buf;
+      hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+      auto cmsg = CMSG_FIRSTHDR(&hdr);
+      cmsg->cmsg_level = IPPROTO_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      auto size = static_cast<uint16_t>(segment_size);
+      memcpy(CMSG_DATA(cmsg), &size, sizeof(uint16_t));
+      continue;
+    }
+#  endif // UDP_SEGMENT
+    do {
+      auto chunk = payload.first(std::min(segment_size, payload.size()));
+      add(i, chunk);
+      payload = payload.subspan(chunk.size());
+    } while (!payload.empty() && n < max_datagram_batch_size);
+  }
+  auto res = ::sendmmsg(x.id, hdrs, static_cast<unsigned>(n),
+                        no_sigpipe_io_flag);
+  if (res <= 0)
+    return res;
+  ptrdiff_t result = 0;
+  for (size_t i = 0; i < static_cast<size_t>(res); ++i)
+    result += static_cast<ptrdiff_t>(segments[i]);
+  return result;
+}
+
+} // namespace
+
+ptrdiff_t write(udp_datagram_socket x, span<const outgoing_datagram> msgs) {
+  if (msgs.empty())
+    return 0;
+#  ifdef UDP_SEGMENT
+  if (!segmentation_offload_failed.load(std::memory_order_relaxed)) {
+    auto res = send_batch(x, msgs, true);
+    if (res >= 0 || num_segments(msgs.front()) < 2)
+      return res;
+    auto err = errno;
+    if (err != EIO && err != EINVAL)
+      return res;
+    // The kernel rejects segmented payloads with EIO if the network device
+    // lacks checksum offload and with EINVAL if a payload has too many
+    // segments. Only the former applies to all future payloads as well.
+    if (err == EIO)
+      segmentation_offload_failed.store(true, std::memory_order_relaxed);
+  }
+#  endif // UDP_SEGMENT
+  return send_batch(x, msgs, false);
+}
+
+#else // CAF_LINUX
+
+ptrdiff_t read(udp_datagram_socket x, span<received_datagram> msgs) {
+  auto n = std::min(msgs.size(), max_datagram_batch_size);
+  for (size_t i = 0; i < n; ++i) {
+    auto& msg = msgs[i];
+    auto res = read(x, msg.payload, &msg.source);
+    if (res < 0)
+      return i > 0 ? static_cast<ptrdiff_t>(i) : res;
+    auto len = static_cast<size_t>(res);
+    msg.truncated = len > msg.payload.size();
+    msg.payload = msg.payload.first(std::min(len, msg.payload.size()));
+    msg.segment_size = 0;
+  }
+  return static_cast<ptrdiff_t>(n);
+}
+
+ptrdiff_t write(udp_datagram_socket x, span<const outgoing_datagram> msgs) {
+  auto limit = static_cast<ptrdiff_t>(max_datagram_batch_size);
+  ptrdiff_t result = 0;
+  for (size_t i = 0; i < msgs.size() && result < limit; ++i) {
+    auto& msg = msgs[i];
+    // Split the payload in user space, since the kernel cannot do it for us.
+    auto segment_size = msg.segment_size > 0 ? msg.segment_size
+                                             : msg.payload.size();
+    auto payload = msg.payload;
+    do {
+      auto chunk = payload.first(std::min(segment_size, payload.size()));
+      if (auto res = write(x, chunk, msg.destination); res < 0)
+        return result > 0 ? result : res;
+      ++result;
+      payload = payload.subspan(chunk.size());
+    } while (!payload.empty() && result < limit);
+  }
+  return result;
+}
+
+#endif // CAF_LINUX
+
+#if defined(CAF_LINUX) && defined(UDP_GRO)
+
+error allow_receive_offload(udp_datagram_socket x, bool new_value) {
+  CAF_LOG_TRACE(CAF_ARG(x) << CAF_ARG(new_value));
+  int value = new_value ? 1 : 0;
+  CAF_NET_SYSCALL("setsockopt", res, !=, 0,
+                  setsockopt(x.id, IPPROTO_UDP, UDP_GRO, &value,
+                             static_cast<socket_size_type>(sizeof(value))));
+  return none;
+}
+
+#else // CAF_LINUX && UDP_GRO
+
+error allow_receive_offload(udp_datagram_socket, bool) {
+  return make_error(sec::unsupported_operation,
+                    "generic receive offload requires Linux");
+}
+
+#endif // CAF_LINUX && UDP_GRO
+
 } // namespace caf::net
@@ -10,7 +10,10 @@
 #include "caf/byte_span.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/fwd.hpp"
+#include "caf/ip_endpoint.hpp"
+#include "caf/span.hpp"
 
+#include <cstddef>
 #include <vector>
 
 namespace caf::net {
@@ -23,6 +26,49 @@ struct CAF_NET_EXPORT udp_datagram_socket : datagram_socket {
   using super::super;
 };
 
+/// Describes a single datagram for receiving a batch of datagrams.
+struct received_datagram {
+  /// Stores the address of the sender after receiving the datagram.
+  ip_endpoint source;
+
+  /// Points to the receive buffer before reading and to the received bytes
+  /// after reading.
+  byte_span payload;
+
+  /// Stores the size of the individual datagrams if the kernel coalesced
+  /// multiple datagrams from the same sender into `payload` (generic receive
+  /// offload) or 0 otherwise.
+  size_t segment_size = 0;
+
+  /// Stores whether the datagram did not fit into the receive buffer.
+  bool truncated = false;
+};
+
+/// Describes a single datagram for sending a batch of datagrams.
+struct outgoing_datagram {
+  /// The endpoint to send the datagram to.
+  ip_endpoint destination;
+
+  /// The bytes to send.
+  const_byte_span payload;
+
+  /// Splits `payload` into datagrams of this size when set to a non-zero
+  /// value. Lets the kernel split the payload if it supports generic
+  /// segmentation offload.
+  size_t segment_size = 0;
+};
+
+/// Returns how many datagrams sending `x` puts on the wire.
+/// @relates outgoing_datagram
+inline size_t num_segments(const outgoing_datagram& x) noexcept {
+  if (x.segment_size == 0 || x.payload.size() <= x.segment_size)
+    return 1;
+  return (x.payload.size() + x.segment_size - 1) / x.segment_size;
+}
+
+/// Maximum number of datagrams that a single batch operation transmits.
+constexpr size_t max_datagram_batch_size = 64;
+
 /// Creates a `udp_datagram_socket` bound to given port.
 /// @param ep ip_endpoint that contains the port to bind to. Pass port '0' to
 ///           bind to any unused port - The endpoint will be updated with the
@@ -55,4 +101,41 @@ ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x, byte_span buf,
 ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x, const_byte_span buf,
                                ip_endpoint ep);
 
+/// Receives a batch of datagrams on socket `x` with a single system call if
+/// the platform supports it (`recvmmsg`).
+/// @param x The UDP socket for receiving datagrams.
+/// @param msgs Stores the receive buffers. Receives at most
+///             `max_datagram_batch_size` datagrams at once.
+/// @returns The number of received datagrams on success or -1 in case of an
+///          error. Returns -1 only if no datagram was available.
+/// @relates udp_datagram_socket
+/// @post The first N elements of `msgs` store the received datagrams, where N
+///       is the result of this function.
+ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x,
+                              span<received_datagram> msgs);
+
+/// Sends a batch of datagrams on socket `x` with a single system call if the
+/// platform supports it (`sendmmsg`). Payloads with a segment size go to the
+/// kernel as a whole if it supports generic segmentation offload (GSO). CAF
+/// splits them in user space otherwise, e.g., after the network device
+/// rejected GSO.
+/// @param x The UDP socket for sending datagrams.
+/// @param msgs The datagrams to send. Sends at most `max_datagram_batch_size`
+///             payloads or payload segments at once.
+/// @returns The number of sent datagrams on success or -1 in case of an error.
+///          Counts each segment of a payload as one datagram. Hence, callers
+///          may use `num_segments` to find out where to resume after a partial
+///          write. Returns -1 only if no datagram was sent.
+/// @relates udp_datagram_socket
+ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x,
+                               span<const outgoing_datagram> msgs);
+
+/// Enables or disables generic receive offload (GRO) for `x`. When enabled,
+/// the kernel may coalesce datagrams from the same sender and `read` reports
+/// the size of the individual datagrams in `received_datagram::segment_size`.
+/// @returns An error if the platform does not support GRO.
+/// @relates udp_datagram_socket
+error CAF_NET_EXPORT allow_receive_offload(udp_datagram_socket x,
+                                           bool new_value);
+
 } // namespace caf::net
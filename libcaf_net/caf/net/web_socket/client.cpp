@@ -29,6 +29,16 @@ std::unique_ptr<client> client::make(handshake_ptr hs, upper_layer_ptr up_ptr) {
   return std::make_unique<client>(std::move(hs), std::move(up_ptr));
 }
 
+std::unique_ptr<client>
+client::make(handshake_ptr hs, upper_layer_ptr up_ptr,
+             std::optional<detail::rfc7692::params> deflate) {
+  if (deflate)
+    hs->extensions(detail::rfc7692::make_offer(*deflate));
+  auto res = make(std::move(hs), std::move(up_ptr));
+  res->deflate_ = deflate;
+  return res;
+}
+
 // -- implementation of octet_stream::upper_layer ------------------------------
 
 error client::start(octet_stream::lower_layer* down) {
@@ -87,16 +97,30 @@ bool client::done_sending() {
 
 bool client::handle_header(std::string_view http) {
   CAF_ASSERT(hs_ != nullptr);
-  auto http_ok = hs_->is_valid_http_1_response(http);
+  std::string extensions;
+  auto http_ok = hs_->is_valid_http_1_response(http, &extensions);
   hs_.reset();
-  if (http_ok) {
-    down_->switch_protocol(framing::make_client(std::move(up_)));
-    return true;
+  if (!http_ok) {
+    CAF_LOG_DEBUG("received an invalid WebSocket handshake");
+    up_->abort(make_error(sec::protocol_error,
+                          "received an invalid WebSocket handshake"));
+    return false;
   }
-  CAF_LOG_DEBUG("received an invalid WebSocket handshake");
-  up_->abort(
-    make_error(sec::protocol_error, "received an invalid WebSocket handshake"));
-  return false;
+  std::optional<detail::rfc7692::params> deflate_params;
+  if (deflate_) {
+    auto res = detail::rfc7692::accept_response(extensions, *deflate_);
+    if (!res) {
+      CAF_LOG_DEBUG("received invalid permessage-deflate parameters");
+      up_->abort(std::move(res.error()));
+      return false;
+    }
+    deflate_params = *res;
+  }
+  auto framing_layer = framing::make_client(std::move(up_));
+  if (deflate_params)
+    framing_layer->enable_deflate(*deflate_params);
+  down_->switch_protocol(std::move(framing_layer));
+  return true;
 }
 
 } // namespace caf::net::web_socket
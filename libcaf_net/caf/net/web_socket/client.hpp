@@ -14,6 +14,7 @@
 #include "caf/byte_span.hpp"
 #include "caf/detail/base64.hpp"
 #include "caf/detail/message_flow_bridge.hpp"
+#include "caf/detail/rfc7692.hpp"
 #include "caf/error.hpp"
 #include "caf/hash/sha1.hpp"
 #include "caf/logger.hpp"
@@ -21,6 +22,7 @@
 #include "caf/settings.hpp"
 
 #include <algorithm>
+#include <optional>
 
 namespace caf::net::web_socket {
 
@@ -51,6 +53,12 @@ public:
     return make(std::make_unique<handshake>(std::move(hs)), std::move(up));
   }
 
+  /// Creates a client that offers the extension `permessage-deflate` to the
+  /// server if `deflate` is set.
+  static std::unique_ptr<client>
+  make(handshake_ptr hs, upper_layer_ptr up,
+       std::optional<detail::rfc7692::params> deflate);
+
   // -- implementation of octet_stream::upper_layer ----------------------------
 
   error start(octet_stream::lower_layer* down) override;
@@ -78,6 +86,10 @@ private:
 
   /// Next layer in the processing chain.
   upper_layer_ptr up_;
+
+  /// Stores the parameters for `permessage-deflate` that we offer to the
+  /// server, if any.
+  std::optional<detail::rfc7692::params> deflate_;
 };
 
 } // namespace caf::net::web_socket
@@ -98,7 +98,8 @@ private:
     auto [a2s_pull, a2s_push] = async::make_spsc_buffer_resource<output_t>();
     auto bridge = bridge_t::make(std::move(a2s_pull), std::move(s2a_push));
     auto bridge_ptr = bridge.get();
-    auto impl = client::make(std::move(cfg.hs), std::move(bridge));
+    auto hs = std::make_unique<handshake>(std::move(cfg.hs));
+    auto impl = client::make(std::move(hs), std::move(bridge), cfg.deflate);
     auto transport = transport_t::make(std::move(conn), std::move(impl));
     transport->active_policy().connect();
     auto ptr = socket_manager::make(cfg.mpx, std::move(transport));
@@ -11,7 +11,9 @@
 
 #include "caf/actor_control_block.hpp"
 #include "caf/detail/net_export.hpp"
+#include "caf/detail/rfc7692.hpp"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -30,6 +32,9 @@ public:
 
   /// Configures the protocol layer.
   Trait trait;
+
+  /// Configures the extension `permessage-deflate` if enabled.
+  std::optional<detail::rfc7692::params> deflate;
 };
 
 /// The configuration for a length-prefix framing server.
@@ -49,10 +54,12 @@ public:
                                 std::in_place_type<T>,
                                 std::forward<Args>(args)...);
     ptr->trait = from.trait;
+    ptr->deflate = from.deflate;
     return ptr;
   }
 
   Trait trait;
+  std::optional<detail::rfc7692::params> deflate;
 };
 
 /// The configuration for a length-prefix framing client.
@@ -72,12 +79,14 @@ public:
                                 std::in_place_type<T>,
                                 std::forward<Args>(args)...);
     ptr->trait = from.trait;
+    ptr->deflate = from.deflate;
     ptr->hs.endpoint("/");
     return ptr;
   }
 
   Trait trait;
   handshake hs;
+  std::optional<detail::rfc7692::params> deflate;
 };
 
 } // namespace caf::net::web_socket
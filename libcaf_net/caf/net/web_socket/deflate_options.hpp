@@ -0,0 +1,35 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+
+namespace caf::net::web_socket {
+
+/// Configures the WebSocket extension `permessage-deflate` as defined in
+/// RFC 7692.
+struct deflate_options {
+  /// The compression level between 1 (fastest) and 9 (best compression).
+  int level = 6;
+
+  /// Upper bound for the size of the LZ77 sliding window (base-2 logarithm)
+  /// for both directions. Must be in the range [9, 15].
+  int max_window_bits = 15;
+
+  /// Allows both sides to keep the compression context between messages. When
+  /// disabled, each message gets compressed independently. This usually
+  /// results in worse compression ratios but allows the decoder to use a
+  /// smaller window.
+  bool context_takeover = true;
+
+  /// Upper bound for the memory in bytes that the compression state of a
+  /// single connection may use or 0 for no limit. When set, CAF reduces the
+  /// window size and the internal memory level of the compressor to stay
+  /// within the limit and does not negotiate the extension if the limit is too
+  /// small for the minimum window size.
+  size_t max_memory = 0;
+};
+
+} // namespace caf::net::web_socket
@@ -9,6 +9,8 @@
 #include "caf/detail/rfc3629.hpp"
 #include "caf/logger.hpp"
 
+#include <type_traits>
+
 namespace caf::net::web_socket {
 
 // -- static utility functions -------------------------------------------------
@@ -68,7 +70,8 @@ ptrdiff_t framing::consume(byte_span buffer, byte_span) {
   down_->configure_read(receive_policy::up_to(2048));
   // Parse header.
   detail::rfc6455::header hdr;
-  auto hdr_bytes = detail::rfc6455::decode_header(buffer, hdr);
+  auto allowed_rsv = deflate_ ? detail::rfc6455::rsv1_flag : uint8_t{0};
+  auto hdr_bytes = detail::rfc6455::decode_header(buffer, hdr, allowed_rsv);
   if (hdr_bytes < 0) {
     CAF_LOG_DEBUG("decoded malformed data: hdr_bytes < 0");
     abort_and_shutdown(sec::protocol_error,
@@ -79,6 +82,17 @@ ptrdiff_t framing::consume(byte_span buffer, byte_span) {
     // Wait for more input.
     return 0;
   }
+  // RSV1 marks compressed messages and may only appear on the first frame of a
+  // data message (see RFC 7692, Section 6).
+  auto compressed = (hdr.rsv & detail::rfc6455::rsv1_flag) != 0;
+  if (compressed
+      && (detail::rfc6455::is_control_frame(hdr.opcode)
+          || hdr.opcode == detail::rfc6455::continuation_frame)) {
+    CAF_LOG_DEBUG("received RSV1 on a WebSocket control or continuation frame");
+    abort_and_shutdown(sec::protocol_error, "received RSV1 on a WebSocket "
+                                            "control or continuation frame");
+    return -1;
+  }
   if (detail::rfc6455::is_control_frame(hdr.opcode)) {
     // control frames can only have payload up to 125 bytes
     if (hdr.payload_len > 125) {
@@ -112,7 +126,10 @@ ptrdiff_t framing::consume(byte_span buffer, byte_span) {
   // Decode frame.
   auto payload_len = static_cast<size_t>(hdr.payload_len);
   auto payload = buffer.subspan(hdr_bytes, payload_len);
-  if (hdr.mask_key != 0) {
+  // Unfragmented text frames get unmasked while validating them (see below).
+  auto is_text = !compressed && hdr.fin && opcode_ == nil_code
+                 && hdr.opcode == detail::rfc6455::text_frame;
+  if (hdr.mask_key != 0 && !is_text) {
     detail::rfc6455::mask_data(hdr.mask_key, payload);
   }
   // Handle control frames first, since these may not me fragmented,
@@ -136,8 +153,9 @@ ptrdiff_t framing::consume(byte_span buffer, byte_span) {
   if (hdr.fin) {
     if (opcode_ == nil_code) {
       // Call upper layer.
-      if (hdr.opcode == detail::rfc6455::text_frame
-          && !detail::rfc3629::valid(payload)) {
+      if (compressed)
+        return handle_compressed(hdr.opcode, payload, frame_size);
+      if (is_text && !valid_text(hdr.mask_key, payload)) {
         abort_and_shutdown(sec::malformed_message, "invalid UTF-8 sequence");
         return -1;
       }
@@ -151,6 +169,13 @@ ptrdiff_t framing::consume(byte_span buffer, byte_span) {
     }
     // End of fragmented input.
     payload_buf_.insert(payload_buf_.end(), payload.begin(), payload.end());
+    if (compressed_) {
+      auto result = handle_compressed(opcode_, payload_buf_, frame_size);
+      opcode_ = nil_code;
+      payload_buf_.clear();
+      compressed_ = false;
+      return result;
+    }
     if (opcode_ == detail::rfc6455::text_frame && !payload_valid()) {
       abort_and_shutdown(sec::malformed_message, "invalid UTF-8 sequence");
       return -1;
@@ -165,13 +190,16 @@ ptrdiff_t framing::consume(byte_span buffer, byte_span) {
   // the first frame must be a continuation frame.
   if (opcode_ == nil_code) {
     opcode_ = hdr.opcode;
+    compressed_ = compressed;
   } else if (hdr.opcode != detail::rfc6455::continuation_frame) {
     CAF_LOG_DEBUG("expected a continuation frame");
     abort_and_shutdown(sec::protocol_error, "expected a continuation frame");
     return -1;
   }
   payload_buf_.insert(payload_buf_.end(), payload.begin(), payload.end());
-  if (opcode_ == detail::rfc6455::text_frame && !payload_valid()) {
+  // Compressed text can only be validated after decompressing it.
+  if (!compressed_ && opcode_ == detail::rfc6455::text_frame
+      && !payload_valid()) {
     abort_and_shutdown(sec::malformed_message, "invalid UTF-8 sequence");
     return -1;
   }
@@ -186,6 +214,10 @@ bool framing::done_sending() {
   return up_->done_sending();
 }
 
+void framing::enable_deflate(const detail::rfc7692::params& cfg) {
+  deflate_ = std::make_unique<detail::rfc7692::codec>(cfg);
+}
+
 // -- web_socket::lower_layer implementation -----------------------------------
 
 multiplexer& framing::mpx() noexcept {
@@ -227,8 +259,7 @@ byte_buffer& framing::binary_message_buffer() {
 }
 
 bool framing::end_binary_message() {
-  ship_frame(binary_buf_);
-  return true;
+  return ship_frame(binary_buf_);
 }
 
 void framing::begin_text_message() {
@@ -240,8 +271,7 @@ text_buffer& framing::text_message_buffer() {
 }
 
 bool framing::end_text_message() {
-  ship_frame(text_buf_);
-  return true;
+  return ship_frame(text_buf_);
 }
 
 // -- implementation details ---------------------------------------------------
@@ -278,6 +308,23 @@ ptrdiff_t framing::handle(uint8_t opcode, byte_span payload,
   return static_cast<ptrdiff_t>(frame_size);
 }
 
+ptrdiff_t framing::handle_compressed(uint8_t opcode, byte_span payload,
+                                     size_t frame_size) {
+  inflate_buf_.clear();
+  if (!deflate_->decompress(payload, inflate_buf_, max_frame_size)) {
+    CAF_LOG_DEBUG("failed to decompress a WebSocket message");
+    abort_and_shutdown(sec::protocol_error,
+                       "failed to decompress a WebSocket message");
+    return -1;
+  }
+  if (opcode == detail::rfc6455::text_frame
+      && !detail::rfc3629::valid(inflate_buf_)) {
+    abort_and_shutdown(sec::malformed_message, "invalid UTF-8 sequence");
+    return -1;
+  }
+  return handle(opcode, inflate_buf_, frame_size);
+}
+
 void framing::ship_pong(byte_span payload) {
   uint32_t mask_key = 0;
   if (mask_outgoing_frames) {
@@ -291,7 +338,31 @@ void framing::ship_pong(byte_span payload) {
 }
 
 template <class T>
-void framing::ship_frame(std::vector<T>& buf) {
+bool framing::ship_frame(std::vector<T>& buf) {
+  if (deflate_) {
+    constexpr auto opcode = std::is_same_v<T, char>
+                              ? detail::rfc6455::text_frame
+                              : detail::rfc6455::binary_frame;
+    constexpr auto flags = detail::rfc6455::fin_flag
+                           | detail::rfc6455::rsv1_flag;
+    deflate_buf_.clear();
+    auto ok = deflate_->compress(as_bytes(make_span(buf)), deflate_buf_);
+    buf.clear();
+    if (!ok) {
+      CAF_LOG_ERROR("failed to compress a WebSocket message");
+      return false;
+    }
+    uint32_t mask_key = 0;
+    if (mask_outgoing_frames) {
+      mask_key = static_cast<uint32_t>(rng_());
+      detail::rfc6455::mask_data(mask_key, deflate_buf_);
+    }
+    down_->begin_output();
+    detail::rfc6455::assemble_frame(opcode, mask_key, deflate_buf_,
+                                    down_->output_buffer(), flags);
+    down_->end_output();
+    return true;
+  }
   uint32_t mask_key = 0;
   if (mask_outgoing_frames) {
     mask_key = static_cast<uint32_t>(rng_());
@@ -301,6 +372,7 @@ void framing::ship_frame(std::vector<T>& buf) {
   detail::rfc6455::assemble_frame(mask_key, buf, down_->output_buffer());
   down_->end_output();
   buf.clear();
+  return true;
 }
 
 void framing::ship_closing_message(status code, std::string_view msg) {
@@ -322,6 +394,12 @@ void framing::ship_closing_message(status code, std::string_view msg) {
   down_->end_output();
 }
 
+bool framing::valid_text(uint32_t mask_key, byte_span payload) noexcept {
+  if (mask_key != 0)
+    return detail::rfc6455::mask_and_validate(mask_key, payload);
+  return detail::rfc3629::valid(payload);
+}
+
 bool framing::payload_valid() noexcept {
   // validate from the index where we left off last time
   auto [index, incomplete] = detail::rfc3629::validate(
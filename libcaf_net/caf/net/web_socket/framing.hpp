@@ -15,6 +15,7 @@
 #include "caf/byte.hpp"
 #include "caf/byte_span.hpp"
 #include "caf/detail/rfc6455.hpp"
+#include "caf/detail/rfc7692.hpp"
 #include "caf/sec.hpp"
 #include "caf/span.hpp"
 #include "caf/string_view.hpp"
@@ -92,6 +93,15 @@ public:
   /// the standard.
   bool mask_outgoing_frames = true;
 
+  /// Enables the extension `permessage-deflate` with the parameters that both
+  /// sides have agreed upon during the handshake.
+  void enable_deflate(const detail::rfc7692::params& cfg);
+
+  /// Checks whether this layer compresses and decompresses messages.
+  bool deflate_enabled() const noexcept {
+    return deflate_ != nullptr;
+  }
+
   // -- octet_stream::upper_layer implementation -------------------------------
 
   error start(octet_stream::lower_layer* down) override;
@@ -144,10 +154,14 @@ private:
   // Returns `frame_size` on success and -1 on error.
   ptrdiff_t handle(uint8_t opcode, byte_span payload, size_t frame_size);
 
+  // Decompresses `payload` before calling `handle`.
+  ptrdiff_t handle_compressed(uint8_t opcode, byte_span payload,
+                              size_t frame_size);
+
   void ship_pong(byte_span payload);
 
   template <class T>
-  void ship_frame(std::vector<T>& buf);
+  bool ship_frame(std::vector<T>& buf);
 
   // Sends closing message, can be error status, or closing handshake
   void ship_closing_message(status code, std::string_view desc);
@@ -168,6 +182,10 @@ private:
   /// while scanning in order to avoid validating the same bytes again.
   bool payload_valid() noexcept;
 
+  /// Unmasks `payload` unless `mask_key` is 0 and checks whether the result is
+  /// valid UTF-8.
+  static bool valid_text(uint32_t mask_key, byte_span payload) noexcept;
+
   // -- member variables -------------------------------------------------------
 
   /// Points to the transport layer below.
@@ -191,6 +209,19 @@ private:
   /// Stores where to resume the UTF-8 input validation.
   size_t validation_offset_ = 0;
 
+  /// Compresses and decompresses messages if both sides have agreed on using
+  /// the extension `permessage-deflate`.
+  std::unique_ptr<detail::rfc7692::codec> deflate_;
+
+  /// Stores whether the fragmented message in `payload_buf_` is compressed.
+  bool compressed_ = false;
+
+  /// Stores compressed payloads for outgoing messages.
+  byte_buffer deflate_buf_;
+
+  /// Stores decompressed payloads of incoming messages.
+  byte_buffer inflate_buf_;
+
   /// Next layer in the processing chain.
   upper_layer_ptr up_;
 };
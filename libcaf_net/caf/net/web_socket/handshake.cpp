@@ -118,7 +118,10 @@ void handshake::write_http_1_response(byte_buffer& buf) const {
          "Upgrade: websocket\r\n"
          "Connection: Upgrade\r\n"
          "Sec-WebSocket-Accept: "
-      << response_key() << "\r\n\r\n";
+      << response_key() << "\r\n";
+  if (auto ext = lookup("Sec-WebSocket-Extensions"); !ext.empty())
+    out << "Sec-WebSocket-Extensions: " << ext << "\r\n";
+  out << "\r\n";
 }
 
 void handshake::write_response(http::lower_layer* down) const {
@@ -126,6 +129,8 @@ void handshake::write_response(http::lower_layer* down) const {
   down->add_header_field("Upgrade", "websocket");
   down->add_header_field("Connection", "Upgrade");
   down->add_header_field("Sec-WebSocket-Accept", response_key());
+  if (auto ext = lookup("Sec-WebSocket-Extensions"); !ext.empty())
+    down->add_header_field("Sec-WebSocket-Extensions", ext);
   down->end_header();
   down->send_payload({});
 }
@@ -154,8 +159,10 @@ struct response_checker {
   bool has_upgrade_field = false;
   bool has_connection_field = false;
   bool has_ws_accept_field = false;
+  std::string* extensions = nullptr;
 
-  response_checker(std::string_view key) : ws_key(key) {
+  response_checker(std::string_view key, std::string* ext)
+    : ws_key(key), extensions(ext) {
     // nop
   }
 
@@ -178,6 +185,12 @@ struct response_checker {
         has_connection_field = icase_equal(value, "upgrade");
       else if (field == "Sec-WebSocket-Accept")
         has_ws_accept_field = value == ws_key;
+      else if (extensions != nullptr
+               && icase_equal(field, "Sec-WebSocket-Extensions")) {
+        if (!extensions->empty())
+          *extensions += ", ";
+        extensions->insert(extensions->end(), value.begin(), value.end());
+      }
     }
   }
 };
@@ -185,11 +198,16 @@ struct response_checker {
 } // namespace
 
 bool handshake::is_valid_http_1_response(std::string_view http_response) const {
+  return is_valid_http_1_response(http_response, nullptr);
+}
+
+bool handshake::is_valid_http_1_response(std::string_view http_response,
+                                         std::string* extensions) const {
   auto seed = detail::base64::encode(key_);
   seed += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
   auto response_key_sha = hash::sha1::compute(seed);
   auto response_key = detail::base64::encode(response_key_sha);
-  response_checker checker{response_key};
+  response_checker checker{response_key, extensions};
   for_each_http_line(http_response, checker);
   return checker.ok();
 }
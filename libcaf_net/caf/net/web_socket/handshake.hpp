@@ -149,6 +149,13 @@ public:
   /// - A `Sec-WebSocket-Accept` field with the value `response_key()`.
   bool is_valid_http_1_response(std::string_view http_response) const;
 
+  /// Checks whether the `http_response` is valid (see above) and stores the
+  /// value of the `Sec-WebSocket-Extensions` field to `extensions` unless
+  /// `extensions` is `nullptr`. Appends values of repeated fields as a
+  /// comma-separated list.
+  bool is_valid_http_1_response(std::string_view http_response,
+                                std::string* extensions) const;
+
 private:
   // -- utility ----------------------------------------------------------------
 
@@ -88,12 +88,23 @@ bool server::handle_header(std::string_view http) {
   // Finalize the WebSocket handshake.
   handshake hs;
   hs.assign_key(sec_key);
+  std::optional<detail::rfc7692::params> deflate_params;
+  if (deflate_) {
+    std::string response;
+    auto offers = hdr.field("Sec-WebSocket-Extensions");
+    deflate_params = detail::rfc7692::accept_offer(offers, *deflate_, response);
+    if (deflate_params)
+      hs.extensions(std::move(response));
+  }
   down_->begin_output();
   hs.write_http_1_response(down_->output_buffer());
   down_->end_output();
   // All done. Switch to the framing protocol.
   CAF_LOG_DEBUG("completed WebSocket handshake");
-  down_->switch_protocol(framing::make_server(std::move(up_)));
+  auto framing_layer = framing::make_server(std::move(up_));
+  if (deflate_params)
+    framing_layer->enable_deflate(*deflate_params);
+  down_->switch_protocol(std::move(framing_layer));
   return true;
 }
 
@@ -22,6 +22,7 @@
 #include "caf/byte_span.hpp"
 #include "caf/detail/message_flow_bridge.hpp"
 #include "caf/detail/net_export.hpp"
+#include "caf/detail/rfc7692.hpp"
 #include "caf/error.hpp"
 #include "caf/logger.hpp"
 #include "caf/pec.hpp"
@@ -29,6 +30,7 @@
 #include "caf/string_algorithms.hpp"
 
 #include <algorithm>
+#include <optional>
 
 namespace caf::net::web_socket {
 
@@ -54,6 +56,15 @@ public:
     return std::make_unique<server>(std::move(up));
   }
 
+  /// Creates a server that accepts offers for the extension
+  /// `permessage-deflate` from clients if `deflate` is set.
+  static std::unique_ptr<server>
+  make(upper_layer_ptr up, std::optional<detail::rfc7692::params> deflate) {
+    auto res = make(std::move(up));
+    res->deflate_ = deflate;
+    return res;
+  }
+
   // -- octet_stream::upper_layer implementation -------------------------------
 
   error start(octet_stream::lower_layer* down) override;
@@ -78,6 +89,9 @@ private:
 
   /// We store this only to pass it to the framing layer after the handshake.
   upper_layer_ptr up_;
+
+  /// Configures the extension `permessage-deflate` if enabled.
+  std::optional<detail::rfc7692::params> deflate_;
 };
 
 } // namespace caf::net::web_socket
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include <variant>
 
 namespace caf::detail {
@@ -46,9 +47,6 @@ public:
 
   using ws_res_type = typename acceptor_impl_t::ws_res_type;
 
-  // Note: this is shared with the connection factory. In general, this is
-  //       *unsafe*. However, we exploit the fact that there is currently only
-  //       one thread running in the multiplexer (which makes this safe).
   using shared_producer_type = std::shared_ptr<producer_type>;
 
   ws_server_flow_bridge(on_request_cb_type on_request,
@@ -113,10 +111,12 @@ public:
 
   ws_connection_factory(on_request_cb_type on_request,
                         shared_producer_type producer,
-                        size_t max_consecutive_reads)
+                        size_t max_consecutive_reads,
+                        std::optional<rfc7692::params> deflate)
     : on_request_(std::move(on_request)),
       producer_(std::move(producer)),
-      max_consecutive_reads_(max_consecutive_reads) {
+      max_consecutive_reads_(max_consecutive_reads),
+      deflate_(deflate) {
     // nop
   }
 
@@ -129,7 +129,7 @@ public:
     using bridge_t = ws_server_flow_bridge<Trait, Ts...>;
     auto app = bridge_t::make(on_request_, producer_);
     auto app_ptr = app.get();
-    auto ws = net::web_socket::server::make(std::move(app));
+    auto ws = net::web_socket::server::make(std::move(app), deflate_);
     auto transport = Transport::make(std::move(conn), std::move(ws));
     transport->max_consecutive_reads(max_consecutive_reads_);
     transport->active_policy().accept();
@@ -142,6 +142,7 @@ private:
   on_request_cb_type on_request_;
   shared_producer_type producer_;
   size_t max_consecutive_reads_;
+  std::optional<rfc7692::params> deflate_;
 };
 
 } // namespace caf::detail
@@ -208,7 +209,8 @@ private:
     auto [pull, push] = async::make_spsc_buffer_resource<accept_event>();
     auto producer = std::make_shared<producer_t>(producer_t{push.try_open()});
     auto factory = std::make_unique<factory_t>(on_request_, std::move(producer),
-                                               cfg.max_consecutive_reads);
+                                               cfg.max_consecutive_reads,
+                                               cfg.deflate);
     auto impl = impl_t::make(std::move(acc), std::move(factory),
                              cfg.max_connections);
     auto impl_ptr = impl.get();
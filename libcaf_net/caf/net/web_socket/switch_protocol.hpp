@@ -29,9 +29,6 @@ public:
 
   using push_type = async::producer_resource<typename Trait::input_type>;
 
-  // Note: in general, this is *unsafe*. However, we exploit the fact that there
-  //       is currently only one thread running in the multiplexer (which makes
-  //       this safe).
   using shared_producer_type = std::shared_ptr<producer_type>;
 
   ws_switch_protocol_flow_bridge(shared_producer_type producer, pull_type pull,
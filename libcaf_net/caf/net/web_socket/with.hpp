@@ -14,9 +14,12 @@
 #include "caf/net/web_socket/client_factory.hpp"
 #include "caf/net/web_socket/config.hpp"
 #include "caf/net/web_socket/default_trait.hpp"
+#include "caf/net/web_socket/deflate_options.hpp"
 #include "caf/net/web_socket/has_on_request.hpp"
 
+#include "caf/detail/rfc7692.hpp"
 #include "caf/fwd.hpp"
+#include "caf/sec.hpp"
 
 #include <cstdint>
 
@@ -38,6 +41,30 @@ public:
 
   with_t& operator=(const with_t&) noexcept = default;
 
+  /// Enables the extension `permessage-deflate` (RFC 7692) for compressing
+  /// messages. The extension is only active if the remote side agrees to use
+  /// it during the handshake.
+  /// @param opts Configures the compression level, the window sizes and the
+  ///             memory limit per connection.
+  /// @returns a reference to `*this`.
+  with_t& deflate(const deflate_options& opts) {
+    if (auto params = detail::rfc7692::fit(opts))
+      config_->deflate = *params;
+    else
+      config_->fail(make_error(sec::invalid_argument,
+                               "invalid options for permessage-deflate"));
+    return *this;
+  }
+
+  /// Enables the extension `permessage-deflate` (RFC 7692) with default
+  /// settings except for the compression `level`.
+  /// @returns a reference to `*this`.
+  with_t& deflate(int level = 6) {
+    deflate_options opts;
+    opts.level = level;
+    return deflate(opts);
+  }
+
   /// @private
   config_type& config() {
     return *config_;
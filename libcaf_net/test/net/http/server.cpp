@@ -6,8 +6,19 @@
 
 #include "caf/net/http/server.hpp"
 
+#include "caf/net/http/router.hpp"
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/octet_stream/transport.hpp"
+#include "caf/net/socket_guard.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/stream_socket.hpp"
+
+#include "caf/string_algorithms.hpp"
+
 #include "net-test.hpp"
 
+#include <limits>
+
 using namespace caf;
 using namespace std::literals;
 
@@ -106,3 +117,453 @@ SCENARIO("the server parses HTTP GET requests into header fields") {
     }
   }
 }
+
+namespace {
+
+// Responds to requests for "/async" only when calling `respond_later`.
+class async_app_t : public net::http::upper_layer {
+public:
+  net::http::lower_layer* down = nullptr;
+
+  std::vector<size_t> pending;
+
+  static auto make() {
+    return std::make_unique<async_app_t>();
+  }
+
+  error start(net::http::lower_layer* down_ptr) override {
+    down = down_ptr;
+    down->request_messages();
+    return none;
+  }
+
+  void abort(const error& reason) override {
+    CAF_FAIL("app::abort called: " << reason);
+  }
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+  ptrdiff_t consume(const net::http::request_header& hdr,
+                    const_byte_span body) override {
+    if (hdr.path() == "/async")
+      pending.push_back(down->current_request_id());
+    else
+      down->send_response(net::http::status::ok, "text/plain", hdr.path());
+    return static_cast<ptrdiff_t>(body.size());
+  }
+
+  void respond_later(size_t index) {
+    down->select_request(pending.at(index));
+    down->send_response(net::http::status::ok, "text/plain", "async");
+  }
+};
+
+std::string ok_response(std::string_view content) {
+  std::string result = "HTTP/1.1 200 OK\r\n"
+                       "Content-Type: text/plain\r\n"
+                       "Content-Length: ";
+  result += std::to_string(content.size());
+  result += "\r\n\r\n";
+  result += content;
+  return result;
+}
+
+} // namespace
+
+SCENARIO("the server sends responses to pipelined requests in order") {
+  GIVEN("multiple pipelined HTTP GET requests") {
+    std::string_view req = "GET /first HTTP/1.1\r\n\r\n"
+                           "GET /async HTTP/1.1\r\n\r\n"
+                           "GET /third HTTP/1.1\r\n\r\n"
+                           "GET /async HTTP/1.1\r\n\r\n"
+                           "GET /fifth HTTP/1.1\r\n\r\n";
+    WHEN("the application responds to some requests asynchronously") {
+      auto app_ptr = async_app_t::make();
+      auto app = app_ptr.get();
+      auto http_ptr = net::http::server::make(std::move(app_ptr));
+      auto serv = mock_stream_transport::make(std::move(http_ptr));
+      CHECK_EQ(serv->start(nullptr), error{});
+      serv->push(req);
+      CHECK_EQ(serv->handle_input(), static_cast<ptrdiff_t>(req.size()));
+      THEN("the server holds back responses until previous ones complete") {
+        REQUIRE_EQ(app->pending.size(), 2u);
+        CHECK_EQ(serv->output_as_str(), ok_response("/first"));
+        serv->output_buffer().clear();
+        app->respond_later(1);
+        CHECK_EQ(serv->output_as_str(), "");
+        app->respond_later(0);
+        auto expected = ok_response("async");
+        expected += ok_response("/third");
+        expected += ok_response("async");
+        expected += ok_response("/fifth");
+        CHECK_EQ(serv->output_as_str(), expected);
+      }
+    }
+  }
+}
+
+SCENARIO("the server collects chunked bodies for non-streaming upper layers") {
+  GIVEN("an HTTP POST request with chunked transfer encoding") {
+    std::string_view req = "POST /foo HTTP/1.1\r\n"
+                           "Host: localhost:8090\r\n"
+                           "Transfer-Encoding: chunked\r\n\r\n"
+                           "5\r\nHello\r\n"
+                           "7;ext=1\r\n, World\r\n"
+                           "0\r\n"
+                           "X-Trailer: ignored\r\n\r\n";
+    WHEN("sending it to an HTTP server") {
+      auto app_ptr = app_t::make();
+      auto app = app_ptr.get();
+      auto http_ptr = net::http::server::make(std::move(app_ptr));
+      auto serv = mock_stream_transport::make(std::move(http_ptr));
+      CHECK_EQ(serv->start(nullptr), error{});
+      serv->push(req);
+      THEN("the application receives the decoded body") {
+        CHECK_EQ(serv->handle_input(), static_cast<ptrdiff_t>(req.size()));
+        CHECK_EQ(app->hdr.path(), "/foo");
+        auto body = std::string_view{
+          reinterpret_cast<const char*>(app->payload.data()),
+          app->payload.size()};
+        CHECK_EQ(body, "Hello, World");
+        CHECK_EQ(serv->output_as_str(), ok_response("Hello world!"));
+      }
+    }
+  }
+}
+
+namespace {
+
+// Consumes bodies in pieces and stops reading after `max_pieces`.
+class stream_app_t : public net::http::upper_layer {
+public:
+  net::http::lower_layer* down = nullptr;
+
+  std::vector<std::string> pieces;
+
+  size_t max_pieces = std::numeric_limits<size_t>::max();
+
+  bool completed = false;
+
+  error abort_reason;
+
+  static auto make() {
+    return std::make_unique<stream_app_t>();
+  }
+
+  error start(net::http::lower_layer* down_ptr) override {
+    down = down_ptr;
+    down->request_messages();
+    return none;
+  }
+
+  void abort(const error& reason) override {
+    abort_reason = reason;
+  }
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+  ptrdiff_t consume(const net::http::request_header&,
+                    const_byte_span body) override {
+    return static_cast<ptrdiff_t>(body.size());
+  }
+
+  bool begin_body(const net::http::request_header&) override {
+    return true;
+  }
+
+  ptrdiff_t consume_body(const_byte_span bytes) override {
+    pieces.emplace_back(reinterpret_cast<const char*>(bytes.data()),
+                        bytes.size());
+    if (pieces.size() >= max_pieces)
+      down->suspend_reading();
+    return static_cast<ptrdiff_t>(bytes.size());
+  }
+
+  void end_body() override {
+    completed = true;
+    down->send_response(net::http::status::ok, "text/plain", "done");
+  }
+};
+
+} // namespace
+
+SCENARIO("the server passes large and chunked bodies to the upper layer") {
+  GIVEN("an HTTP POST request with chunks that arrive in multiple parts") {
+    WHEN("sending it to an HTTP server") {
+      auto app_ptr = stream_app_t::make();
+      auto app = app_ptr.get();
+      auto http_ptr = net::http::server::make(std::move(app_ptr));
+      auto serv = mock_stream_transport::make(std::move(http_ptr));
+      CHECK_EQ(serv->start(nullptr), error{});
+      THEN("the server forwards each part without waiting for full chunks") {
+        serv->push("POST /foo HTTP/1.1\r\n"
+                   "Transfer-Encoding: chunked\r\n\r\n"
+                   "A\r\nHello");
+        serv->handle_input();
+        CHECK_EQ(app->pieces, std::vector<std::string>{"Hello"});
+        serv->push(", Bob\r\n0\r\n\r\n");
+        serv->handle_input();
+        CHECK_EQ(app->pieces, (std::vector<std::string>{"Hello", ", Bob"}));
+        CHECK(app->completed);
+        CHECK_EQ(serv->output_as_str(), ok_response("done"));
+        CHECK(serv->input.empty());
+      }
+    }
+  }
+  GIVEN("an HTTP POST request with a body that exceeds the maximum size") {
+    std::string body;
+    for (char c = 'a'; c <= 'z'; ++c)
+      body.append(3, c);
+    std::string req = "POST /foo HTTP/1.1\r\n"
+                      "Content-Length: 78\r\n\r\n";
+    auto header_size = req.size();
+    req += body;
+    WHEN("sending it to an HTTP server that stops reading after each piece") {
+      auto app_ptr = stream_app_t::make();
+      auto app = app_ptr.get();
+      app->max_pieces = 1;
+      auto http_ptr = net::http::server::make(std::move(app_ptr));
+      http_ptr->max_request_size(header_size + 5);
+      auto serv = mock_stream_transport::make(std::move(http_ptr));
+      CHECK_EQ(serv->start(nullptr), error{});
+      serv->push(req);
+      THEN("the server stops reading until the upper layer resumes") {
+        serv->handle_input();
+        CHECK_EQ(app->pieces, std::vector<std::string>{"aaabb"});
+        CHECK(!serv->is_reading());
+        CHECK_EQ(serv->input.size(), body.size() - 5);
+        app->max_pieces = std::numeric_limits<size_t>::max();
+        app->down->request_messages();
+        serv->handle_input();
+        std::string received;
+        for (auto& piece : app->pieces)
+          received += piece;
+        CHECK_EQ(received, body);
+        CHECK(app->completed);
+        CHECK(serv->input.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("the server rejects malformed chunks") {
+  GIVEN("an HTTP POST request with a malformed chunk") {
+    std::string_view req = "POST /foo HTTP/1.1\r\n"
+                           "Transfer-Encoding: chunked\r\n\r\n"
+                           "xyz\r\nHello\r\n";
+    WHEN("sending it to an HTTP server") {
+      auto app_ptr = stream_app_t::make();
+      auto app = app_ptr.get();
+      auto http_ptr = net::http::server::make(std::move(app_ptr));
+      auto serv = mock_stream_transport::make(std::move(http_ptr));
+      CHECK_EQ(serv->start(nullptr), error{});
+      serv->push(req);
+      THEN("the server responds with 400 Bad Request") {
+        CHECK_EQ(serv->handle_input(), 0);
+        CHECK_EQ(app->abort_reason, sec::protocol_error);
+        CHECK(starts_with(serv->output_as_str(),
+                          "HTTP/1.1 400 Bad Request\r\n"));
+      }
+    }
+  }
+}
+
+namespace {
+
+std::string to_string(const net::http::chunk& x) {
+  return std::string{reinterpret_cast<const char*>(x.bytes().data()),
+                     x.size()};
+}
+
+net::http::chunk make_chunk(std::string_view str) {
+  return net::http::chunk{as_bytes(make_span(str))};
+}
+
+} // namespace
+
+SCENARIO("routes may read and write bodies as streams") {
+  using net::http::chunk;
+  using net::http::responder;
+  auto mpx = net::multiplexer::make(nullptr);
+  mpx->set_thread_id();
+  async::consumer_resource<chunk> upload;
+  async::producer_resource<chunk> download;
+  std::vector<net::http::route_ptr> routes;
+  routes.push_back(unbox(net::http::make_route(
+    "/upload", net::http::method::post, net::http::stream_body,
+    [&upload](responder& res) {
+      CHECK(res.has_body_stream());
+      upload = res.body_stream();
+      res.respond(net::http::status::ok, "text/plain", "ok");
+    })));
+  routes.push_back(unbox(net::http::make_route(
+    "/echo", net::http::method::post, [](responder& res) {
+      CHECK(!res.has_body_stream());
+      res.respond(net::http::status::ok, "text/plain", res.payload());
+    })));
+  routes.push_back(
+    unbox(net::http::make_route("/download", [&download](responder& res) {
+      auto [pull, push] = async::make_spsc_buffer_resource<chunk>();
+      download = std::move(push);
+      res.respond(net::http::status::ok, "text/plain", std::move(pull));
+    })));
+  auto app = net::http::router::make(std::move(routes));
+  auto serv = mock_stream_transport::make(
+    net::http::server::make(std::move(app)));
+  REQUIRE_EQ(serv->start(mpx.get()), error{});
+  auto nop = make_action([] {});
+  GIVEN("a route that reads the body of a request as a stream") {
+    WHEN("the client sends more chunks than the router buffers") {
+      std::string req = "POST /upload HTTP/1.1\r\n"
+                        "Transfer-Encoding: chunked\r\n\r\n";
+      for (size_t i = 0; i < net::http::router::body_buffer_size + 2; ++i)
+        req += "1\r\nx\r\n";
+      req += "0\r\n\r\n";
+      serv->push(req);
+      serv->handle_input();
+      THEN("the server stops reading until the route consumes the chunks") {
+        CHECK_EQ(serv->output_as_str(), ok_response("ok"));
+        CHECK(!serv->is_reading());
+        CHECK(!serv->input.empty());
+        auto in = async::consumer_adapter<chunk>::make(upload, mpx.get(), nop);
+        REQUIRE(in);
+        std::string body;
+        chunk item;
+        while (in->pull(async::delay_errors, item) == async::read_result::ok)
+          body += to_string(item);
+        mpx->apply_updates();
+        CHECK(serv->is_reading());
+        serv->handle_input();
+        CHECK(serv->input.empty());
+        for (;;) {
+          auto res = in->pull(async::delay_errors, item);
+          if (res != async::read_result::ok) {
+            CHECK(res == async::read_result::stop);
+            break;
+          }
+          body += to_string(item);
+        }
+        CHECK_EQ(body, std::string(net::http::router::body_buffer_size + 2,
+                                   'x'));
+      }
+    }
+  }
+  GIVEN("a route that reads the body of a request in one piece") {
+    WHEN("the client sends the body with chunked transfer encoding") {
+      serv->output.clear();
+      serv->push("POST /echo HTTP/1.1\r\n"
+                 "Transfer-Encoding: chunked\r\n\r\n"
+                 "5\r\nHello\r\n"
+                 "7\r\n, World\r\n"
+                 "0\r\n\r\n");
+      serv->handle_input();
+      THEN("the server collects the chunks before calling the route") {
+        CHECK_EQ(serv->output_as_str(), ok_response("Hello, World"));
+        CHECK(serv->input.empty());
+      }
+    }
+  }
+  GIVEN("a route that writes the body of a response as a stream") {
+    WHEN("the route produces chunks asynchronously") {
+      serv->output.clear();
+      serv->push("GET /download HTTP/1.1\r\n\r\n");
+      serv->handle_input();
+      THEN("the server sends each chunk with chunked transfer encoding") {
+        std::string expected = "HTTP/1.1 200 OK\r\n"
+                               "Content-Type: text/plain\r\n"
+                               "Transfer-Encoding: chunked\r\n\r\n";
+        CHECK_EQ(serv->output_as_str(), expected);
+        auto out = async::producer_adapter<chunk>::make(download, mpx.get(),
+                                                        nop, nop);
+        REQUIRE(out);
+        out->push(make_chunk("Hello"));
+        out->push(make_chunk(", World! Hello, World!"));
+        out->close();
+        mpx->apply_updates();
+        expected += "5\r\nHello\r\n"
+                    "16\r\n, World! Hello, World!\r\n"
+                    "0\r\n\r\n";
+        CHECK_EQ(serv->output_as_str(), expected);
+      }
+    }
+  }
+}
+
+SCENARIO("routes may read streamed bodies slower than the client sends them") {
+  using net::http::chunk;
+  using net::http::responder;
+  GIVEN("an HTTP server that reads from a socket") {
+    auto [fd1, fd2] = unbox(net::make_stream_socket_pair());
+    auto client_guard = net::make_socket_guard(fd1);
+    auto mpx = net::multiplexer::make(nullptr);
+    mpx->set_thread_id();
+    if (auto err = mpx->init())
+      FAIL("mpx->init failed: " << err);
+    mpx->apply_updates();
+    if (auto err = net::nonblocking(fd2, true))
+      FAIL("nonblocking returned an error: " << err);
+    async::consumer_resource<chunk> upload;
+    std::vector<net::http::route_ptr> routes;
+    routes.push_back(unbox(net::http::make_route(
+      "/upload", net::http::method::post, net::http::stream_body,
+      [&upload](responder& res) {
+        upload = res.body_stream();
+        res.respond(net::http::status::ok, "text/plain", "ok");
+      })));
+    auto app = net::http::router::make(std::move(routes));
+    auto serv = net::http::server::make(std::move(app));
+    auto transport = net::octet_stream::transport::make(fd2, std::move(serv));
+    auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+    REQUIRE_EQ(mgr->start(), none);
+    mpx->apply_updates();
+    WHEN("the client sends more chunks than the router buffers at once") {
+      auto num_chunks = net::http::router::body_buffer_size * 2;
+      std::string req = "POST /upload HTTP/1.1\r\n"
+                        "Transfer-Encoding: chunked\r\n\r\n";
+      for (size_t i = 0; i < num_chunks; ++i)
+        req += "1\r\nx\r\n";
+      req += "0\r\n\r\n";
+      REQUIRE_EQ(net::write(fd1, as_bytes(make_span(req))),
+                 static_cast<ptrdiff_t>(req.size()));
+      THEN("the route receives all chunks after the server paused reading") {
+        while (!upload)
+          mpx->poll_once(true);
+        auto nop = make_action([] {});
+        auto in = async::consumer_adapter<chunk>::make(upload, mpx.get(), nop);
+        REQUIRE(in);
+        std::string body;
+        chunk item;
+        for (;;) {
+          auto res = in->pull(async::delay_errors, item);
+          if (res == async::read_result::ok) {
+            body += to_string(item);
+          } else if (res == async::read_result::try_again_later) {
+            // Pulling on the multiplexer thread only enqueues the resume
+            // action, which runs as part of the next update cycle.
+            mpx->apply_updates();
+            mpx->poll_once(false);
+          } else {
+            break;
+          }
+        }
+        CHECK_EQ(body, std::string(num_chunks, 'x'));
+      }
+    }
+    mgr->dispose();
+    while (mpx->poll_once(false)) {
+      // repeat
+    }
+  }
+}
@@ -24,6 +24,7 @@
 
 #include "net-test.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <numeric>
 #include <vector>
@@ -153,6 +154,29 @@ void run_writer(net::stream_socket fd) {
   }
 }
 
+// Sends all inputs with a single write and then waits for all responses.
+void run_batch_writer(net::stream_socket fd) {
+  net::multiplexer::block_sigpipe();
+  std::ignore = allow_sigpipe(fd, false);
+  auto guard = make_socket_guard(fd);
+  std::vector<std::string_view> inputs{"first", "second", "pause", "third",
+                                       "fourth"};
+  byte_buffer wr_buf;
+  for (auto input : inputs)
+    encode(wr_buf, input);
+  write(fd, wr_buf);
+  // Each response consists of the 4-byte header plus "ok <n>".
+  auto pending = inputs.size() * 8;
+  byte_buffer rd_buf;
+  rd_buf.resize(512);
+  while (pending > 0) {
+    auto res = read(fd, rd_buf);
+    if (res <= 0)
+      return;
+    pending -= std::min(pending, static_cast<size_t>(res));
+  }
+}
+
 } // namespace
 
 SCENARIO("length-prefix framing reads data with 32-bit size headers") {
@@ -178,6 +202,44 @@ SCENARIO("length-prefix framing reads data with 32-bit size headers") {
   }
 }
 
+SCENARIO("length-prefix framing dispatches all messages from a single read") {
+  GIVEN("a framing object with an app that consumes strings") {
+    auto buf = std::make_shared<string_list>();
+    auto app = app_t<false>::make(nullptr, buf);
+    auto framing = net::lp::framing::make(std::move(app));
+    auto uut = mock_stream_transport::make(std::move(framing));
+    CHECK_EQ(uut->start(nullptr), error{});
+    CHECK_EQ(uut->min_read_size, net::lp::framing::hdr_size);
+    CHECK_EQ(uut->max_read_size, net::lp::framing::max_read_chunk_size);
+    WHEN("the input ends with a partial message") {
+      encode(uut->input, "hello");
+      encode(uut->input, "world");
+      auto complete_size = static_cast<ptrdiff_t>(uut->input.size());
+      byte_buffer partial;
+      encode(partial, "partial");
+      uut->input.insert(uut->input.end(), partial.begin(), partial.begin() + 6);
+      THEN("the framing consumes all complete messages at once") {
+        CHECK_EQ(uut->handle_input(), complete_size);
+        if (CHECK_EQ(buf->size(), 2u)) {
+          CHECK_EQ(buf->at(0), "hello");
+          CHECK_EQ(buf->at(1), "world");
+        }
+      }
+      AND_THEN("the framing waits for the remainder of the partial message") {
+        CHECK_EQ(uut->min_read_size, partial.size());
+        CHECK_EQ(uut->input.size(), 6u);
+        uut->input.insert(uut->input.end(), partial.begin() + 6,
+                          partial.end());
+        CHECK_EQ(uut->handle_input(),
+                 static_cast<ptrdiff_t>(partial.size()));
+        if (CHECK_EQ(buf->size(), 3u))
+          CHECK_EQ(buf->at(2), "partial");
+        CHECK_EQ(uut->min_read_size, net::lp::framing::hdr_size);
+      }
+    }
+  }
+}
+
 SCENARIO("calling suspend_reading temporarily halts receiving of messages") {
   using namespace std::literals;
   GIVEN("a framing object with an app that consumes strings") {
@@ -233,6 +295,49 @@ SCENARIO("calling suspend_reading temporarily halts receiving of messages") {
   }
 }
 
+SCENARIO("resuming after suspend_reading delivers already received messages") {
+  GIVEN("a framing object that received all messages with a single read") {
+    auto [fd1, fd2] = unbox(net::make_stream_socket_pair());
+    auto writer = std::thread{run_batch_writer, fd1};
+    auto mpx = net::multiplexer::make(nullptr);
+    mpx->set_thread_id();
+    if (auto err = mpx->init())
+      FAIL("mpx->init failed: " << err);
+    mpx->apply_updates();
+    if (auto err = net::nonblocking(fd2, true))
+      CAF_FAIL("nonblocking returned an error: " << err);
+    auto buf = std::make_shared<string_list>();
+    auto app = app_t<true>::make(mpx, buf);
+    auto app_ptr = app.get();
+    auto framing = net::lp::framing::make(std::move(app));
+    auto transport = net::octet_stream::transport::make(fd2,
+                                                        std::move(framing));
+    auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+    CHECK_EQ(mgr->start(), none);
+    mpx->apply_updates();
+    WHEN("the app calls suspend_reading") {
+      while (buf->size() < 3u)
+        mpx->poll_once(true);
+      CHECK(!mpx->is_reading(mgr.get()));
+      CHECK_EQ(buf->size(), 3u);
+      THEN("resuming delivers the buffered messages without further input") {
+        app_ptr->continue_reading();
+        while (buf->size() < 5u)
+          mpx->poll_once(true);
+        if (CHECK_EQ(buf->size(), 5u)) {
+          CHECK_EQ(buf->at(2), "pause");
+          CHECK_EQ(buf->at(3), "third");
+          CHECK_EQ(buf->at(4), "fourth");
+        }
+      }
+    }
+    writer.join();
+    while (mpx->poll_once(false)) {
+      // repeat
+    }
+  }
+}
+
 SCENARIO("lp::with(...).connect(...) translates between flows and socket I/O") {
   using namespace std::literals;
   GIVEN("a connected socket with a writer at the other end") {
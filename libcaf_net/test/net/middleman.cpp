@@ -0,0 +1,147 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE net.middleman
+
+#include "caf/net/middleman.hpp"
+
+#include "caf/net/lp/with.hpp"
+#include "caf/net/socket_guard.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/network_order.hpp"
+#include "caf/scheduled_actor/flow.hpp"
+
+#include "net-test.hpp"
+
+#include <set>
+#include <string>
+#include <string_view>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct config : actor_system_config {
+  explicit config(size_t num_threads) {
+    set("caf.scheduler.max-threads", 2);
+    set("caf.scheduler.policy", "sharing");
+    load<net::middleman>();
+    set("caf.middleman.multiplexer-threads", num_threads);
+  }
+};
+
+// Writes a length-prefixed frame to `fd` and returns the response.
+std::string round_trip(net::stream_socket fd, std::string_view str) {
+  byte_buffer buf;
+  auto len = detail::to_network_order(static_cast<uint32_t>(str.size()));
+  auto len_bytes = as_bytes(make_span(&len, 1));
+  buf.insert(buf.end(), len_bytes.begin(), len_bytes.end());
+  auto str_bytes = as_bytes(make_span(str));
+  buf.insert(buf.end(), str_bytes.begin(), str_bytes.end());
+  if (net::write(fd, buf) != static_cast<ptrdiff_t>(buf.size()))
+    return "<write failed>";
+  std::string result;
+  auto expected_size = buf.size();
+  buf.clear();
+  while (buf.size() < expected_size) {
+    std::byte tmp[64];
+    auto res = net::read(fd, make_span(tmp));
+    if (res <= 0)
+      return "<read failed>";
+    buf.insert(buf.end(), tmp, tmp + res);
+  }
+  for (auto i = buf.begin() + 4; i != buf.end(); ++i)
+    result.push_back(static_cast<char>(*i));
+  return result;
+}
+
+} // namespace
+
+SCENARIO("the middleman runs one multiplexer per configured thread") {
+  GIVEN("an actor system with three multiplexer threads") {
+    config cfg{3};
+    actor_system sys{cfg};
+    auto& mm = sys.network_manager();
+    WHEN("picking multiplexers for incoming connections") {
+      THEN("the middleman cycles through all multiplexers") {
+        CHECK_EQ(mm.num_multiplexers(), 3u);
+        std::set<net::multiplexer*> picked;
+        for (size_t i = 0; i < 3; ++i)
+          picked.emplace(mm.next_mpx());
+        CHECK_EQ(picked.size(), 3u);
+        CHECK(picked.count(mm.mpx_ptr()) == 1);
+      }
+    }
+  }
+  GIVEN("an actor system with a single multiplexer thread") {
+    config cfg{1};
+    actor_system sys{cfg};
+    auto& mm = sys.network_manager();
+    WHEN("picking multiplexers for incoming connections") {
+      THEN("the middleman always returns its default multiplexer") {
+        CHECK_EQ(mm.num_multiplexers(), 1u);
+        CHECK_EQ(mm.next_mpx(), mm.mpx_ptr());
+        CHECK_EQ(mm.next_mpx(), mm.mpx_ptr());
+      }
+    }
+  }
+}
+
+SCENARIO("the middleman selects the multiplexer backend by its short name") {
+  GIVEN("an actor system with caf.middleman.multiplexer-backend = poll") {
+    config cfg{1};
+    cfg.set("caf.middleman.multiplexer-backend", "poll");
+    actor_system sys{cfg};
+    WHEN("querying the backend of the multiplexer") {
+      THEN("the multiplexer uses poll") {
+        CHECK_EQ(sys.network_manager().mpx().backend(),
+                 net::multiplexer_backend::poll);
+      }
+    }
+  }
+}
+
+SCENARIO("servers distribute connections across multiplexers") {
+  GIVEN("an echo server in an actor system with three multiplexer threads") {
+    config cfg{3};
+    actor_system sys{cfg};
+    // Let the OS pick a free port for us and then release it again.
+    auto port = uint16_t{0};
+    {
+      auto acc = net::make_socket_guard(unbox(net::make_tcp_accept_socket(0)));
+      port = unbox(net::local_port(acc.socket()));
+    }
+    auto server
+      = net::lp::with(sys)
+          .accept(port)
+          .start([&sys](net::lp::default_trait::acceptor_resource events) {
+            sys.spawn([events](event_based_actor* self) {
+              events.observe_on(self).for_each([self](const auto& event) {
+                auto& [pull, push] = event.data();
+                pull.observe_on(self).subscribe(push);
+              });
+            });
+          });
+    REQUIRE(server);
+    WHEN("multiple clients connect to the server") {
+      THEN("each client receives its own messages back") {
+        std::vector<net::socket_guard<net::tcp_stream_socket>> clients;
+        for (size_t i = 0; i < 6; ++i) {
+          auto fd = unbox(net::make_connected_tcp_stream_socket("localhost",
+                                                                port));
+          clients.emplace_back(fd);
+        }
+        for (size_t i = 0; i < clients.size(); ++i) {
+          auto msg = "hello " + std::to_string(i);
+          CHECK_EQ(round_trip(clients[i].socket(), msg), msg);
+        }
+      }
+    }
+    server->dispose();
+  }
+}
@@ -220,6 +220,95 @@ SCENARIO("socket managers can register for read and write operations") {
   }
 }
 
+SCENARIO("the multiplexer dispatches events with any backend") {
+  for (auto backend : {net::multiplexer_backend::poll,
+                       net::multiplexer_backend::epoll}) {
+#ifndef CAF_LINUX
+    if (backend == net::multiplexer_backend::epoll)
+      continue;
+#endif
+    GIVEN("a multiplexer with the " << to_string(backend) << " backend") {
+      mpx = net::multiplexer::make(nullptr);
+      mpx->set_thread_id();
+      if (auto err = mpx->init(backend))
+        FAIL("mpx->init failed: " << err);
+      exhaust();
+      CHECK_EQ(mpx->backend(), backend);
+      WHEN("socket managers exchange data") {
+        auto [alice_fd, bob_fd] = unbox(net::make_stream_socket_pair());
+        auto [alice, alice_mgr] = make_manager(alice_fd, "Alice");
+        auto [bob, bob_mgr] = make_manager(bob_fd, "Bob");
+        alice_mgr->register_reading();
+        bob_mgr->register_reading();
+        apply_updates();
+        THEN("the multiplexer runs callbacks on socket activity") {
+          alice->send("Hello Bob!");
+          alice_mgr->register_writing();
+          exhaust();
+          CHECK_EQ(bob->receive(), "Hello Bob!");
+          bob->send("Hello Alice!");
+          bob_mgr->register_writing();
+          exhaust();
+          CHECK_EQ(alice->receive(), "Hello Alice!");
+        }
+      }
+      mpx->shutdown();
+      exhaust();
+    }
+  }
+}
+
+SCENARIO("the multiplexer keeps track of managers after removing others") {
+  GIVEN("an initialized multiplexer with multiple socket managers") {
+    init();
+    auto [alice_fd, bob_fd] = unbox(net::make_stream_socket_pair());
+    auto [carl_fd, dave_fd] = unbox(net::make_stream_socket_pair());
+    auto [alice, alice_mgr] = make_manager(alice_fd, "Alice");
+    auto [bob, bob_mgr] = make_manager(bob_fd, "Bob");
+    auto [carl, carl_mgr] = make_manager(carl_fd, "Carl");
+    auto [dave, dave_mgr] = make_manager(dave_fd, "Dave");
+    for (auto* mgr : {alice_mgr.get(), bob_mgr.get(), carl_mgr.get(),
+                      dave_mgr.get()})
+      mgr->register_reading();
+    apply_updates();
+    CHECK_EQ(mpx->num_socket_managers(), 5u);
+    WHEN("removing a manager from the middle of the pollset") {
+      bob_mgr->deregister();
+      apply_updates();
+      THEN("all other managers keep receiving events") {
+        CHECK_EQ(mpx->num_socket_managers(), 4u);
+        CHECK_EQ(mpx->index_of(bob_mgr), -1);
+        CHECK_NE(mpx->index_of(dave_mgr), -1);
+        carl->send("Hello Dave!");
+        carl_mgr->register_writing();
+        exhaust();
+        CHECK_EQ(dave->receive(), "Hello Dave!");
+        dave->send("Hello Carl!");
+        dave_mgr->register_writing();
+        exhaust();
+        CHECK_EQ(carl->receive(), "Hello Carl!");
+      }
+    }
+  }
+}
+
+SCENARIO("multiplexer backends have a string representation") {
+  GIVEN("the names of all backends") {
+    WHEN("parsing the names") {
+      THEN("the result round-trips through to_string") {
+        auto backend = net::multiplexer_backend::poll;
+        CHECK(from_string("caf::net::multiplexer_backend::epoll", backend));
+        CHECK_EQ(backend, net::multiplexer_backend::epoll);
+        CHECK_EQ(to_string(backend), "caf::net::multiplexer_backend::epoll");
+        CHECK(from_string("caf::net::multiplexer_backend::poll", backend));
+        CHECK_EQ(backend, net::multiplexer_backend::poll);
+        CHECK_EQ(to_string(backend), "caf::net::multiplexer_backend::poll");
+        CHECK(!from_string("caf::net::multiplexer_backend::select", backend));
+      }
+    }
+  }
+}
+
 SCENARIO("a multiplexer terminates its thread after shutting down") {
   GIVEN("a multiplexer running in its own thread and some socket managers") {
     init();
@@ -53,6 +53,17 @@ struct fixture : test_coordinator_fixture<> {
     return mpx->poll_once(false);
   }
 
+  std::string receive_all() {
+    while (handle_io_event())
+      ; // repeat
+    recv_buf.resize(8192);
+    auto res = read(send_socket_guard.socket(), make_span(recv_buf));
+    if (res <= 0)
+      return {};
+    return std::string{reinterpret_cast<char*>(recv_buf.data()),
+                       static_cast<size_t>(res)};
+  }
+
   settings config;
   net::multiplexer_ptr mpx;
   byte_buffer recv_buf;
@@ -112,6 +123,86 @@ private:
   byte_buffer_ptr send_buf_;
 };
 
+// Mixes the output buffer with buffers that the transport sends without
+// copying them.
+class appending_application : public mock_application {
+public:
+  using mock_application::mock_application;
+
+  static auto make(byte_buffer_ptr recv_buf, byte_buffer_ptr send_buf) {
+    return std::make_unique<appending_application>(std::move(recv_buf),
+                                                   std::move(send_buf));
+  }
+
+  void prepare_send() override {
+    if (done_)
+      return;
+    done_ = true;
+    auto add = [this](char c, size_t n) {
+      auto& buf = down->output_buffer();
+      buf.insert(buf.end(), n, static_cast<std::byte>(c));
+    };
+    add('a', 10);
+    down->append_output(byte_buffer(2000, std::byte{'b'}));
+    add('c', 10);
+    down->append_output(
+      net::shared_bytes{byte_buffer(1500, std::byte{'d'})});
+    down->append_output(byte_buffer(5, std::byte{'e'}));
+    add('f', 10);
+  }
+
+private:
+  bool done_ = false;
+};
+
+// Writes at most 100 bytes at once to force partial writes.
+class trickle_policy : public os::transport::policy_impl {
+public:
+  using super = os::transport::policy_impl;
+
+  using super::super;
+
+  ptrdiff_t write(const_byte_span buf) override {
+    return super::write(buf.first(std::min(buf.size(), size_t{100})));
+  }
+
+  ptrdiff_t write(span<const const_byte_span> bufs) override {
+    std::vector<const_byte_span> trimmed;
+    size_t remaining = 100;
+    for (auto buf : bufs) {
+      if (remaining == 0)
+        break;
+      auto n = std::min(buf.size(), remaining);
+      trimmed.push_back(buf.first(n));
+      remaining -= n;
+    }
+    return super::write(make_span(trimmed));
+  }
+};
+
+// Uses the trickle policy instead of the default policy.
+class trickle_transport : public os::transport {
+public:
+  trickle_transport(net::stream_socket fd, upper_layer_ptr up)
+    : os::transport(&policy_, std::move(up)), policy_(fd) {
+    // nop
+  }
+
+private:
+  trickle_policy policy_;
+};
+
+std::string expected_output() {
+  std::string result;
+  result.append(10, 'a');
+  result.append(2000, 'b');
+  result.append(10, 'c');
+  result.append(1500, 'd');
+  result.append(5, 'e');
+  result.append(10, 'f');
+  return result;
+}
+
 } // namespace
 
 BEGIN_FIXTURE_SCOPE(fixture)
@@ -155,4 +246,43 @@ CAF_TEST(send) {
            hello_manager);
 }
 
+SCENARIO("the transport sends appended buffers in order") {
+  GIVEN("an application that appends buffers to its output") {
+    WHEN("the transport writes to the socket") {
+      auto mock = appending_application::make(shared_recv_buf,
+                                              shared_send_buf);
+      auto transport = os::transport::make(recv_socket_guard.release(),
+                                           std::move(mock));
+      auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+      REQUIRE_EQ(mgr->start(), none);
+      mpx->apply_updates();
+      mgr->register_writing();
+      mpx->apply_updates();
+      THEN("the peer receives all bytes in the order of writing them") {
+        CHECK_EQ(receive_all(), expected_output());
+      }
+    }
+  }
+}
+
+SCENARIO("the transport resumes partial writes") {
+  GIVEN("a policy that only writes parts of the buffers") {
+    WHEN("the transport writes to the socket") {
+      auto mock = appending_application::make(shared_recv_buf,
+                                              shared_send_buf);
+      auto transport
+        = std::make_unique<trickle_transport>(recv_socket_guard.release(),
+                                              std::move(mock));
+      auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+      REQUIRE_EQ(mgr->start(), none);
+      mpx->apply_updates();
+      mgr->register_writing();
+      mpx->apply_updates();
+      THEN("the transport resumes each write where the last one stopped") {
+        CHECK_EQ(receive_all(), expected_output());
+      }
+    }
+  }
+}
+
 END_FIXTURE_SCOPE()
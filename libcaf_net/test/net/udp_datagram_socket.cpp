@@ -59,6 +59,37 @@ error read_from_socket(udp_datagram_socket sock, byte_buffer& buf) {
   return make_error(sec::runtime_error, "too many read attempts");
 }
 
+// Reads datagrams in batches until receiving `num_bytes` bytes in total and
+// splits coalesced datagrams into their segments.
+std::vector<std::string> read_batches(udp_datagram_socket sock,
+                                      size_t num_bytes) {
+  std::vector<std::string> result;
+  std::vector<byte_buffer> bufs(4, byte_buffer(1024));
+  size_t received = 0;
+  for (auto attempt = 0; attempt < 100 && received < num_bytes; ++attempt) {
+    std::vector<received_datagram> msgs;
+    for (auto& buf : bufs)
+      msgs.push_back(received_datagram{ip_endpoint{}, buf, 0, false});
+    auto res = read(sock, make_span(msgs));
+    if (res < 0)
+      continue;
+    for (size_t i = 0; i < static_cast<size_t>(res); ++i) {
+      auto payload = msgs[i].payload;
+      received += payload.size();
+      auto segment_size = msgs[i].segment_size > 0 ? msgs[i].segment_size
+                                                   : payload.size();
+      while (!payload.empty()) {
+        auto n = std::min(segment_size, payload.size());
+        result.emplace_back(reinterpret_cast<const char*>(payload.data()), n);
+        payload = payload.subspan(n);
+      }
+    }
+  }
+  return result;
+}
+
+using string_list = std::vector<std::string>;
+
 } // namespace
 
 CAF_TEST_FIXTURE_SCOPE(udp_datagram_socket_test, fixture)
@@ -85,4 +116,53 @@ CAF_TEST(read and write) {
   CHECK_EQ(received, hello_test);
 }
 
+CAF_TEST(read and write batches) {
+  if (auto err = nonblocking(socket_cast<net::socket>(receive_socket), true))
+    CAF_FAIL("setting socket to nonblocking failed: " << err);
+  std::vector<received_datagram> empty(2);
+  CHECK(read(receive_socket, make_span(empty)) < 0);
+  std::string_view strs[] = {"first", "second", "third"};
+  std::vector<outgoing_datagram> msgs;
+  for (auto str : strs)
+    msgs.push_back(outgoing_datagram{ep, as_bytes(make_span(str)), 0});
+  CHECK_EQ(write(send_socket, make_span(msgs)), 3);
+  CHECK_EQ(read_batches(receive_socket, 16),
+           string_list({"first", "second", "third"}));
+}
+
+CAF_TEST(segmentation offload) {
+  if (auto err = nonblocking(socket_cast<net::socket>(receive_socket), true))
+    CAF_FAIL("setting socket to nonblocking failed: " << err);
+  std::string_view str = "aaaaabbbbbccc";
+  outgoing_datagram msg{ep, as_bytes(make_span(str)), 5};
+  CHECK_EQ(num_segments(msg), 3u);
+  CHECK_EQ(write(send_socket, make_span(&msg, 1)), 3);
+  CHECK_EQ(read_batches(receive_socket, str.size()),
+           string_list({"aaaaa", "bbbbb", "ccc"}));
+  if (auto err = allow_receive_offload(receive_socket, true)) {
+    CAF_MESSAGE("skip receive offload test: " << err);
+    return;
+  }
+  CHECK_EQ(write(send_socket, make_span(&msg, 1)), 3);
+  CHECK_EQ(read_batches(receive_socket, str.size()),
+           string_list({"aaaaa", "bbbbb", "ccc"}));
+}
+
+CAF_TEST(partial writes report the number of sent segments) {
+  if (auto err = nonblocking(socket_cast<net::socket>(receive_socket), true))
+    CAF_FAIL("setting socket to nonblocking failed: " << err);
+  // The kernel rejects payloads with too many segments. CAF then splits the
+  // payload in user space and sends at most `max_datagram_batch_size`
+  // segments at once.
+  std::string str(100, 'a');
+  outgoing_datagram msg{ep, as_bytes(make_span(str)), 1};
+  auto res = write(send_socket, make_span(&msg, 1));
+  CAF_MESSAGE("sent " << res << " segments");
+  CHECK(res == 100 || res == static_cast<ptrdiff_t>(max_datagram_batch_size));
+  if (res <= 0)
+    return;
+  auto n = static_cast<size_t>(res);
+  CHECK_EQ(read_batches(receive_socket, n), string_list(n, "a"));
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -382,6 +382,107 @@ SCENARIO("the application shuts down on invalid UTF-8 message") {
   }
 }
 
+SCENARIO("the framing layer supports permessage-deflate") {
+  detail::rfc7692::params cfg;
+  detail::rfc7692::codec peer{cfg};
+  auto text = "Hello, WebSocket! Hello, WebSocket!"sv;
+  byte_buffer payload;
+  REQUIRE(peer.compress(as_bytes(make_span(text)), payload));
+  auto rsv1_flag = detail::rfc6455::rsv1_flag;
+  GIVEN("a WebSocket connection with permessage-deflate") {
+    WHEN("the client sends a compressed text message") {
+      reset();
+      uut->enable_deflate(cfg);
+      byte_buffer frame;
+      detail::rfc6455::assemble_frame(detail::rfc6455::text_frame, 0x0,
+                                      payload, frame,
+                                      detail::rfc6455::fin_flag | rsv1_flag);
+      transport->push(frame);
+      THEN("the application receives the decompressed text") {
+        CHECK_EQ(transport->handle_input(),
+                 static_cast<ptrdiff_t>(frame.size()));
+        CHECK_EQ(app->text_input, text);
+        CHECK(!app->has_aborted());
+      }
+    }
+    WHEN("the client sends a compressed text message in two fragments") {
+      reset();
+      uut->enable_deflate(cfg);
+      auto payload_span = make_span(payload);
+      auto half = payload.size() / 2;
+      byte_buffer frame;
+      detail::rfc6455::assemble_frame(detail::rfc6455::text_frame, 0x0,
+                                      payload_span.subspan(0, half), frame,
+                                      rsv1_flag);
+      detail::rfc6455::assemble_frame(detail::rfc6455::continuation_frame, 0x0,
+                                      payload_span.subspan(half), frame);
+      transport->push(frame);
+      THEN("the application receives the decompressed text") {
+        CHECK_EQ(transport->handle_input(),
+                 static_cast<ptrdiff_t>(frame.size()));
+        CHECK_EQ(app->text_input, text);
+        CHECK(!app->has_aborted());
+      }
+    }
+    WHEN("the client sets RSV1 on a continuation frame") {
+      reset();
+      uut->enable_deflate(cfg);
+      auto payload_span = make_span(payload);
+      auto half = payload.size() / 2;
+      byte_buffer frame;
+      detail::rfc6455::assemble_frame(detail::rfc6455::text_frame, 0x0,
+                                      payload_span.subspan(0, half), frame,
+                                      rsv1_flag);
+      detail::rfc6455::assemble_frame(detail::rfc6455::continuation_frame, 0x0,
+                                      payload_span.subspan(half), frame,
+                                      detail::rfc6455::fin_flag | rsv1_flag);
+      transport->push(frame);
+      THEN("the server aborts the application") {
+        transport->handle_input();
+        CHECK_EQ(app->abort_reason, sec::protocol_error);
+      }
+    }
+    WHEN("the application sends a text message") {
+      reset();
+      uut->enable_deflate(cfg);
+      uut->begin_text_message();
+      auto& buf = uut->text_message_buffer();
+      buf.insert(buf.end(), text.begin(), text.end());
+      CHECK(uut->end_text_message());
+      THEN("the server sends a compressed frame") {
+        auto& out = transport->output_buffer();
+        detail::rfc6455::header hdr;
+        auto hdr_bytes = detail::rfc6455::decode_header(out, hdr, rsv1_flag);
+        REQUIRE_GT(hdr_bytes, 0);
+        CHECK_EQ(hdr.rsv, rsv1_flag);
+        CHECK_EQ(hdr.opcode, detail::rfc6455::text_frame);
+        CHECK_EQ(out.size(), hdr_bytes + hdr.payload_len);
+        byte_buffer decompressed;
+        auto compressed = make_span(out).subspan(hdr_bytes);
+        CHECK(peer.decompress(compressed, decompressed, 1024));
+        auto str = std::string_view{
+          reinterpret_cast<const char*>(decompressed.data()),
+          decompressed.size()};
+        CHECK_EQ(str, text);
+      }
+    }
+  }
+  GIVEN("a WebSocket connection without permessage-deflate") {
+    WHEN("the client sends a compressed text message") {
+      reset();
+      byte_buffer frame;
+      detail::rfc6455::assemble_frame(detail::rfc6455::text_frame, 0x0,
+                                      payload, frame,
+                                      detail::rfc6455::fin_flag | rsv1_flag);
+      transport->push(frame);
+      THEN("the server aborts the application") {
+        transport->handle_input();
+        CHECK_EQ(app->abort_reason, sec::protocol_error);
+      }
+    }
+  }
+}
+
 END_FIXTURE_SCOPE()
 
 namespace {
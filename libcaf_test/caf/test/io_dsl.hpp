@@ -71,6 +71,7 @@ public:
   uint16_t publish(Handle whom, uint16_t port, const char* in = nullptr,
                    bool reuse = false) {
     this->sched.inline_next_enqueue();
+    this->sched.after_next_enqueue(run_all_nodes);
     auto res = mm.publish(whom, port, in, reuse);
     CAF_REQUIRE(res);
     return *res;